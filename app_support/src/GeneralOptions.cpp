@@ -11,6 +11,9 @@ auto GetGeneralOpts() -> po::options_description
         ("cache-memory-limit", po::value<std::string>(), "Maximum size of the "
             "slice cache in bytes. Accepts the suffixes: (K|M|G|T)(B). "
             "Default: 50% of the total system memory.")
+        ("prefetch-slices", po::value<std::size_t>()->default_value(8),
+            "Number of slices to load in the background ahead of sequential "
+            "slice access. Set to 0 to disable prefetching.")
         ("progress", po::value<bool>()->default_value(true),
             "When enabled, show algorithm progress bars.")
         ("progress-interval", po::value<std::string>(),
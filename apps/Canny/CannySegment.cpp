@@ -2,33 +2,35 @@
 #pragma ide diagnostic ignored "readability-identifier-length"
 #pragma clang diagnostic ignored "-Wunknown-pragmas"
 #pragma ide diagnostic ignored "cppcoreguidelines-avoid-magic-numbers"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <QApplication>
 #include <boost/program_options.hpp>
 #include <opencv2/imgcodecs.hpp>
-#include <vtkAppendPolyData.h>
-#include <vtkCleanPolyData.h>
-#include <vtkCutter.h>
-#include <vtkLine.h>
-#include <vtkPointData.h>
-#include <vtkProbeFilter.h>
-#include <vtkSmartPointer.h>
 
 #include "CannyViewerWindow.hpp"
 #include "vc/app_support/ProgressIndicator.hpp"
 #include "vc/core/filesystem.hpp"
 #include "vc/core/io/MeshIO.hpp"
-#include "vc/core/io/PLYWriter.hpp"
-#include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/Exceptions.hpp"
 #include "vc/core/types/Volume.hpp"
 #include "vc/core/types/VolumePkg.hpp"
+#include "vc/core/util/Canny.hpp"
+#include "vc/core/util/CharConv.hpp"
 #include "vc/core/util/ImageConversion.hpp"
 #include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/String.hpp"
-#include "vc/meshing/ITK2VTK.hpp"
+#include "vc/core/util/ThreadPool.hpp"
+#include "vc/meshing/MeshSlicer.hpp"
 
 namespace fs = volcart::filesystem;
 namespace po = boost::program_options;
@@ -38,6 +40,254 @@ namespace vcm = volcart::meshing;
 using vc::range;
 using vc::range2D;
 
+namespace
+{
+// Reusable per-thread images for SegmentSlice
+struct SliceScratch {
+    cv::Mat slice;
+    cv::Mat edges;
+};
+
+// Segment a single slice and return the surface points in ray order
+auto SegmentSlice(
+    const vc::Volume& volume,
+    const vcm::MeshSlicer* slicer,
+    const vc::CannySettings& cannySettings,
+    int z) -> std::vector<cv::Vec3d>
+{
+    // Workers persist for the whole run, so each keeps its images across
+    // slices instead of reallocating them
+    thread_local SliceScratch scratch;
+
+    // Get the slice. The cached slice is converted into the scratch image
+    // rather than copied first.
+    vc::QuantizeImage(volume.getSliceData(z), scratch.slice, CV_8U, false);
+
+    vc::Canny(scratch.slice, scratch.edges, cannySettings);
+    const auto& processed = scratch.edges;
+
+    std::vector<cv::Vec3d> points;
+
+    // Keep all edges
+    if (cannySettings.projectionFrom == 'N') {
+        for (const auto pt : range2D(processed.rows, processed.cols)) {
+            const auto& x = pt.second;
+            const auto& y = pt.first;
+            if (processed.at<std::uint8_t>(y, x) > 0) {
+                points.emplace_back(x, y, z);
+            }
+        }
+        return points;
+    }
+
+    // Build the set of rays that will be projected to find the edges
+    std::vector<cv::Vec2d> rayBases;
+    std::vector<cv::Vec2d> rayOrigins;
+
+    if (cannySettings.projectionFrom == 'L') {
+        for (auto y : range(processed.rows)) {
+            rayOrigins.push_back({0, static_cast<double>(y)});
+            rayBases.push_back({1, 0});
+        }
+    } else if (cannySettings.projectionFrom == 'R') {
+        for (auto y : range(processed.rows)) {
+            rayOrigins.push_back(
+                {static_cast<double>(processed.cols - 1),
+                 static_cast<double>(y)});
+            rayBases.push_back({-1, 0});
+        }
+    } else if (cannySettings.projectionFrom == 'T') {
+        for (auto x : range(processed.cols)) {
+            rayOrigins.push_back({static_cast<double>(x), 0});
+            rayBases.push_back({0, 1});
+        }
+    } else if (cannySettings.projectionFrom == 'B') {
+        for (auto x : range(processed.cols)) {
+            rayOrigins.push_back(
+                {static_cast<double>(x),
+                 static_cast<double>(processed.rows - 1)});
+            rayBases.push_back({0, -1});
+        }
+    } else if (
+        cannySettings.projectionFrom == 'M' ||
+        cannySettings.projectionFrom == 'I') {
+        // go through line segments of the mesh intersection
+        for (const auto& line : slicer->slice(z)) {
+            for (std::size_t i = 0; i + 1 < line.points.size(); ++i) {
+                const auto& p0 = line.points[i];
+                const auto& p1 = line.points[i + 1];
+                const auto& n0 = line.normals[i];
+                const auto& n1 = line.normals[i + 1];
+
+                // sample points and normals along the segment
+                const auto length = cv::norm(p1 - p0);
+                for (auto t = 0; t < static_cast<int>(length); ++t) {
+                    const auto a = t / length;
+                    const cv::Vec3d p = p0 + a * (p1 - p0);
+                    cv::Vec3d n = n0 + a * (n1 - n0);
+                    // check if normal is all zeros
+                    if (n[0] == 0 && n[1] == 0 && n[2] == 0) {
+                        continue;
+                    }
+                    // project normal to xy plane
+                    n[2] = 0;
+                    // normalize
+                    n = n / cv::norm(n);
+                    // invert normal if needed
+                    if (cannySettings.projectionFrom == 'I') {
+                        n = -n;
+                    }
+                    // add point to ray origins after converting to 2d
+                    rayOrigins.push_back({p[0], p[1]});
+                    // add normal to ray bases after converting to 2d
+                    rayBases.push_back({n[0], n[1]});
+                }
+            }
+        }
+    }
+
+    cv::Vec3d first;
+    cv::Vec3d last;
+    for (auto r : range(rayBases.size())) {
+        const auto& rayBasis = rayBases[r];
+        const auto& rayOrigin = rayOrigins[r];
+
+        // Get the first
+        auto haveFirst = false;
+
+        auto pt = rayOrigin;
+        int xI = static_cast<int>(pt[0]);
+        int yI = static_cast<int>(pt[1]);
+        while (
+            xI >= 0
+            && xI < processed.cols
+            && yI >= 0
+            && yI < processed.rows
+        ) {
+            // if point is on detected edge
+            if (!haveFirst && processed.at<std::uint8_t>(yI, xI) != 0) {
+                // set first
+                first = {pt[0], pt[1], static_cast<double>(z)};
+                last = first;
+                haveFirst = true;
+                continue;
+            }
+
+            if (cannySettings.midpoint && haveFirst &&
+                processed.at<std::uint8_t>(yI, xI) != 0) {
+                last = {pt[0], pt[1], static_cast<double>(z)};
+            }
+
+            if (!cannySettings.midpoint && haveFirst) {
+                break;
+            }
+
+            // move point along ray
+            pt += rayBasis * 0.5;
+            xI = static_cast<int>(pt[0]);
+            yI = static_cast<int>(pt[1]);
+        }
+
+        if (!haveFirst) {
+            continue;
+        }
+
+        points.emplace_back((first + last) / 2);
+    }
+
+    return points;
+}
+
+// Writes points to an ASCII PLY file as they are produced. The vertex count
+// isn't known until the end, so vertices are written to a temporary file
+// which is appended to the header by finish(). The output matches the point
+// cloud written by PLYWriter.
+class PointStreamWriter
+{
+public:
+    explicit PointStreamWriter(fs::path path)
+        : path_{std::move(path)}, tmpPath_{path_}
+    {
+        tmpPath_ += ".vertices.tmp";
+        tmp_.open(tmpPath_.string(), std::ios::binary);
+        if (not tmp_.is_open()) {
+            throw vc::IOException(
+                "Failed to open file for writing: " + tmpPath_.string());
+        }
+    }
+
+    // Remove the temporary vertex list, even if finish() was never reached
+    ~PointStreamWriter()
+    {
+        tmp_.close();
+        try {
+            fs::remove(tmpPath_);
+        } catch (...) {
+            // Destructors must not throw
+        }
+    }
+
+    PointStreamWriter(const PointStreamWriter&) = delete;
+    auto operator=(const PointStreamWriter&) -> PointStreamWriter& = delete;
+
+    // Append points to the vertex list
+    void write(const std::vector<cv::Vec3d>& points)
+    {
+        for (const auto& p : points) {
+            for (int i = 0; i < 3; i++) {
+                vc::AppendNumber(buffer_, static_cast<float>(p[i]));
+                buffer_ += ' ';
+            }
+            buffer_ += "0 0 0\n";
+        }
+        tmp_.write(
+            buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+        count_ += points.size();
+    }
+
+    // Write the header and vertex list to the output file
+    void finish()
+    {
+        tmp_.close();
+        std::ofstream out(path_.string(), std::ios::binary);
+        if (not out.is_open()) {
+            throw vc::IOException(
+                "Failed to open file for writing: " + path_.string());
+        }
+        out << "ply\n";
+        out << "format ascii 1.0\n";
+        out << "comment VC PLY Exporter v1.0\n";
+        out << "element vertex " << count_ << "\n";
+        out << "property float x\n";
+        out << "property float y\n";
+        out << "property float z\n";
+        out << "property float nx\n";
+        out << "property float ny\n";
+        out << "property float nz\n";
+        out << "end_header\n";
+        if (count_ > 0) {
+            std::ifstream in(tmpPath_.string(), std::ios::binary);
+            out << in.rdbuf();
+        }
+        out.close();
+        fs::remove(tmpPath_);
+    }
+
+private:
+    // Output path
+    fs::path path_;
+    // Temporary vertex list path
+    fs::path tmpPath_;
+    // Temporary vertex list
+    std::ofstream tmp_;
+    // Formatting buffer
+    std::string buffer_;
+    // Number of points written
+    std::size_t count_{0};
+};
+}  // namespace
+
 auto main(int argc, char* argv[]) -> int
 {
     ///// Parse the command line options /////
@@ -153,43 +403,18 @@ auto main(int argc, char* argv[]) -> int
     /**************************************************************************/
     /******************************** MESHES **********************************/
 
-    // Get meshes
+    // Get meshes and index their triangles for slicing
     std::cout << "Loading meshes..." << std::endl;
-    std::vector<vtkSmartPointer<vtkPolyData>> meshes;
-    for (const auto& meshPath : cannySettings.fromMeshes) {
-        auto meshFile = vc::ReadMesh(meshPath);
-        auto vtkMesh = vcm::ITK2VTK(meshFile.mesh);
-        meshes.push_back(vtkMesh);
-    }
-
-    // Combine meshes if we have multiple
-    vtkSmartPointer<vtkPolyData> vtkMesh;
-    if (meshes.size() > 1) {
-        // Append all the meshes into a single polydata
-        auto append = vtkSmartPointer<vtkAppendPolyData>::New();
-        for (const auto& mesh : meshes) {
-            append->AddInputData(mesh);
+    std::unique_ptr<vcm::MeshSlicer> slicer;
+    if (not cannySettings.fromMeshes.empty()) {
+        slicer = std::make_unique<vcm::MeshSlicer>();
+        for (const auto& meshPath : cannySettings.fromMeshes) {
+            auto meshFile = vc::ReadMesh(meshPath);
+            slicer->addMesh(meshFile.mesh);
         }
-        append->Update();
-
-        // Clean it up
-        auto cleaner = vtkSmartPointer<vtkCleanPolyData>::New();
-        cleaner->SetInputConnection(append->GetOutputPort());
-        cleaner->Update();
-
-        vtkMesh = cleaner->GetOutput();
-    } else if (meshes.size() == 1) {
-        vtkMesh = meshes[0];
-    }
-
-    vtkSmartPointer<vtkCutter> cutter;
-    vtkSmartPointer<vtkPlane> plane;
-    if (vtkMesh != nullptr) {
-        cutter = vtkSmartPointer<vtkCutter>::New();
-        plane = vtkSmartPointer<vtkPlane>::New();
 
-        auto zMin = static_cast<int>(std::floor(vtkMesh->GetBounds()[4]));
-        auto zMax = static_cast<int>(std::ceil(vtkMesh->GetBounds()[5]));
+        auto zMin = static_cast<int>(std::floor(slicer->zMin()));
+        auto zMax = static_cast<int>(std::ceil(slicer->zMax()));
 
         // Bounds checks
         if (zMin < 0) {
@@ -204,17 +429,6 @@ auto main(int argc, char* argv[]) -> int
 
         cannySettings.zMin = zMin;
         cannySettings.zMax = zMax;
-
-        plane->SetOrigin(
-            static_cast<double>(volume->sliceWidth()) / 2,
-            static_cast<double>(volume->sliceHeight()) / 2,
-            0
-        );
-        plane->SetNormal(0, 0, 1);
-
-        cutter->SetInputData(vtkMesh);
-        cutter->SetCutFunction(plane);
-        cutter->Update();
     }
     /**************************************************************************/
 
@@ -232,210 +446,50 @@ auto main(int argc, char* argv[]) -> int
     // check that if project from is 'M' or 'I' that we have a mesh
     if ((cannySettings.projectionFrom == 'M' ||
          cannySettings.projectionFrom == 'I') &&
-        vtkMesh == nullptr) {
+        slicer == nullptr) {
         std::cerr << "ERROR: projection-from=[M,I] requires --from-mesh to be "
                      "specified\n";
         return EXIT_FAILURE;
     }
+    if ((cannySettings.projectionFrom == 'M' ||
+         cannySettings.projectionFrom == 'I') &&
+        not slicer->hasNormals()) {
+        std::cerr << "Error: Input mesh has no normals\n";
+        return EXIT_FAILURE;
+    }
 
     // Segment
     std::cout << "Segmenting surface..." << std::endl;
-    auto mesh = vc::ITKMesh::New();
-    cv::Vec3d first;
-    cv::Vec3d middle;
-    cv::Vec3d last;
     auto zMin = static_cast<int>(cannySettings.zMin);
     auto zMax = static_cast<int>(cannySettings.zMax);
-    for (const auto& z : ProgressWrap(range(zMin, zMax), "Slice:")) {
-        // Get the slice
-        auto slice =
-            vc::QuantizeImage(volume->getSliceDataCopy(z), CV_8UC1, false);
-
-        auto processed = vc::Canny(slice, cannySettings);
-
-        // Keep all edges
-        if (cannySettings.projectionFrom == 'N') {
-            for (const auto pt : range2D(processed.rows, processed.cols)) {
-                const auto& x = pt.second;
-                const auto& y = pt.first;
-                if (processed.at<std::uint8_t>(y, x) > 0) {
-                    middle = {
-                        static_cast<double>(x), static_cast<double>(y),
-                        static_cast<double>(z)};
-                    mesh->SetPoint(mesh->GetNumberOfPoints(), middle.val);
-                }
-            }
-            continue;
-        }
-
-        // Build the set of rays that will be projected to find the edges
-        std::vector<cv::Vec2d> rayBases;
-        std::vector<cv::Vec2d> rayOrigins;
-
-        if (cannySettings.projectionFrom == 'L') {
-            for (auto y : range(processed.rows)) {
-                rayOrigins.push_back({0, static_cast<double>(y)});
-                rayBases.push_back({1, 0});
-            }
-        } else if (cannySettings.projectionFrom == 'R') {
-            for (auto y : range(processed.rows)) {
-                rayOrigins.push_back({static_cast<double>(processed.cols - 1), static_cast<double>(y)});
-                rayBases.push_back({-1, 0});
-            }
-        } else if (cannySettings.projectionFrom == 'T') {
-            for (auto x : range(processed.cols)) {
-                rayOrigins.push_back({static_cast<double>(x), 0});
-                rayBases.push_back({0, 1});
-            }
-        } else if (cannySettings.projectionFrom == 'B') {
-            for (auto x : range(processed.cols)) {
-                rayOrigins.push_back({static_cast<double>(x), static_cast<double>(processed.rows - 1)});
-                rayBases.push_back({0, -1});
-            }
-        } else if (cannySettings.projectionFrom == 'M' || cannySettings.projectionFrom == 'I') {
-            if (plane == nullptr || cutter == nullptr) {
-                std::cerr << "Error: Projection from mesh requested but mesh "
-                             "cutter not initialized\n";
-                return EXIT_FAILURE;
-            }
-            // update plane Z
-            plane->SetOrigin(0, 0, static_cast<double>(z));
-            cutter->Update();
-
-            // get cutter output
-            const vtkSmartPointer<vtkPolyData> cutterOutput =
-                cutter->GetOutput();
-
-            // vtk list of points
-            auto points = vtkSmartPointer<vtkPoints>::New();
-
-            // go through line segments
-            for (auto i = 0; i < cutterOutput->GetNumberOfCells(); ++i) {
-                // get cell
-                const vtkSmartPointer<vtkCell> cell = cutterOutput->GetCell(i);
-
-                // get points as cv::Vec3d
-                const cv::Vec3d p0{cell->GetPoints()->GetPoint(0)};
-                const cv::Vec3d p1{cell->GetPoints()->GetPoint(1)};
-
-                const auto length = cv::norm(p1 - p0);
-                const cv::Vec3d step = (p1 - p0) / length;
-
-                for (auto t = 0; t < static_cast<int>(length); ++t) {
-                    auto p = p0 + step * t;
-                    points->InsertNextPoint(p.val);
-                }
-            }
-
-            // if zero points, skip
-            if (points->GetNumberOfPoints() == 0) {
-                continue;
-            }
-
-            // create polydata
-            const auto pointsPolyData = vtkSmartPointer<vtkPolyData>::New();
-            pointsPolyData->SetPoints(points);
-
-            // use probe filter
-            const auto probeFilter = vtkSmartPointer<vtkProbeFilter>::New();
-            probeFilter->SetInputData(pointsPolyData);
-            probeFilter->SetSourceData(vtkMesh);
-            probeFilter->Update();
-
-            // get probe output
-            const vtkSmartPointer<vtkDataSet> probeOutput =
-                probeFilter->GetOutput();
-
-            // get normal vectors
-            const vtkSmartPointer<vtkDataArray> normals =
-                probeOutput->GetPointData()->GetNormals();
-
-            // check if normals exist
-            if (normals == nullptr) {
-                std::cerr << "Error: Input mesh has no normals\n";
-                return EXIT_FAILURE;
-            }
-
-            // go through points and normals
-            for (auto i = 0; i < probeOutput->GetNumberOfPoints(); ++i) {
-                // get point
-                cv::Vec3d p{probeOutput->GetPoint(i)};
-                // get normal
-                cv::Vec3d n{normals->GetTuple(i)};
-                // check if normal is all zeros
-                if (n[0] == 0 && n[1] == 0 && n[2] == 0) {
-                    continue;
-                }
-                // project normal to xy plane
-                n[2] = 0;
-                // normalize
-                n = n / cv::norm(n);
-                // invert normal if needed
-                if (cannySettings.projectionFrom == 'I') {
-                    n = -n;
-                }
-                // add point to ray origins after converting to 2d
-                rayOrigins.push_back({p[0], p[1]});
-                // add normal to ray bases after converting to 2d
-                rayBases.push_back({n[0], n[1]});
-            }
-        }
-
-        for (auto r : range(rayBases.size())) {
-            const auto& rayBasis = rayBases[r];
-            const auto& rayOrigin = rayOrigins[r];
-
-            // Get the first
-            auto haveFirst = false;
-
-            auto pt = rayOrigin;
-            int xI = static_cast<int>(pt[0]);
-            int yI = static_cast<int>(pt[1]);
-            while (
-                xI >= 0
-                && xI < processed.cols
-                && yI >= 0
-                && yI < processed.rows
-            ) {
-                // if point is on detected edge
-                if (!haveFirst && processed.at<std::uint8_t>(yI, xI) != 0) {
-                    // set first
-                    first = {pt[0], pt[1], static_cast<double>(z)};
-                    last = first;
-                    haveFirst = true;
-                    continue;
-                }
-
-                if (cannySettings.midpoint && haveFirst &&
-                    processed.at<std::uint8_t>(yI, xI) != 0) {
-                    last = {pt[0], pt[1], static_cast<double>(z)};
-                }
-
-                if (!cannySettings.midpoint && haveFirst) {
-                    break;
-                }
-
-                // move point along ray
-                pt += rayBasis * 0.5;
-                xI = static_cast<int>(pt[0]);
-                yI = static_cast<int>(pt[1]);
-            }
-
-            if (!haveFirst) {
-                continue;
-            }
-
-            middle = (first + last) / 2;
-            mesh->SetPoint(mesh->GetNumberOfPoints(), middle.val);
+    auto numSlices = static_cast<std::size_t>(std::max(zMax - zMin, 0));
+
+    // Slices are segmented in parallel batches. Each batch is written in
+    // slice order as soon as it completes so that only one batch of points is
+    // held in memory.
+    vc::ThreadPool pool;
+    const auto batchSize = 4 * (pool.size() + 1);
+    std::vector<std::vector<cv::Vec3d>> batch(batchSize);
+    PointStreamWriter writer(outputPath);
+    auto progress = vc::NewProgressBar(numSlices, "Slice:");
+    for (std::size_t b = 0; b < numSlices; b += batchSize) {
+        auto count = std::min(batchSize, numSlices - b);
+        pool.parallelFor(0, count, [&](std::size_t i) {
+            auto z = zMin + static_cast<int>(b + i);
+            batch[i] = SegmentSlice(*volume, slicer.get(), cannySettings, z);
+        });
+        for (std::size_t i = 0; i < count; i++) {
+            writer.write(batch[i]);
+            batch[i].clear();
         }
+        progress->set_option(indicators::option::PostfixText{
+            std::to_string(b + count) + "/" + std::to_string(numSlices)});
+        progress->set_progress(b + count);
     }
 
     // Write mesh
     std::cout << "Writing mesh..." << std::endl;
-    vc::io::PLYWriter writer;
-    writer.setMesh(mesh);
-    writer.setPath(outputPath);
-    writer.write();
+    writer.finish();
 }
 
 #pragma clang diagnostic pop
@@ -2,21 +2,18 @@
 #pragma clang diagnostic ignored "-Wunknown-pragmas"
 #pragma ide diagnostic ignored "cppcoreguidelines-avoid-magic-numbers"
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
 
 #include <QApplication>
 #include <boost/program_options.hpp>
 #include <opencv2/core.hpp>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
-#include <vtkAppendPolyData.h>
-#include <vtkCleanPolyData.h>
-#include <vtkCutter.h>
-#include <vtkPlane.h>
-#include <vtkSmartPointer.h>
-#include <vtkStripper.h>
 
 #include "ProjectionViewerWindow.hpp"
 #include "vc/app_support/ProgressIndicator.hpp"
@@ -26,13 +23,16 @@
 #include "vc/core/types/VolumePkg.hpp"
 #include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/Logging.hpp"
-#include "vc/meshing/ITK2VTK.hpp"
+#include "vc/meshing/MeshSlicer.hpp"
 
 namespace po = boost::program_options;
 namespace fs = volcart::filesystem;
 namespace vc = volcart;
 namespace vcm = volcart::meshing;
 
+// Number of slices intersected with the mesh at once
+constexpr int BATCH_SIZE{64};
+
 auto main(int argc, char* argv[]) -> int
 {
     ///// Parse the command line options /////
@@ -147,43 +147,17 @@ auto main(int argc, char* argv[]) -> int
     auto height = volume->sliceHeight();
     auto padding = static_cast<int>(std::to_string(volume->numSlices()).size());
 
-    // Get meshes
+    // Get meshes and index their triangles for slicing
     std::cout << "Loading meshes..." << std::endl;
-    std::vector<vtkSmartPointer<vtkPolyData>> meshes;
+    auto slicer = std::make_shared<vcm::MeshSlicer>();
     for (const auto& meshPath : meshPaths) {
         auto meshFile = vc::ReadMesh(meshPath);
-        auto vtkMesh = vcm::ITK2VTK(meshFile.mesh);
-        meshes.push_back(vtkMesh);
-    }
-
-    // Combine meshes if we have multiple
-    vtkSmartPointer<vtkPolyData> vtkMesh;
-    if (meshes.size() > 1) {
-        // Append all of the meshes into a single polydata
-        auto append = vtkSmartPointer<vtkAppendPolyData>::New();
-        for (auto& mesh : meshes) {
-            append->AddInputData(mesh);
-        }
-        append->Update();
-
-        // Clean it up
-        auto cleaner = vtkSmartPointer<vtkCleanPolyData>::New();
-        cleaner->SetInputConnection(append->GetOutputPort());
-        cleaner->Update();
-
-        vtkMesh = cleaner->GetOutput();
-    } else {
-        vtkMesh = meshes[0];
+        slicer->addMesh(meshFile.mesh);
     }
 
-    // Setup intersection plane
-    vtkSmartPointer<vtkPlane> cutPlane = vtkSmartPointer<vtkPlane>::New();
-    cutPlane->SetOrigin(width / 2.0, height / 2.0, 0);
-    cutPlane->SetNormal(0, 0, 1);
-    projectionSettings.zMin =
-        static_cast<int>(std::floor(vtkMesh->GetBounds()[4]));
-    projectionSettings.zMax =
-        static_cast<int>(std::ceil(vtkMesh->GetBounds()[5]));
+    // Get the z-range of the meshes
+    projectionSettings.zMin = static_cast<int>(std::floor(slicer->zMin()));
+    projectionSettings.zMax = static_cast<int>(std::ceil(slicer->zMax()));
 
     // Bounds checks
     if (projectionSettings.zMin < 0) {
@@ -196,36 +170,32 @@ auto main(int argc, char* argv[]) -> int
         projectionSettings.zMax += 1;
     }
 
-    // Setup cutting and stripping pipeline
-    auto cutter = vtkSmartPointer<vtkCutter>::New();
-    cutter->SetCutFunction(cutPlane);
-    cutter->SetInputData(vtkMesh);
-
-    auto stripper = vtkSmartPointer<vtkStripper>::New();
-    stripper->SetInputConnection(cutter->GetOutputPort());
-
     if (parsed.count("visualize") > 0) {
         QApplication app(argc, argv);
         QGuiApplication::setApplicationDisplayName(
             ProjectionViewerWindow::tr("Projection Viewer"));
-        ProjectionViewerWindow viewer(
-            &projectionSettings, cutPlane, stripper, volume);
+        ProjectionViewerWindow viewer(&projectionSettings, slicer, volume);
         viewer.show();
         QApplication::exec();
     }
 
     // Iterate over every z-index in the range between zMin and zMax
-    // Cut the mesh and draw its corresponding intersection onto a new output
-    // image
+    // Intersect the mesh with batches of slices in parallel, then draw each
+    // intersection onto a new output image
     cv::Mat outputImg;
-    std::vector<cv::Point> contour;
+    std::vector<vcm::MeshSlicer::Slice> batch;
+    int batchStart{0};
     for (const auto& zIdx : vc::ProgressWrap(
              vc::range(projectionSettings.zMin, projectionSettings.zMax),
              "vc::projection::Projecting:")) {
-        // Cut the mesh and get the intersection
-        cutPlane->SetOrigin(width / 2.0, height / 2.0, zIdx);
-        stripper->Update();
-        auto* intersection = stripper->GetOutput();
+        // Get the intersection
+        if (batch.empty() or zIdx - batchStart >= BATCH_SIZE) {
+            batchStart = zIdx;
+            auto batchEnd =
+                std::min(zIdx + BATCH_SIZE, projectionSettings.zMax);
+            batch = slicer->slices(batchStart, batchEnd);
+        }
+        const auto& intersection = batch[zIdx - batchStart];
 
         // Setup the output image
         if (projectionSettings.intersectOnly) {
@@ -237,21 +207,7 @@ auto main(int argc, char* argv[]) -> int
         }
 
         // Draw the intersections
-        for (auto cId = 0; cId < intersection->GetNumberOfCells(); ++cId) {
-            auto* inputCell = intersection->GetCell(cId);
-
-            contour.clear();
-            for (auto pIt = 0; pIt < inputCell->GetNumberOfPoints(); ++pIt) {
-                auto pId = inputCell->GetPointId(pIt);
-                contour.emplace_back(cv::Point(
-                    static_cast<int>(intersection->GetPoint(pId)[0]),
-                    static_cast<int>(intersection->GetPoint(pId)[1])));
-            }
-
-            cv::polylines(
-                outputImg, contour, false, projectionSettings.color,
-                projectionSettings.thickness, cv::LINE_AA);
-        }
+        vc::DrawIntersection(outputImg, intersection, projectionSettings);
 
         // Save the output to the provided directory
         std::stringstream filename;
@@ -3,10 +3,13 @@
 #pragma clang diagnostic ignored "-Wunknown-pragmas"
 #pragma ide diagnostic ignored "cert-err58-cpp"
 #include <cstdint>
+#include <vector>
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
 
+#include "vc/meshing/MeshSlicer.hpp"
+
 static const double MAX_8BPC = std::numeric_limits<std::uint8_t>::max();
 static const double MAX_16BPC = std::numeric_limits<std::uint16_t>::max();
 
@@ -30,5 +33,24 @@ struct ProjectionSettings {
     std::string ppmImageOverlay;
 };
 
+/** Draw the mesh intersection polylines onto an image */
+inline void DrawIntersection(
+    cv::Mat& img,
+    const volcart::meshing::MeshSlicer::Slice& slice,
+    const ProjectionSettings& settings)
+{
+    std::vector<cv::Point> contour;
+    for (const auto& line : slice) {
+        contour.clear();
+        for (const auto& p : line.points) {
+            contour.emplace_back(
+                static_cast<int>(p[0]), static_cast<int>(p[1]));
+        }
+        cv::polylines(
+            img, contour, false, settings.color, settings.thickness,
+            cv::LINE_AA);
+    }
+}
+
 }  // namespace volcart
 #pragma clang diagnostic pop
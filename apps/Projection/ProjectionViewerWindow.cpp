@@ -9,15 +9,14 @@
 
 ProjectionViewerWindow::ProjectionViewerWindow(
     volcart::ProjectionSettings* settings,
-    const vtkSmartPointer<vtkPlane>& cutPlane,
-    const vtkSmartPointer<vtkStripper>& stripper,
+    const std::shared_ptr<const volcart::meshing::MeshSlicer>& slicer,
     volcart::Volume::Pointer& volume,
     QWidget* parent)
     : QMainWindow(parent)
     , mainSplitter_(new QSplitter)
     , sidePanelSplitter_(new QSplitter(Qt::Vertical))
     , sliceProjectionViewerWidget_(
-          new SliceProjectionViewerWidget(volume, cutPlane, stripper))
+          new SliceProjectionViewerWidget(volume, slicer))
     , projectionSettingsWidget_(new ProjectionSettingsWidget(settings))
     , ppmProjectionViewerWidget_(new PPMProjectionViewerWidget(
           settings->visualizePPMIntersection, settings->ppmImageOverlay))
@@ -1,12 +1,9 @@
 #include "SliceProjectionThread.hpp"
 
 SliceProjectionThread::SliceProjectionThread(
-    vtkSmartPointer<vtkPlane> cutPlane,
-    vtkSmartPointer<vtkStripper> stripper,
+    std::shared_ptr<const volcart::meshing::MeshSlicer> slicer,
     QObject* parent)
-    : QThread(parent)
-    , cutPlane_(std::move(cutPlane))
-    , stripper_(std::move(stripper))
+    : QThread(parent), slicer_(std::move(slicer))
 {
 }
 
@@ -47,16 +44,14 @@ void SliceProjectionThread::run()
         mutex_.lock();
         cv::Mat src = mat_;
         volcart::ProjectionSettings settings = settings_;
-        // Cut the mesh and get the intersection
-        cutPlane_->SetOrigin(
-            src.size().width / 2.0, src.size().height / 2.0, sliceIdx_);
-        stripper_->Update();
-        auto* intersection = stripper_->GetOutput();
+        int sliceIdx = sliceIdx_;
         mutex_.unlock();
 
+        // Get the intersection
+        auto intersection = slicer_->slice(sliceIdx);
+
         if (!restart_) {
             cv::Mat outputImg;
-            std::vector<cv::Point> contour;
 
             // Setup the output image
             if (settings.intersectOnly) {
@@ -67,21 +62,7 @@ void SliceProjectionThread::run()
             }
 
             // Draw the intersections
-            for (auto cId = 0; cId < intersection->GetNumberOfCells(); ++cId) {
-                auto* inputCell = intersection->GetCell(cId);
-
-                contour.clear();
-                for (auto pIt = 0; pIt < inputCell->GetNumberOfPoints();
-                     ++pIt) {
-                    auto pId = inputCell->GetPointId(pIt);
-                    contour.emplace_back(cv::Point(
-                        static_cast<int>(intersection->GetPoint(pId)[0]),
-                        static_cast<int>(intersection->GetPoint(pId)[1])));
-                }
-                cv::polylines(
-                    outputImg, contour, false, settings.color,
-                    settings.thickness, cv::LINE_AA);
-            }
+            volcart::DrawIntersection(outputImg, intersection, settings);
             emit ranProjection(outputImg);
         }
 
@@ -2,13 +2,13 @@
 
 #include <QMutex>
 #include <QThread>
+#include <memory>
+
 #include <QWaitCondition>
 #include <opencv2/core.hpp>
-#include <vtkPlane.h>
-#include <vtkSmartPointer.h>
-#include <vtkStripper.h>
 
 #include "Projection.hpp"
+#include "vc/meshing/MeshSlicer.hpp"
 
 class SliceProjectionThread : public QThread
 {
@@ -18,8 +18,7 @@ class SliceProjectionThread : public QThread
 
 public:
     explicit SliceProjectionThread(
-        vtkSmartPointer<vtkPlane> cutPlane,
-        vtkSmartPointer<vtkStripper> stripper,
+        std::shared_ptr<const volcart::meshing::MeshSlicer> slicer,
         QObject* parent = nullptr);
     ~SliceProjectionThread() override;
 
@@ -41,6 +40,5 @@ private:
     cv::Mat mat_;
     volcart::ProjectionSettings settings_;
     int sliceIdx_;
-    vtkSmartPointer<vtkPlane> cutPlane_;
-    vtkSmartPointer<vtkStripper> stripper_;
+    std::shared_ptr<const volcart::meshing::MeshSlicer> slicer_;
 };
@@ -7,10 +7,8 @@
 
 SliceProjectionViewerWidget::SliceProjectionViewerWidget(
     volcart::Volume::Pointer& volume,
-    vtkSmartPointer<vtkPlane> cutPlane,
-    vtkSmartPointer<vtkStripper> stripper)
-    : fetchSliceThread_(volume)
-    , projectionThread_(std::move(cutPlane), std::move(stripper))
+    std::shared_ptr<const volcart::meshing::MeshSlicer> slicer)
+    : fetchSliceThread_(volume), projectionThread_(std::move(slicer))
 {
     qRegisterMetaType<cv::Mat>("cv::Mat");
     connect(
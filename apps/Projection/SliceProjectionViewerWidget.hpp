@@ -1,11 +1,11 @@
 #pragma once
 
+#include <memory>
+
 #include <QLabel>
 #include <QScrollArea>
 #include <QWidget>
 #include <opencv2/core.hpp>
-#include <vtkPlane.h>
-#include <vtkStripper.h>
 
 #include "SliceProjectionThread.hpp"
 #include "vc/core/types/Volume.hpp"
@@ -21,8 +21,7 @@ class SliceProjectionViewerWidget : public volcart::gui::ImageScrollArea
 public:
     SliceProjectionViewerWidget(
         volcart::Volume::Pointer& volume,
-        vtkSmartPointer<vtkPlane> cutPlane,
-        vtkSmartPointer<vtkStripper> stripper);
+        std::shared_ptr<const volcart::meshing::MeshSlicer> slicer);
 
 signals:
     void sliceLoaded();
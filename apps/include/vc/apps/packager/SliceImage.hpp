@@ -18,14 +18,17 @@ public:
     bool operator!=(const SliceImage& b) const { return !operator==(b); }
     bool operator<(const SliceImage& b) const;
 
+    cv::Mat read() const;
     bool analyze();
+    bool analyze(const cv::Mat& image);
     cv::Mat conformedImage();
-    int width() { return w_; }
-    int height() { return h_; }
-    double min() { return min_; }
-    double max() { return max_; }
-    bool needsConvert() { return needsConvert_; }
-    bool needsScale() { return needsScale_; }
+    cv::Mat conformedImage(cv::Mat image) const;
+    int width() const { return w_; }
+    int height() const { return h_; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+    bool needsConvert() const { return needsConvert_; }
+    bool needsScale() const { return needsScale_; }
     void setScale(double max, double min)
     {
         max_ = max;
@@ -1,4 +1,5 @@
 #include <cstddef>
+#include <optional>
 #include <sstream>
 
 #include <boost/program_options.hpp>
@@ -9,6 +10,7 @@
 #include "vc/app_support/ProgressIndicator.hpp"
 #include "vc/core/filesystem.hpp"
 #include "vc/core/io/ImageIO.hpp"
+#include "vc/core/io/TIFFIO.hpp"
 #include "vc/core/neighborhood/LineGenerator.hpp"
 #include "vc/core/types/PerPixelMap.hpp"
 #include "vc/core/types/Transforms.hpp"
@@ -29,6 +31,26 @@ static constexpr int VOLPKG_MIN_VERSION = 6;
 
 namespace
 {
+// Parse a --tiff-compression value
+auto ParseTIFFCompression(std::string s)
+    -> std::optional<tiffio::Compression>
+{
+    to_lower(s);
+    if (s == "none") {
+        return tiffio::Compression::NONE;
+    }
+    if (s == "lzw") {
+        return tiffio::Compression::LZW;
+    }
+    if (s == "deflate") {
+        return tiffio::Compression::ADOBE_DEFLATE;
+    }
+    if (s == "packbits") {
+        return tiffio::Compression::PACKBITS;
+    }
+    return std::nullopt;
+}
+
 auto GetTransformOpts() -> po::options_description
 {
     // clang-format off
@@ -62,7 +84,18 @@ auto main(int argc, char* argv[]) -> int
             "that maps to the layer volume.")
         ("image-format,f", po::value<std::string>()->default_value("png"),
             "Image format for layer images. Default: png")
-        ("compression", po::value<int>(), "Image compression level");
+        ("compression", po::value<int>(), "Image compression level")
+        ("tiled", "Write the layers as tiled TIFF images while they are "
+            "generated instead of after all layers have been generated. "
+            "Only one row of tiles per layer is held in memory. Ignores "
+            "--image-format and --compression.")
+        ("tiff-compression", po::value<std::string>()->default_value("lzw"),
+            "Compression scheme for --tiled: none, lzw, deflate, or "
+            "packbits. Default: lzw")
+        ("tile-size", po::value<int>()->default_value(256),
+            "Tile width and height for --tiled. Must be a multiple of 16.")
+        ("multipage", "With --tiled, merge the layers into a single "
+            "multi-page TIFF, layers.tif, in the output directory.");
 
     po::options_description filterOptions("Generic Filtering Options");
     filterOptions.add_options()
@@ -133,6 +166,22 @@ auto main(int argc, char* argv[]) -> int
             return EXIT_FAILURE;
         }
     }
+    const auto tiled = parsed.count("tiled") > 0;
+    const auto multipage = parsed.count("multipage") > 0;
+    if (multipage and not tiled) {
+        Logger()->error("--multipage requires --tiled");
+        return EXIT_FAILURE;
+    }
+    const auto tiffCompressionStr =
+        parsed["tiff-compression"].as<std::string>();
+    const auto tiffCompression = ParseTIFFCompression(tiffCompressionStr);
+    if (not tiffCompression) {
+        Logger()->error(
+            "Invalid --tiff-compression: {}. Options: none, lzw, deflate, "
+            "packbits",
+            tiffCompressionStr);
+        return EXIT_FAILURE;
+    }
     auto imgFmt = to_lower_copy(parsed["image-format"].as<std::string>());
     WriteImageOpts writeOpts;
     if (parsed.count("compression") > 0) {
@@ -178,6 +227,7 @@ auto main(int argc, char* argv[]) -> int
         cacheBytes = MemorySizeStringParser(cacheSizeOpt);
     }
     volume->setCacheMemoryInBytes(cacheBytes);
+    volume->setPrefetchDepth(parsed["prefetch-slices"].as<std::size_t>());
     Logger()->info(
         "Volume Cache :: Capacity: {} || Size: {}", volume->getCacheCapacity(),
         BytesToMemorySizeString(cacheBytes));
@@ -249,17 +299,36 @@ auto main(int argc, char* argv[]) -> int
         Logger()->info("Generating layers...");
     }
 
-    auto texture = layerGen.compute();
-
-    // Write the image sequence
-    const fs::path filepath = outDir / ("{}." + imgFmt);
-    if (enableProgress) {
-        Logger()->debug("Writing layers...");
-        auto progIt = ProgressWrap(texture, "Writing layers:", cfg);
-        WriteImageSequence(filepath, progIt, writeOpts);
+    std::size_t numLayers{0};
+    if (tiled) {
+        // Generate and write the layers one row of tiles at a time
+        auto tileDim = parsed["tile-size"].as<int>();
+        auto paths = layerGen.computeToTIFF(
+            outDir / "{}.tif", *tiffCompression, {tileDim, tileDim});
+        numLayers = paths.size();
+
+        // Merge the layers into a single file
+        if (multipage) {
+            Logger()->info("Merging layers...");
+            tiffio::MergeTiledTIFFs(paths, outDir / "layers.tif");
+            for (const auto& path : paths) {
+                fs::remove(path);
+            }
+        }
     } else {
-        Logger()->info("Writing layers...");
-        WriteImageSequence(filepath, texture, writeOpts);
+        auto texture = layerGen.compute();
+        numLayers = texture.size();
+
+        // Write the image sequence
+        const fs::path filepath = outDir / ("{}." + imgFmt);
+        if (enableProgress) {
+            Logger()->debug("Writing layers...");
+            auto progIt = ProgressWrap(texture, "Writing layers:", cfg);
+            WriteImageSequence(filepath, progIt, writeOpts);
+        } else {
+            Logger()->info("Writing layers...");
+            WriteImageSequence(filepath, texture, writeOpts);
+        }
     }
 
     if (parsed.count("output-ppm") > 0) {
@@ -274,7 +343,7 @@ auto main(int argc, char* argv[]) -> int
         newPPM.setCellMap(ppm->cellMap());
 
         // Fill new PPM
-        auto z = static_cast<double>(texture.size() - 1) / 2.0;
+        auto z = static_cast<double>(numLayers - 1) / 2.0;
         auto normal = (parsed.count("negative-normal") > 0) ? -1.0 : 1.0;
         for (auto [y, x] : range2D(height, width)) {
             if (!newPPM.hasMapping(y, x)) {
@@ -1,8 +1,13 @@
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <regex>
+#include <thread>
+#include <vector>
 
 #include <boost/program_options.hpp>
 
@@ -14,9 +19,9 @@
 #include "vc/core/types/Metadata.hpp"
 #include "vc/core/types/VolumePkg.hpp"
 #include "vc/core/util/FormatStrToRegexStr.hpp"
-#include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/String.hpp"
+#include "vc/core/util/ThreadPool.hpp"
 
 namespace fs = volcart::filesystem;
 namespace po = boost::program_options;
@@ -34,6 +39,12 @@ static const double MAX_16BPC = std::numeric_limits<std::uint16_t>::max();
 // Volpkg version required by this app
 static constexpr int VOLPKG_MIN_VERSION = 6;
 
+// Number of bins in the 16-bit intensity histogram
+static constexpr std::size_t HISTOGRAM_BINS = 65536;
+
+// Histogram file written to the volume directory
+static const fs::path HISTOGRAM_FILE{"histogram.json"};
+
 struct VolumeInfo {
     fs::path path;
     std::string name;
@@ -42,12 +53,36 @@ struct VolumeInfo {
     Flip flipOption{Flip::None};
     vc::Metadata meta;
     bool compress{false};
+    int pyramidLevels{0};
+    std::size_t numThreads{vc::ThreadPool::DefaultThreadCount()};
+};
+
+// Statistics gathered while ingesting slices
+struct IngestStats {
+    double min{std::numeric_limits<double>::max()};
+    double max{std::numeric_limits<double>::lowest()};
+    std::vector<std::uint64_t> histogram;
+    std::vector<fs::path> mismatches;
 };
 
 static bool DoAnalyze{true};
 
 auto GetVolumeInfo(const po::variables_map& parsed) -> VolumeInfo;
 void AddVolume(vc::VolumePkg::Pointer& volpkg, const VolumeInfo& info);
+auto AnalyzeSlices(std::vector<vc::SliceImage>& slices, vc::ThreadPool& pool)
+    -> IngestStats;
+auto WriteSlices(
+    std::vector<vc::SliceImage>& slices,
+    const vc::Volume::Pointer& volume,
+    const VolumeInfo& info,
+    double volMin,
+    double volMax,
+    bool analyze,
+    vc::ThreadPool& pool) -> IngestStats;
+auto ReportMismatches(IngestStats& stats) -> bool;
+void FlipImage(cv::Mat& image, Flip flip);
+void AccumulateHistogram(
+    const cv::Mat& image, std::vector<std::uint64_t>& hist);
 
 auto main(int argc, char* argv[]) -> int
 {
@@ -82,7 +117,12 @@ auto main(int argc, char* argv[]) -> int
         ("flip,f", po::value<std::string>()->default_value("none"),
             "Flip options: Vertical flip (vf), horizontal flip (hf), both, "
             "z-flip (zf), all, [none].")
-        ("compress,c", "Compress slice images");
+        ("compress,c", "Compress slice images")
+        ("pyramid-levels", po::value<int>()->default_value(0),
+            "Number of downsampled resolution levels to generate. Each level "
+            "halves the resolution of the previous level along every axis.")
+        ("num-threads", po::value<std::size_t>(), "Number of threads used to "
+            "read, convert, and write slices. Default: Number of CPU cores");
     
     po::options_description helpOpts("Usage");
     helpOpts.add(options).add(volpkg_metadata).add(volume_options);
@@ -257,6 +297,14 @@ auto GetVolumeInfo(const po::variables_map& parsed) -> VolumeInfo
     // Whether to compress
     info.compress = parsed.count("compress") != 0;
 
+    // Number of ingest threads
+    if (parsed.count("num-threads") > 0) {
+        info.numThreads = parsed["num-threads"].as<std::size_t>();
+    }
+
+    // Resolution levels
+    info.pyramidLevels = std::max(parsed["pyramid-levels"].as<int>(), 0);
+
     return info;
 }
 
@@ -313,70 +361,57 @@ void AddVolume(vc::VolumePkg::Pointer& volpkg, const VolumeInfo& info)
     // Report the number of slices
     std::cout << "Slice images found: " << slices.size() << std::endl;
 
-    ///// Analyze the slices /////
-    auto consistent = true;
-    auto volMin = std::numeric_limits<double>::max();
-    auto volMax = std::numeric_limits<double>::lowest();
-    std::vector<fs::path> mismatches;
-    if (DoAnalyze) {
-        for (auto& slice : vc::ProgressWrap(slices, "Analyzing slices")) {
-            // Skip if we can't analyze
-            if (!slice.analyze()) {
-                continue;
-            }
-
-            // Compare all slices to the properties of the first slice
-            // Don't quit yet so we can get a list of the problematic files
-            if (slice != *slices.begin()) {
-                consistent = false;
-                mismatches.push_back(slice.path.filename());
-                continue;
-            }
-
-            // Update the volume's min and max
-            if (slice.min() < volMin) {
-                volMin = slice.min();
-            }
-
-            if (slice.max() > volMax) {
-                volMax = slice.max();
-            }
-        }
-    } else {
-        // Make sure the first slice is analyzed
-        slices.front().analyze();
-        volMin = MIN_16BPC;
-        volMax = MAX_16BPC;
+    // Flip the slice order
+    if (info.flipOption == Flip::ZFlip or info.flipOption == Flip::All) {
+        std::reverse(slices.begin(), slices.end());
     }
 
-    // Report mismatched slices
-    if (not mismatches.empty()) {
-        std::cerr << "Found " << mismatches.size();
-        std::cerr << " files which did not match the initial slice:";
-        std::cerr << std::endl;
-        for (const auto& p : mismatches) {
-            std::cerr << "\t" << p << std::endl;
-        }
+    // The first slice determines the expected slice properties
+    auto& first = slices.front();
+    if (!first.analyze()) {
+        std::cerr << "ERROR: Could not read slice: " << first.path << std::endl;
+        return;
     }
 
-    // Quit if the volume isn't consistent
-    if (!consistent) {
-        std::cerr << "ERROR: Slices in slice directory do not have matching "
-                     "properties (width/height/depth)."
-                  << std::endl;
-        return;
+    // Rescaling needs the volume min/max before any slice can be written, so
+    // it requires a separate analysis pass. Otherwise, slices are analyzed
+    // while they are written.
+    vc::ThreadPool pool(info.numThreads);
+    auto volMin = MIN_16BPC;
+    auto volMax = MAX_16BPC;
+    if (DoAnalyze and first.needsScale()) {
+        auto stats = AnalyzeSlices(slices, pool);
+        if (!ReportMismatches(stats)) {
+            return;
+        }
+        volMin = stats.min;
+        volMax = stats.max;
     }
 
     ///// Add data to the volume /////
     // Metadata
     auto volume = volpkg->newVolume(info.name);
     volume->setNumberOfSlices(slices.size());
-    volume->setSliceWidth(slices.front().width());
-    volume->setSliceHeight(slices.front().height());
+    volume->setSliceWidth(first.width());
+    volume->setSliceHeight(first.height());
     volume->setVoxelSize(info.voxelsize);
+    volume->saveMetadata();
+
+    // Convert, analyze, and write the slices
+    const auto analyzeWhileWriting = DoAnalyze and not first.needsScale();
+    auto written = WriteSlices(
+        slices, volume, info, volMin, volMax, analyzeWhileWriting, pool);
+    if (!ReportMismatches(written)) {
+        volpkg->removeVolume(volume->id());
+        return;
+    }
+    if (analyzeWhileWriting) {
+        volMin = written.min;
+        volMax = written.max;
+    }
 
     // Scale min/max values
-    if (slices.begin()->needsScale()) {
+    if (first.needsScale()) {
         volume->setMin(MIN_16BPC);
         volume->setMax(MAX_16BPC);
     } else {
@@ -385,22 +420,138 @@ void AddVolume(vc::VolumePkg::Pointer& volpkg, const VolumeInfo& info)
     }
     volume->saveMetadata();
 
-    if (info.flipOption == Flip::ZFlip or info.flipOption == Flip::All) {
-        std::reverse(slices.begin(), slices.end());
+    // Save the intensity histogram of the packaged slices
+    if (DoAnalyze) {
+        vc::Metadata histogram;
+        histogram.set("bins", written.histogram);
+        histogram.save(volume->path() / HISTOGRAM_FILE);
+    }
+
+    // Build the resolution pyramid
+    if (info.pyramidLevels > 0) {
+        std::cout << "Generating " << info.pyramidLevels;
+        std::cout << " resolution levels..." << std::endl;
+        volume->generateLevels(info.pyramidLevels, info.compress);
+    }
+}
+
+void FlipImage(cv::Mat& image, Flip flip)
+{
+    switch (flip) {
+        case Flip::All:
+        case Flip::Both:
+            cv::flip(image, image, -1);
+            break;
+        case Flip::Vertical:
+            cv::flip(image, image, 0);
+            break;
+        case Flip::Horizontal:
+            cv::flip(image, image, 1);
+            break;
+        case Flip::ZFlip:
+        case Flip::None:
+            // Do nothing
+            break;
     }
+}
+
+void AccumulateHistogram(
+    const cv::Mat& image, std::vector<std::uint64_t>& hist)
+{
+    for (int y = 0; y < image.rows; y++) {
+        const auto* row = image.ptr<std::uint16_t>(y);
+        for (int x = 0; x < image.cols; x++) {
+            hist[row[x]]++;
+        }
+    }
+}
 
+auto AnalyzeSlices(std::vector<vc::SliceImage>& slices, vc::ThreadPool& pool)
+    -> IngestStats
+{
+    IngestStats stats;
+    std::mutex statsMutex;
+    const auto& first = slices.front();
+    auto bar = vc::NewProgressBar(slices.size(), "Analyzing slices");
+    pool.parallelFor(0, slices.size(), [&](std::size_t idx) {
+        auto& slice = slices[idx];
+
+        // Compare all slices to the properties of the first slice
+        // Don't quit yet so we can get a list of the problematic files
+        auto ok = (idx == 0) or (slice.analyze() and slice == first);
+
+        const std::lock_guard<std::mutex> lock(statsMutex);
+        if (ok) {
+            stats.min = std::min(stats.min, slice.min());
+            stats.max = std::max(stats.max, slice.max());
+        } else {
+            stats.mismatches.push_back(slice.path.filename());
+        }
+        bar->tick();
+    });
+
+    return stats;
+}
+
+auto WriteSlices(
+    std::vector<vc::SliceImage>& slices,
+    const vc::Volume::Pointer& volume,
+    const VolumeInfo& info,
+    double volMin,
+    double volMax,
+    bool analyze,
+    vc::ThreadPool& pool) -> IngestStats
+{
     // Do we need to flip?
     auto needsFlip = info.flipOption == Flip::Horizontal ||
                      info.flipOption == Flip::Vertical ||
                      info.flipOption == Flip::Both ||
                      info.flipOption == Flip::All;
 
-    // Move the slices into the VolPkg
-    using vc::enumerate;
-    using vc::ProgressWrap;
-    for (auto pair : ProgressWrap(enumerate(slices), "Saving to volpkg")) {
-        const auto& idx = pair.first;
-        auto& slice = pair.second;
+    // Without analysis, slices are assumed to match the first slice
+    const auto& first = slices.front();
+    auto mustDecode = analyze || DoAnalyze || first.needsConvert() ||
+                      first.needsScale() || needsFlip || info.compress;
+
+    IngestStats stats;
+    std::mutex statsMutex;
+
+    // Each thread accumulates its own histogram, merged after writing
+    std::map<std::thread::id, std::vector<std::uint64_t>> threadHists;
+    auto threadHist = [&]() -> std::vector<std::uint64_t>& {
+        const std::lock_guard<std::mutex> lock(statsMutex);
+        auto& hist = threadHists[std::this_thread::get_id()];
+        if (hist.empty()) {
+            hist.assign(HISTOGRAM_BINS, 0);
+        }
+        return hist;
+    };
+    auto bar = vc::NewProgressBar(slices.size(), "Saving to volpkg");
+    pool.parallelFor(0, slices.size(), [&](std::size_t idx) {
+        auto& slice = slices[idx];
+
+        // Just copy to the volume
+        if (not mustDecode) {
+            fs::copy_file(slice.path, volume->getSlicePath(idx));
+            bar->tick();
+            return;
+        }
+
+        // Read and analyze
+        auto image = slice.read();
+        // The first slice was analyzed before writing started
+        if ((analyze or not DoAnalyze) and idx > 0) {
+            auto ok = slice.analyze(image) and (not analyze or slice == first);
+            if (not ok) {
+                const std::lock_guard<std::mutex> lock(statsMutex);
+                stats.mismatches.push_back(slice.path.filename());
+                bar->tick();
+                return;
+            }
+        }
+        auto sliceMin = slice.min();
+        auto sliceMax = slice.max();
+
         // Convert or flip
         if (slice.needsConvert() || slice.needsScale() || needsFlip ||
             info.compress) {
@@ -408,35 +559,60 @@ void AddVolume(vc::VolumePkg::Pointer& volpkg, const VolumeInfo& info)
             if (slice.needsScale()) {
                 slice.setScale(volMax, volMin);
             }
-
-            // Get slice
-            auto tmp = slice.conformedImage();
-
-            // Apply flips
-            switch (info.flipOption) {
-                case Flip::All:
-                case Flip::Both:
-                    cv::flip(tmp, tmp, -1);
-                    break;
-                case Flip::Vertical:
-                    cv::flip(tmp, tmp, 0);
-                    break;
-                case Flip::Horizontal:
-                    cv::flip(tmp, tmp, 1);
-                    break;
-                case Flip::ZFlip:
-                case Flip::None:
-                    // Do nothing
-                    break;
-            }
-
-            // Add to volume
-            volume->setSliceData(idx, tmp, info.compress);
+            image = slice.conformedImage(image);
+            FlipImage(image, info.flipOption);
+            volume->setSliceData(idx, image, info.compress);
         }
 
         // Just copy to the volume
         else {
             fs::copy_file(slice.path, volume->getSlicePath(idx));
         }
+
+        // Update the statistics
+        if (DoAnalyze) {
+            AccumulateHistogram(image, threadHist());
+        }
+        const std::lock_guard<std::mutex> lock(statsMutex);
+        if (analyze) {
+            stats.min = std::min(stats.min, sliceMin);
+            stats.max = std::max(stats.max, sliceMax);
+        }
+        bar->tick();
+    });
+
+    // Merge the per-thread histograms
+    if (DoAnalyze) {
+        stats.histogram.assign(HISTOGRAM_BINS, 0);
+        for (const auto& entry : threadHists) {
+            const auto& hist = entry.second;
+            for (std::size_t i = 0; i < hist.size(); i++) {
+                stats.histogram[i] += hist[i];
+            }
+        }
+    }
+
+    return stats;
+}
+
+auto ReportMismatches(IngestStats& stats) -> bool
+{
+    if (stats.mismatches.empty()) {
+        return true;
     }
+
+    // Report mismatched slices
+    std::sort(stats.mismatches.begin(), stats.mismatches.end());
+    std::cerr << "Found " << stats.mismatches.size();
+    std::cerr << " files which could not be read or did not match the initial "
+                 "slice:";
+    std::cerr << std::endl;
+    for (const auto& p : stats.mismatches) {
+        std::cerr << "\t" << p << std::endl;
+    }
+
+    std::cerr << "ERROR: Slices in slice directory do not have matching "
+                 "properties (width/height/depth)."
+              << std::endl;
+    return false;
 }
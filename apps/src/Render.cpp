@@ -1,8 +1,12 @@
 #include <cstddef>
 #include <cstdint>
+#include <map>
+#include <optional>
 #include <unordered_map>
+#include <utility>
 
 #include <boost/program_options.hpp>
+#include <nlohmann/json.hpp>
 #include <smgl/smgl.hpp>
 
 #include "vc/app_support/GetMemorySize.hpp"
@@ -11,9 +15,11 @@
 #include "vc/core/io/FileExtensionFilter.hpp"
 #include "vc/core/io/PointSetIO.hpp"
 #include "vc/core/types/VolumePkg.hpp"
+#include "vc/core/util/ContentHash.hpp"
 #include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/MemorySizeStringParser.hpp"
+#include "vc/core/util/Profiling.hpp"
 #include "vc/core/util/String.hpp"
 #include "vc/graph.hpp"
 
@@ -50,6 +56,13 @@ auto GetGeneralOpts() -> po::options_description
         ("cache-memory-limit", po::value<std::string>(),
          "Maximum size of the slice cache in bytes. Accepts the suffixes: "
          "(K|M|G|T)(B). Default: 50% of the total system memory.")
+        ("graph-threads", po::value<std::size_t>()->default_value(0),
+         "Maximum number of independent render graph nodes to update at the "
+         "same time. If 0, uses the number of hardware threads. If 1, nodes "
+         "are updated one at a time.")
+        ("profile", "Record hot-path timers and counters during the render. "
+         "The totals are logged when the render finishes and are saved to "
+         "the render's profile metadata.")
         ("log-level", po::value<std::string>()->default_value("info"),
          "Options: off, critical, error, warn, info, debug");
     // clang-format on
@@ -74,7 +87,11 @@ auto GetIOOpts() -> po::options_description
         "Output file path for the generated PPM.")
     ("compression", po::value<int>(), "Image compression level")
     ("save-graph", po::value<bool>()->default_value(true),
-        "Save the generated render graph into the volume package.");
+        "Save the generated render graph into the volume package.")
+    ("reuse-renders", po::value<bool>()->default_value(true),
+        "Reuse the meshes, UV maps, and PPMs of previous renders in the "
+        "volume package when their inputs and parameters match. Results are "
+        "only saved for reuse when --save-graph is enabled.");
     // clang-format on
 
     return opts;
@@ -270,12 +287,39 @@ auto GetThicknessOpts() -> po::options_description
     opts.add_options()
         ("volume-mask", po::value<std::string>(),
             "Path to volumetric mask point set")
+        ("mask-volume", po::value<std::string>(),
+            "ID of a mask volume in the volume package, such as one written "
+            "by vc_seg_to_pointmask --output-volume. The mask volume is read "
+            "through the slice cache instead of being loaded into memory.")
         ("normalize-output", po::value<bool>()->default_value(true),
             "Normalize the output image between [0, 1]");
     // clang-format on
 
     return opts;
 }
+
+// Hash the parameters of a pipeline stage together with the hash of the stage
+// which produces its input. Changing the input or parameters of any stage
+// changes the hashes of all following stages.
+auto StageHash(const std::string& inputHash, const nlohmann::json& params)
+    -> std::string
+{
+    ContentHash hash;
+    hash.update(inputHash);
+    hash.update(params.dump());
+    return hash.hex();
+}
+
+// Get an option's value or null if it wasn't provided
+template <typename T>
+auto OptionValue(const po::variables_map& parsed, const std::string& key)
+    -> nlohmann::json
+{
+    if (parsed.count(key) > 0) {
+        return parsed[key].as<T>();
+    }
+    return nullptr;
+}
 }  // namespace
 
 auto main(int argc, char* argv[]) -> int
@@ -347,8 +391,9 @@ auto main(int argc, char* argv[]) -> int
 
     //// Create the graph pipeline ////
     std::shared_ptr<smgl::Graph> graph;
+    Render::Pointer render;
     if (parsed["save-graph"].as<bool>()) {
-        auto render = vpkg->newRender();
+        render = vpkg->newRender();
         graph = render->graph();
         vc::Logger()->info(
             "Created new Render graph in VolPkg: {}", render->id());
@@ -387,35 +432,45 @@ auto main(int argc, char* argv[]) -> int
         return EXIT_FAILURE;
     }
 
+    // The input nodes are only added if the mesh isn't reused from a previous
+    // render, but the input is hashed up front
     std::string outStem;
+    ContentHash inputHash;
     if (loadSeg) {
-        Logger()->debug("Loading segmentation");
-        const auto id = parsed["seg"].as<std::string>();
-        outStem = id;
-
-        auto seg = graph->insertNode<SegmentationSelectorNode>();
-        seg->volpkg = vpkg;
-        seg->id = id;
-
-        auto getPts = graph->insertNode<SegmentationPropertiesNode>();
-        getPts->segmentation = seg->segmentation;
-
-        auto mesher = graph->insertNode<MeshingNode>();
-        mesher->points = getPts->pointSet;
-        results["mesh"] = &mesher->mesh;
+        outStem = parsed["seg"].as<std::string>();
+        inputHash.update("seg:" + outStem);
+        inputHash.updateFile(vpkg->segmentation(outStem)->path());
     } else {
-        Logger()->debug("Loading mesh");
         const fs::path inputPath = parsed["input-mesh"].as<std::string>();
         outStem = inputPath.stem().string();
+        inputHash.update("mesh:");
+        inputHash.updateFile(inputPath);
+    }
 
-        auto reader = graph->insertNode<LoadMeshNode>();
-        reader->path = inputPath;
-        reader->cacheArgs = true;
-        results["mesh"] = &reader->mesh;
-        if (parsed.count("uv-reuse") > 0) {
-            results["uvMap"] = &reader->uvMap;
+    auto addInputNodes = [&]() {
+        if (loadSeg) {
+            Logger()->debug("Loading segmentation");
+            auto seg = graph->insertNode<SegmentationSelectorNode>();
+            seg->volpkg = vpkg;
+            seg->id = outStem;
+
+            auto getPts = graph->insertNode<SegmentationPropertiesNode>();
+            getPts->segmentation = seg->segmentation;
+
+            auto mesher = graph->insertNode<MeshingNode>();
+            mesher->points = getPts->pointSet;
+            results["mesh"] = &mesher->mesh;
+        } else {
+            Logger()->debug("Loading mesh");
+            auto reader = graph->insertNode<LoadMeshNode>();
+            reader->path = fs::path(parsed["input-mesh"].as<std::string>());
+            reader->cacheArgs = true;
+            results["mesh"] = &reader->mesh;
+            if (parsed.count("uv-reuse") > 0) {
+                results["uvMap"] = &reader->uvMap;
+            }
         }
-    }
+    };
 
     //// Setup the output file path ////
     fs::path outDir;
@@ -562,8 +617,106 @@ auto main(int argc, char* argv[]) -> int
         results["transform"] = &invTfm->output;
     }
 
+    //// Look for reusable results from previous renders ////
+    // Transforms from files are identified by their contents
+    std::string tfmKey;
+    if (useTfm and tfmIdInVpkg) {
+        tfmKey = tfmId;
+    } else if (useTfm) {
+        ContentHash tfmHash;
+        tfmHash.updateFile(tfmId);
+        tfmKey = tfmHash.hex();
+    }
+    const auto invertTfm = useTfm and parsed.count("invert-transform") > 0;
+    auto meshTfm = tfmInputType != TransformInput::PerPixelMap;
+
+    // clang-format off
+    auto meshHash = ::StageHash(inputHash.hex(), {
+        {"srcVolume", srcVolId},
+        {"tgtVolume", tgtVolId},
+        {"transform", (meshTfm) ? tfmKey : ""},
+        {"invertTransform", meshTfm and invertTfm},
+        {"applyTransformTo", static_cast<int>(tfmInputType)},
+        {"scaleMesh", ::OptionValue<double>(parsed, "scale-mesh")},
+        {"resample", loadSeg or parsed.count("enable-mesh-resampling") > 0},
+        {"resampleFactor", parsed["mesh-resample-factor"].as<double>()},
+        {"resampleVCount",
+            ::OptionValue<std::size_t>(parsed, "mesh-resample-vcount")},
+        {"resampleKeepVCount", parsed.count("mesh-resample-keep-vcount") > 0},
+        {"resampleAnisotropic", parsed.count("mesh-resample-anisotropic") > 0},
+        {"resampleGradation", parsed["mesh-resample-gradation"].as<double>()},
+        {"resampleQuadrics",
+            parsed["mesh-resample-quadrics-level"].as<std::size_t>()},
+        {"resampleSmoothing", parsed["mesh-resample-smoothing"].as<int>()},
+        {"orientNormals", parsed.count("orient-normals") > 0}
+    });
+    auto uvHash = ::StageHash(meshHash, {
+        {"algorithm", parsed["uv-algorithm"].as<int>()},
+        {"reuse", parsed.count("uv-reuse") > 0},
+        {"alignToAxis", static_cast<int>(
+            parsed["uv-align-to-axis"].as<UVMap::AlignmentAxis>())},
+        {"rotate", ::OptionValue<double>(parsed, "uv-rotate")},
+        {"flip", ::OptionValue<int>(parsed, "uv-flip")}
+    });
+    auto ppmHash = ::StageHash(uvHash, {
+        {"shading", parsed["shading"].as<int>()},
+        {"transform", (meshTfm) ? "" : tfmKey},
+        {"invertTransform", not meshTfm and invertTfm}
+    });
+    // clang-format on
+
+    const auto reuse = parsed["reuse-renders"].as<bool>();
+    auto findCheckpoint = [&](const std::string& name,
+                              const std::string& hash) {
+        std::optional<fs::path> file;
+        if (reuse) {
+            file = vpkg->findCheckpoint(name, hash);
+        }
+        if (file) {
+            Logger()->info("Reusing {} from previous render: {}", name, *file);
+        }
+        return file;
+    };
+
+    // The mesh and UV map are only needed to make the PPM and for some outputs
+    auto ppmCheckpoint = findCheckpoint("ppm", ppmHash);
+    const bool needMeshUV = not ppmCheckpoint or
+                            vc::IsFileType(outputPath, {"obj", "ply"}) or
+                            parsed.count("intermediate-mesh") > 0 or
+                            parsed.count("uv-plot") > 0 or
+                            parsed.count("uv-plot-error") > 0;
+    std::optional<fs::path> uvCheckpoint;
+    std::optional<fs::path> meshCheckpoint;
+    if (needMeshUV) {
+        uvCheckpoint = findCheckpoint("uv", uvHash);
+    }
+    // Reused meshes don't include the input mesh's UV map
+    if (needMeshUV and not uvCheckpoint and parsed.count("uv-reuse") == 0) {
+        meshCheckpoint = findCheckpoint("mesh", meshHash);
+    }
+    const bool buildMesh =
+        needMeshUV and not uvCheckpoint and not meshCheckpoint;
+    const bool buildUV = needMeshUV and not uvCheckpoint;
+
+    // Results saved for reuse by later renders: name -> (hash, file)
+    std::map<std::string, std::pair<std::string, fs::path>> checkpoints;
+
+    //// Load the segmentation/mesh ////
+    if (uvCheckpoint) {
+        auto reader = graph->insertNode<LoadMeshNode>();
+        reader->path = *uvCheckpoint;
+        results["mesh"] = &reader->mesh;
+        results["uvMap"] = &reader->uvMap;
+    } else if (meshCheckpoint) {
+        auto reader = graph->insertNode<LoadMeshNode>();
+        reader->path = *meshCheckpoint;
+        results["mesh"] = &reader->mesh;
+    } else if (buildMesh) {
+        addInputNodes();
+    }
+
     //// Transform raw input ////
-    if (useTfm and tfmInputType == TransformInput::Raw) {
+    if (buildMesh and useTfm and tfmInputType == TransformInput::Raw) {
         Logger()->debug("Adding transform raw mesh node");
         auto tfmNode = graph->insertNode<TransformMeshNode>();
         tfmNode->input = *results["mesh"];
@@ -572,7 +725,7 @@ auto main(int argc, char* argv[]) -> int
     }
 
     //// Scale the mesh /////
-    if (parsed.count("scale-mesh") > 0) {
+    if (buildMesh and parsed.count("scale-mesh") > 0) {
         Logger()->debug("Adding scale mesh node");
         auto scaleMesh = graph->insertNode<ScaleMeshNode>();
         scaleMesh->input = *results["mesh"];
@@ -581,7 +734,8 @@ auto main(int argc, char* argv[]) -> int
     }
 
     ///// Resample and smooth the mesh /////
-    auto needResample = loadSeg || parsed.count("enable-mesh-resampling") > 0;
+    auto needResample =
+        buildMesh and (loadSeg || parsed.count("enable-mesh-resampling") > 0);
     if (needResample) {
         // Pre-smooth
         auto smoothType =
@@ -654,7 +808,7 @@ auto main(int argc, char* argv[]) -> int
     }
 
     ///// Reorient the mesh normals /////
-    if (parsed.count("orient-normals") > 0) {
+    if (buildMesh and parsed.count("orient-normals") > 0) {
         Logger()->debug("Adding normal reorientation node");
         auto orient = graph->insertNode<OrientNormalsNode>();
         orient->input = *results["mesh"];
@@ -663,7 +817,7 @@ auto main(int argc, char* argv[]) -> int
     }
 
     //// Transform resampled input ////
-    if (useTfm and tfmInputType == TransformInput::Resampled) {
+    if (buildMesh and useTfm and tfmInputType == TransformInput::Resampled) {
         Logger()->debug("Adding transform resampled mesh node");
         auto tfmNode = graph->insertNode<TransformMeshNode>();
         tfmNode->input = *results["mesh"];
@@ -671,6 +825,16 @@ auto main(int argc, char* argv[]) -> int
         results["mesh"] = &tfmNode->output;
     }
 
+    ///// Save the mesh for reuse /////
+    if (render and buildMesh) {
+        Logger()->debug("Adding mesh checkpoint writer node");
+        const fs::path file{"checkpoint_mesh.vcmesh"};
+        auto writer = graph->insertNode<WriteMeshNode>();
+        writer->path = render->path() / file;
+        writer->mesh = *results["mesh"];
+        checkpoints["mesh"] = {meshHash, file};
+    }
+
     ///// Save the intermediate mesh /////
     if (parsed.count("intermediate-mesh") > 0) {
         Logger()->debug("Adding node to save intermediate mesh");
@@ -689,7 +853,7 @@ auto main(int argc, char* argv[]) -> int
     }
 
     // Compute a UV map if we're not using a loaded one
-    if (results.count("uvMap") == 0) {
+    if (buildUV and results.count("uvMap") == 0) {
         Logger()->debug("Adding UV computation node");
         auto method =
             static_cast<FlatteningAlgorithm>(parsed["uv-algorithm"].as<int>());
@@ -726,7 +890,7 @@ auto main(int argc, char* argv[]) -> int
 
     // Align to axis
     auto uvAlignAxis = parsed["uv-align-to-axis"].as<UVMap::AlignmentAxis>();
-    if (uvAlignAxis != UVMap::AlignmentAxis::None) {
+    if (buildUV and uvAlignAxis != UVMap::AlignmentAxis::None) {
         Logger()->debug("Adding UV align to axis node");
         auto align = graph->insertNode<AlignUVMapToAxisNode>();
         align->uvMapIn = *results["uvMap"];
@@ -739,7 +903,7 @@ auto main(int argc, char* argv[]) -> int
     }
 
     // Rotate
-    if (parsed.count("uv-rotate") > 0) {
+    if (buildUV and parsed.count("uv-rotate") > 0) {
         Logger()->debug("Adding UV rotation node");
         auto rotate = graph->insertNode<RotateUVMapNode>();
         rotate->uvMapIn = *results["uvMap"];
@@ -751,7 +915,7 @@ auto main(int argc, char* argv[]) -> int
     }
 
     // Flip
-    if (parsed.count("uv-flip") > 0) {
+    if (buildUV and parsed.count("uv-flip") > 0) {
         Logger()->debug("Adding UV flip node");
         auto axis = static_cast<UVMap::FlipAxis>(parsed["uv-flip"].as<int>());
         auto flip = graph->insertNode<FlipUVMapNode>();
@@ -763,6 +927,17 @@ auto main(int argc, char* argv[]) -> int
         results.erase("uvMesh");
     }
 
+    // Save the mesh and UV map for reuse
+    if (render and buildUV) {
+        Logger()->debug("Adding UV checkpoint writer node");
+        const fs::path file{"checkpoint_uv.vcmesh"};
+        auto writer = graph->insertNode<WriteMeshNode>();
+        writer->path = render->path() / file;
+        writer->mesh = *results["mesh"];
+        writer->uvMap = *results["uvMap"];
+        checkpoints["uv"] = {uvHash, file};
+    }
+
     // UV plotting options
     auto plotUV = parsed.count("uv-plot") > 0;
     auto plotUVError = parsed.count("uv-plot-error") > 0;
@@ -790,21 +965,38 @@ auto main(int argc, char* argv[]) -> int
     }
 
     // Generate the PPM
-    Logger()->debug("Adding PPM generator node");
-    using Shading = PPMGeneratorNode::Shading;
-    auto ppmGen = graph->insertNode<PPMGeneratorNode>();
-    ppmGen->mesh = *results["mesh"];
-    ppmGen->uvMap = *results["uvMap"];
-    ppmGen->shading = static_cast<Shading>(parsed["shading"].as<int>());
-    results["ppm"] = &ppmGen->ppm;
+    if (ppmCheckpoint) {
+        Logger()->debug("Adding PPM reader node");
+        auto reader = graph->insertNode<LoadPPMNode>();
+        reader->path = *ppmCheckpoint;
+        results["ppm"] = &reader->ppm;
+    } else {
+        Logger()->debug("Adding PPM generator node");
+        using Shading = PPMGeneratorNode::Shading;
+        auto ppmGen = graph->insertNode<PPMGeneratorNode>();
+        ppmGen->mesh = *results["mesh"];
+        ppmGen->uvMap = *results["uvMap"];
+        ppmGen->shading = static_cast<Shading>(parsed["shading"].as<int>());
+        results["ppm"] = &ppmGen->ppm;
+
+        //// Transform resampled input ////
+        if (useTfm and tfmInputType == TransformInput::PerPixelMap) {
+            Logger()->debug("Adding transform PPM node");
+            auto tfmNode = graph->insertNode<TransformPPMNode>();
+            tfmNode->input = *results["ppm"];
+            tfmNode->transform = *results["transform"];
+            results["ppm"] = &tfmNode->output;
+        }
 
-    //// Transform resampled input ////
-    if (useTfm and tfmInputType == TransformInput::PerPixelMap) {
-        Logger()->debug("Adding transform PPM node");
-        auto tfmNode = graph->insertNode<TransformPPMNode>();
-        tfmNode->input = *results["ppm"];
-        tfmNode->transform = *results["transform"];
-        results["ppm"] = &tfmNode->output;
+        // Save the PPM for reuse
+        if (render) {
+            Logger()->debug("Adding PPM checkpoint writer node");
+            const fs::path file{"checkpoint_ppm.vcppm"};
+            auto writer = graph->insertNode<WritePPMNode>();
+            writer->path = render->path() / file;
+            writer->ppm = *results["ppm"];
+            checkpoints["ppm"] = {ppmHash, file};
+        }
     }
 
     // Save the PPM
@@ -829,7 +1021,7 @@ auto main(int argc, char* argv[]) -> int
         // PPM properties
         Logger()->debug("Adding PPM properties node");
         auto ppmProps = graph->insertNode<PPMPropertiesNode>();
-        ppmProps->ppm = ppmGen->ppm;
+        ppmProps->ppm = *results["ppm"];
 
         // Generate the error plots
         Logger()->debug("Adding UV error plotting node");
@@ -949,20 +1141,37 @@ auto main(int argc, char* argv[]) -> int
 
     else if (method == Method::Thickness) {
         // Load mask
-        if (parsed.count("volume-mask") == 0) {
+        auto hasMaskPts = parsed.count("volume-mask") > 0;
+        auto hasMaskVol = parsed.count("mask-volume") > 0;
+        if (not hasMaskPts and not hasMaskVol) {
             vc::Logger()->error(
                 "Selected Thickness texturing, but did not provide volume mask "
-                "path.");
+                "path or mask volume.");
             std::exit(EXIT_FAILURE);
         }
-        Logger()->debug("Adding volume mask reader node");
-        auto reader = graph->insertNode<LoadVolumetricMaskNode>();
-        reader->cacheArgs = true;
-        reader->path = parsed["volume-mask"].as<std::string>();
 
         Logger()->debug("Adding thickness texture node");
         auto t = graph->insertNode<ThicknessTextureNode>();
-        t->volumetricMask = reader->volumetricMask;
+        if (hasMaskPts) {
+            Logger()->debug("Adding volume mask reader node");
+            auto reader = graph->insertNode<LoadVolumetricMaskNode>();
+            reader->cacheArgs = true;
+            reader->path = parsed["volume-mask"].as<std::string>();
+            t->volumetricMask = reader->volumetricMask;
+        } else {
+            auto maskVolId = parsed["mask-volume"].as<std::string>();
+            if (not vpkg->hasVolume(maskVolId)) {
+                Logger()->error(
+                    "Volume package does not contain volume with ID: {}",
+                    maskVolId);
+                return EXIT_FAILURE;
+            }
+            Logger()->debug("Adding mask volume selector node");
+            auto maskVolSelector = graph->insertNode<VolumeSelectorNode>();
+            maskVolSelector->volpkg = vpkg;
+            maskVolSelector->id = maskVolId;
+            t->maskVolume = maskVolSelector->volume;
+        }
         t->normalizeOutput = parsed["normalize-output"].as<bool>();
         t->samplingInterval = parsed["interval"].as<double>();
         texturing = t;
@@ -1032,13 +1241,52 @@ auto main(int argc, char* argv[]) -> int
     // Update the graph
     try {
         Logger()->debug("Starting graph update");
-        auto status = graph->update();
-        if (status == smgl::Graph::State::Updating) {
-            Logger()->error("Graph already updating");
-        } else if (status == smgl::Graph::State::Error) {
+        auto threads = parsed["graph-threads"].as<std::size_t>();
+        const auto profile = parsed.count("profile") > 0;
+        profiling::SetEnabled(profile);
+        auto update = UpdateGraphConcurrent(*graph, threads);
+        Logger()->info("Graph updated in {:.3f} s", update.wallTime);
+        profiling::Report report;
+        if (profile) {
+            report = profiling::Snapshot();
+            profiling::LogReport(report);
+        }
+
+        // Save the graph and per-node performance info
+        if (render) {
+            render->saveGraph();
+            nlohmann::json nodes;
+            for (const auto& n : update.nodes) {
+                // clang-format off
+                nodes[n.uuid] = {
+                    {"order", n.order},
+                    {"wallTime", n.wallTime},
+                    {"peakMemory", n.peakMemory},
+                    {"peakMemoryIncrease", n.peakMemoryIncrease}
+                };
+                // clang-format on
+            }
+            nlohmann::json info{
+                {"threads", threads},
+                {"wallTime", update.wallTime},
+                {"nodes", nodes},
+            };
+            if (profile) {
+                info["instrumentation"] = profiling::ToJson(report);
+            }
+            render->setProfile(info);
+        }
+
+        if (update.state == smgl::Graph::State::Error) {
             Logger()->error("Graph pipeline failed to update");
         } else {
             Logger()->debug("Graph is idle");
+
+            // Make the saved results available to later renders
+            for (const auto& [name, checkpoint] : checkpoints) {
+                const auto& [hash, file] = checkpoint;
+                render->setCheckpoint(name, hash, file);
+            }
         }
     } catch (const std::exception& e) {
         Logger()->error(e.what());
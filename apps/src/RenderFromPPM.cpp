@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include <boost/program_options.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -19,8 +20,10 @@
 #include "vc/core/types/Transforms.hpp"
 #include "vc/core/types/VolumePkg.hpp"
 #include "vc/core/util/DateTime.hpp"
+#include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/MemorySizeStringParser.hpp"
+#include "vc/texturing/BatchTexturing.hpp"
 #include "vc/texturing/CompositeTexture.hpp"
 #include "vc/texturing/IntegralTexture.hpp"
 #include "vc/texturing/IntersectionTexture.hpp"
@@ -58,13 +61,16 @@ auto main(int argc, char* argv[]) -> int
     po::options_description ioOpts("Input/Output Options");
     ioOpts.add_options()
         ("volpkg,v", po::value<std::string>()->required(), "VolumePkg path")
-        ("ppm,p", po::value<std::string>()->required(), "Input PPM file")
+        ("ppm,p", po::value<std::vector<std::string>>()->multitoken()
+            ->required(), "Input PPM file(s). When multiple PPMs are "
+            "provided, all are textured in a single pass through the volume.")
         ("volume", po::value<std::string>(),
             "Volume to use for texturing. Default: First volume.")
-        ("output-file,o", po::value<std::string>()->required(),
-            "Output image file path.")
+        ("output-file,o", po::value<std::vector<std::string>>()
+            ->multitoken()->required(), "Output image file path(s). Provide "
+            "one path for each input PPM.")
         ("output-ppm", po::value<std::string>(), "Save a new PPM to the given "
-            "path.")
+            "path. Only supported with a single input PPM.")
         ("tiff-floating-point", "When outputting to the TIFF format, save a "
             "floating-point image.");
 
@@ -102,9 +108,21 @@ auto main(int argc, char* argv[]) -> int
 
     // Get the parsed options
     const fs::path volpkgPath = parsed["volpkg"].as<std::string>();
-    const fs::path inputPPMPath = parsed["ppm"].as<std::string>();
+    const auto inputPPMPaths = parsed["ppm"].as<std::vector<std::string>>();
     const auto method = static_cast<Method>(parsed["method"].as<int>());
-    const fs::path outputPath = parsed["output-file"].as<std::string>();
+    const auto outputPaths =
+        parsed["output-file"].as<std::vector<std::string>>();
+    if (inputPPMPaths.size() != outputPaths.size()) {
+        Logger()->error(
+            "Number of input PPMs ({}) does not match number of output files "
+            "({})",
+            inputPPMPaths.size(), outputPaths.size());
+        return EXIT_FAILURE;
+    }
+    if (inputPPMPaths.size() > 1 and parsed.count("output-ppm") > 0) {
+        Logger()->error("--output-ppm requires a single input PPM");
+        return EXIT_FAILURE;
+    }
 
     ///// Load the volume package /////
     auto vpkg = VolumePkg::New(volpkgPath);
@@ -140,6 +158,7 @@ auto main(int argc, char* argv[]) -> int
         cacheBytes = MemorySizeStringParser(cacheSizeOpt);
     }
     volume->setCacheMemoryInBytes(cacheBytes);
+    volume->setPrefetchDepth(parsed["prefetch-slices"].as<std::size_t>());
     Logger()->info(
         "Volume Cache :: Capacity: {} || Size: {}", volume->getCacheCapacity(),
         BytesToMemorySizeString(cacheBytes));
@@ -191,15 +210,10 @@ auto main(int argc, char* argv[]) -> int
     }
     auto normalize = parsed["normalize-output"].as<bool>();
 
-    // Read the ppm
-    Logger()->info("Loading PPM...");
-    auto ppm = PerPixelMap::New(std::move(PerPixelMap::ReadPPM(inputPPMPath)));
-
-    ///// Transform the PPM /////
+    ///// Load the transform /////
+    Transform3D::Pointer tfm;
     if (parsed.count("transform") > 0) {
-        // load the transform
         auto tfmId = parsed.at("transform").as<std::string>();
-        Transform3D::Pointer tfm;
         if (vpkg->hasTransform(tfmId)) {
             tfm = vpkg->transform(tfmId);
         } else {
@@ -213,9 +227,21 @@ auto main(int argc, char* argv[]) -> int
                 Logger()->warn("Cannot invert transform. Using original.");
             }
         }
+    }
 
-        Logger()->info("Applying transform...");
-        ppm = ApplyTransform(ppm, tfm);
+    // Read the ppms
+    std::vector<PerPixelMap::Pointer> ppms;
+    for (const auto& inputPPMPath : inputPPMPaths) {
+        Logger()->info("Loading PPM: {}", inputPPMPath);
+        auto ppm =
+            PerPixelMap::New(std::move(PerPixelMap::ReadPPM(inputPPMPath)));
+
+        ///// Transform the PPM /////
+        if (tfm) {
+            Logger()->info("Applying transform...");
+            ppm = ApplyTransform(ppm, tfm);
+        }
+        ppms.emplace_back(ppm);
     }
 
     ///// Setup Neighborhood /////
@@ -264,58 +290,83 @@ auto main(int argc, char* argv[]) -> int
     }
     Logger()->info(ss.str());
 
-    Logger()->debug("Setting up texturing algorithm...");
-    vct::TexturingAlgorithm::Pointer textureGen;
-    if (method == Method::Intersection) {
-        auto intersect = vct::IntersectionTexture::New();
-        intersect->setVolume(volume);
-        intersect->setPerPixelMap(ppm);
-        textureGen = intersect;
+    // Load mask
+    VolumetricMask::Pointer mask;
+    Volume::Pointer maskVolume;
+    if (method == Method::Thickness) {
+        if (maskPath.empty() and parsed.count("mask-volume") == 0) {
+            Logger()->error(
+                "Selected Thickness texturing, but did not "
+                "provide volume mask path or mask volume.");
+            std::exit(EXIT_FAILURE);
+        }
+        if (not maskPath.empty()) {
+            Logger()->info("Loading volume mask...");
+            auto pts = PointSetIO<cv::Vec3i>::ReadPointSet(maskPath);
+            mask = VolumetricMask::New(pts);
+        } else {
+            try {
+                maskVolume =
+                    vpkg->volume(parsed["mask-volume"].as<std::string>());
+            } catch (const std::exception& e) {
+                Logger()->error("Cannot load mask volume: {}", e.what());
+                return EXIT_FAILURE;
+            }
+        }
     }
 
-    else if (method == Method::Composite) {
-        auto composite = vct::CompositeTexture::New();
-        composite->setPerPixelMap(ppm);
-        composite->setVolume(volume);
-        composite->setFilter(filter);
-        composite->setGenerator(generator);
-        textureGen = composite;
-    }
+    Logger()->debug("Setting up texturing algorithm...");
+    auto makeTextureGen = [&](const PerPixelMap::Pointer& ppm) {
+        vct::TexturingAlgorithm::Pointer textureGen;
+        if (method == Method::Intersection) {
+            auto intersect = vct::IntersectionTexture::New();
+            intersect->setVolume(volume);
+            intersect->setPerPixelMap(ppm);
+            textureGen = intersect;
+        }
 
-    else if (method == Method::Integral) {
-        auto integral = vct::IntegralTexture::New();
-        integral->setPerPixelMap(ppm);
-        integral->setVolume(volume);
-        integral->setGenerator(generator);
-        integral->setWeightMethod(weightType);
-        integral->setLinearWeightDirection(weightDirection);
-        integral->setExponentialDiffExponent(weightExponent);
-        integral->setExponentialDiffBaseMethod(expoDiffBaseMethod);
-        integral->setExponentialDiffBaseValue(expoDiffBase);
-        integral->setClampValuesToMax(clampToMax);
-        if (clampToMax) {
-            integral->setClampMax(parsed["clamp-to-max"].as<std::uint16_t>());
+        else if (method == Method::Composite) {
+            auto composite = vct::CompositeTexture::New();
+            composite->setPerPixelMap(ppm);
+            composite->setVolume(volume);
+            composite->setFilter(filter);
+            composite->setGenerator(generator);
+            textureGen = composite;
         }
-        textureGen = integral;
-    }
 
-    else if (method == Method::Thickness) {
-        // Load mask
-        if (maskPath.empty()) {
-            Logger()->error(
-                "Selected Thickness texturing, but did not "
-                "provide volume mask path.");
-            std::exit(EXIT_FAILURE);
+        else if (method == Method::Integral) {
+            auto integral = vct::IntegralTexture::New();
+            integral->setPerPixelMap(ppm);
+            integral->setVolume(volume);
+            integral->setGenerator(generator);
+            integral->setWeightMethod(weightType);
+            integral->setLinearWeightDirection(weightDirection);
+            integral->setExponentialDiffExponent(weightExponent);
+            integral->setExponentialDiffBaseMethod(expoDiffBaseMethod);
+            integral->setExponentialDiffBaseValue(expoDiffBase);
+            integral->setClampValuesToMax(clampToMax);
+            if (clampToMax) {
+                integral->setClampMax(
+                    parsed["clamp-to-max"].as<std::uint16_t>());
+            }
+            textureGen = integral;
         }
-        Logger()->info("Loading volume mask...");
-        auto pts = PointSetIO<cv::Vec3i>::ReadPointSet(maskPath);
-        auto mask = VolumetricMask::New(pts);
-
-        auto thickness = vct::ThicknessTexture::New();
-        thickness->setPerPixelMap(ppm);
-        thickness->setVolumetricMask(mask);
-        thickness->setNormalizeOutput(normalize);
-        textureGen = thickness;
+
+        else if (method == Method::Thickness) {
+            auto thickness = vct::ThicknessTexture::New();
+            thickness->setPerPixelMap(ppm);
+            thickness->setVolumetricMask(mask);
+            thickness->setMaskVolume(maskVolume);
+            thickness->setNormalizeOutput(normalize);
+            textureGen = thickness;
+        }
+        return textureGen;
+    };
+
+    // Texture all PPMs in one pass through the volume
+    auto batch = vct::BatchTexturing::New();
+    for (const auto& ppm : ppms) {
+        batch->addAlgorithm(makeTextureGen(ppm));
     }
 
     if (parsed["progress"].as<bool>()) {
@@ -324,23 +375,25 @@ auto main(int argc, char* argv[]) -> int
             cfg.interval = DurationFromString(
                 parsed["progress-interval"].as<std::string>());
         }
-        ReportProgress(*textureGen, "Texturing:", cfg);
+        ReportProgress(*batch, "Texturing:", cfg);
         Logger()->debug("Texturing...");
     } else {
         Logger()->info("Texturing...");
     }
 
     Logger()->debug("Starting texturing algorithm...");
-    auto texture = textureGen->compute();
+    auto textures = batch->compute();
 
-    // Write the output
-    Logger()->info("Writing output image...");
-    WriteImage(outputPath, texture[0]);
+    // Write the outputs
+    for (const auto [idx, texture] : enumerate(textures)) {
+        Logger()->info("Writing output image: {}", outputPaths[idx]);
+        WriteImage(outputPaths[idx], texture[0]);
+    }
 
     if (parsed.count("output-ppm") > 0) {
         Logger()->info("Writing output PPM...");
         const fs::path outputPPMPath = parsed["output-ppm"].as<std::string>();
-        PerPixelMap::WritePPM(outputPPMPath, *ppm);
+        PerPixelMap::WritePPM(outputPPMPath, *ppms[0]);
     }
 
     Logger()->info("Done.");
@@ -130,6 +130,10 @@ auto GetThicknessOpts() -> po::options_description
     opts.add_options()
         ("volume-mask", po::value<std::string>(),
             "Path to volumetric mask point set")
+        ("mask-volume", po::value<std::string>(),
+            "ID of a mask volume in the volume package, such as one written "
+            "by vc_seg_to_pointmask --output-volume. The mask volume is read "
+            "through the slice cache instead of being loaded into memory.")
         ("normalize-output", po::value<bool>()->default_value(true),
             "Normalize the output image between [0, 1]. If enabled "
             "(default), the output file should be a TIFF file and the "
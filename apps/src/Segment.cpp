@@ -233,6 +233,7 @@ auto main(int argc, char* argv[]) -> int
         cacheBytes = SystemMemorySize() / 2;
     }
     volume->setCacheMemoryInBytes(cacheBytes);
+    volume->setPrefetchDepth(parsed["prefetch-slices"].as<std::size_t>());
     std::cout << "Volume Cache :: ";
     std::cout << "Capacity: " << volume->getCacheCapacity() << " || ";
     std::cout << "Size: " << vc::BytesToMemorySizeString(cacheBytes);
@@ -34,6 +34,12 @@ auto SliceImage::operator<(const SliceImage& b) const -> bool
     return aName.size() < bName.size();
 }
 
+auto SliceImage::read() const -> cv::Mat
+{
+    return cv::imread(
+        path.string(), cv::IMREAD_ANYCOLOR | cv::IMREAD_ANYDEPTH);
+}
+
 auto SliceImage::analyze() -> bool
 {
     // return if the path is wrong or if this isn't a regular file
@@ -42,12 +48,18 @@ auto SliceImage::analyze() -> bool
         return false;
     }
 
+    return analyze(read());
+}
+
+auto SliceImage::analyze(const cv::Mat& image) -> bool
+{
+    if (image.empty()) {
+        return false;
+    }
+
     // Set needsConvert_ if it's not a tif
     needsConvert_ = !io::FileExtensionFilter(path, {"tif", "tiff"});
 
-    auto image =
-        cv::imread(path.string(), cv::IMREAD_ANYCOLOR | cv::IMREAD_ANYDEPTH);
-
     w_ = image.cols;
     h_ = image.rows;
 
@@ -67,10 +79,11 @@ auto SliceImage::analyze() -> bool
 
 auto SliceImage::conformedImage() -> cv::Mat
 {
-    // Load the image
-    auto image =
-        cv::imread(path.string(), cv::IMREAD_ANYCOLOR | cv::IMREAD_ANYDEPTH);
+    return conformedImage(read());
+}
 
+auto SliceImage::conformedImage(cv::Mat image) const -> cv::Mat
+{
     // Remap values to 16 bit
     if (needsScale_) {
         image.convertTo(
@@ -0,0 +1,76 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+#include <string>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/core/types/UVMap.hpp"
+#include "vc/core/types/Volume.hpp"
+#include "vc/core/types/VolumePkg.hpp"
+
+namespace volcart::benchmarks
+{
+/** @brief Shapes which can be used to generate a phantom */
+enum class PhantomShape { Spiral, Arch, Plane, Sphere };
+
+/** @brief Get the name of a phantom shape */
+auto ShapeName(PhantomShape shape) -> std::string;
+
+/**
+ * @brief Synthetic volume and surface for benchmarking
+ *
+ * A phantom is generated from one of the core ShapePrimitives. The shape is
+ * scaled to fill a cubic volume and rasterized as a bright, slightly noisy
+ * sheet a few voxels thick on a dark background. The volume is stored in a
+ * temporary VolumePkg which is removed when the program exits.
+ *
+ * Phantoms are deterministic: the same shape and size always produce the
+ * same volume, so results can be compared across builds and machines.
+ */
+struct Phantom {
+    /** The volume package */
+    VolumePkg::Pointer volpkg;
+    /** The phantom volume */
+    Volume::Pointer volume;
+    /** The shape's surface in volume coordinates, with normals */
+    ITKMesh::Pointer mesh;
+};
+
+/**
+ * @brief Get the phantom for a shape and volume size
+ *
+ * Phantoms are generated the first time they are requested and reused by
+ * later calls. The returned volume's slice cache may hold slices from
+ * previous benchmarks.
+ *
+ * @param size Width, height, and number of slices of the volume
+ */
+auto GetPhantom(PhantomShape shape, int size) -> const Phantom&;
+
+/**
+ * @brief Get the flattened UV map of a phantom's mesh
+ *
+ * Computed with LSCM the first time it is requested and reused by later
+ * calls.
+ */
+auto GetPhantomUVMap(PhantomShape shape, int size) -> UVMap::Pointer;
+
+/**
+ * @brief Get the PerPixelMap of a phantom's mesh
+ *
+ * The PPM is generated from GetPhantomUVMap() with a width of roughly `size`
+ * pixels. Generated the first time it is requested and reused by later
+ * calls.
+ */
+auto GetPhantomPPM(PhantomShape shape, int size) -> PerPixelMap::Pointer;
+
+/** @brief Generate a wavy grid mesh with approximately `numFaces` faces */
+auto MakeGridMesh(std::size_t numFaces) -> ITKMesh::Pointer;
+
+/** @brief Get the directory which holds temporary benchmark files */
+auto TempDir() -> const filesystem::path&;
+}  // namespace volcart::benchmarks
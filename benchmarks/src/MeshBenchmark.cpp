@@ -0,0 +1,176 @@
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "vc/benchmarks/Phantoms.hpp"
+#include "vc/core/io/CacheIO.hpp"
+#include "vc/core/io/OBJReader.hpp"
+#include "vc/core/io/OBJWriter.hpp"
+#include "vc/core/io/PLYReader.hpp"
+#include "vc/core/io/PLYWriter.hpp"
+#include "vc/meshing/CalculateNormals.hpp"
+#include "vc/texturing/AngleBasedFlattening.hpp"
+
+using namespace volcart;
+using namespace volcart::benchmarks;
+namespace fs = volcart::filesystem;
+
+namespace
+{
+// Mesh file formats
+enum class Format { OBJ = 0, PLYASCII, PLYBinary, Cache };
+
+auto FormatName(Format f) -> std::string
+{
+    switch (f) {
+        case Format::OBJ:
+            return "OBJ";
+        case Format::PLYASCII:
+            return "PLY (ASCII)";
+        case Format::PLYBinary:
+            return "PLY (binary)";
+        case Format::Cache:
+            return "VC mesh cache";
+    }
+    return "";
+}
+
+auto FormatPath(Format f) -> fs::path
+{
+    switch (f) {
+        case Format::OBJ:
+            return TempDir() / "mesh_io.obj";
+        case Format::PLYASCII:
+        case Format::PLYBinary:
+            return TempDir() / "mesh_io.ply";
+        case Format::Cache:
+            return TempDir() / "mesh_io.vcmesh";
+    }
+    return {};
+}
+
+void WriteMesh(Format f, const fs::path& path, const ITKMesh::Pointer& mesh)
+{
+    switch (f) {
+        case Format::OBJ:
+            io::OBJWriter(path, mesh).write();
+            return;
+        case Format::PLYASCII:
+        case Format::PLYBinary: {
+            io::PLYWriter writer(path, mesh);
+            writer.setFormat(
+                (f == Format::PLYASCII)
+                    ? io::PLYWriter::Format::ASCII
+                    : io::PLYWriter::Format::BinaryLittleEndian);
+            writer.write();
+            return;
+        }
+        case Format::Cache:
+            io::WriteMeshCache(path, mesh);
+            return;
+    }
+}
+
+auto ReadMesh(Format f, const fs::path& path) -> ITKMesh::Pointer
+{
+    switch (f) {
+        case Format::OBJ: {
+            io::OBJReader reader;
+            reader.setPath(path);
+            return reader.read();
+        }
+        case Format::PLYASCII:
+        case Format::PLYBinary:
+            return io::PLYReader(path).read();
+        case Format::Cache:
+            return io::ReadMeshCache(path).mesh;
+    }
+    return nullptr;
+}
+
+// Grid meshes are reused between benchmarks
+auto GridMesh(std::size_t numFaces) -> ITKMesh::Pointer
+{
+    static std::map<std::size_t, ITKMesh::Pointer> meshes;
+    auto& mesh = meshes[numFaces];
+    if (not mesh) {
+        mesh = MakeGridMesh(numFaces);
+    }
+    return mesh;
+}
+
+void MeshIOArgs(benchmark::internal::Benchmark* b)
+{
+    b->ArgsProduct(
+        {{static_cast<int>(Format::OBJ), static_cast<int>(Format::PLYASCII),
+          static_cast<int>(Format::PLYBinary), static_cast<int>(Format::Cache)},
+         {100'000, 1'000'000}});
+    b->ArgNames({"format", "faces"});
+    b->Unit(benchmark::kMillisecond);
+}
+
+void BM_MeshWrite(benchmark::State& state)
+{
+    auto format = static_cast<Format>(state.range(0));
+    auto mesh = GridMesh(state.range(1));
+    auto path = FormatPath(format);
+    for (auto _ : state) {
+        WriteMesh(format, path, mesh);
+    }
+    state.SetLabel(FormatName(format));
+    state.SetBytesProcessed(state.iterations() * fs::file_size(path));
+    fs::remove(path);
+}
+BENCHMARK(BM_MeshWrite)->Apply(MeshIOArgs);
+
+void BM_MeshRead(benchmark::State& state)
+{
+    auto format = static_cast<Format>(state.range(0));
+    auto path = FormatPath(format);
+    WriteMesh(format, path, GridMesh(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ReadMesh(format, path));
+    }
+    state.SetLabel(FormatName(format));
+    state.SetBytesProcessed(state.iterations() * fs::file_size(path));
+    fs::remove(path);
+}
+BENCHMARK(BM_MeshRead)->Apply(MeshIOArgs);
+
+void BM_CalculateNormals(benchmark::State& state)
+{
+    auto mesh = GridMesh(state.range(0));
+    for (auto _ : state) {
+        meshing::CalculateNormals normals(mesh);
+        benchmark::DoNotOptimize(normals.compute());
+    }
+    state.SetItemsProcessed(state.iterations() * mesh->GetNumberOfCells());
+}
+BENCHMARK(BM_CalculateNormals)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+void FlatteningArgs(benchmark::internal::Benchmark* b)
+{
+    b->ArgsProduct({{0, 1}, {2'000, 20'000}});
+    b->ArgNames({"abf", "faces"});
+    b->Unit(benchmark::kMillisecond);
+}
+
+void BM_Flattening(benchmark::State& state)
+{
+    auto useABF = state.range(0) != 0;
+    auto mesh = GridMesh(state.range(1));
+    for (auto _ : state) {
+        texturing::AngleBasedFlattening abf(mesh);
+        abf.setUseABF(useABF);
+        benchmark::DoNotOptimize(abf.compute());
+    }
+    state.SetLabel(useABF ? "ABF" : "LSCM");
+    state.SetItemsProcessed(state.iterations() * mesh->GetNumberOfCells());
+}
+BENCHMARK(BM_Flattening)->Apply(FlatteningArgs);
+}  // namespace
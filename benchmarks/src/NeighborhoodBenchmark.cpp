@@ -0,0 +1,87 @@
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <opencv2/core.hpp>
+
+#include "vc/benchmarks/Phantoms.hpp"
+#include "vc/core/neighborhood/CuboidGenerator.hpp"
+#include "vc/core/neighborhood/LineGenerator.hpp"
+
+using namespace volcart;
+using namespace volcart::benchmarks;
+
+namespace
+{
+constexpr int VOLUME_SIZE{128};
+constexpr std::size_t NUM_SAMPLES{4096};
+
+// Reproducible sample positions and normals
+struct Samples {
+    std::vector<cv::Vec3d> points;
+    std::vector<cv::Vec3d> normals;
+};
+
+auto MakeSamples(int size, bool aligned) -> Samples
+{
+    cv::RNG rng(0xC0FFEE);
+    Samples s;
+    for (std::size_t i = 0; i < NUM_SAMPLES; i++) {
+        s.points.emplace_back(
+            rng.uniform(8.0, size - 9.0), rng.uniform(8.0, size - 9.0),
+            rng.uniform(8.0, size - 9.0));
+        if (aligned) {
+            s.normals.emplace_back(0, 0, 1);
+        } else {
+            cv::Vec3d n{
+                rng.gaussian(1), rng.gaussian(1), rng.gaussian(1) + 1e-3};
+            s.normals.emplace_back(cv::normalize(n));
+        }
+    }
+    return s;
+}
+
+void RunGenerator(
+    benchmark::State& state,
+    NeighborhoodGenerator& gen,
+    const Samples& samples)
+{
+    auto volume = GetPhantom(PhantomShape::Spiral, VOLUME_SIZE).volume;
+    volume->setCacheCapacity(volume->numSlices());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < samples.points.size(); i++) {
+            auto n = gen.compute(
+                volume, samples.points[i], {samples.normals[i]});
+            benchmark::DoNotOptimize(n.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * samples.points.size());
+}
+
+void BM_LineGenerator(benchmark::State& state)
+{
+    LineGenerator gen;
+    gen.setSamplingRadius(static_cast<double>(state.range(0)));
+    gen.setSamplingInterval(0.5);
+    RunGenerator(state, gen, MakeSamples(VOLUME_SIZE, false));
+}
+BENCHMARK(BM_LineGenerator)->Arg(2)->Arg(8);
+
+void BM_CuboidGeneratorAligned(benchmark::State& state)
+{
+    auto r = static_cast<double>(state.range(0));
+    CuboidGenerator gen;
+    gen.setSamplingRadius(r, r, r);
+    RunGenerator(state, gen, MakeSamples(VOLUME_SIZE, true));
+}
+BENCHMARK(BM_CuboidGeneratorAligned)->Arg(2)->Arg(4);
+
+void BM_CuboidGeneratorOblique(benchmark::State& state)
+{
+    auto r = static_cast<double>(state.range(0));
+    CuboidGenerator gen;
+    gen.setSamplingRadius(r, r, r);
+    RunGenerator(state, gen, MakeSamples(VOLUME_SIZE, false));
+}
+BENCHMARK(BM_CuboidGeneratorOblique)->Arg(2)->Arg(4);
+}  // namespace
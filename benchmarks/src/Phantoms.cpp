@@ -0,0 +1,315 @@
+#include "vc/benchmarks/Phantoms.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <opencv2/imgproc.hpp>
+
+#include "vc/core/shapes/Arch.hpp"
+#include "vc/core/shapes/Plane.hpp"
+#include "vc/core/shapes/Sphere.hpp"
+#include "vc/core/shapes/Spiral.hpp"
+#include "vc/texturing/AngleBasedFlattening.hpp"
+#include "vc/texturing/PPMGenerator.hpp"
+
+using namespace volcart;
+using namespace volcart::benchmarks;
+namespace fs = volcart::filesystem;
+
+namespace
+{
+// Intensities of the phantom sheet and background
+constexpr double SHEET_VALUE{30000};
+constexpr double BACKGROUND_VALUE{4000};
+constexpr double NOISE_SIGMA{500};
+// Empty border around the shape, in voxels
+constexpr double MARGIN{4};
+
+using Key = std::pair<PhantomShape, int>;
+
+// Generated phantoms and the temporary directory which holds them. Removes
+// the directory when the program exits.
+struct PhantomCache {
+    PhantomCache()
+    {
+        auto stamp =
+            std::chrono::steady_clock::now().time_since_epoch().count();
+        dir = fs::temp_directory_path() /
+              ("vc_benchmarks_" + std::to_string(stamp));
+        fs::create_directories(dir);
+    }
+
+    ~PhantomCache()
+    {
+        ppms.clear();
+        uvMaps.clear();
+        phantoms.clear();
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    PhantomCache(const PhantomCache&) = delete;
+    auto operator=(const PhantomCache&) -> PhantomCache& = delete;
+
+    fs::path dir;
+    std::map<Key, Phantom> phantoms;
+    std::map<Key, UVMap::Pointer> uvMaps;
+    std::map<Key, PerPixelMap::Pointer> ppms;
+};
+
+auto Cache() -> PhantomCache&
+{
+    static PhantomCache cache;
+    return cache;
+}
+
+auto ShapeMesh(PhantomShape shape) -> ITKMesh::Pointer
+{
+    switch (shape) {
+        case PhantomShape::Spiral:
+            return shapes::Spiral(600, 100, 200, 50).itkMesh();
+        case PhantomShape::Arch:
+            return shapes::Arch(100, 100).itkMesh();
+        case PhantomShape::Plane:
+            return shapes::Plane(100, 100).itkMesh();
+        case PhantomShape::Sphere:
+            return shapes::Sphere(50, 3).itkMesh();
+    }
+    throw std::invalid_argument("Unknown phantom shape");
+}
+
+// Uniformly scale and translate the mesh to fill a cube of the given size
+void FitMesh(const ITKMesh::Pointer& mesh, int size)
+{
+    cv::Vec3d min{DBL_MAX, DBL_MAX, DBL_MAX};
+    cv::Vec3d max{-DBL_MAX, -DBL_MAX, -DBL_MAX};
+    for (auto pt = mesh->GetPoints()->Begin(); pt != mesh->GetPoints()->End();
+         ++pt) {
+        for (int i = 0; i < 3; i++) {
+            min[i] = std::min(min[i], pt->Value()[i]);
+            max[i] = std::max(max[i], pt->Value()[i]);
+        }
+    }
+
+    auto extent = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2]});
+    auto scale = (size - 1 - 2 * MARGIN) / extent;
+    auto center = 0.5 * (min + max);
+    for (auto pt = mesh->GetPoints()->Begin(); pt != mesh->GetPoints()->End();
+         ++pt) {
+        for (int i = 0; i < 3; i++) {
+            pt->Value()[i] =
+                (pt->Value()[i] - center[i]) * scale + 0.5 * (size - 1);
+        }
+    }
+}
+
+// Mark every voxel the mesh surface passes through
+auto Rasterize(const ITKMesh::Pointer& mesh, int size)
+    -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> occupied(
+        static_cast<std::size_t>(size) * size * size, 0);
+    for (auto cell = mesh->GetCells()->Begin(); cell != mesh->GetCells()->End();
+         ++cell) {
+        const auto& ids = cell->Value()->GetPointIdsContainer();
+        auto a = mesh->GetPoint(ids[0]);
+        auto b = mesh->GetPoint(ids[1]);
+        auto c = mesh->GetPoint(ids[2]);
+        cv::Vec3d ab{b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        cv::Vec3d ac{c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+
+        // Sample the face at half-voxel spacing
+        auto len = std::max({cv::norm(ab), cv::norm(ac), cv::norm(ac - ab)});
+        auto steps = static_cast<int>(std::ceil(2 * len)) + 1;
+        auto step = 1.0 / steps;
+        for (int i = 0; i <= steps; i++) {
+            for (int j = 0; i + j <= steps; j++) {
+                auto p = cv::Vec3d{a[0], a[1], a[2]} + ab * (i * step) +
+                         ac * (j * step);
+                auto x = cvRound(p[0]);
+                auto y = cvRound(p[1]);
+                auto z = cvRound(p[2]);
+                if (x < 0 or y < 0 or z < 0 or x >= size or y >= size or
+                    z >= size) {
+                    continue;
+                }
+                auto idx = (static_cast<std::size_t>(z) * size + y) * size + x;
+                occupied[idx] = 1;
+            }
+        }
+    }
+    return occupied;
+}
+
+// Render the phantom slices into a new volume
+void WriteVolume(
+    const Volume::Pointer& volume,
+    std::vector<std::uint8_t>& occupied,
+    int size)
+{
+    volume->setSliceWidth(size);
+    volume->setSliceHeight(size);
+    volume->setNumberOfSlices(size);
+    volume->setVoxelSize(1);
+    volume->setMin(0);
+    volume->setMax(65535);
+    volume->saveMetadata();
+
+    const auto sliceVoxels = static_cast<std::size_t>(size) * size;
+    auto layer = [&](int z) {
+        return cv::Mat(size, size, CV_8UC1, occupied.data() + z * sliceVoxels);
+    };
+    const auto kernel = cv::getStructuringElement(cv::MORPH_RECT, {3, 3});
+    for (int z = 0; z < size; z++) {
+        // Thicken the sheet by one voxel in every direction
+        cv::Mat sheet = layer(z).clone();
+        if (z > 0) {
+            sheet |= layer(z - 1);
+        }
+        if (z + 1 < size) {
+            sheet |= layer(z + 1);
+        }
+        cv::dilate(sheet, sheet, kernel);
+
+        // Intensities with a little noise and blur
+        cv::Mat slice(size, size, CV_32FC1);
+        slice.setTo(BACKGROUND_VALUE);
+        slice.setTo(SHEET_VALUE, sheet);
+        cv::Mat noise(size, size, CV_32FC1);
+        cv::RNG rng(z + 1);
+        rng.fill(noise, cv::RNG::NORMAL, 0, NOISE_SIGMA);
+        slice += noise;
+        cv::GaussianBlur(slice, slice, {5, 5}, 1);
+
+        cv::Mat out;
+        slice.convertTo(out, CV_16UC1);
+        volume->setSliceData(z, out);
+    }
+}
+}  // namespace
+
+auto benchmarks::ShapeName(PhantomShape shape) -> std::string
+{
+    switch (shape) {
+        case PhantomShape::Spiral:
+            return "Spiral";
+        case PhantomShape::Arch:
+            return "Arch";
+        case PhantomShape::Plane:
+            return "Plane";
+        case PhantomShape::Sphere:
+            return "Sphere";
+    }
+    throw std::invalid_argument("Unknown phantom shape");
+}
+
+auto benchmarks::GetPhantom(PhantomShape shape, int size) -> const Phantom&
+{
+    auto& cache = Cache();
+    auto it = cache.phantoms.find({shape, size});
+    if (it != cache.phantoms.end()) {
+        return it->second;
+    }
+
+    Phantom phantom;
+    auto name = ShapeName(shape) + "_" + std::to_string(size);
+    phantom.volpkg = VolumePkg::New(
+        cache.dir / (name + ".volpkg"), VOLPKG_VERSION_LATEST);
+    phantom.volpkg->setMetadata("name", name);
+    phantom.volpkg->setMetadata("materialthickness", 5.0);
+    phantom.volpkg->saveMetadata();
+
+    phantom.mesh = ShapeMesh(shape);
+    FitMesh(phantom.mesh, size);
+    phantom.volume = phantom.volpkg->newVolume(name);
+    auto occupied = Rasterize(phantom.mesh, size);
+    WriteVolume(phantom.volume, occupied, size);
+
+    return cache.phantoms.emplace(Key{shape, size}, std::move(phantom))
+        .first->second;
+}
+
+auto benchmarks::GetPhantomUVMap(PhantomShape shape, int size)
+    -> UVMap::Pointer
+{
+    if (shape == PhantomShape::Sphere) {
+        throw std::invalid_argument("Cannot flatten a closed phantom");
+    }
+
+    auto& cache = Cache();
+    auto& uv = cache.uvMaps[{shape, size}];
+    if (not uv) {
+        texturing::AngleBasedFlattening abf(GetPhantom(shape, size).mesh);
+        abf.setUseABF(false);
+        abf.compute();
+        uv = abf.getUVMap();
+    }
+    return uv;
+}
+
+auto benchmarks::GetPhantomPPM(PhantomShape shape, int size)
+    -> PerPixelMap::Pointer
+{
+    auto& cache = Cache();
+    auto& ppm = cache.ppms[{shape, size}];
+    if (not ppm) {
+        auto uv = GetPhantomUVMap(shape, size);
+        auto width = static_cast<std::size_t>(size);
+        auto height =
+            static_cast<std::size_t>(std::ceil(width / uv->ratio().aspect));
+        texturing::PPMGenerator gen;
+        gen.setDimensions(height, width);
+        gen.setMesh(GetPhantom(shape, size).mesh);
+        gen.setUVMap(uv);
+        ppm = gen.compute();
+    }
+    return ppm;
+}
+
+auto benchmarks::MakeGridMesh(std::size_t numFaces) -> ITKMesh::Pointer
+{
+    auto side = static_cast<std::size_t>(std::sqrt(numFaces / 2.0)) + 1;
+    auto mesh = ITKMesh::New();
+    ITKMesh::PointIdentifier pid{0};
+    for (std::size_t y = 0; y < side; y++) {
+        for (std::size_t x = 0; x < side; x++) {
+            ITKPoint p;
+            p[0] = 0.37 * x;
+            p[1] = 0.37 * y;
+            p[2] = 5.0 * std::sin(0.01 * x) * std::cos(0.013 * y);
+            mesh->SetPoint(pid, p);
+            ITKPixel n;
+            n[0] = 0;
+            n[1] = 0;
+            n[2] = 1;
+            mesh->SetPointData(pid++, n);
+        }
+    }
+
+    ITKMesh::CellIdentifier cid{0};
+    ITKCell::CellAutoPointer cell;
+    auto addFace = [&](std::size_t a, std::size_t b, std::size_t c) {
+        cell.TakeOwnership(new ITKTriangle);
+        cell->SetPointId(0, a);
+        cell->SetPointId(1, b);
+        cell->SetPointId(2, c);
+        mesh->SetCell(cid++, cell);
+    };
+    for (std::size_t y = 0; y + 1 < side; y++) {
+        for (std::size_t x = 0; x + 1 < side; x++) {
+            auto v0 = y * side + x;
+            addFace(v0, v0 + 1, v0 + side);
+            addFace(v0 + 1, v0 + side + 1, v0 + side);
+        }
+    }
+    return mesh;
+}
+
+auto benchmarks::TempDir() -> const fs::path& { return Cache().dir; }
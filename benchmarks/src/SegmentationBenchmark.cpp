@@ -0,0 +1,83 @@
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "vc/segmentation/tff/Skeletonize.hpp"
+
+using namespace volcart::segmentation;
+
+namespace
+{
+constexpr std::size_t SPUR_LENGTH{6};
+
+// Synthetic scroll cross-section: a thick Archimedean spiral with some
+// roughness along its edges
+auto MakeScrollPhantom(int size, int turns, int thickness) -> cv::Mat
+{
+    cv::Mat mask = cv::Mat::zeros(size, size, CV_8UC1);
+    auto center = size / 2.0;
+    auto spacing = center / (turns + 1);
+    std::vector<cv::Point> pts;
+    for (double t = 0; t < turns * 2 * CV_PI; t += 0.01) {
+        auto r = spacing * (1 + t / (2 * CV_PI));
+        pts.emplace_back(center + r * std::cos(t), center + r * std::sin(t));
+    }
+    cv::polylines(mask, pts, false, cv::Scalar::all(255), thickness);
+
+    cv::RNG rng(0xC0FFEE);
+    for (std::size_t i = 0; i < pts.size(); i += 25) {
+        auto offset = cv::Point(
+            rng.uniform(-thickness, thickness),
+            rng.uniform(-thickness, thickness));
+        cv::circle(
+            mask, pts[i] + offset, thickness / 3, cv::Scalar::all(255),
+            cv::FILLED);
+    }
+    return mask;
+}
+
+// Reference: sparse voxel set
+void BM_SkeletonizeVoxelSet(benchmark::State& state)
+{
+    auto mask = MakeScrollPhantom(static_cast<int>(state.range(0)), 8, 9);
+    std::vector<cv::Point> pts;
+    cv::findNonZero(mask, pts);
+    for (auto _ : state) {
+        VoxelSet skeleton;
+        for (const auto& p : pts) {
+            skeleton.emplace(p.x, p.y, 0);
+        }
+        skeleton = ThinMask(skeleton);
+        skeleton = PruneSpurs(skeleton, SPUR_LENGTH);
+        benchmark::DoNotOptimize(skeleton.size());
+    }
+    state.SetItemsProcessed(state.iterations() * pts.size());
+}
+BENCHMARK(BM_SkeletonizeVoxelSet)
+    ->Arg(512)
+    ->Arg(1024)
+    ->Arg(2048)
+    ->Unit(benchmark::kMillisecond);
+
+// Dense, row-parallel bitmap
+void BM_SkeletonizeBitmap(benchmark::State& state)
+{
+    auto mask = MakeScrollPhantom(static_cast<int>(state.range(0)), 8, 9);
+    for (auto _ : state) {
+        auto bitmap = MakeSkeletonBitmap(mask);
+        ThinMask(bitmap);
+        PruneSpurs(bitmap, SPUR_LENGTH);
+        benchmark::DoNotOptimize(SkeletonBitmapToVoxels(bitmap, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * cv::countNonZero(mask));
+}
+BENCHMARK(BM_SkeletonizeBitmap)
+    ->Arg(512)
+    ->Arg(1024)
+    ->Arg(2048)
+    ->Unit(benchmark::kMillisecond);
+}  // namespace
@@ -0,0 +1,151 @@
+#include <cmath>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "vc/benchmarks/Phantoms.hpp"
+#include "vc/core/neighborhood/LineGenerator.hpp"
+#include "vc/core/types/VolumetricMask.hpp"
+#include "vc/texturing/CompositeTexture.hpp"
+#include "vc/texturing/IntegralTexture.hpp"
+#include "vc/texturing/IntersectionTexture.hpp"
+#include "vc/texturing/LayerTexture.hpp"
+#include "vc/texturing/PPMGenerator.hpp"
+#include "vc/texturing/ThicknessTexture.hpp"
+
+using namespace volcart;
+using namespace volcart::benchmarks;
+using namespace volcart::texturing;
+
+namespace
+{
+// Voxels brighter than this are inside the phantom sheet
+constexpr std::uint16_t MASK_THRESHOLD{17000};
+
+// Shapes which can be flattened, by volume size
+void ShapeArgs(benchmark::internal::Benchmark* b)
+{
+    b->ArgsProduct(
+        {{static_cast<int>(PhantomShape::Spiral),
+          static_cast<int>(PhantomShape::Arch),
+          static_cast<int>(PhantomShape::Plane)},
+         {64, 128}});
+    b->ArgNames({"shape", "size"});
+    b->Unit(benchmark::kMillisecond);
+}
+
+auto StateShape(const benchmark::State& state) -> PhantomShape
+{
+    return static_cast<PhantomShape>(state.range(0));
+}
+
+auto StateSize(const benchmark::State& state) -> int
+{
+    return static_cast<int>(state.range(1));
+}
+
+// Run a texturing algorithm on a phantom. The slice cache is cleared before
+// every run so that the timings include reading the volume.
+void RunTexturing(benchmark::State& state, TexturingAlgorithm& alg)
+{
+    const auto& phantom = GetPhantom(StateShape(state), StateSize(state));
+    auto ppm = GetPhantomPPM(StateShape(state), StateSize(state));
+    alg.setVolume(phantom.volume);
+    alg.setPerPixelMap(ppm);
+    for (auto _ : state) {
+        state.PauseTiming();
+        phantom.volume->cachePurge();
+        state.ResumeTiming();
+        auto texture = alg.compute();
+        benchmark::DoNotOptimize(texture.data());
+    }
+    state.SetLabel(ShapeName(StateShape(state)));
+    state.SetItemsProcessed(state.iterations() * ppm->numMappings());
+}
+
+// Mask of the voxels in the phantom sheet
+auto PhantomMask(const Volume::Pointer& volume) -> VolumetricMask::Pointer
+{
+    auto mask = VolumetricMask::New();
+    for (int z = 0; z < volume->numSlices(); z++) {
+        auto slice = volume->getSliceData(z);
+        for (int y = 0; y < slice.rows; y++) {
+            for (int x = 0; x < slice.cols; x++) {
+                if (slice.at<std::uint16_t>(y, x) > MASK_THRESHOLD) {
+                    mask->setIn({x, y, z});
+                }
+            }
+        }
+    }
+    return mask;
+}
+
+void BM_PPMGenerator(benchmark::State& state)
+{
+    const auto& phantom = GetPhantom(StateShape(state), StateSize(state));
+    auto uv = GetPhantomUVMap(StateShape(state), StateSize(state));
+    auto width = static_cast<std::size_t>(StateSize(state));
+    auto height =
+        static_cast<std::size_t>(std::ceil(width / uv->ratio().aspect));
+    for (auto _ : state) {
+        PPMGenerator gen;
+        gen.setDimensions(height, width);
+        gen.setMesh(phantom.mesh);
+        gen.setUVMap(uv);
+        benchmark::DoNotOptimize(gen.compute());
+    }
+    state.SetLabel(ShapeName(StateShape(state)));
+    state.SetItemsProcessed(state.iterations() * width * height);
+}
+BENCHMARK(BM_PPMGenerator)->Apply(ShapeArgs);
+
+void BM_CompositeTexture(benchmark::State& state)
+{
+    auto gen = LineGenerator::New();
+    gen->setSamplingRadius(3);
+    CompositeTexture alg;
+    alg.setGenerator(gen);
+    alg.setFilter(CompositeTexture::Filter::Maximum);
+    RunTexturing(state, alg);
+}
+BENCHMARK(BM_CompositeTexture)->Apply(ShapeArgs);
+
+void BM_IntegralTexture(benchmark::State& state)
+{
+    auto gen = LineGenerator::New();
+    gen->setSamplingRadius(3);
+    IntegralTexture alg;
+    alg.setGenerator(gen);
+    alg.setWeightMethod(IntegralTexture::WeightMethod::ExpoDiff);
+    alg.setExponentialDiffBaseMethod(IntegralTexture::ExpoDiffBaseMethod::Mode);
+    RunTexturing(state, alg);
+}
+BENCHMARK(BM_IntegralTexture)->Apply(ShapeArgs);
+
+void BM_IntersectionTexture(benchmark::State& state)
+{
+    IntersectionTexture alg;
+    RunTexturing(state, alg);
+}
+BENCHMARK(BM_IntersectionTexture)->Apply(ShapeArgs);
+
+void BM_LayerTexture(benchmark::State& state)
+{
+    auto gen = LineGenerator::New();
+    gen->setSamplingRadius(3);
+    LayerTexture alg;
+    alg.setGenerator(gen);
+    RunTexturing(state, alg);
+}
+BENCHMARK(BM_LayerTexture)->Apply(ShapeArgs);
+
+void BM_ThicknessTexture(benchmark::State& state)
+{
+    const auto& phantom = GetPhantom(StateShape(state), StateSize(state));
+    ThicknessTexture alg;
+    alg.setVolumetricMask(PhantomMask(phantom.volume));
+    alg.setSamplingInterval(0.5);
+    RunTexturing(state, alg);
+}
+BENCHMARK(BM_ThicknessTexture)->Apply(ShapeArgs);
+}  // namespace
@@ -0,0 +1,130 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <opencv2/core.hpp>
+
+#include "vc/benchmarks/Phantoms.hpp"
+
+using namespace volcart;
+using namespace volcart::benchmarks;
+
+namespace
+{
+constexpr std::size_t NUM_POINTS{1 << 16};
+
+// Reproducible random positions inside a volume
+auto RandomPoints(int size, std::size_t count) -> std::vector<cv::Vec3d>
+{
+    cv::RNG rng(0xC0FFEE);
+    std::vector<cv::Vec3d> points(count);
+    for (auto& p : points) {
+        p = {
+            rng.uniform(0.0, size - 1.0), rng.uniform(0.0, size - 1.0),
+            rng.uniform(0.0, size - 1.0)};
+    }
+    return points;
+}
+
+// Get a phantom volume with every slice in the cache
+auto CachedVolume(int size) -> Volume::Pointer
+{
+    auto volume = GetPhantom(PhantomShape::Spiral, size).volume;
+    volume->setCacheCapacity(volume->numSlices());
+    for (int z = 0; z < volume->numSlices(); z++) {
+        volume->getSliceData(z);
+    }
+    return volume;
+}
+
+void BM_InterpolateAt(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto volume = CachedVolume(size);
+    auto points = RandomPoints(size, NUM_POINTS);
+    for (auto _ : state) {
+        for (const auto& p : points) {
+            benchmark::DoNotOptimize(volume->interpolateAt(p));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_InterpolateAt)->Arg(64)->Arg(128)->Arg(256);
+
+void BM_InterpolateAtBatch(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto volume = CachedVolume(size);
+    auto points = RandomPoints(size, NUM_POINTS);
+    std::vector<std::uint16_t> values(points.size());
+    for (auto _ : state) {
+        volume->interpolateAt(points.data(), points.size(), values.data());
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_InterpolateAtBatch)->Arg(64)->Arg(128)->Arg(256);
+
+void BM_Reslice(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto volume = CachedVolume(size);
+    const cv::Vec3d center{size / 2.0, size / 2.0, size / 2.0};
+    const auto xvec = cv::normalize(cv::Vec3d{1, 1, 0});
+    const auto yvec = cv::normalize(cv::Vec3d{-1, 1, 1});
+    for (auto _ : state) {
+        auto r = volume->reslice(center, xvec, yvec, size, size);
+        benchmark::DoNotOptimize(r.sliceData().data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_Reslice)->Arg(64)->Arg(128)->Arg(256);
+
+void BM_SliceCacheHit(benchmark::State& state)
+{
+    auto volume = CachedVolume(static_cast<int>(state.range(0)));
+    int z{0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(volume->getSliceData(z).data);
+        z = (z + 1) % volume->numSlices();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SliceCacheHit)->Arg(64)->Arg(256);
+
+void BM_SliceCacheMiss(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto volume = GetPhantom(PhantomShape::Spiral, size).volume;
+    int z{0};
+    for (auto _ : state) {
+        state.PauseTiming();
+        volume->cachePurge();
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(volume->getSliceData(z).data);
+        z = (z + 1) % volume->numSlices();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(
+        state.iterations() * size * size * sizeof(std::uint16_t));
+}
+BENCHMARK(BM_SliceCacheMiss)->Arg(64)->Arg(256);
+
+void BM_VoxelBlock(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto volume = CachedVolume(size);
+    const cv::Vec3i blockSize{32, 32, 32};
+    std::vector<std::uint16_t> block(32 * 32 * 32);
+    auto origins = RandomPoints(size - 32, 64);
+    for (auto _ : state) {
+        for (const auto& o : origins) {
+            volume->getVoxelBlock(cv::Vec3i(o), blockSize, block.data());
+            benchmark::DoNotOptimize(block.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * origins.size());
+}
+BENCHMARK(BM_VoxelBlock)->Arg(64)->Arg(256);
+}  // namespace
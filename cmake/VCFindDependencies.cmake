@@ -110,6 +110,24 @@ if(VC_BUILD_TESTS)
     endif()
 endif()
 
+### Google Benchmark ###
+if(VC_BUILD_BENCHMARKS)
+    FetchContent_Declare(
+        googlebenchmark
+        GIT_REPOSITORY https://github.com/google/benchmark.git
+        GIT_TAG        v1.8.3
+    )
+
+    FetchContent_GetProperties(googlebenchmark)
+    if(NOT googlebenchmark_POPULATED)
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL OFF FORCE)
+        set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL OFF FORCE)
+        set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL OFF FORCE)
+        FetchContent_Populate(googlebenchmark)
+        add_subdirectory(${googlebenchmark_SOURCE_DIR} ${googlebenchmark_BINARY_DIR} EXCLUDE_FROM_ALL)
+    endif()
+endif()
+
 # Python bindings
 if(VC_BUILD_PYTHON_BINDINGS)
     find_package(pybind11 REQUIRED)
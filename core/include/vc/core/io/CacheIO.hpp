@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * @file
+ *
+ * @brief Binary cache formats for intermediate results
+ *
+ * Compact binary serialization for the mesh, UV map, and per-pixel map
+ * results cached by render graph nodes. Cache files are memory mapped when
+ * loaded and are validated against a format version and payload checksum.
+ * Values are stored in native byte order, so cache files are not portable
+ * between machines with different endianness.
+ *
+ * @ingroup IO
+ */
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/io/MeshIO.hpp"
+#include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/core/types/UVMap.hpp"
+
+namespace volcart::io
+{
+/**
+ * @brief Write a mesh to the binary mesh cache format (.vcmesh)
+ *
+ * Only triangular faces are supported. If provided, the UV map and texture
+ * image are stored in the same file.
+ *
+ * @throws volcart::IOException
+ */
+void WriteMeshCache(
+    const filesystem::path& path,
+    const ITKMesh::Pointer& mesh,
+    const UVMap::Pointer& uv = nullptr,
+    const cv::Mat& texture = cv::Mat());
+
+/**
+ * @brief Read a mesh from the binary mesh cache format (.vcmesh)
+ *
+ * @throws volcart::IOException If the file is not a mesh cache, was written
+ * by a different format version, or fails the checksum
+ */
+auto ReadMeshCache(const filesystem::path& path) -> MeshReaderResult;
+
+/**
+ * @brief Write a UVMap to the binary UV map cache format (.vcuv)
+ *
+ * @throws volcart::IOException
+ */
+void WriteUVMapCache(const filesystem::path& path, const UVMap& uvMap);
+
+/**
+ * @brief Read a UVMap from the binary UV map cache format (.vcuv)
+ *
+ * Files with the .uvm extension are read with ReadUVMap() so that caches
+ * written in the older archival format can still be loaded.
+ *
+ * @throws volcart::IOException If the file is not a UV map cache, was written
+ * by a different format version, or fails the checksum
+ */
+auto ReadUVMapCache(const filesystem::path& path) -> UVMap;
+
+/**
+ * @brief Write a PerPixelMap to the binary PPM cache format (.vcppm)
+ *
+ * The pixel mask and cell map are stored in the same file.
+ *
+ * @throws volcart::IOException
+ */
+void WritePPMCache(const filesystem::path& path, const PerPixelMap& ppm);
+
+/**
+ * @brief Read a PerPixelMap from the binary PPM cache format (.vcppm)
+ *
+ * Files with the .ppm extension are read with PerPixelMap::ReadPPM() so that
+ * caches written in the older archival format can still be loaded.
+ *
+ * @throws volcart::IOException If the file is not a PPM cache, was written
+ * by a different format version, or fails the checksum
+ */
+auto ReadPPMCache(const filesystem::path& path) -> PerPixelMap;
+}  // namespace volcart::io
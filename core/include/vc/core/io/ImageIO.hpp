@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
@@ -45,51 +47,33 @@ struct WriteImageOpts {
 void WriteImage(
     const filesystem::path& path, const cv::Mat& img, WriteImageOpts = {});
 
+/**
+ * @brief Get the file paths of an image sequence
+ *
+ * Replaces `{}` in the stem of `path` with the index of each image. If `path`
+ * is a directory, the images are named `path/###.tif`. Indices are
+ * zero-padded to the number of digits in `count` unless `padding` is set.
+ */
+auto ImageSequencePaths(
+    const filesystem::path& path,
+    std::size_t count,
+    std::optional<int> padding = std::nullopt)
+    -> std::vector<filesystem::path>;
+
+/**
+ * @brief Write images to the file paths given by ImageSequencePaths()
+ *
+ * @throws volcart::IOException
+ */
 template <class Iterable>
 void WriteImageSequence(
     const filesystem::path& path,
     const Iterable& iterable,
     const WriteImageOpts& opts = {})
 {
-    namespace fs = volcart::filesystem;
-
-    // components
-    fs::path parent;
-    std::string prefix;
-    std::string suffix;
-    fs::path ext;
-
-    // If directory, default to dir/###.tif
-    if (fs::is_directory(path)) {
-        parent = path;
-        ext = ".tif";
-    }
-
-    // If path, decompose to replace {} with a number
-    else {
-        parent = path.parent_path();
-        ext = path.extension();
-
-        // Split into a prefix and suffix
-        auto stem = path.stem().string();
-        std::tie(prefix, std::ignore, suffix) = partition(stem, "{}");
-
-        // Log when separator not found
-        if (suffix.empty()) {
-            Logger()->debug(
-                "Index placement separator \\{\\} not found in stem: {}", stem);
-        }
-    }
-
-    // Setup padding (default or user-provided)
-    auto pad = std::to_string(std::size(iterable)).size();
-    pad = opts.padding.value_or(pad);
-
-    // Write images
+    auto paths = ImageSequencePaths(path, std::size(iterable), opts.padding);
     for (const auto [i, image] : enumerate(iterable)) {
-        const auto name = prefix + to_padded_string(i, pad) + suffix;
-        auto filepath = (parent / name).replace_extension(ext);
-        WriteImage(filepath, image, opts);
+        WriteImage(paths[i], image, opts);
     }
 }
 
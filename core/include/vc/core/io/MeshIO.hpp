@@ -26,7 +26,8 @@ struct MeshReaderResult {
  * @brief Read a mesh from a file
  *
  * Uses the file extension to determine which mesh reader is used (e.g.
- * OBJReader, PLYReader, etc.).
+ * OBJReader, PLYReader, etc.). Files with the .vcmesh extension are read with
+ * io::ReadMeshCache().
  *
  * @param path Input file path
  */
@@ -41,7 +42,8 @@ struct MeshWriterOpts {
  * @brief Write a mesh to a file
  *
  * Uses the provided file extension to determine which mesh writer is used
- * (e.g. OBJWriter, PLYWriter, etc.).
+ * (e.g. OBJWriter, PLYWriter, etc.). Files with the .vcmesh extension are
+ * written with io::WriteMeshCache().
  *
  * @param path Output file path
  * @param mesh Mesh to write
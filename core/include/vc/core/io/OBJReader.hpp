@@ -3,6 +3,8 @@
 /** @file */
 
 #include <fstream>
+#include <string_view>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
@@ -21,7 +23,8 @@ namespace volcart::io
  * @brief Read an OBJ file into a volcart::ITKMesh
  *
  * Supports image mapped meshes. Image path is parsed from the OBJ's mtl
- * include. Other material properties are currently ignored. Throws
+ * include. Other material properties are currently ignored. Negative face
+ * references are relative to the elements parsed before the face. Throws
  * volcart::IOException on error.
  *
  * @ingroup IO
@@ -84,17 +87,17 @@ private:
     /** Parse the mesh */
     void parse_();
     /** Handle parsed vertex lines */
-    void parse_vertex_(const std::vector<std::string>& strs);
+    void parse_vertex_(const std::vector<std::string_view>& strs);
     /** Handle parsed vertex normal lines */
-    void parse_normal_(const std::vector<std::string>& strs);
+    void parse_normal_(const std::vector<std::string_view>& strs);
     /** Handle parsed vertex UV coordinate lines */
-    void parse_tcoord_(const std::vector<std::string>& strs);
+    void parse_tcoord_(const std::vector<std::string_view>& strs);
     /** Handle parsed face lines */
-    void parse_face_(const std::vector<std::string>& strs);
+    void parse_face_(const std::vector<std::string_view>& strs);
     /** Handle parsed mtllib lines */
-    void parse_mtllib_(const std::vector<std::string>& strs);
+    void parse_mtllib_(const std::vector<std::string_view>& strs);
     /** Classify a OBJReader::VertexRefs as an OBJReader::RefType */
-    auto classify_vertref_(const std::string& ref) -> RefType;
+    auto classify_vertref_(std::string_view ref) -> RefType;
 
     /** Construct a mesh from the parsed information */
     void build_mesh_();
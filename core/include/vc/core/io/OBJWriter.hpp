@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
@@ -95,13 +97,15 @@ private:
      * Keeps track of what info we have about each point in the mesh. Used for
      * building OBJ faces.
      *
-     * [ Point Index, {v, vt, vn} ]
+     * pointLinks_[Point Index] = {v, vt, vn}
      *
      * v = vertex index number \n
      * vt = UV coordinate index number \n
      * vn = vertex normal index number \n
      */
-    std::map<std::uint32_t, cv::Vec3i> pointLinks_;
+    std::vector<cv::Vec3i> pointLinks_;
+    /** Output buffer, written to outputMesh_ in large blocks */
+    std::string buffer_;
 
     /** Input mesh */
     ITKMesh::Pointer mesh_;
@@ -125,6 +129,11 @@ private:
     void write_texture_coordinates_();
     /** Write the OBJ faces */
     void write_faces_();
+    /**
+     * Write the output buffer to outputMesh_. Only writes once the buffer is
+     * full unless `force` is true.
+     */
+    void flush_buffer_(bool force = false);
 };
 
 }  // namespace volcart::io
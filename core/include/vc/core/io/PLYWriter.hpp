@@ -4,6 +4,8 @@
 
 #include <cstdint>
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
@@ -20,9 +22,9 @@ namespace volcart::io
  *
  * @brief Write an ITKMesh to a PLY file
  *
- * Writes both textured and untextured meshes in ASCII PLY format. Texture
- * information is automatically written if the volcart::Texture has images
- * and if the UV map is set and is not empty.
+ * Writes both textured and untextured meshes in ASCII or binary little endian
+ * PLY format. Texture information is automatically written if the
+ * volcart::Texture has images and if the UV map is set and is not empty.
  *
  * Assumes that vertices have vertex normal information.
  *
@@ -31,6 +33,9 @@ namespace volcart::io
 class PLYWriter
 {
 public:
+    /** @brief PLY file encodings */
+    enum class Format { ASCII, BinaryLittleEndian };
+
     /**@{*/
     /** @brief Default constructor */
     PLYWriter() = default;
@@ -62,6 +67,14 @@ public:
 
     /** @brief Set per-vertex color information */
     void setVertexColors(const std::vector<std::uint16_t>& c);
+
+    /**
+     * @brief Set the file encoding
+     *
+     * Binary files are smaller and much faster to read and write than ASCII
+     * files. Default: Format::ASCII
+     */
+    void setFormat(Format format);
     /**@}*/
 
     /**@{*/
@@ -89,6 +102,17 @@ private:
     cv::Mat texture_;
     /** Vertex colors */
     std::vector<std::uint16_t> vcolors_;
+    /** File encoding */
+    Format format_{Format::ASCII};
+    /** Output buffer, written to outputMesh_ in large blocks */
+    std::string buffer_;
+
+    /**
+     * @brief Write the output buffer to the file
+     *
+     * Only writes once the buffer is full unless `force` is true.
+     */
+    void flush_buffer_(bool force = false);
 
     /** @brief Write the PLY header */
     void write_header_();
@@ -96,14 +120,14 @@ private:
     /**
      * @brief Write the PLY vertices
      *
-     * Lines are formatted:
+     * ASCII lines are formatted:
      *
      * `x y z nx ny nz`
      */
     void write_vertices_();
     /**@brief Write the PLY faces
      *
-     * Lines are formatted:
+     * ASCII lines are formatted:
      *
      * `[n vertices in face] v1 v2 ... vn`
      */
@@ -5,9 +5,12 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -15,6 +18,7 @@
 #include "vc/core/types/Exceptions.hpp"
 #include "vc/core/types/OrderedPointSet.hpp"
 #include "vc/core/types/PointSet.hpp"
+#include "vc/core/util/MemoryMappedFile.hpp"
 #include "vc/core/util/String.hpp"
 
 namespace volcart
@@ -26,6 +30,9 @@ namespace volcart
  */
 enum class IOMode { ASCII = 0, BINARY };
 
+template <typename T>
+class MappedPointSet;
+
 /**
  * @class PointSetIO
  * @author Sean Karlage
@@ -396,71 +403,21 @@ private:
     /** @brief Read a binary PointSet */
     static PointSet<T> ReadPointSetBinary(const volcart::filesystem::path& path)
     {
-        std::ifstream infile{path.string(), std::ios::binary};
-        if (!infile.is_open()) {
-            auto msg = "could not open file '" + path.string() + "'";
-            throw IOException(msg);
-        }
-        auto header = PointSetIO<T>::ParseHeader(infile, false);
-        PointSet<T> ps{header.size};
-
-        // Size of binary elements to read
-        std::size_t typeBytes{};
-        if (header.type == "float") {
-            typeBytes = sizeof(float);
-        } else if (header.type == "double") {
-            typeBytes = sizeof(double);
-        } else if (header.type == "int") {
-            typeBytes = sizeof(int);
-        }
-
-        // Read data
-        T t;
-        for (std::size_t i = 0; i < header.size; ++i) {
-            auto nbytes = header.dim * typeBytes;
-            infile.read(reinterpret_cast<char*>(t.val), nbytes);
-            ps.push_back(t);
-        }
-
-        return ps;
+        MappedPointSet<T> mapped(path);
+        return mapped.readPoints(0, mapped.size());
     }
 
     /** @brief Read a binary OrderedPointSet */
     static OrderedPointSet<T> ReadOrderedPointSetBinary(
         const volcart::filesystem::path& path)
     {
-        std::ifstream infile{path.string(), std::ios::binary};
-        if (!infile.is_open()) {
-            auto msg = "could not open file '" + path.string() + "'";
-            throw IOException(msg);
-        }
-        auto header = PointSetIO<T>::ParseHeader(infile, true);
-        OrderedPointSet<T> ps{header.width};
-
-        // Size of binary elements to read
-        std::size_t typeBytes = sizeof(int);
-        if (header.type == "float") {
-            typeBytes = sizeof(float);
-        } else if (header.type == "double") {
-            typeBytes = sizeof(double);
-        } else if (header.type == "int") {
-            typeBytes = sizeof(int);
-        } else {
-            auto msg = "Unrecognized type: " + header.type;
+        MappedPointSet<T> mapped(path);
+        if (!mapped.ordered()) {
+            const auto* msg =
+                "Tried to read unordered pointset with ordered PointSetIO";
             throw IOException(msg);
         }
-
-        // Read data
-        T t;
-        std::size_t nbytes = header.width * header.dim * typeBytes;
-        std::vector<T> points(header.width, 0);
-        points.reserve(header.width);
-        for (std::size_t h = 0; h < header.height; ++h) {
-            infile.read(reinterpret_cast<char*>(points.data()), nbytes);
-            ps.pushRow(points);
-        }
-
-        return ps;
+        return mapped.readRows(0, mapped.height());
     }
     /**@}*/
 
@@ -572,4 +529,186 @@ private:
     }
     /**@}*/
 };
+
+/**
+ * @class MappedPointSet
+ * @brief Memory-mapped reader for binary PointSet and OrderedPointSet files
+ *
+ * The file header is parsed once on construction and the point data is
+ * memory-mapped, so opening a file does not read its points. Individual
+ * points, rows, and ranges of points or rows are copied out of the mapping on
+ * request. This allows large point sets to be processed in pieces without
+ * loading the whole file into memory.
+ *
+ * Point data in the mapping is not guaranteed to be aligned for T, so values
+ * are always copied rather than referenced. Only binary files are supported.
+ * The reader is read-only and can be shared between threads.
+ *
+ * Example Usage:
+ * @code{.cpp}
+ * MappedPointSet<cv::Vec3d> mapped("segmentation.vcps");
+ * for (std::size_t i = 0; i < mapped.height(); i += 100) {
+ *     auto count = std::min<std::size_t>(100, mapped.height() - i);
+ *     auto rows = mapped.readRows(i, count);
+ *     // ...
+ * }
+ * @endcode
+ *
+ * @ingroup IO
+ *
+ * @see volcart::PointSetIO
+ */
+template <typename T>
+class MappedPointSet
+{
+public:
+    /** PointSet file header type */
+    using Header = typename PointSetIO<T>::Header;
+
+    /**
+     * @brief Open and map a binary PointSet or OrderedPointSet file
+     *
+     * @throws volcart::IOException If the file cannot be opened, its header
+     * is invalid, or the file is smaller than its header describes
+     */
+    explicit MappedPointSet(const volcart::filesystem::path& path)
+    {
+        // Parse the header and find where the point data starts
+        std::ifstream infile{path.string(), std::ios::binary};
+        if (!infile.is_open()) {
+            auto msg = "could not open file '" + path.string() + "'";
+            throw IOException(msg);
+        }
+        header_ = PointSetIO<T>::ParseHeader(infile, false);
+        auto offset = infile.tellg();
+        if (offset < 0) {
+            auto msg = "missing header terminator: '" + path.string() + "'";
+            throw IOException(msg);
+        }
+        offset_ = static_cast<std::size_t>(offset);
+        infile.close();
+
+        // Map the file and make sure it holds all of the points
+        file_ = std::make_shared<MemoryMappedFile>(path);
+        if (file_->size() < offset_ + header_.size * POINT_BYTES) {
+            auto msg = "file is smaller than expected: '" + path.string() + "'";
+            throw IOException(msg);
+        }
+    }
+
+    /** @brief Get the parsed file header */
+    const Header& header() const { return header_; }
+
+    /** @brief Whether the file holds an OrderedPointSet */
+    bool ordered() const { return header_.ordered; }
+
+    /** @brief Get the number of points in the file */
+    std::size_t size() const { return header_.size; }
+
+    /**
+     * @brief Get the number of points in a row
+     *
+     * Unordered point sets are treated as a single row.
+     */
+    std::size_t width() const
+    {
+        return header_.ordered ? header_.width : header_.size;
+    }
+
+    /**
+     * @brief Get the number of rows
+     *
+     * Unordered point sets are treated as a single row.
+     */
+    std::size_t height() const
+    {
+        return header_.ordered ? header_.height : std::size_t{1};
+    }
+
+    /**
+     * @brief Get a point by index
+     *
+     * Throws a std::range_error if `i` is outside the range of point indices.
+     */
+    T operator[](std::size_t i) const
+    {
+        if (i >= header_.size) {
+            throw std::range_error("out of range");
+        }
+        T t;
+        copy_points_(i, 1, &t);
+        return t;
+    }
+
+    /**
+     * @brief Get a row of points
+     *
+     * Throws a std::range_error if `i` is outside the range of row indices.
+     */
+    std::vector<T> row(std::size_t i) const
+    {
+        if (i >= height()) {
+            throw std::range_error("out of range");
+        }
+        std::vector<T> points(width());
+        copy_points_(i * width(), width(), points.data());
+        return points;
+    }
+
+    /**
+     * @brief Read `count` points starting at point `first`
+     *
+     * Throws a std::range_error if the range extends past the end of the
+     * file.
+     */
+    PointSet<T> readPoints(std::size_t first, std::size_t count) const
+    {
+        if (first > header_.size || count > header_.size - first) {
+            throw std::range_error("out of range");
+        }
+        PointSet<T> ps(count, T());
+        if (count > 0) {
+            copy_points_(first, count, &ps[0]);
+        }
+        return ps;
+    }
+
+    /**
+     * @brief Read `count` rows starting at row `first`
+     *
+     * Throws a std::range_error if the range extends past the last row.
+     */
+    OrderedPointSet<T> readRows(std::size_t first, std::size_t count) const
+    {
+        if (first > height() || count > height() - first) {
+            throw std::range_error("out of range");
+        }
+        OrderedPointSet<T> ps(width());
+        std::vector<T> points(width());
+        for (std::size_t r = first; r < first + count; r++) {
+            copy_points_(r * width(), width(), points.data());
+            ps.pushRow(points);
+        }
+        return ps;
+    }
+
+private:
+    /** Size of a single point in the file */
+    static constexpr std::size_t POINT_BYTES =
+        T::channels * sizeof(typename T::value_type);
+
+    /** Copy points [first, first + count) into contiguous storage */
+    void copy_points_(std::size_t first, std::size_t count, T* dst) const
+    {
+        const auto* src = file_->data() + offset_ + first * POINT_BYTES;
+        std::memcpy(dst->val, src, count * POINT_BYTES);
+    }
+
+    /** Parsed file header */
+    Header header_;
+    /** Byte offset of the first point */
+    std::size_t offset_{0};
+    /** Mapped file */
+    std::shared_ptr<MemoryMappedFile> file_;
+};
 }  // namespace volcart
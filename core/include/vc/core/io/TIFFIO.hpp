@@ -10,6 +10,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <vector>
+
 #include <opencv2/core.hpp>
 
 #include "vc/core/filesystem.hpp"
@@ -55,10 +59,11 @@ enum class Compression {
  * will be returned with a BGR channel order, except for 8-bit and 16-bit
  * signed integer types which will be returned with an RGB channel order.
  *
- * Only supports single image TIFF files with scanline encoding and a
- * contiguous planar configuration (this matches the format written by
- * WriteTIFF). Unless you need to read some obscure image type (e.g. 32-bit
- * float or signed integer images), it's generally preferable to use cv::imread.
+ * Only supports single image TIFF files with strip or tile encoding and a
+ * contiguous planar configuration (this matches the formats written by
+ * WriteTIFF and WriteTiledTIFF). Unless you need to read some obscure image
+ * type (e.g. 32-bit float or signed integer images), it's generally
+ * preferable to use cv::imread.
  *
  * If the raw size of the image (width x height x channels x bytes-per-sample)
  * is >= 4GB, the TIFF will be written using the BigTIFF extension to the TIFF
@@ -69,6 +74,26 @@ enum class Compression {
  */
 auto ReadTIFF(const volcart::filesystem::path& path) -> cv::Mat;
 
+/**
+ * @brief Read a region of a TIFF file
+ *
+ * Only the strips or tiles which overlap `roi` are decoded, and strips are
+ * only decoded as far as the last row of the region. For the single-strip
+ * images written by WriteTIFF, this avoids decoding the rows below the
+ * region. For images written by WriteTiledTIFF, only the overlapping tiles
+ * are read from disk.
+ *
+ * Supports the same image formats as ReadTIFF(const filesystem::path&). An
+ * empty `roi` reads the full image.
+ *
+ * @param path Path to TIFF file
+ * @param roi Region of the image to read. Must lie within the image bounds.
+ * @throws volcart::IOException Unrecoverable read errors or if `roi` is not
+ * within the image bounds
+ */
+auto ReadTIFF(const volcart::filesystem::path& path, const cv::Rect& roi)
+    -> cv::Mat;
+
 /**
  * @brief Write a TIFF image to file
  *
@@ -83,4 +108,138 @@ void WriteTIFF(
     const volcart::filesystem::path& path,
     const cv::Mat& img,
     Compression compression = Compression::LZW);
+
+/**
+ * @brief Write a tiled TIFF image to file
+ *
+ * Supports the same image types as WriteTIFF. The image is divided into tiles
+ * of `tileSize` which are compressed in parallel and written to the file in
+ * order. Edge tiles are padded with zeros. Tiled images allow ReadTIFF(const
+ * filesystem::path&, const cv::Rect&) to read small regions of large images
+ * efficiently.
+ *
+ * Tiles are compressed sequentially if `compression` is JPEG or OJPEG, since
+ * these schemes share encoding tables between tiles.
+ *
+ * @param path Output file path
+ * @param img Image to write
+ * @param compression Compression scheme
+ * @param tileSize Tile dimensions. Must be positive multiples of 16.
+ * @param numThreads Number of compression threads. If 0, uses
+ * ThreadPool::DefaultThreadCount().
+ * @throws volcart::IOException All writing errors
+ */
+void WriteTiledTIFF(
+    const volcart::filesystem::path& path,
+    const cv::Mat& img,
+    Compression compression = Compression::LZW,
+    const cv::Size& tileSize = {256, 256},
+    std::size_t numThreads = 0);
+
+/**
+ * @brief Incrementally write a tiled TIFF image
+ *
+ * Writes a tiled TIFF one row of tiles at a time, so that only a single row
+ * of tiles needs to be held in memory. This allows very large images to be
+ * written while they are being generated. Supports the same image types as
+ * WriteTIFF. Edge tiles are padded with zeros.
+ *
+ * A TiledTIFFWriter is not thread-safe, but separate writers may be used
+ * from different threads.
+ *
+ * @code{.cpp}
+ * TiledTIFFWriter writer("out.tif", {width, height}, CV_16UC1);
+ * for (int y = 0; y < height; y += writer.tileSize().height) {
+ *     cv::Mat rows = ...; // The next tileSize().height rows
+ *     writer.writeTileRow(rows);
+ * }
+ * writer.close();
+ * @endcode
+ */
+class TiledTIFFWriter
+{
+public:
+    /**
+     * @brief Open a file for writing
+     *
+     * @param path Output file path
+     * @param size Image dimensions
+     * @param type Image type (e.g. CV_16UC1)
+     * @param compression Compression scheme
+     * @param tileSize Tile dimensions. Must be positive multiples of 16.
+     * @throws volcart::IOException If the image type, compression scheme, or
+     * tile size are not supported or the file cannot be opened
+     */
+    TiledTIFFWriter(
+        const volcart::filesystem::path& path,
+        const cv::Size& size,
+        int type,
+        Compression compression = Compression::LZW,
+        const cv::Size& tileSize = {256, 256});
+
+    /**
+     * @brief Close the file
+     *
+     * If not all rows have been written, the file is closed and will be
+     * incomplete.
+     */
+    ~TiledTIFFWriter();
+
+    /** Not copyable */
+    TiledTIFFWriter(const TiledTIFFWriter&) = delete;
+    /** Not copyable */
+    auto operator=(const TiledTIFFWriter&) -> TiledTIFFWriter& = delete;
+
+    /** @brief Get the image dimensions */
+    [[nodiscard]] auto size() const -> cv::Size;
+
+    /** @brief Get the tile dimensions */
+    [[nodiscard]] auto tileSize() const -> cv::Size;
+
+    /** @brief Get the number of image rows which have been written */
+    [[nodiscard]] auto rowsWritten() const -> int;
+
+    /**
+     * @brief Write the next row of tiles
+     *
+     * `rows` must have the image width and type. It must have
+     * tileSize().height rows, except for the last row of tiles, which has the
+     * remaining image rows.
+     *
+     * @throws volcart::IOException If `rows` has the wrong size or type, or
+     * on writing errors
+     */
+    void writeTileRow(const cv::Mat& rows);
+
+    /**
+     * @brief Finish writing the file
+     *
+     * @throws volcart::IOException If not all rows have been written
+     */
+    void close();
+
+private:
+    struct Impl;
+    /** Writer state */
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Write tiled TIFF images as the pages of a multi-page TIFF
+ *
+ * The compressed tiles of each input image are copied into a page of the
+ * output file without being decoded, so this uses little memory regardless
+ * of the image size. The inputs do not need to have the same dimensions or
+ * type. The output is written using the BigTIFF extension if the inputs
+ * total at least 4GB.
+ *
+ * @param inputs Tiled TIFF images, such as those written by WriteTiledTIFF or
+ * TiledTIFFWriter, in page order
+ * @param path Output file path
+ * @throws volcart::IOException If an input is not tiled or uses JPEG
+ * compression, or on reading and writing errors
+ */
+void MergeTiledTIFFs(
+    const std::vector<volcart::filesystem::path>& inputs,
+    const volcart::filesystem::path& path);
 }  // namespace volcart::tiffio
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
@@ -86,6 +88,13 @@ StructureTensor ComputeSubvoxelStructureTensor(
     int radius = 1,
     int kernelSize = 3);
 
+/**
+ * @brief Compute the eigenvalues and eigenvectors of a structure tensor
+ *
+ * Eigenpairs are sorted by eigenvalue in descending order.
+ */
+EigenPairs ComputeEigenPairs(const StructureTensor& st);
+
 /**
  * @brief Compute the eigenvalues and eigenvectors from the structure tensor
  * for a voxel position
@@ -133,6 +142,9 @@ EigenPairs ComputeSubvoxelEigenPairs(
 
 /**
  * @brief Get an axis-aligned cuboid subvolume centered on a voxel
+ *
+ * The voxels are copied with Volume::getVoxelBlock().
+ *
  * @param center Center position of the subvolume
  * @param rx Radius of the subvolume X-axis
  * @param ry Radius of the subvolume Y-axis
@@ -146,14 +158,18 @@ Tensor3D<DType> ComputeVoxelNeighbors(
     std::int32_t ry,
     std::int32_t rz)
 {
-    Tensor3D<DType> v(2 * rx + 1, 2 * ry + 1, 2 * rz + 1);
-    for (std::int32_t k = center(2) - rz, c = 0; k <= center(2) + rz;
-         ++k, ++c) {
-        for (std::int32_t j = center(1) - ry, b = 0; j <= center(1) + ry;
-             ++j, ++b) {
-            for (std::int32_t i = center(0) - rx, a = 0; i <= center(0) + rx;
-                 ++i, ++a) {
-                v(a, b, c) = DType(volume->intensityAt(i, j, k));
+    const cv::Vec3i size{2 * rx + 1, 2 * ry + 1, 2 * rz + 1};
+    std::vector<std::uint16_t> buffer(
+        static_cast<std::size_t>(size[0]) * size[1] * size[2]);
+    volume->getVoxelBlock(center - cv::Vec3i{rx, ry, rz}, size, buffer.data());
+
+    Tensor3D<DType> v(size[0], size[1], size[2], false);
+    const auto* in = buffer.data();
+    for (int c = 0; c < size[2]; ++c) {
+        for (int b = 0; b < size[1]; ++b) {
+            auto* row = v.xySlice(c)[b];
+            for (int a = 0; a < size[0]; ++a) {
+                row[a] = DType(*in++);
             }
         }
     }
@@ -165,6 +181,11 @@ Tensor3D<DType> ComputeVoxelNeighbors(
  * @brief Get an axis-aligned cuboid subvolume centered on a subvoxel
  *
  * @copydetails getVoxelNeighbors()
+ *
+ * When the sampling axes are the volume axes (the default), the subvolume is
+ * sampled with Volume::interpolateBlock(). Otherwise, each sample is
+ * interpolated with Volume::interpolateAt(). In both cases, samples are
+ * rounded to the nearest integer intensity.
  */
 template <typename DType>
 Tensor3D<DType> ComputeSubvoxelNeighbors(
@@ -177,7 +198,29 @@ Tensor3D<DType> ComputeSubvoxelNeighbors(
     const cv::Vec3d& yvec = {0, 1, 0},
     const cv::Vec3d& zvec = {0, 0, 1})
 {
-    Tensor3D<DType> v(2 * rx + 1, 2 * ry + 1, 2 * rz + 1);
+    Tensor3D<DType> v(2 * rx + 1, 2 * ry + 1, 2 * rz + 1, false);
+
+    // Axis-aligned: sample the whole block at once
+    if (xvec == cv::Vec3d{1, 0, 0} && yvec == cv::Vec3d{0, 1, 0} &&
+        zvec == cv::Vec3d{0, 0, 1}) {
+        const cv::Vec3i size{2 * rx + 1, 2 * ry + 1, 2 * rz + 1};
+        std::vector<double> buffer(
+            static_cast<std::size_t>(size[0]) * size[1] * size[2]);
+        volume->interpolateBlock(
+            center - cv::Vec3d(rx, ry, rz), size, buffer.data());
+        const auto* in = buffer.data();
+        for (int c = 0; c < size[2]; ++c) {
+            for (int b = 0; b < size[1]; ++b) {
+                auto* row = v.xySlice(c)[b];
+                // Round like interpolateAt()
+                for (int a = 0; a < size[0]; ++a) {
+                    row[a] = DType(static_cast<std::uint16_t>(cvRound(*in++)));
+                }
+            }
+        }
+        return v;
+    }
+
     for (int c = 0; c < 2 * rz + 1; ++c) {
         for (int b = 0; b < 2 * ry + 1; ++b) {
             for (int a = 0; a < 2 * rx + 1; ++a) {
@@ -0,0 +1,109 @@
+/**
+ * @file
+ *
+ * @ingroup Math
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/math/StructureTensor.hpp"
+#include "vc/core/types/Volume.hpp"
+
+namespace volcart
+{
+/**
+ * @class StructureTensorField
+ * @brief Cached field of voxel structure tensors with subvoxel sampling
+ *
+ * Computes the structure tensor at integer voxel positions and stores them
+ * for reuse. Tensors are computed in cubic blocks of voxels the first time
+ * any voxel in a block is needed. Subvoxel positions are sampled by
+ * trilinearly interpolating the tensors of the eight surrounding voxels.
+ *
+ * Algorithms which repeatedly sample the same region of a volume, such as
+ * particle simulations, can use this in place of
+ * ComputeSubvoxelStructureTensor(), which computes a new tensor from the
+ * subvoxel neighborhood of every sample. At integer positions, the two
+ * produce the same tensor. At other positions, the interpolated tensor is a
+ * smoothed approximation.
+ *
+ * Sampling is thread-safe. Each block is computed once, by the first thread
+ * which needs it.
+ *
+ * @ingroup Math
+ */
+class StructureTensorField
+{
+public:
+    /** Edge length of a cached block of voxels */
+    static constexpr int BLOCK_SIZE{8};
+
+    /**
+     * @brief Constructor
+     *
+     * @param radius Radius of the structure tensor calculation
+     * @param kernelSize Size of the gradient kernel
+     *
+     * @see ComputeSubvoxelStructureTensor()
+     */
+    explicit StructureTensorField(
+        Volume::Pointer volume, int radius = 1, int kernelSize = 3);
+
+    /** @brief Get the structure tensor at a voxel position */
+    auto voxelAt(int x, int y, int z) -> StructureTensor;
+
+    /** @brief Get the interpolated structure tensor at a subvoxel position */
+    auto at(const cv::Vec3d& p) -> StructureTensor;
+
+    /**
+     * @brief Get the eigenpairs of the interpolated structure tensor at a
+     * subvoxel position
+     */
+    auto eigenPairsAt(const cv::Vec3d& p) -> EigenPairs;
+
+    /** @brief Get the number of cached blocks */
+    [[nodiscard]] auto numBlocks() const -> std::size_t;
+
+    /**
+     * @brief Remove all cached tensors
+     *
+     * Must not be called while other threads are sampling the field.
+     */
+    void clear();
+
+private:
+    /** Block of cached tensors */
+    struct Block {
+        /** Guards the computation of the tensors */
+        std::once_flag computed;
+        /** Tensors in x, y, z order */
+        std::vector<StructureTensor> tensors;
+    };
+
+    /** Get the block with the given block index, computing it if needed */
+    auto block_(const cv::Vec3i& idx) -> const Block&;
+
+    /** Compute the tensors of a block */
+    void compute_block_(const cv::Vec3i& idx, Block& block) const;
+
+    /** Input volume */
+    Volume::Pointer volume_;
+    /** Structure tensor radius */
+    int radius_;
+    /** Gradient kernel size */
+    int kernelSize_;
+    /** Cached blocks, keyed by packed block index */
+    std::unordered_map<std::uint64_t, std::unique_ptr<Block>> blocks_;
+    /** Guards blocks_ */
+    mutable std::mutex mutex_;
+};
+}  // namespace volcart
@@ -2,6 +2,9 @@
 
 /** @file */
 
+#include <array>
+#include <vector>
+
 #include "vc/core/neighborhood/NeighborhoodGenerator.hpp"
 
 namespace volcart
@@ -20,7 +23,7 @@ public:
 
     /**@{*/
     /** @brief Default Constructor */
-    CuboidGenerator() : NeighborhoodGenerator(3) {}
+    CuboidGenerator() : NeighborhoodGenerator(3) { update_offsets_(); }
 
     /** @overload CuboidGenerator() */
     static Pointer New() { return std::make_shared<CuboidGenerator>(); }
@@ -43,12 +46,35 @@ public:
      * generate any missing axes using the cross product. For example, if one
      * axis is provided, the 2nd and 3rd will be generated, but if two are
      * provided, only the 3rd will be generated.
+     *
+     * The sample offsets along each axis are precomputed when the sampling
+     * parameters change. Sample positions are generated by stepping along
+     * the axes and are sampled with a single call to
+     * Volume::interpolateAt(). If every axis is aligned with a Volume axis
+     * and the sampling interval is 1, the neighborhood is sampled as a block
+     * with Volume::interpolateBlock().
      */
     Neighborhood compute(
         const Volume::Pointer& v,
         const cv::Vec3d& pt,
         const std::vector<cv::Vec3d>& axes) override;
     /**@}*/
+
+private:
+    /** Precompute the sample offsets along each axis */
+    void update_offsets_() override;
+
+    /** Sample a neighborhood whose axes are aligned with the Volume axes */
+    void compute_aligned_(
+        const Volume::Pointer& v,
+        const cv::Vec3d& center,
+        const std::array<cv::Vec3d, 3>& bases,
+        Neighborhood& output) const;
+
+    /** Sample offsets along each axis, from the center */
+    std::array<std::vector<double>, 3> offsets_;
+    /** Offset of the center along the first axis */
+    double centerOffset_{0};
 };
 
 }  // namespace volcart
@@ -2,6 +2,8 @@
 
 /** @file */
 
+#include <vector>
+
 #include "vc/core/neighborhood/NeighborhoodGenerator.hpp"
 
 namespace volcart
@@ -20,7 +22,7 @@ public:
 
     /**@{*/
     /** @brief Default Constructor */
-    LineGenerator() : NeighborhoodGenerator(1) {}
+    LineGenerator() : NeighborhoodGenerator(1) { update_offsets_(); }
 
     /** @overload LineGenerator() */
     static Pointer New() { return std::make_shared<LineGenerator>(); }
@@ -40,12 +42,23 @@ public:
      * required.
      *
      * This class does not make use of the value of `setAutoGenAxes()`.
+     *
+     * The sample offsets are precomputed when the sampling parameters change.
+     * Sample positions are generated by stepping along the axis and are
+     * sampled with a single call to Volume::interpolateAt().
      */
     Neighborhood compute(
         const Volume::Pointer& v,
         const cv::Vec3d& pt,
         const std::vector<cv::Vec3d>& axes) override;
     /**@}*/
+
+private:
+    /** Precompute the sample offsets along the axis */
+    void update_offsets_() override;
+
+    /** Sample offsets along the axis, from the center */
+    std::vector<double> offsets_;
 };
 
 }  // namespace volcart
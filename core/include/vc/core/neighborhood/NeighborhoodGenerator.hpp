@@ -59,16 +59,22 @@ public:
     void setSamplingRadius(double r, std::size_t axis = 0)
     {
         radius_[axis] = r;
+        update_offsets_();
     }
 
     /** @brief Set the sampling search radius for all axes */
     void setSamplingRadius(double r0, double r1, double r2)
     {
         radius_ = {r0, r1, r2};
+        update_offsets_();
     }
 
     /** @overload setSamplingRadius(double, double, double) */
-    void setSamplingRadius(const cv::Vec3d& radii) { radius_ = radii; }
+    void setSamplingRadius(const cv::Vec3d& radii)
+    {
+        radius_ = radii;
+        update_offsets_();
+    }
 
     /**
      * @brief Set the sampling interval: how frequently along the radius (in
@@ -76,14 +82,22 @@ public:
      *
      * Default = 1.0
      */
-    void setSamplingInterval(double i) { interval_ = i; }
+    void setSamplingInterval(double i)
+    {
+        interval_ = i;
+        update_offsets_();
+    }
 
     /**
      * @brief Set the filtering search direction
      *
      * Default: Bidirectional
      */
-    void setSamplingDirection(Direction d) { direction_ = d; }
+    void setSamplingDirection(Direction d)
+    {
+        direction_ = d;
+        update_offsets_();
+    }
 
     /**
      * @brief Enable/Disable auto-generation of missing axes
@@ -107,6 +121,14 @@ protected:
 
     virtual ~NeighborhoodGenerator() = default;
 
+    /**
+     * Rebuild any sampling tables which depend on the radius, interval, or
+     * direction. Called whenever one of these parameters changes. Derived
+     * classes which override this should also call it from their
+     * constructors.
+     */
+    virtual void update_offsets_() {}
+
     /** Dimensionality of the generator */
     const std::size_t dim_{0};
 
@@ -3,7 +3,10 @@
 /** @file */
 
 #include <memory>
+#include <optional>
+#include <string>
 
+#include <nlohmann/json.hpp>
 #include <smgl/Graph.hpp>
 
 #include "vc/core/filesystem.hpp"
@@ -55,6 +58,47 @@ public:
      */
     [[nodiscard]] auto graph() const -> std::shared_ptr<smgl::Graph>;
 
+    /**
+     * @brief Save the render graph and its cached results to disk
+     *
+     * smgl::Graph::update() saves the graph automatically. Call this function
+     * after updating the graph by other means (e.g. UpdateGraphConcurrent()).
+     */
+    void saveGraph() const;
+
+    /**
+     * @brief Record performance information about the last graph update
+     *
+     * Stored in the Render metadata under the key "profile".
+     */
+    void setProfile(const nlohmann::json& profile);
+
+    /**
+     * @brief Record a reusable intermediate result
+     *
+     * Checkpoints associate a file in the Render directory with the content
+     * hash of the inputs and parameters which produced it. Later renders can
+     * look up checkpoints by hash to skip recomputing the result.
+     *
+     * @param name Pipeline stage which produced the file (e.g. "ppm")
+     * @param hash Content hash of the stage's inputs and parameters
+     * @param file File path relative to the Render directory
+     */
+    void setCheckpoint(
+        const std::string& name,
+        const std::string& hash,
+        const filesystem::path& file);
+
+    /**
+     * @brief Get the file for a checkpoint if its hash matches
+     *
+     * @return Absolute path to the checkpoint file, or std::nullopt if there
+     * is no checkpoint with a matching hash or if its file no longer exists
+     */
+    [[nodiscard]] auto checkpoint(
+        const std::string& name, const std::string& hash) const
+        -> std::optional<filesystem::path>;
+
 private:
     /** Render graph */
     mutable std::shared_ptr<smgl::Graph> graph_;
@@ -140,6 +140,31 @@ public:
     [[nodiscard]] auto applyPointAndNormal(
         const cv::Vec6d& ptN, bool normalize = true) const -> cv::Vec6d;
 
+    /**
+     * @brief Transform an array of 3D points in place
+     *
+     * Equivalent to calling applyPoint() on every element of the array, but
+     * lets derived transforms avoid per-point overhead. The base
+     * implementation calls applyPoint() on every element.
+     *
+     * @param points Pointer to the first point
+     * @param count Number of points in the array
+     */
+    virtual void applyPoints(cv::Vec3d* points, std::size_t count) const;
+    /**
+     * @brief Transform an array of points and surface normals in place
+     *
+     * Equivalent to calling applyPointAndNormal() on every element of the
+     * array. The base implementation does exactly that.
+     *
+     * @param ptNs Pointer to the first point and normal
+     * @param count Number of elements in the array
+     * @param normalize If true (default), the normal component of each element
+     * will be normalized.
+     */
+    virtual void applyPointsAndNormals(
+        cv::Vec6d* ptNs, std::size_t count, bool normalize = true) const;
+
     /**
      * @brief Compose two transforms into a single new transform
      *
@@ -272,6 +297,11 @@ public:
     /** @copydoc Transform3D::applyVector() */
     [[nodiscard]] auto applyVector(const cv::Vec3d& vector) const
         -> cv::Vec3d final;
+    /** @copydoc Transform3D::applyPoints() */
+    void applyPoints(cv::Vec3d* points, std::size_t count) const final;
+    /** @copydoc Transform3D::applyPointsAndNormals() */
+    void applyPointsAndNormals(
+        cv::Vec6d* ptNs, std::size_t count, bool normalize = true) const final;
 
     /** @brief Get the current transform parameters */
     [[nodiscard]] auto params() const -> Parameters;
@@ -381,6 +411,11 @@ public:
     /** @copydoc Transform3D::applyVector() */
     [[nodiscard]] auto applyVector(const cv::Vec3d& vector) const
         -> cv::Vec3d final;
+    /** @copydoc Transform3D::applyPoints() */
+    void applyPoints(cv::Vec3d* points, std::size_t count) const final;
+    /** @copydoc Transform3D::applyPointsAndNormals() */
+    void applyPointsAndNormals(
+        cv::Vec6d* ptNs, std::size_t count, bool normalize = true) const final;
 
 private:
     /** Don't allow construction on the stack */
@@ -457,6 +492,11 @@ public:
     /** @copydoc Transform3D::applyVector() */
     [[nodiscard]] auto applyVector(const cv::Vec3d& vector) const
         -> cv::Vec3d final;
+    /** @copydoc Transform3D::applyPoints() */
+    void applyPoints(cv::Vec3d* points, std::size_t count) const final;
+    /** @copydoc Transform3D::applyPointsAndNormals() */
+    void applyPointsAndNormals(
+        cv::Vec6d* ptNs, std::size_t count, bool normalize = true) const final;
 
     /**
      * @brief Add a transform to the end of the composite transform stack
@@ -490,13 +530,23 @@ private:
     void from_meta_(const Metadata& meta) final;
 };
 
-/** @brief Apply a transform to an ITKMesh */
+/**
+ * @brief Apply a transform to an ITKMesh
+ *
+ * Vertices and normals are transformed in parallel chunks using
+ * Transform3D::applyPointsAndNormals().
+ */
 auto ApplyTransform(
     const ITKMesh::Pointer& mesh,
     const Transform3D::Pointer& transform,
     bool normalize = true) -> ITKMesh::Pointer;
 
-/** @brief Apply a transform to a PerPixelMap */
+/**
+ * @brief Apply a transform to a PerPixelMap
+ *
+ * Rows of mappings are transformed in parallel using
+ * Transform3D::applyPointsAndNormals().
+ */
 auto ApplyTransform(
     const PerPixelMap& ppm,
     const Transform3D::Pointer& transform,
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
 /** DEBUG ONLY: Print AffineTransform to std::ostream */
 auto operator<<(std::ostream& os, const volcart::AffineTransform& t)
     -> std::ostream&;
@@ -12,9 +15,16 @@ auto ApplyTransform(const PointSetT& ps, const Transform3D::Pointer& transform)
     -> PointSetT
 {
     PointSetT output(ps);
-    std::transform(
-        output.begin(), output.end(), output.begin(),
-        [transform](const auto& a) { return transform->applyPoint(a); });
+    using PointT = std::decay_t<decltype(*output.begin())>;
+    if constexpr (std::is_same_v<PointT, cv::Vec3d>) {
+        if (not output.empty()) {
+            transform->applyPoints(&output[0], output.size());
+        }
+    } else {
+        std::transform(
+            output.begin(), output.end(), output.begin(),
+            [transform](const auto& a) { return transform->applyPoint(a); });
+    }
     return output;
 }
 
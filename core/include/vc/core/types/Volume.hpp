@@ -3,8 +3,13 @@
 /** @file */
 
 #include <cstddef>
+#include <condition_variable>
 #include <cstdint>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <set>
+#include <vector>
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/types/BoundingBox.hpp"
@@ -12,6 +17,7 @@
 #include "vc/core/types/DiskBasedObjectBaseClass.hpp"
 #include "vc/core/types/LRUCache.hpp"
 #include "vc/core/types/Reslice.hpp"
+#include "vc/core/util/ThreadPool.hpp"
 
 namespace volcart
 {
@@ -24,6 +30,19 @@ namespace volcart
  * Provides access to a volumetric dataset, such as a CT scan. By default,
  * slices are cached in memory using volcart::LRUCache.
  *
+ * Slices can optionally be prefetched into the cache by background I/O
+ * threads. When a prefetch depth is set with setPrefetchDepth(), the Volume
+ * watches for slice requests which move steadily through z and loads the next
+ * slices in that direction before they are needed. Callers which know their
+ * access pattern ahead of time can instead request slices with prefetch().
+ *
+ * A Volume may also store a pyramid of downsampled resolution levels, built
+ * with generateLevels(). Level `l` is downsampled by a factor of 2^l along
+ * every axis. Level 0 is the full-resolution Volume. Interactive views and
+ * coarse processing can use the level overloads of getSliceData(),
+ * interpolateAt(), and reslice() to read a fraction of the full-resolution
+ * data.
+ *
  * @ingroup Types
  */
 // shared_from_this used in Python bindings
@@ -117,6 +136,19 @@ public:
     /** @copydoc getSliceData(int) const */
     cv::Mat getSliceDataCopy(int index) const;
 
+    /**
+     * @brief Get a region of a slice by index number
+     *
+     * `roi` is clipped to the slice bounds. If the slice is cached, returns a
+     * copy of the cached region. If the region covers a large part of the
+     * slice, the full slice is loaded into the cache with getSliceData(), so
+     * that later requests for the same slice don't decode it again.
+     * Otherwise, only the region is decoded from disk and the slice is not
+     * added to the cache. Use this when only a small window of a slice is
+     * needed.
+     */
+    cv::Mat getSliceRegion(int index, const cv::Rect& roi) const;
+
     /**
      * @brief Set a slice by index number
      *
@@ -156,9 +188,53 @@ public:
         return interpolateAt(v[0], v[1], v[2]);
     }
 
+    /**
+     * @brief Get the intensity values at many subvoxel positions
+     *
+     * Writes `interpolateAt(points[i])` to `out[i]` for every i < `count`.
+     * The slices used by the samples are fetched from the cache once per
+     * call rather than once per voxel, so this is much faster than calling
+     * interpolateAt() in a loop when the points are close together.
+     */
+    void interpolateAt(
+        const cv::Vec3d* points, std::size_t count, std::uint16_t* out) const;
+
+    /**
+     * @brief Copy an axis-aligned block of voxels
+     *
+     * Copies the `size[0]` x `size[1]` x `size[2]` voxels starting at voxel
+     * `origin` into `out`, which must hold `size[0] * size[1] * size[2]`
+     * values. Values are stored in x, then y, then z order. Each slice is
+     * fetched from the cache once and copied a row at a time. Voxels outside
+     * of the Volume are 0.
+     */
+    void getVoxelBlock(
+        const cv::Vec3i& origin,
+        const cv::Vec3i& size,
+        std::uint16_t* out) const;
+
+    /**
+     * @brief Sample an axis-aligned block at a subvoxel position
+     *
+     * Fills `out` with the trilinearly interpolated intensity at
+     * `origin + (x, y, z)` for every `x < size[0]`, `y < size[1]`, and
+     * `z < size[2]`, in the same order as getVoxelBlock(). Because every
+     * sample has the same subvoxel offset, the voxels are fetched once with
+     * getVoxelBlock() and interpolated with one linear pass per axis.
+     * Samples outside of the Volume bounds are 0. Values are not rounded, but
+     * otherwise match interpolateAt().
+     */
+    void interpolateBlock(
+        const cv::Vec3d& origin, const cv::Vec3i& size, double* out) const;
+
     /**
      * @brief Create a Reslice image by intersecting the volume with a plane
      *
+     * When `level` is greater than 0, the plane is sampled from that
+     * resolution level. Neighboring Reslice pixels are 2^level voxels apart
+     * and the returned Reslice maps its pixels back to full-resolution
+     * Volume coordinates.
+     *
      * @warning This function makes no attempt to check that the X and Y vectors
      * are orthogonal to each other. Vectors that are not orthogonal will
      * produce unexpected behavior.
@@ -168,13 +244,68 @@ public:
      * @param yvec Y-axis of the Reslice plane
      * @param height Height of the Reslice image
      * @param width Width of the Reslice image
+     * @param level Resolution level to sample
      */
     Reslice reslice(
         const cv::Vec3d& center,
         const cv::Vec3d& xvec,
         const cv::Vec3d& yvec,
         int width = 64,
-        int height = 64) const;
+        int height = 64,
+        int level = 0) const;
+    /**@}*/
+
+    /**@{*/
+    /**
+     * @brief Get the number of resolution levels
+     *
+     * Includes the full-resolution level, so a Volume without a pyramid has
+     * one level.
+     */
+    int numLevels() const;
+
+    /** @brief Get the downsampling factor of a resolution level */
+    static int LevelScale(int level) { return 1 << level; }
+
+    /**
+     * @brief Get the Volume which stores a resolution level
+     *
+     * The returned Volume has the dimensions of the level and can be used
+     * like any other Volume. Level 0 returns this Volume, which must be
+     * managed by a shared pointer.
+     *
+     * @throws std::out_of_range if the level does not exist
+     */
+    Pointer level(int level) const;
+
+    /**
+     * @brief Get a slice from a resolution level
+     *
+     * `index` is the slice index within the level. Returns the same slice as
+     * `level(level)->getSliceData(index)`.
+     */
+    cv::Mat getSliceData(int index, int level) const;
+
+    /**
+     * @brief Get the intensity value at a subvoxel position from a resolution
+     * level
+     *
+     * `v` is a full-resolution Volume position. Values are trilinearly
+     * interpolated from the voxels of the level.
+     */
+    std::uint16_t interpolateAt(const cv::Vec3d& v, int level) const;
+
+    /**
+     * @brief Generate downsampled resolution levels
+     *
+     * Each level is generated from the previous level by averaging 2x2x2
+     * blocks of voxels. Existing levels are replaced.
+     *
+     * @param levels Number of levels to generate, not including the
+     * full-resolution level
+     * @param compress Whether to compress the level slice images
+     */
+    void generateLevels(int levels, bool compress = true);
     /**@}*/
 
     /**@{*/
@@ -207,6 +338,40 @@ public:
     void cachePurge() { cache_->purge(); }
     /**@}*/
 
+    /**@{*/
+    /**
+     * @brief Set the number of slices to read ahead of sequential access
+     *
+     * When sequential slice access is detected, the next `depth` slices in
+     * the direction of travel are loaded into the cache by background
+     * threads. The cache capacity should be larger than the prefetch depth.
+     * Setting the depth to 0 (default) disables automatic prefetching.
+     */
+    void setPrefetchDepth(std::size_t depth);
+
+    /** @brief Get the number of slices read ahead of sequential access */
+    std::size_t prefetchDepth() const;
+
+    /**
+     * @brief Set the number of background threads used for prefetching
+     *
+     * Waits for pending prefetches to finish before resizing. Default: 2
+     */
+    void setPrefetchThreads(std::size_t n);
+
+    /**
+     * @brief Load slices in the range [zBegin, zEnd) into the cache in the
+     * background
+     *
+     * Slices which are already cached or queued are skipped, as are indices
+     * outside of the Volume. Does nothing when slice caching is disabled.
+     */
+    void prefetch(int zBegin, int zEnd) const;
+
+    /** @brief Wait for all queued prefetches to finish */
+    void waitForPrefetch() const;
+    /**@}*/
+
 protected:
     /** Slice width */
     int width_{0};
@@ -216,6 +381,8 @@ protected:
     int slices_{0};
     /** Slice file name padding */
     int numSliceCharacters_{0};
+    /** Number of resolution levels, including the full resolution */
+    int numLevels_{1};
 
     /** Whether to use slice cache */
     bool cacheSlices_{true};
@@ -228,5 +395,42 @@ protected:
     cv::Mat load_slice_(int index) const;
     /** Load slice from cache */
     cv::Mat cache_slice_(int index) const;
+
+    /** Get the directory of a resolution level */
+    volcart::filesystem::path level_path_(int level) const;
+    /** Resolution levels, loaded on first use */
+    mutable std::vector<Pointer> levels_;
+    /** Resolution level mutex */
+    mutable std::mutex levelsMutex_;
+
+    /** Number of slices to read ahead of sequential access */
+    std::size_t prefetchDepth_{0};
+    /** Number of prefetch threads */
+    std::size_t prefetchThreads_{2};
+    /** Slices queued for prefetching. Guarded by cacheMutex_. */
+    mutable std::set<int> prefetchQueued_;
+    /** Slices currently being loaded. Guarded by cacheMutex_. */
+    mutable std::set<int> loading_;
+    /** Signals that a slice has finished loading */
+    mutable std::condition_variable loadedCV_;
+    /** Furthest slice reached by the current access stream */
+    mutable int streamHead_{std::numeric_limits<int>::min()};
+    /** Direction of the current access stream */
+    mutable int streamDir_{0};
+    /** Number of steps taken by the current access stream */
+    mutable int streamRun_{0};
+
+    /** Track slice access and prefetch ahead. Requires cacheMutex_. */
+    void track_access_(int index) const;
+    /** Queue slices for prefetching. Requires cacheMutex_. */
+    void queue_prefetch_(int zBegin, int zEnd) const;
+    /** Prefetch task run by the prefetch threads */
+    void prefetch_slice_(int index) const;
+
+    /**
+     * Prefetch threads. Declared last so that queued prefetches finish before
+     * the rest of the Volume is destroyed.
+     */
+    mutable std::unique_ptr<ThreadPool> prefetchPool_;
 };
 }  // namespace volcart
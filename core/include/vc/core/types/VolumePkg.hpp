@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <iostream>
 #include <map>
+#include <optional>
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/types/Metadata.hpp"
@@ -178,6 +179,15 @@ public:
 
     /** @copydoc VolumePkg::volume(const Volume::Identifier&) const */
     auto volume(const Volume::Identifier& id) -> Volume::Pointer;
+
+    /**
+     * @brief Remove a Volume from the VolumePkg
+     *
+     * Unregisters the Volume and deletes its directory from disk.
+     *
+     * @throws std::out_of_range if no Volume has the given identifier
+     */
+    void removeVolume(const Volume::Identifier& id);
     /**@}*/
 
     /** @name Segmentation Data */
@@ -242,6 +252,19 @@ public:
 
     /** @copydoc VolumePkg::render(const Render::Identifier&) const */
     auto render(const Render::Identifier& id) -> Render::Pointer;
+
+    /**
+     * @brief Find a reusable intermediate result in any Render
+     *
+     * Searches the Renders, newest first, for a checkpoint with the given
+     * name and content hash.
+     *
+     * @see Render::checkpoint()
+     * @return Path to the checkpoint file, or std::nullopt if not found
+     */
+    [[nodiscard]] auto findCheckpoint(
+        const std::string& name, const std::string& hash) const
+        -> std::optional<filesystem::path>;
     /**@}*/
 
     /** @name Transform Data */
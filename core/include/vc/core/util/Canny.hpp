@@ -36,6 +36,17 @@ struct CannySettings {
  */
 auto Canny(cv::Mat src, CannySettings settings) -> cv::Mat;
 
+/**
+ * @copybrief Canny(cv::Mat, CannySettings)
+ *
+ * Writes the edge image to `dst`, reusing its buffer if it already has the
+ * size of `src` and type CV_8UC1. Useful for processing many images of the
+ * same size. `dst` must not be `src`.
+ *
+ * @ingroup Util
+ */
+void Canny(const cv::Mat& src, cv::Mat& dst, const CannySettings& settings);
+
 }  // namespace volcart
 
 #pragma clang diagnostic pop
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+/** @file */
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace volcart
+{
+
+namespace detail
+{
+/** Whether the standard library provides floating-point to/from_chars */
+#if defined(__cpp_lib_to_chars)
+constexpr bool HAS_FLOAT_CHARCONV{true};
+#else
+constexpr bool HAS_FLOAT_CHARCONV{false};
+#endif
+}  // namespace detail
+
+/**
+ * @brief Parse a number from the start of a character range
+ *
+ * Wrapper around std::from_chars which also accepts a leading '+'. Leading
+ * whitespace is not skipped. When the standard library does not provide
+ * floating-point std::from_chars, floating-point values are parsed with
+ * std::strtod, which uses the current C locale.
+ *
+ * @return Pointer to the first character after the number, or nullptr if
+ * the range does not start with a valid number
+ */
+template <typename T>
+auto ParseNumber(const char* first, const char* last, T& value) -> const char*
+{
+    static_assert(std::is_arithmetic_v<T>, "T must be a number");
+    if (first != last and *first == '+') {
+        ++first;
+    }
+    if constexpr (std::is_floating_point_v<T> and
+                  not detail::HAS_FLOAT_CHARCONV) {
+        // strtod requires a null-terminated string
+        const std::string buffer(first, last);
+        char* end{nullptr};
+        auto v = std::strtod(buffer.c_str(), &end);
+        if (end == buffer.c_str()) {
+            return nullptr;
+        }
+        value = static_cast<T>(v);
+        return first + (end - buffer.c_str());
+    } else {
+        auto [ptr, ec] = std::from_chars(first, last, value);
+        if (ec != std::errc()) {
+            return nullptr;
+        }
+        return ptr;
+    }
+}
+
+/**
+ * @brief Append the text representation of a number to a string
+ *
+ * Wrapper around std::to_chars. Floating-point values are
+ * written with the shortest representation which reads back to the same
+ * value. When the standard library does not provide floating-point
+ * std::to_chars, floating-point values are written with std::snprintf using
+ * enough digits to do the same.
+ */
+template <typename T>
+void AppendNumber(std::string& str, T value)
+{
+    static_assert(std::is_arithmetic_v<T>, "T must be a number");
+    std::array<char, 32> buffer{};
+    if constexpr (std::is_floating_point_v<T> and
+                  not detail::HAS_FLOAT_CHARCONV) {
+        constexpr auto DIGITS = std::is_same_v<T, float> ? 9 : 17;
+        auto len = std::snprintf(
+            buffer.data(), buffer.size(), "%.*g", DIGITS,
+            static_cast<double>(value));
+        str.append(buffer.data(), static_cast<std::size_t>(len));
+    } else {
+        auto end = buffer.data() + buffer.size();
+        auto result = std::to_chars(buffer.data(), end, value);
+        str.append(buffer.data(), result.ptr);
+    }
+}
+
+}  // namespace volcart
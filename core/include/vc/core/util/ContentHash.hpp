@@ -0,0 +1,66 @@
+#pragma once
+
+/** @file */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "vc/core/filesystem.hpp"
+
+namespace volcart
+{
+
+/**
+ * @brief Incremental 64-bit content hash
+ *
+ * Computes the 64-bit FNV-1a hash of a byte stream, processed in 8-byte words
+ * rather than single bytes so that hashing large buffers is fast. The final
+ * partial word is zero-padded. The result only depends on the concatenated
+ * bytes and not on how they were split between calls to update().
+ *
+ * Not suitable for cryptographic purposes.
+ *
+ * @ingroup Util
+ */
+class ContentHash
+{
+public:
+    /** @brief Add bytes to the hash */
+    void update(const void* data, std::size_t size);
+
+    /** @brief Add the bytes of a string to the hash */
+    void update(const std::string& str);
+
+    /**
+     * @brief Add the contents of a file to the hash
+     *
+     * If `path` is a directory, adds the name and contents of every regular
+     * file in the directory in sorted order. Subdirectories are ignored.
+     *
+     * @throws volcart::IOException If a file cannot be read
+     */
+    void updateFile(const filesystem::path& path);
+
+    /** @brief Get the hash of all bytes added so far */
+    std::uint64_t digest() const;
+
+    /** @brief Get the digest as a 16 character hexadecimal string */
+    std::string hex() const;
+
+private:
+    /** Word size */
+    static constexpr std::size_t WORD{sizeof(std::uint64_t)};
+    /** Mix a single word into the hash */
+    void mix_(const char* data);
+
+    /** Current hash value */
+    std::uint64_t hash_{14695981039346656037ULL};
+    /** Bytes not yet mixed into the hash */
+    std::array<char, WORD> pending_{};
+    /** Number of pending bytes */
+    std::size_t pendingSize_{0};
+};
+
+}  // namespace volcart
@@ -24,6 +24,21 @@ auto DepthToString(int depth) -> std::string;
 auto QuantizeImage(
     const cv::Mat& m, int depth = CV_16U, bool scaleMinMax = true) -> cv::Mat;
 
+/**
+ * @copybrief QuantizeImage(const cv::Mat&, int, bool)
+ *
+ * Writes the converted image to `output`, reusing its buffer if it already
+ * has the converted size and type. If `m` already has the requested depth,
+ * `output` is set to a shallow copy of `m`. `output` must not be `m`.
+ *
+ * @ingroup Util
+ */
+void QuantizeImage(
+    const cv::Mat& m,
+    cv::Mat& output,
+    int depth = CV_16U,
+    bool scaleMinMax = true);
+
 /**
  * @brief Convert image to specified number of channels
  *
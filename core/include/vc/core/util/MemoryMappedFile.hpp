@@ -0,0 +1,52 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+
+#include "vc/core/filesystem.hpp"
+
+namespace volcart
+{
+
+/**
+ * @brief Read-only memory mapping of a file
+ *
+ * Maps the entire contents of a file into memory on construction and unmaps
+ * it on destruction. Pages are loaded by the OS on first access, so large
+ * files can be opened without reading them into memory first.
+ *
+ * @ingroup Util
+ */
+class MemoryMappedFile
+{
+public:
+    /**
+     * @brief Map a file into memory
+     *
+     * @throws volcart::IOException If the file cannot be opened or mapped
+     */
+    explicit MemoryMappedFile(const filesystem::path& path);
+
+    /** @brief Unmap the file */
+    ~MemoryMappedFile();
+
+    /** Not copyable */
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    /** Not copyable */
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    /** @brief Get a pointer to the start of the mapped file */
+    const char* data() const { return data_; }
+
+    /** @brief Get the size of the mapped file in bytes */
+    std::size_t size() const { return size_; }
+
+private:
+    /** Start of the mapping */
+    const char* data_{nullptr};
+    /** Size of the mapping */
+    std::size_t size_{0};
+};
+
+}  // namespace volcart
@@ -0,0 +1,29 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+
+namespace volcart
+{
+
+/**
+ * @brief Get the current resident memory of this process in bytes
+ *
+ * Returns 0 if the resident memory cannot be determined on this platform.
+ *
+ * @ingroup Util
+ */
+std::size_t CurrentResidentMemory();
+
+/**
+ * @brief Get the peak resident memory of this process in bytes
+ *
+ * The peak is the high-water mark since the process started and never
+ * decreases. Returns 0 if the peak cannot be determined on this platform.
+ *
+ * @ingroup Util
+ */
+std::size_t PeakResidentMemory();
+
+}  // namespace volcart
@@ -0,0 +1,194 @@
+#pragma once
+
+/**
+ * @file Profiling.hpp
+ *
+ * @ingroup Util
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+/**
+ * @namespace volcart::profiling
+ * @brief Lightweight hot-path timers and event counters
+ *
+ * Library code records events with Count() and times regions of code with
+ * ScopedTimer. Values are accumulated in thread-local storage without locks
+ * and are summed across threads by Snapshot(). Profiling is disabled by
+ * default. While disabled, Count() and ScopedTimer only check a flag.
+ *
+ * @code{.cpp}
+ * // At file scope
+ * static const profiling::Timer LOAD_TIMER{"Load slice"};
+ *
+ * void Load()
+ * {
+ *     profiling::ScopedTimer timer(LOAD_TIMER);
+ *     profiling::Count(profiling::Counter::SliceCacheMisses);
+ *     ...
+ * }
+ * @endcode
+ */
+namespace volcart::profiling
+{
+/** @brief Event counters */
+enum class Counter {
+    /** Volume slice requests served from the slice cache */
+    SliceCacheHits = 0,
+    /** Volume slice requests which loaded the slice from disk */
+    SliceCacheMisses,
+    /** Bytes of slice data loaded from disk */
+    SliceBytesLoaded,
+    /** Volume samples computed by trilinear interpolation */
+    SamplesInterpolated,
+    /** Ray traversals of a bounding volume hierarchy */
+    BVHTraversals,
+    /** Mask samples skipped because they are in a brick entirely in the mask */
+    MaskSamplesSkipped
+};
+
+/** Number of Counter values */
+constexpr std::size_t NUM_COUNTERS{6};
+
+/** Maximum number of registered Timers */
+constexpr std::size_t MAX_TIMERS{64};
+
+/** @brief Get the name of a counter */
+auto CounterName(Counter c) -> std::string;
+
+namespace detail
+{
+/** Global enable flag */
+extern std::atomic<bool> enabled;
+/** Add to a counter of the calling thread */
+void AddCount(Counter c, std::uint64_t n);
+/** Add a timed call to a timer of the calling thread */
+void AddTime(std::size_t id, std::chrono::steady_clock::duration d);
+}  // namespace detail
+
+/** @brief Enable or disable profiling. Disabled by default. */
+void SetEnabled(bool b);
+
+/** @brief Whether profiling is enabled */
+inline auto IsEnabled() -> bool
+{
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/** @brief Add `n` to a counter if profiling is enabled */
+inline void Count(Counter c, std::uint64_t n = 1)
+{
+    if (IsEnabled()) {
+        detail::AddCount(c, n);
+    }
+}
+
+/**
+ * @brief Named timer
+ *
+ * Registers a name for use with ScopedTimer. Timers are usually static
+ * objects. Constructing a Timer with an existing name refers to the same
+ * timer.
+ *
+ * @throws std::length_error If more than MAX_TIMERS names are registered
+ */
+class Timer
+{
+public:
+    /** @brief Register a timer name */
+    explicit Timer(const std::string& name);
+
+    /** @brief Get the timer's registration index */
+    [[nodiscard]] auto id() const -> std::size_t { return id_; }
+
+private:
+    /** Registration index */
+    std::size_t id_;
+};
+
+/**
+ * @brief Time the enclosing scope
+ *
+ * Adds one call and the elapsed wall time to a Timer when destroyed. Does
+ * nothing if profiling was disabled when the ScopedTimer was constructed.
+ */
+class ScopedTimer
+{
+public:
+    /** @brief Start timing */
+    explicit ScopedTimer(const Timer& timer)
+        : id_{timer.id()}, active_{IsEnabled()}
+    {
+        if (active_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    /** @brief Stop timing */
+    ~ScopedTimer()
+    {
+        if (active_) {
+            detail::AddTime(id_, std::chrono::steady_clock::now() - start_);
+        }
+    }
+
+    /** Not copyable */
+    ScopedTimer(const ScopedTimer&) = delete;
+    /** Not copyable */
+    auto operator=(const ScopedTimer&) -> ScopedTimer& = delete;
+
+private:
+    /** Timer index */
+    std::size_t id_;
+    /** Whether profiling was enabled at construction */
+    bool active_;
+    /** Start time */
+    std::chrono::steady_clock::time_point start_;
+};
+
+/** @brief Accumulated values of a Timer */
+struct TimerReport {
+    /** Timer name */
+    std::string name;
+    /** Number of timed calls */
+    std::uint64_t calls{0};
+    /**
+     * Total time of all calls in seconds. Calls on different threads are
+     * summed, so this can be larger than the elapsed wall time.
+     */
+    double seconds{0};
+};
+
+/** @brief Accumulated values of all counters and timers */
+struct Report {
+    /** Counter values, indexed by Counter */
+    std::array<std::uint64_t, NUM_COUNTERS> counters{};
+    /** Timers which have been called at least once */
+    std::vector<TimerReport> timers;
+};
+
+/**
+ * @brief Get the totals of all threads
+ *
+ * Includes threads which have exited. Values from threads which are still
+ * recording may be slightly out of date.
+ */
+auto Snapshot() -> Report;
+
+/** @brief Reset all counters and timers to zero */
+void Reset();
+
+/** @brief Convert a Report to JSON for storage in metadata */
+auto ToJson(const Report& report) -> nlohmann::json;
+
+/** @brief Write a Report to the info log */
+void LogReport(const Report& report);
+}  // namespace volcart::profiling
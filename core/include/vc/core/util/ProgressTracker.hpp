@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * @file ProgressTracker.hpp
+ *
+ * @ingroup Util
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "vc/core/types/Mixins.hpp"
+
+namespace volcart
+{
+
+/**
+ * @brief Thread-safe, throttled progress reporting for IterationsProgress
+ *
+ * Tight loops record their progress in an atomic counter with set() or add()
+ * instead of sending IterationsProgress::progressUpdated for every
+ * iteration. A reporter thread polls the counter at a fixed interval and
+ * sends progressUpdated only when the value has changed. The reporter
+ * thread is only started if progressUpdated has connected slots.
+ *
+ * The signals of the tracked object are never sent concurrently: while the
+ * tracker is active, progressUpdated is sent from the reporter thread. The
+ * final update and progressComplete are sent from the thread which calls
+ * complete(). Slots must not be connected or disconnected while the tracker
+ * is active.
+ *
+ * @code{.cpp}
+ * ProgressTracker progress(*this);
+ * pool.parallelFor(0, rows, [&](std::size_t y) {
+ *     for (std::size_t x = 0; x < cols; x++) {
+ *         ...
+ *     }
+ *     progress.add(cols);
+ * });
+ * progress.complete();
+ * @endcode
+ *
+ * @ingroup Util
+ */
+class ProgressTracker
+{
+public:
+    /** Default reporting interval */
+    static constexpr std::chrono::milliseconds DEFAULT_INTERVAL{100};
+
+    /**
+     * @brief Start tracking
+     *
+     * Sends IterationsProgress::progressStarted.
+     */
+    explicit ProgressTracker(
+        IterationsProgress& p,
+        std::chrono::milliseconds interval = DEFAULT_INTERVAL);
+
+    /**
+     * @brief Stop the reporter thread
+     *
+     * Does not send progressComplete if complete() was not called, e.g.
+     * when the tracked loop exits with an exception.
+     */
+    ~ProgressTracker();
+
+    /** Not copyable */
+    ProgressTracker(const ProgressTracker&) = delete;
+    /** Not copyable */
+    auto operator=(const ProgressTracker&) -> ProgressTracker& = delete;
+
+    /**
+     * @brief Set the number of completed iterations
+     *
+     * Lock-free. Intended for loops with a single producer thread.
+     */
+    void set(std::size_t count)
+    {
+        count_.store(count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add to the number of completed iterations
+     *
+     * Lock-free and safe to call from multiple threads. For best
+     * performance, workers should add a batch of iterations at once.
+     */
+    void add(std::size_t n = 1)
+    {
+        count_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** @brief Get the number of completed iterations */
+    [[nodiscard]] auto count() const -> std::size_t
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Finish tracking
+     *
+     * Stops the reporter thread, sends the final count if it has not been
+     * reported, then sends IterationsProgress::progressComplete. Subsequent
+     * calls do nothing.
+     */
+    void complete();
+
+private:
+    /** Reporter thread loop */
+    void run_();
+    /** Stop and join the reporter thread */
+    void stop_();
+    /** Send progressUpdated if the count has changed */
+    void report_();
+
+    /** Tracked object */
+    IterationsProgress& progress_;
+    /** Reporting interval */
+    std::chrono::milliseconds interval_;
+    /** Completed iterations */
+    std::atomic<std::size_t> count_{0};
+    /** Last reported count */
+    std::size_t reported_{0};
+    /** Reporter stop flag and wake up */
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_{false};
+    /** Whether complete() has been called */
+    bool completed_{false};
+    /** Reporter thread */
+    std::thread reporter_;
+};
+
+}  // namespace volcart
@@ -0,0 +1,193 @@
+#pragma once
+
+/** @file */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace volcart
+{
+
+/**
+ * @brief Persistent pool of worker threads
+ *
+ * Worker threads are started on construction and are reused for every task
+ * submitted to the pool until the pool is destroyed. Tasks are executed in
+ * submission order. Destroying the pool finishes all queued tasks before
+ * joining the workers.
+ *
+ * Example Usage:
+ * @code{.cpp}
+ * ThreadPool pool(4);
+ *
+ * // Run a single task
+ * auto result = pool.submit([]() { return 42; });
+ * std::cout << result.get() << std::endl; // prints "42"
+ *
+ * // Run a loop on the pool
+ * std::vector<int> values(1000);
+ * pool.parallelFor(0, values.size(), [&](std::size_t i) { values[i] = i; });
+ * @endcode
+ *
+ * @ingroup Util
+ */
+class ThreadPool
+{
+public:
+    /** @brief Construct with the given number of worker threads */
+    explicit ThreadPool(std::size_t numThreads = DefaultThreadCount());
+
+    /** @brief Finish all queued tasks and join the worker threads */
+    ~ThreadPool();
+
+    /** Not copyable */
+    ThreadPool(const ThreadPool&) = delete;
+    /** Not copyable */
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** @brief Get the default number of worker threads */
+    static std::size_t DefaultThreadCount();
+
+    /**
+     * @brief Get the process-wide shared pool
+     *
+     * The pool has DefaultThreadCount() workers and is created on first use.
+     * Library code which parallelizes a loop with parallelFor() should use
+     * this pool rather than constructing its own. Callers running at the same
+     * time, such as graph nodes updated by UpdateGraphConcurrent(), then
+     * share one set of workers instead of each starting a full-size pool.
+     *
+     * Tasks submitted to the shared pool must not block waiting on other
+     * tasks in the pool. Nested parallelFor() calls are safe.
+     */
+    static ThreadPool& Shared();
+
+    /** @brief Get the number of worker threads */
+    std::size_t size() const { return workers_.size(); }
+
+    /** @brief Get the number of tasks waiting for a free worker */
+    std::size_t queued() const;
+
+    /**
+     * @brief Queue a task for execution
+     *
+     * @return A future which holds the result or exception of the task
+     */
+    template <class Fn, class... Args>
+    auto submit(Fn&& fn, Args&&... args)
+        -> std::future<std::invoke_result_t<Fn, Args...>>
+    {
+        using ResultType = std::invoke_result_t<Fn, Args...>;
+        auto task = std::make_shared<std::packaged_task<ResultType()>>(
+            std::bind(std::forward<Fn>(fn), std::forward<Args>(args)...));
+        auto result = task->get_future();
+        enqueue_([task]() { (*task)(); });
+        return result;
+    }
+
+    /**
+     * @brief Call `fn(i)` for every i in [begin, end) using the pool
+     *
+     * The range is split into chunks of `grainSize` indices. Workers and the
+     * calling thread claim chunks one at a time until none remain, so uneven
+     * per-index costs are balanced across threads. Blocks until every index
+     * has been processed. If `fn` throws, remaining chunks are skipped and the
+     * first exception is rethrown in the calling thread.
+     *
+     * Because the calling thread also processes chunks, parallelFor can safely
+     * be called from a task running on the same pool.
+     */
+    template <class Fn>
+    void parallelFor(
+        std::size_t begin, std::size_t end, Fn&& fn, std::size_t grainSize = 1)
+    {
+        if (begin >= end) {
+            return;
+        }
+
+        // Shared with helper tasks, which may start after this call returns
+        struct LoopState {
+            std::size_t numChunks{0};
+            std::atomic<std::size_t> next{0};
+            std::size_t done{0};
+            std::atomic<bool> failed{false};
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable cv;
+        };
+        grainSize = std::max<std::size_t>(grainSize, 1);
+        auto state = std::make_shared<LoopState>();
+        state->numChunks = (end - begin + grainSize - 1) / grainSize;
+
+        // Claim and run chunks until there are none left
+        std::function<void()> runChunks = [state, begin, end, grainSize,
+                                           &fn]() {
+            std::size_t chunk;
+            while ((chunk = state->next++) < state->numChunks) {
+                try {
+                    if (!state->failed) {
+                        auto first = begin + chunk * grainSize;
+                        auto last = std::min(first + grainSize, end);
+                        for (auto i = first; i < last; i++) {
+                            fn(i);
+                        }
+                    }
+                } catch (...) {
+                    const std::lock_guard<std::mutex> lock(state->mutex);
+                    if (!state->failed.exchange(true)) {
+                        state->error = std::current_exception();
+                    }
+                }
+                const std::lock_guard<std::mutex> lock(state->mutex);
+                if (++state->done == state->numChunks) {
+                    state->cv.notify_all();
+                }
+            }
+        };
+
+        // Queue helpers, then work on the calling thread too
+        auto numHelpers = std::min(size(), state->numChunks - 1);
+        for (std::size_t i = 0; i < numHelpers; i++) {
+            enqueue_(runChunks);
+        }
+        runChunks();
+
+        // Wait for chunks claimed by helpers
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->cv.wait(
+            lock, [&state]() { return state->done == state->numChunks; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+private:
+    /** Add a task to the queue and wake a worker */
+    void enqueue_(std::function<void()> task);
+    /** Worker thread loop */
+    void run_();
+
+    /** Worker threads */
+    std::vector<std::thread> workers_;
+    /** Task queue */
+    std::queue<std::function<void()>> tasks_;
+    /** Task queue mutex */
+    mutable std::mutex mutex_;
+    /** Signals that tasks are available or that the pool is stopping */
+    std::condition_variable cv_;
+    /** Whether the pool is shutting down */
+    bool stop_{false};
+};
+
+}  // namespace volcart
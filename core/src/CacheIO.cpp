@@ -0,0 +1,390 @@
+#include "vc/core/io/CacheIO.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+#include "vc/core/io/FileExtensionFilter.hpp"
+#include "vc/core/io/UVMapIO.hpp"
+#include "vc/core/types/Exceptions.hpp"
+#include "vc/core/util/ContentHash.hpp"
+#include "vc/core/util/MemoryMappedFile.hpp"
+
+using namespace volcart;
+using namespace volcart::io;
+
+namespace fs = volcart::filesystem;
+namespace vio = volcart::io;
+
+namespace
+{
+// Increment when the layout of any cache type changes
+constexpr std::uint32_t CACHE_VERSION{1};
+constexpr std::array<char, 8> CACHE_MAGIC{'V', 'C', 'C', 'A',
+                                          'C', 'H', 'E', '\0'};
+
+// Type of object stored in a cache file
+enum class CacheType : std::uint32_t { Mesh = 1, UVMap = 2, PPM = 3 };
+
+// Fixed-size header at the start of every cache file
+struct CacheHeader {
+    std::array<char, 8> magic{CACHE_MAGIC};
+    std::uint32_t version{CACHE_VERSION};
+    CacheType type{CacheType::Mesh};
+    std::uint64_t payloadSize{0};
+    std::uint64_t checksum{0};
+};
+static_assert(sizeof(CacheHeader) == 32, "Unexpected cache header size");
+
+// Writes a cache header and payload, checksumming the payload as it's written
+class CacheWriter
+{
+public:
+    CacheWriter(const fs::path& path, CacheType type)
+        : path_{path}, out_{path.string(), std::ios::binary}
+    {
+        if (!out_.is_open()) {
+            auto msg = "could not open file '" + path.string() + "'";
+            throw IOException(msg);
+        }
+
+        // Reserve space for the header, which is written on close
+        header_.type = type;
+        out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    }
+
+    void write(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const char*>(data);
+        out_.write(bytes, static_cast<std::streamsize>(size));
+        checksum_.update(bytes, size);
+        header_.payloadSize += size;
+    }
+
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write(&value, sizeof(T));
+    }
+
+    void writeMat(const cv::Mat& mat)
+    {
+        write(static_cast<std::int32_t>(mat.rows));
+        write(static_cast<std::int32_t>(mat.cols));
+        write(static_cast<std::int32_t>(mat.type()));
+        for (int y = 0; y < mat.rows; y++) {
+            write(mat.ptr(y), mat.cols * mat.elemSize());
+        }
+    }
+
+    void writeUVMap(const UVMap& uvMap)
+    {
+        write(static_cast<std::uint32_t>(uvMap.origin()));
+        write(uvMap.ratio().width);
+        write(uvMap.ratio().height);
+        write(static_cast<std::uint64_t>(uvMap.size()));
+        for (const auto& [id, uv] : uvMap.as_map()) {
+            write(static_cast<std::uint64_t>(id));
+            write(uv[0]);
+            write(uv[1]);
+        }
+    }
+
+    void close()
+    {
+        header_.checksum = checksum_.digest();
+        out_.seekp(0);
+        out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+        out_.flush();
+        out_.close();
+        if (out_.fail()) {
+            auto msg = "failure writing file '" + path_.string() + "'";
+            throw IOException(msg);
+        }
+    }
+
+private:
+    fs::path path_;
+    std::ofstream out_;
+    CacheHeader header_;
+    ContentHash checksum_;
+};
+
+// Memory maps a cache file, validates it, and reads values from the payload
+class CacheReader
+{
+public:
+    CacheReader(const fs::path& path, CacheType type)
+        : path_{path}, file_{path}
+    {
+        CacheHeader header;
+        if (file_.size() < sizeof(header)) {
+            throw IOException("File is not a cache file: " + path.string());
+        }
+        std::memcpy(&header, file_.data(), sizeof(header));
+
+        if (header.magic != CACHE_MAGIC) {
+            throw IOException("File is not a cache file: " + path.string());
+        }
+        if (header.version != CACHE_VERSION) {
+            auto msg = "Version mismatch. Cache file version is " +
+                       std::to_string(header.version) +
+                       ", processing version is " +
+                       std::to_string(CACHE_VERSION) + ".";
+            throw IOException(msg);
+        }
+        if (header.type != type) {
+            throw IOException("Cache file type mismatch: " + path.string());
+        }
+        if (header.payloadSize != file_.size() - sizeof(header)) {
+            throw IOException("Cache file is truncated: " + path.string());
+        }
+
+        pos_ = file_.data() + sizeof(header);
+        end_ = pos_ + header.payloadSize;
+        ContentHash checksum;
+        checksum.update(pos_, header.payloadSize);
+        if (checksum.digest() != header.checksum) {
+            throw IOException("Cache file checksum mismatch: " + path.string());
+        }
+    }
+
+    // Get a pointer to the next `size` bytes and advance past them
+    auto read(std::size_t size) -> const char*
+    {
+        if (size > static_cast<std::size_t>(end_ - pos_)) {
+            throw IOException("Unexpected end of cache: " + path_.string());
+        }
+        const auto* data = pos_;
+        pos_ += size;
+        return data;
+    }
+
+    template <typename T>
+    auto read() -> T
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        std::memcpy(&value, read(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    auto readMat() -> cv::Mat
+    {
+        auto rows = read<std::int32_t>();
+        auto cols = read<std::int32_t>();
+        auto type = read<std::int32_t>();
+        cv::Mat mat(rows, cols, type);
+        auto size = mat.total() * mat.elemSize();
+        if (size > 0) {
+            std::memcpy(mat.data, read(size), size);
+        }
+        return mat;
+    }
+
+    auto readUVMap() -> UVMap
+    {
+        UVMap uvMap;
+        auto origin = static_cast<UVMap::Origin>(read<std::uint32_t>());
+        auto width = read<double>();
+        auto height = read<double>();
+        uvMap.ratio(width, height);
+
+        // Mappings are stored relative to the top-left
+        auto size = read<std::uint64_t>();
+        for (std::uint64_t i = 0; i < size; i++) {
+            auto id = read<std::uint64_t>();
+            auto u = read<double>();
+            auto v = read<double>();
+            uvMap.set(id, {u, v}, UVMap::Origin::TopLeft);
+        }
+        uvMap.setOrigin(origin);
+        return uvMap;
+    }
+
+private:
+    fs::path path_;
+    MemoryMappedFile file_;
+    const char* pos_{nullptr};
+    const char* end_{nullptr};
+};
+}  // namespace
+
+void vio::WriteMeshCache(
+    const fs::path& path,
+    const ITKMesh::Pointer& mesh,
+    const UVMap::Pointer& uv,
+    const cv::Mat& texture)
+{
+    CacheWriter writer(path, CacheType::Mesh);
+
+    // Counts
+    auto numPoints = mesh->GetNumberOfPoints();
+    const auto& pointData = mesh->GetPointData();
+    auto hasNormals = pointData and pointData->Size() == numPoints;
+    writer.write(static_cast<std::uint64_t>(numPoints));
+    writer.write(static_cast<std::uint64_t>(mesh->GetNumberOfCells()));
+    writer.write(static_cast<std::uint64_t>(hasNormals));
+
+    // Vertices and normals
+    for (auto pt = mesh->GetPoints()->Begin(); pt != mesh->GetPoints()->End();
+         ++pt) {
+        writer.write(pt.Value().GetDataPointer(), 3 * sizeof(double));
+    }
+    if (hasNormals) {
+        for (auto n = pointData->Begin(); n != pointData->End(); ++n) {
+            writer.write(n.Value().GetDataPointer(), 3 * sizeof(double));
+        }
+    }
+
+    // Faces
+    for (auto cell = mesh->GetCells()->Begin(); cell != mesh->GetCells()->End();
+         ++cell) {
+        if (cell.Value()->GetNumberOfPoints() != 3) {
+            throw IOException("Mesh cache only supports triangular faces");
+        }
+        for (auto id = cell.Value()->PointIdsBegin();
+             id != cell.Value()->PointIdsEnd(); ++id) {
+            writer.write(static_cast<std::uint64_t>(*id));
+        }
+    }
+
+    // Texturing information
+    auto hasUV = uv != nullptr and not uv->empty();
+    writer.write(static_cast<std::uint64_t>(hasUV));
+    if (hasUV) {
+        writer.writeUVMap(*uv);
+    }
+    writer.write(static_cast<std::uint64_t>(not texture.empty()));
+    if (not texture.empty()) {
+        writer.writeMat(texture);
+    }
+
+    writer.close();
+}
+
+auto vio::ReadMeshCache(const fs::path& path) -> MeshReaderResult
+{
+    CacheReader reader(path, CacheType::Mesh);
+    auto numPoints = reader.read<std::uint64_t>();
+    auto numCells = reader.read<std::uint64_t>();
+    auto hasNormals = reader.read<std::uint64_t>() != 0;
+
+    // Vertices
+    auto points = ITKPointsContainer::New();
+    points->Reserve(numPoints);
+    const auto* data = reader.read(numPoints * sizeof(ITKPoint));
+    for (std::uint64_t i = 0; i < numPoints; i++) {
+        ITKPoint p;
+        std::memcpy(p.GetDataPointer(), data, sizeof(ITKPoint));
+        points->SetElement(i, p);
+        data += sizeof(ITKPoint);
+    }
+
+    // Normals
+    auto normals = ITKMesh::PointDataContainer::New();
+    if (hasNormals) {
+        normals->Reserve(numPoints);
+        data = reader.read(numPoints * sizeof(ITKPixel));
+        for (std::uint64_t i = 0; i < numPoints; i++) {
+            ITKPixel n;
+            std::memcpy(n.GetDataPointer(), data, sizeof(ITKPixel));
+            normals->SetElement(i, n);
+            data += sizeof(ITKPixel);
+        }
+    }
+
+    MeshReaderResult result;
+    result.mesh = ITKMesh::New();
+    result.mesh->SetPoints(points);
+    result.mesh->SetPointData(normals);
+
+    // Faces
+    constexpr std::size_t FACE_BYTES{3 * sizeof(std::uint64_t)};
+    data = reader.read(numCells * FACE_BYTES);
+    ITKCell::CellAutoPointer cell;
+    for (std::uint64_t c = 0; c < numCells; c++) {
+        std::array<std::uint64_t, 3> ids{};
+        std::memcpy(ids.data(), data, FACE_BYTES);
+        data += FACE_BYTES;
+
+        cell.TakeOwnership(new ITKTriangle);
+        for (std::uint32_t i = 0; i < 3; i++) {
+            cell->SetPointId(i, ids[i]);
+        }
+        result.mesh->SetCell(c, cell);
+    }
+
+    // Texturing information
+    if (reader.read<std::uint64_t>() != 0) {
+        result.uv = UVMap::New(reader.readUVMap());
+    }
+    if (reader.read<std::uint64_t>() != 0) {
+        result.texture = reader.readMat();
+    }
+
+    return result;
+}
+
+void vio::WriteUVMapCache(const fs::path& path, const UVMap& uvMap)
+{
+    CacheWriter writer(path, CacheType::UVMap);
+    writer.writeUVMap(uvMap);
+    writer.close();
+}
+
+auto vio::ReadUVMapCache(const fs::path& path) -> UVMap
+{
+    if (IsFileType(path, {"uvm"})) {
+        return ReadUVMap(path);
+    }
+
+    CacheReader reader(path, CacheType::UVMap);
+    return reader.readUVMap();
+}
+
+void vio::WritePPMCache(const fs::path& path, const PerPixelMap& ppm)
+{
+    CacheWriter writer(path, CacheType::PPM);
+    writer.write(static_cast<std::uint64_t>(ppm.height()));
+    writer.write(static_cast<std::uint64_t>(ppm.width()));
+
+    // Rows of the map are contiguous
+    if (ppm.width() > 0) {
+        for (std::size_t y = 0; y < ppm.height(); y++) {
+            writer.write(&ppm(y, 0), ppm.width() * sizeof(cv::Vec6d));
+        }
+    }
+
+    writer.writeMat(ppm.mask());
+    writer.writeMat(ppm.cellMap());
+    writer.close();
+}
+
+auto vio::ReadPPMCache(const fs::path& path) -> PerPixelMap
+{
+    if (IsFileType(path, {"ppm"})) {
+        return PerPixelMap::ReadPPM(path);
+    }
+
+    CacheReader reader(path, CacheType::PPM);
+    auto height = reader.read<std::uint64_t>();
+    auto width = reader.read<std::uint64_t>();
+
+    PerPixelMap ppm(height, width);
+    const auto rowBytes = width * sizeof(cv::Vec6d);
+    if (width > 0) {
+        for (std::size_t y = 0; y < height; y++) {
+            std::memcpy(&ppm(y, 0), reader.read(rowBytes), rowBytes);
+        }
+    }
+
+    ppm.setMask(reader.readMat());
+    ppm.setCellMap(reader.readMat());
+    return ppm;
+}
@@ -5,23 +5,29 @@
 namespace vc = volcart;
 
 auto vc::Canny(const cv::Mat src, const vc::CannySettings settings) -> cv::Mat
+{
+    cv::Mat canny;
+    Canny(src, canny, settings);
+    return canny;
+}
+
+void vc::Canny(
+    const cv::Mat& src, cv::Mat& dst, const vc::CannySettings& settings)
 {
     int gaussianKernel = 2 * settings.blurSize + 1;
     int aperture = 2 * settings.apertureSize + 3;
-    cv::Mat canny;
-    cv::GaussianBlur(src, canny, {gaussianKernel, gaussianKernel}, 0);
+    cv::GaussianBlur(src, dst, {gaussianKernel, gaussianKernel}, 0);
     if (settings.bilateral) {
-        cv::bilateralFilter(canny.clone(), canny, gaussianKernel, 75, 75);
+        cv::bilateralFilter(dst.clone(), dst, gaussianKernel, 75, 75);
     }
 
     // Run Canny Edge Detect
     cv::Canny(
-        canny, canny, settings.minThreshold, settings.maxThreshold, aperture,
-        true);
+        dst, dst, settings.minThreshold, settings.maxThreshold, aperture, true);
 
     // Apply mask
     if (!settings.mask.empty()) {
-        canny.copyTo(canny, settings.mask);
+        dst.copyTo(dst, settings.mask);
     }
 
     // Replace canny edges with contour edges
@@ -29,15 +35,14 @@ auto vc::Canny(const cv::Mat src, const vc::CannySettings settings) -> cv::Mat
         int closingKernel = 2 * settings.closingSize + 1;
         // Apply closing to fill holes and gaps.
         cv::Mat kernel = cv::Mat::ones(closingKernel, closingKernel, CV_8UC1);
-        cv::morphologyEx(canny, canny, cv::MORPH_CLOSE, kernel);
+        cv::morphologyEx(dst, dst, cv::MORPH_CLOSE, kernel);
 
         std::vector<std::vector<cv::Point2i>> contours;
         cv::findContours(
-            canny, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
+            dst, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
 
-        canny = cv::Mat::zeros(src.size(), CV_8UC1);
-        cv::drawContours(canny, contours, -1, {255});
+        dst.create(src.size(), CV_8UC1);
+        dst.setTo(0);
+        cv::drawContours(dst, contours, -1, {255});
     }
-
-    return canny;
-}
\ No newline at end of file
+}
@@ -0,0 +1,96 @@
+#include "vc/core/util/ContentHash.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "vc/core/util/MemoryMappedFile.hpp"
+
+using namespace volcart;
+namespace fs = volcart::filesystem;
+
+namespace
+{
+constexpr std::uint64_t FNV_PRIME{1099511628211ULL};
+}  // namespace
+
+void ContentHash::update(const void* data, std::size_t size)
+{
+    if (size == 0) {
+        return;
+    }
+    const auto* bytes = static_cast<const char*>(data);
+
+    // Complete a word left over from the previous update
+    while (pendingSize_ > 0 and pendingSize_ < WORD and size > 0) {
+        pending_[pendingSize_++] = *bytes++;
+        size--;
+    }
+    if (pendingSize_ == WORD) {
+        mix_(pending_.data());
+        pendingSize_ = 0;
+    }
+
+    for (; size >= WORD; bytes += WORD, size -= WORD) {
+        mix_(bytes);
+    }
+
+    std::memcpy(pending_.data() + pendingSize_, bytes, size);
+    pendingSize_ += size;
+}
+
+void ContentHash::update(const std::string& str)
+{
+    update(str.data(), str.size());
+}
+
+void ContentHash::updateFile(const fs::path& path)
+{
+    if (not fs::is_directory(path)) {
+        const MemoryMappedFile file(path);
+        update(file.data(), file.size());
+        return;
+    }
+
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::directory_iterator(path)) {
+        if (fs::is_regular_file(entry.path())) {
+            files.emplace_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    for (const auto& file : files) {
+        update(file.filename().string());
+        updateFile(file);
+    }
+}
+
+auto ContentHash::digest() const -> std::uint64_t
+{
+    // Zero-pad the final partial word
+    auto hash = hash_;
+    if (pendingSize_ > 0) {
+        std::array<char, WORD> last{};
+        std::memcpy(last.data(), pending_.data(), pendingSize_);
+        std::uint64_t word{0};
+        std::memcpy(&word, last.data(), WORD);
+        hash = (hash ^ word) * ::FNV_PRIME;
+    }
+    return hash;
+}
+
+auto ContentHash::hex() const -> std::string
+{
+    std::stringstream ss;
+    ss << std::hex << std::setw(2 * WORD) << std::setfill('0') << digest();
+    return ss.str();
+}
+
+void ContentHash::mix_(const char* data)
+{
+    std::uint64_t word{0};
+    std::memcpy(&word, data, WORD);
+    hash_ = (hash_ ^ word) * ::FNV_PRIME;
+}
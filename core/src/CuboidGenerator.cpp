@@ -1,13 +1,34 @@
 #include "vc/core/neighborhood/CuboidGenerator.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <exception>
 
-static const std::vector<cv::Vec3d> BASIS_VECTORS = {
-    {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
-
 using namespace volcart;
 
+namespace
+{
+const std::array<cv::Vec3d, 3> BASIS_VECTORS{
+    cv::Vec3d{1, 0, 0}, cv::Vec3d{0, 1, 0}, cv::Vec3d{0, 0, 1}};
+
+// If v is a positive or negative unit vector along a Volume axis, set that
+// axis and the sign and return true
+auto AxisAligned(const cv::Vec3d& v, int& axis, int& sign) -> bool
+{
+    for (int i = 0; i < 3; i++) {
+        auto j = (i + 1) % 3;
+        auto k = (i + 2) % 3;
+        if (v[j] == 0 and v[k] == 0 and std::abs(v[i]) == 1) {
+            axis = i;
+            sign = (v[i] > 0) ? 1 : -1;
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
 auto CuboidGenerator::compute(
     const Volume::Pointer& v,
     const cv::Vec3d& pt,
@@ -39,44 +60,133 @@ auto CuboidGenerator::compute(
                    "). Need 3.";
         throw std::invalid_argument(msg);
     }
+    const std::array<cv::Vec3d, 3> b{bases[0], bases[1], bases[2]};
 
-    // Get center and primary radius of directional subvolume
-    auto center = pt;
-    auto radius = radius_;
-    if (direction_ != Direction::Bidirectional) {
-        radius[0] /= 2.0;
-        auto offset = bases[0] * radius[0];
-        if (direction_ == Direction::Negative) {
-            offset *= -1;
+    // Get center of directional subvolume
+    auto center = pt + b[0] * centerOffset_;
+
+    // Get the number of samples along each basis
+    const auto& [zOffsets, yOffsets, xOffsets] = offsets_;
+    Neighborhood output(
+        3, Neighborhood::Extent{
+               zOffsets.size(), yOffsets.size(), xOffsets.size()});
+    if (output.size() == 0) {
+        return output;
+    }
+
+    // Sample axis-aligned neighborhoods as a block
+    if (interval_ == 1.0) {
+        std::array<int, 3> axis{};
+        std::array<int, 3> sign{};
+        auto aligned = true;
+        for (std::size_t i = 0; i < 3 and aligned; i++) {
+            aligned = ::AxisAligned(b[i], axis[i], sign[i]);
+        }
+        if (aligned and axis[0] != axis[1] and axis[0] != axis[2] and
+            axis[1] != axis[2]) {
+            compute_aligned_(v, center, b, output);
+            return output;
         }
-        center += offset;
     }
 
-    // Get the number of samples along each basis
-    auto extent = extents();
+    // Compute each sample position from its offsets rather than stepping,
+    // so that rounding error doesn't accumulate across the neighborhood
+    auto scaled = [](const cv::Vec3d& axis, const std::vector<double>& offs) {
+        std::vector<cv::Vec3d> result;
+        result.reserve(offs.size());
+        for (const auto& o : offs) {
+            result.emplace_back(axis * o);
+        }
+        return result;
+    };
+    const auto xs = scaled(b[2], xOffsets);
+    const auto ys = scaled(b[1], yOffsets);
+    const auto zs = scaled(b[0], zOffsets);
+    std::vector<cv::Vec3d> points(output.size());
+    auto* p = points.data();
+    for (const auto& zPos : zs) {
+        for (const auto& yPos : ys) {
+            for (const auto& xPos : xs) {
+                *p++ = center + xPos + yPos + zPos;
+            }
+        }
+    }
 
-    // Iterate over the axes
-    Neighborhood output(3, extent);
-    for (std::size_t z = 0; z < extent[0]; ++z) {
-        for (std::size_t y = 0; y < extent[1]; ++y) {
-            for (std::size_t x = 0; x < extent[2]; ++x) {
+    // Sample all positions at once
+    v->interpolateAt(points.data(), points.size(), output.data());
 
-                // Offset along each axis
-                auto zOffset = -radius[0] + (z * interval_);
-                auto yOffset = -radius[1] + (y * interval_);
-                auto xOffset = -radius[2] + (x * interval_);
+    return output;
+}
 
-                // Current 3D position
-                auto p = center + (bases[2] * xOffset) + (bases[1] * yOffset) +
-                         (bases[0] * zOffset);
+void CuboidGenerator::compute_aligned_(
+    const Volume::Pointer& v,
+    const cv::Vec3d& center,
+    const std::array<cv::Vec3d, 3>& bases,
+    Neighborhood& output) const
+{
+    // Block origin and size in Volume axis order. Generator axis i runs
+    // along Volume axis axis[i], possibly in the negative direction.
+    std::array<int, 3> axis{};
+    std::array<int, 3> sign{};
+    cv::Vec3d origin;
+    cv::Vec3i size;
+    for (std::size_t i = 0; i < 3; i++) {
+        ::AxisAligned(bases[i], axis[i], sign[i]);
+        const auto& offsets = offsets_[i];
+        auto first = sign[i] * offsets.front();
+        auto last = sign[i] * offsets.back();
+        origin[axis[i]] = center[axis[i]] + std::min(first, last);
+        size[axis[i]] = static_cast<int>(offsets.size());
+    }
 
-                // Assign to the subvolume array
-                output(z, y, x) = v->interpolateAt(p);
+    std::vector<double> block(output.size());
+    v->interpolateBlock(origin, size, block.data());
+
+    // Block strides along each generator axis
+    const std::array<std::ptrdiff_t, 3> volStride{
+        1, size[0], static_cast<std::ptrdiff_t>(size[0]) * size[1]};
+    std::array<std::ptrdiff_t, 3> stride{};
+    std::ptrdiff_t start{0};
+    for (std::size_t i = 0; i < 3; i++) {
+        stride[i] = sign[i] * volStride[axis[i]];
+        if (sign[i] < 0) {
+            start += (size[axis[i]] - 1) * volStride[axis[i]];
+        }
+    }
+
+    auto* out = output.data();
+    for (int z = 0; z < size[axis[0]]; z++) {
+        for (int y = 0; y < size[axis[1]]; y++) {
+            const auto* in = block.data() + start + z * stride[0] +
+                             y * stride[1];
+            for (int x = 0; x < size[axis[2]]; x++, in += stride[2]) {
+                *out++ = static_cast<std::uint16_t>(cvRound(*in));
             }
         }
     }
+}
 
-    return output;
+void CuboidGenerator::update_offsets_()
+{
+    // Directional neighborhoods cover half of the first axis, centered
+    // halfway along it
+    auto radius = radius_;
+    centerOffset_ = 0;
+    if (direction_ != Direction::Bidirectional) {
+        radius[0] /= 2.0;
+        centerOffset_ = radius[0];
+        if (direction_ == Direction::Negative) {
+            centerOffset_ *= -1;
+        }
+    }
+
+    auto extent = extents();
+    for (std::size_t i = 0; i < 3; i++) {
+        offsets_[i].resize(extent[i]);
+        for (std::size_t j = 0; j < extent[i]; j++) {
+            offsets_[i][j] = -radius[i] + (j * interval_);
+        }
+    }
 }
 
 auto CuboidGenerator::extents() const -> Neighborhood::Extent
@@ -93,4 +203,4 @@ auto CuboidGenerator::extents() const -> Neighborhood::Extent
         static_cast<std::size_t>(std::floor(2.0 * radius_[2] / interval_) + 1));
 
     return extent;
-}
\ No newline at end of file
+}
@@ -53,16 +53,22 @@ auto vc::DepthToString(int depth) -> std::string
 }
 
 auto vc::QuantizeImage(const cv::Mat& m, int depth, bool scaleMinMax) -> cv::Mat
+{
+    cv::Mat output;
+    QuantizeImage(m, output, depth, scaleMinMax);
+    return output;
+}
+
+void vc::QuantizeImage(
+    const cv::Mat& m, cv::Mat& output, int depth, bool scaleMinMax)
 {
     // Make sure we have work to do
     if (m.depth() == depth) {
         // Depth already matches. Do nothing.
-        return m;
+        output = m;
+        return;
     }
 
-    // Copy to output
-    auto output = m.clone();
-
     // Setup the max value for integer images
     double outputMax{1.0};
     switch (depth) {
@@ -87,7 +93,7 @@ auto vc::QuantizeImage(const cv::Mat& m, int depth, bool scaleMinMax) -> cv::Mat
     double min{0};
     double max{1};
     if (scaleMinMax) {
-        cv::minMaxLoc(output, &min, &max);
+        cv::minMaxLoc(m, &min, &max);
     } else {
         switch (m.depth()) {
             case CV_8U:
@@ -107,10 +113,11 @@ auto vc::QuantizeImage(const cv::Mat& m, int depth, bool scaleMinMax) -> cv::Mat
                 break;
         }
     }
-    output.convertTo(
-        output, depth, outputMax / (max - min), -min * outputMax / (max - min));
 
-    return output;
+    // Convert directly into the output. Reuses the output's buffer when it
+    // already has the right size and type.
+    m.convertTo(
+        output, depth, outputMax / (max - min), -min * outputMax / (max - min));
 }
 
 auto vc::ColorConvertImage(const cv::Mat& m, int channels) -> cv::Mat
@@ -1,5 +1,8 @@
 #include "vc/core/io/ImageIO.hpp"
 
+#include <string>
+#include <tuple>
+
 #include <opencv2/imgcodecs.hpp>
 
 #include "vc/core/io/FileExtensionFilter.hpp"
@@ -7,6 +10,7 @@
 #include "vc/core/types/Exceptions.hpp"
 #include "vc/core/util/ImageConversion.hpp"
 #include "vc/core/util/Logging.hpp"
+#include "vc/core/util/String.hpp"
 
 using namespace volcart;
 
@@ -14,6 +18,52 @@ namespace vc = volcart;
 namespace fs = volcart::filesystem;
 namespace tio = volcart::tiffio;
 
+auto vc::ImageSequencePaths(
+    const fs::path& path, std::size_t count, std::optional<int> padding)
+    -> std::vector<fs::path>
+{
+    // components
+    fs::path parent;
+    std::string prefix;
+    std::string suffix;
+    fs::path ext;
+
+    // If directory, default to dir/###.tif
+    if (fs::is_directory(path)) {
+        parent = path;
+        ext = ".tif";
+    }
+
+    // If path, decompose to replace {} with a number
+    else {
+        parent = path.parent_path();
+        ext = path.extension();
+
+        // Split into a prefix and suffix
+        auto stem = path.stem().string();
+        std::string sep;
+        std::tie(prefix, sep, suffix) = partition(stem, "{}");
+
+        // Log when separator not found
+        if (sep.empty()) {
+            Logger()->debug(
+                "Index placement separator \\{\\} not found in stem: {}", stem);
+        }
+    }
+
+    // Setup padding (default or user-provided)
+    auto pad = static_cast<int>(std::to_string(count).size());
+    pad = padding.value_or(pad);
+
+    std::vector<fs::path> paths;
+    paths.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const auto name = prefix + to_padded_string(i, pad) + suffix;
+        paths.emplace_back((parent / name).replace_extension(ext));
+    }
+    return paths;
+}
+
 auto vc::ReadImage(const fs::path& path) -> cv::Mat
 {
     return cv::imread(path.string(), cv::IMREAD_UNCHANGED);
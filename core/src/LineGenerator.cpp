@@ -1,5 +1,6 @@
 #include "vc/core/neighborhood/LineGenerator.hpp"
 
+#include <cmath>
 #include <cstddef>
 
 #include "vc/core/util/FloatComparison.hpp"
@@ -23,6 +24,28 @@ auto LineGenerator::compute(
         throw std::domain_error("Sampling interval too small");
     }
 
+    // Compute each sample position from its offset rather than stepping, so
+    // that rounding error doesn't accumulate along the line
+    std::vector<cv::Vec3d> points;
+    points.reserve(offsets_.size());
+    for (const auto& o : offsets_) {
+        points.emplace_back(pt + axes[0] * o);
+    }
+
+    // Sample all positions at once
+    Neighborhood n(1, points.size());
+    v->interpolateAt(points.data(), points.size(), n.data());
+
+    return n;
+}
+
+void LineGenerator::update_offsets_()
+{
+    offsets_.clear();
+    if (AlmostEqual(interval_, 0.0)) {
+        return;
+    }
+
     // Make sure radius is positive
     auto radius = std::abs(radius_[0]);
 
@@ -46,16 +69,12 @@ auto LineGenerator::compute(
         }
     }
 
-    // Iterate through range
     auto count =
         static_cast<std::size_t>(std::floor((max - min) / interval_) + 1);
-    Neighborhood n(1, count);
+    offsets_.resize(count);
     for (std::size_t it = 0; it < count; it++) {
-        auto offset = min + (it * interval_);
-        n(it) = v->interpolateAt(pt + (axes[0] * offset));
+        offsets_[it] = min + (it * interval_);
     }
-
-    return n;
 }
 
 auto LineGenerator::extents() const -> Neighborhood::Extent
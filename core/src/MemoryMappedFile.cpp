@@ -0,0 +1,48 @@
+#include "vc/core/util/MemoryMappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vc/core/types/Exceptions.hpp"
+
+using namespace volcart;
+namespace fs = volcart::filesystem;
+
+MemoryMappedFile::MemoryMappedFile(const fs::path& path)
+{
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw IOException("could not open file '" + path.string() + "'");
+    }
+
+    struct stat info {
+    };
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw IOException("could not stat file '" + path.string() + "'");
+    }
+
+    // Empty files can't be mapped
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) {
+        auto* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            throw IOException("could not map file '" + path.string() + "'");
+        }
+        ::madvise(addr, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(addr);
+    }
+
+    // The mapping remains valid after the file is closed
+    ::close(fd);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
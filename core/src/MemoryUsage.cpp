@@ -0,0 +1,36 @@
+#include "vc/core/util/MemoryUsage.hpp"
+
+#include <fstream>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace volcart;
+
+auto volcart::CurrentResidentMemory() -> std::size_t
+{
+    // Only available through procfs
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size{0};
+    std::size_t resident{0};
+    if (not(statm >> size >> resident)) {
+        return 0;
+    }
+    return resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+auto volcart::PeakResidentMemory() -> std::size_t
+{
+    rusage usage{};
+    if (::getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    auto peak = static_cast<std::size_t>(usage.ru_maxrss);
+#if defined(__APPLE__)
+    // Reported in bytes
+    return peak;
+#else
+    // Reported in kilobytes
+    return peak * 1024;
+#endif
+}
@@ -1,5 +1,6 @@
 #include "vc/core/io/MeshIO.hpp"
 
+#include "vc/core/io/CacheIO.hpp"
 #include "vc/core/io/FileExtensionFilter.hpp"
 #include "vc/core/io/OBJReader.hpp"
 #include "vc/core/io/OBJWriter.hpp"
@@ -33,6 +34,11 @@ auto volcart::ReadMesh(const filesystem::path& path) -> MeshReaderResult
         result.mesh = r.read();
     }
 
+    // Binary mesh caches
+    else if (IsFileType(path, {"vcmesh"})) {
+        result = ReadMeshCache(path);
+    }
+
     // Can't load file
     else {
         auto msg = "Mesh file not of supported type: " + path.string();
@@ -67,4 +73,8 @@ void volcart::WriteMesh(
         // TODO: Add texture writing support back
         writer.write();
     }
+
+    else if (IsFileType(path, {"vcmesh"})) {
+        WriteMeshCache(path, mesh, uv, texture);
+    }
 }
@@ -1,12 +1,16 @@
 #include "vc/core/io/OBJReader.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <regex>
 #include <string>
 
 #include "vc/core/io/ImageIO.hpp"
 #include "vc/core/types/Exceptions.hpp"
+#include "vc/core/util/CharConv.hpp"
 #include "vc/core/util/Logging.hpp"
+#include "vc/core/util/MemoryMappedFile.hpp"
 #include "vc/core/util/String.hpp"
 
 using namespace volcart;
@@ -18,6 +22,37 @@ namespace fs = volcart::filesystem;
 constexpr static int NOT_PRESENT = -1;
 constexpr static std::size_t VALID_FACE_SIZE = 3;
 
+namespace
+{
+auto IsSpace(char c) -> bool { return c == ' ' or c == '\t' or c == '\r'; }
+
+template <typename T>
+auto ToNumber(std::string_view s) -> T
+{
+    T v{};
+    const auto* end = s.data() + s.size();
+    if (s.empty() or ParseNumber(s.data(), end, v) != end) {
+        throw IOException("Invalid number in obj file: " + std::string(s));
+    }
+    return v;
+}
+
+// Convert a face reference to a 1-based index. Negative references count
+// back from the last of the `count` elements parsed so far.
+auto ToIndex(std::string_view s, std::size_t count) -> int
+{
+    auto ref = ToNumber<int>(s);
+    if (ref >= 0) {
+        return ref;
+    }
+    auto index = static_cast<int>(count) + ref + 1;
+    if (index < 1) {
+        throw IOException("Invalid face reference in obj file");
+    }
+    return index;
+}
+}  // namespace
+
 void OBJReader::setPath(const filesystem::path& p) { path_ = p; }
 
 auto OBJReader::getMesh() -> ITKMesh::Pointer { return mesh_; }
@@ -50,122 +85,139 @@ void OBJReader::reset_()
 // Parse the file
 void OBJReader::parse_()
 {
-    std::regex vertex{"^v"};
-    std::regex normal{"^vn"};
-    std::regex tcoord{"^vt"};
-    std::regex face{"^f"};
-    std::regex mtllib("^mtllib");
-
-    std::ifstream ifs(path_.string());
-    if (!ifs.good()) {
-        throw IOException("Failed to open file for reading");
-    }
-
-    std::string line;
-    std::vector<std::string> strs;
-    while (std::getline(ifs, line)) {
-        // Parse the line
-        trim(line);
-        strs = split(line, ' ');
-        std::for_each(
-            std::begin(strs), std::end(strs), [](auto& s) { trim(s); });
+    const MemoryMappedFile file(path_);
+    const auto* pos = file.data();
+    const auto* end = file.data() + file.size();
+
+    std::vector<std::string_view> strs;
+    while (pos < end) {
+        // Split the line into tokens
+        const auto* eol = static_cast<const char*>(
+            std::memchr(pos, '\n', static_cast<std::size_t>(end - pos)));
+        if (eol == nullptr) {
+            eol = end;
+        }
+        strs.clear();
+        while (pos < eol) {
+            pos = std::find_if_not(pos, eol, IsSpace);
+            const auto* tokenEnd = std::find_if(pos, eol, IsSpace);
+            if (tokenEnd != pos) {
+                strs.emplace_back(pos, tokenEnd - pos);
+            }
+            pos = tokenEnd;
+        }
+        pos = (eol == end) ? end : eol + 1;
         if (strs.empty()) {
             continue;
         }
 
         // Handle vertices
-        if (std::regex_match(strs[0], vertex)) {
+        if (strs[0] == "v") {
             parse_vertex_(strs);
         }
 
         // Handle normals
-        else if (std::regex_match(strs[0], normal)) {
+        else if (strs[0] == "vn") {
             parse_normal_(strs);
         }
 
         // Handle texture coordinates
-        else if (std::regex_match(strs[0], tcoord)) {
+        else if (strs[0] == "vt") {
             parse_tcoord_(strs);
         }
 
         // Handle faces
-        else if (std::regex_match(strs[0], face)) {
+        else if (strs[0] == "f") {
             parse_face_(strs);
         }
 
         // Handle mtllib
-        else if (std::regex_match(strs[0], mtllib)) {
+        else if (strs[0] == "mtllib") {
             parse_mtllib_(strs);
         }
-
-        // Otherwise clear and continue
-        strs.clear();
     }
-
-    ifs.close();
 }
 
-void OBJReader::parse_vertex_(const std::vector<std::string>& strs)
+void OBJReader::parse_vertex_(const std::vector<std::string_view>& strs)
 {
-    auto a = std::stod(strs[1]);
-    auto b = std::stod(strs[2]);
-    auto c = std::stod(strs[3]);
+    if (strs.size() < 4) {
+        throw IOException("Invalid vertex in obj file");
+    }
+    auto a = ToNumber<double>(strs[1]);
+    auto b = ToNumber<double>(strs[2]);
+    auto c = ToNumber<double>(strs[3]);
     vertices_.emplace_back(a, b, c);
 }
 
-void OBJReader::parse_normal_(const std::vector<std::string>& strs)
+void OBJReader::parse_normal_(const std::vector<std::string_view>& strs)
 {
-    auto a = std::stod(strs[1]);
-    auto b = std::stod(strs[2]);
-    auto c = std::stod(strs[3]);
+    if (strs.size() < 4) {
+        throw IOException("Invalid normal in obj file");
+    }
+    auto a = ToNumber<double>(strs[1]);
+    auto b = ToNumber<double>(strs[2]);
+    auto c = ToNumber<double>(strs[3]);
     normals_.emplace_back(a, b, c);
 }
 
-void OBJReader::parse_tcoord_(const std::vector<std::string>& strs)
+void OBJReader::parse_tcoord_(const std::vector<std::string_view>& strs)
 {
-    auto u = std::stod(strs[1]);
-    auto v = std::stod(strs[2]);
+    if (strs.size() < 3) {
+        throw IOException("Invalid texture coordinate in obj file");
+    }
+    auto u = ToNumber<double>(strs[1]);
+    auto v = ToNumber<double>(strs[2]);
     uvs_.emplace_back(u, v);
 }
 
-void OBJReader::parse_face_(const std::vector<std::string>& strs)
+void OBJReader::parse_face_(const std::vector<std::string_view>& strs)
 {
     OBJReader::Face f;
-    std::vector<std::string> vinfo;
-    std::vector<std::string> sub(std::begin(strs) + 1, std::end(strs));
-
-    for (const auto& s : sub) {
+    for (auto it = std::next(strs.begin()); it != strs.end(); ++it) {
+        const auto& s = *it;
         auto faceType = classify_vertref_(s);
-        vinfo = split(s, '/');
+
+        // Split the reference into its v/vt/vn components
+        auto slash0 = s.find('/');
+        auto slash1 = s.find('/', slash0 + 1);
+        auto v = ToIndex(s.substr(0, slash0), vertices_.size());
         switch (faceType) {
             case RefType::Vertex:
-                f.emplace_back(std::stoi(vinfo[0]), NOT_PRESENT, NOT_PRESENT);
+                f.emplace_back(v, NOT_PRESENT, NOT_PRESENT);
                 break;
             case RefType::VertexWithTexture:
                 f.emplace_back(
-                    std::stoi(vinfo[0]), std::stoi(vinfo[1]), NOT_PRESENT);
+                    v, ToIndex(s.substr(slash0 + 1), uvs_.size()),
+                    NOT_PRESENT);
                 break;
             case RefType::VertexWithNormal:
                 f.emplace_back(
-                    std::stoi(vinfo[0]), NOT_PRESENT, std::stoi(vinfo[1]));
+                    v, NOT_PRESENT,
+                    ToIndex(s.substr(slash1 + 1), normals_.size()));
                 break;
             case RefType::VertexWithTextureAndNormal:
                 f.emplace_back(
-                    std::stoi(vinfo[0]), std::stoi(vinfo[1]),
-                    std::stoi(vinfo[2]));
+                    v,
+                    ToIndex(
+                        s.substr(slash0 + 1, slash1 - slash0 - 1),
+                        uvs_.size()),
+                    ToIndex(s.substr(slash1 + 1), normals_.size()));
                 break;
             case RefType::Invalid:
                 throw IOException("Invalid face in obj file");
         }
-        vinfo.clear();
     }
     faces_.push_back(f);
 }
 
-void OBJReader::parse_mtllib_(const std::vector<std::string>& strs)
+void OBJReader::parse_mtllib_(const std::vector<std::string_view>& strs)
 {
+    if (strs.size() < 2) {
+        throw IOException("Invalid mtllib in obj file");
+    }
+
     // Get mtl path, relative to OBJ directory
-    fs::path mtlPath = path_.parent_path() / strs[1];
+    fs::path mtlPath = path_.parent_path() / std::string(strs[1]);
 
     // Open the mtl file
     std::ifstream ifs(mtlPath.string());
@@ -197,7 +249,7 @@ void OBJReader::parse_mtllib_(const std::vector<std::string>& strs)
     ifs.close();
 }
 
-auto OBJReader::classify_vertref_(const std::string& ref) -> OBJReader::RefType
+auto OBJReader::classify_vertref_(std::string_view ref) -> OBJReader::RefType
 {
     const char delimiter = '/';
     auto slashCount = std::count(ref.begin(), ref.end(), delimiter);
@@ -1,14 +1,19 @@
 #include "vc/core/io/OBJWriter.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
 #include "vc/core/io/ImageIO.hpp"
 #include "vc/core/types/Exceptions.hpp"
+#include "vc/core/util/CharConv.hpp"
 #include "vc/core/util/Logging.hpp"
 
 static constexpr int UNSET_VALUE = -1;
 
+// Size at which the output buffer is written to disk
+static constexpr std::size_t BUFFER_SIZE{1 << 20};
+
 using namespace volcart;
 using namespace volcart::io;
 
@@ -68,6 +73,8 @@ void OBJWriter::write_obj_()
         throw IOException(msg);
     }
 
+    buffer_.clear();
+    buffer_.reserve(BUFFER_SIZE);
     write_header_();
     write_vertices_();
 
@@ -77,6 +84,7 @@ void OBJWriter::write_obj_()
     }
 
     write_faces_();
+    flush_buffer_(true);
     outputMesh_.flush();
     outputMesh_.close();
     if (outputMesh_.fail()) {
@@ -158,7 +166,19 @@ void OBJWriter::write_vertices_()
 
     outputMesh_ << "# Vertices: " << mesh_->GetNumberOfPoints() << "\n";
 
+    // Write 'prefix a b c'
+    auto writeVec3 = [this](const char* prefix, const auto& v) {
+        buffer_ += prefix;
+        for (int i = 0; i < 3; i++) {
+            buffer_ += ' ';
+            AppendNumber(buffer_, v[i]);
+        }
+        buffer_ += '\n';
+    };
+
     // Iterate over all of the points
+    pointLinks_.assign(
+        mesh_->GetNumberOfPoints(), {UNSET_VALUE, UNSET_VALUE, UNSET_VALUE});
     std::uint32_t vIndex = 1;
     std::uint32_t vnIndex = 1;
     for (auto pt = mesh_->GetPoints()->Begin(); pt != mesh_->GetPoints()->End();
@@ -167,21 +187,23 @@ void OBJWriter::write_vertices_()
         cv::Vec3i pointLink(vIndex, UNSET_VALUE, UNSET_VALUE);
 
         // Write the point position components
-        outputMesh_ << "v " << pt.Value()[0] << " " << pt.Value()[1] << " "
-                    << pt.Value()[2] << "\n";
+        writeVec3("v", pt.Value());
 
         // Write the point normal information
         ITKPixel normal;
         if (mesh_->GetPointData(pt.Index(), &normal)) {
-            outputMesh_ << "vn " << normal[0] << " " << normal[1] << " "
-                        << normal[2] << "\n";
+            writeVec3("vn", normal);
             pointLink[2] = vnIndex++;
         }
 
         // Add this vertex to the point links
-        pointLinks_.insert({pt.Index(), pointLink});
+        if (pt.Index() >= pointLinks_.size()) {
+            pointLinks_.resize(pt.Index() + 1);
+        }
+        pointLinks_[pt.Index()] = pointLink;
 
         ++vIndex;
+        flush_buffer_();
     }
 }
 
@@ -200,6 +222,7 @@ void OBJWriter::write_texture_coordinates_()
     // Write mtl path, relative to OBJ
     auto mtlpath = outputPath_.stem();
     mtlpath.replace_extension("mtl");
+    flush_buffer_(true);
     outputMesh_ << "# Texture information\n";
     outputMesh_ << "mtllib " << mtlpath.string() << "\n";
     outputMesh_ << "usemtl default\n";
@@ -208,13 +231,20 @@ void OBJWriter::write_texture_coordinates_()
     std::uint32_t vtIndex = 1;
     for (std::uint32_t pId = 0; pId < uvMap_->size(); ++pId) {
         cv::Vec2d uv = uvMap_->get(pId);
-        outputMesh_ << "vt " << uv[0] << " " << uv[1] << "\n";
-
-        // Find this UV map's point in _point_links and set its vt value to our
-        // current position in the vt list
-        pointLinks_.find(pId)->second[1] = vtIndex;
+        buffer_ += "vt ";
+        AppendNumber(buffer_, uv[0]);
+        buffer_ += ' ';
+        AppendNumber(buffer_, uv[1]);
+        buffer_ += '\n';
+
+        // Set this UV map point's vt value to our current position in the vt
+        // list
+        if (pId < pointLinks_.size()) {
+            pointLinks_[pId][1] = vtIndex;
+        }
 
         ++vtIndex;
+        flush_buffer_();
     }
 
     // Restore the starting origin
@@ -229,6 +259,8 @@ void OBJWriter::write_faces_()
     }
     Logger()->debug("Writing faces...");
 
+    // Header is written directly, so flush the buffered vertices first
+    flush_buffer_(true);
     outputMesh_ << "# Faces: " << mesh_->GetNumberOfCells() << "\n";
 
     // Iterate over the faces of the mesh
@@ -236,33 +268,45 @@ void OBJWriter::write_faces_()
     for (auto cell = mesh_->GetCells()->Begin();
          cell != mesh_->GetCells()->End(); ++cell) {
         // Starts a new face line
-        outputMesh_ << "f ";
+        buffer_ += "f ";
 
         // Iterate over the points of this face
         for (point = cell.Value()->PointIdsBegin();
              point != cell.Value()->PointIdsEnd(); ++point) {
 
-            cv::Vec3i pointLink = pointLinks_.find(*point)->second;
+            const auto& pointLink = pointLinks_.at(*point);
 
-            outputMesh_ << pointLink[0];
+            AppendNumber(buffer_, pointLink[0]);
 
             // Write the vtIndex
             if (pointLink[1] != UNSET_VALUE) {
-                outputMesh_ << "/" << pointLink[1];
+                buffer_ += '/';
+                AppendNumber(buffer_, pointLink[1]);
             }
 
             // Write the vnIndex
             if (pointLink[2] != UNSET_VALUE) {
                 // Write a buffer slash if there wasn't a vtIndex
                 if (pointLink[1] == UNSET_VALUE) {
-                    outputMesh_ << "/";
+                    buffer_ += '/';
                 }
 
-                outputMesh_ << "/" << pointLink[2];
+                buffer_ += '/';
+                AppendNumber(buffer_, pointLink[2]);
             }
 
-            outputMesh_ << " ";
+            buffer_ += ' ';
         }
-        outputMesh_ << "\n";
+        buffer_ += '\n';
+        flush_buffer_();
+    }
+}
+
+void OBJWriter::flush_buffer_(bool force)
+{
+    if (force or buffer_.size() >= BUFFER_SIZE) {
+        outputMesh_.write(
+            buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
     }
 }
@@ -1,180 +1,469 @@
 #include "vc/core/io/PLYReader.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
 
 #include "vc/core/types/Exceptions.hpp"
+#include "vc/core/util/CharConv.hpp"
 #include "vc/core/util/Logging.hpp"
+#include "vc/core/util/MemoryMappedFile.hpp"
 #include "vc/core/util/String.hpp"
 
 using namespace volcart;
 using namespace volcart::io;
 namespace fs = volcart::filesystem;
 
-auto PLYReader::read() -> ITKMesh::Pointer
+namespace
 {
-    if (inputPath_.empty() || !fs::exists(inputPath_)) {
-        auto msg = "File not provided or does not exist.";
-        throw volcart::IOException(msg);
-    }
+enum class Format { ASCII, BinaryLittleEndian, BinaryBigEndian };
 
-    // Resets values of member variables in case of 2nd reading
-    pointList_.clear();
-    faceList_.clear();
-    properties_.clear();
-    elementsList_.clear();
-    outMesh_ = ITKMesh::New();
-    numVertices_ = 0;
-    numFaces_ = 0;
-    hasLeadingChar_ = true;
-    hasPointNorm_ = false;
+enum class Type { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
 
-    int skippedElementCnt = 0;
+// Vertex fields which are kept
+enum class Field { None, X, Y, Z, NX, NY, NZ, R, G, B };
 
-    plyFile_.open(inputPath_.string());
-    if (!plyFile_.is_open()) {
-        auto msg = "Open file " + inputPath_.string() + " failed.";
-        throw volcart::IOException(msg);
+struct Property {
+    std::string name;
+    Type type{Type::Float32};
+    bool isList{false};
+    Type countType{Type::UInt8};
+};
+
+struct Element {
+    std::string name;
+    std::size_t count{0};
+    std::vector<Property> properties;
+};
+
+struct Header {
+    Format format{Format::ASCII};
+    std::vector<Element> elements;
+    // Size of the header in bytes
+    std::size_t size{0};
+};
+
+auto ParseType(const std::string& s) -> Type
+{
+    if (s == "char" or s == "int8") {
+        return Type::Int8;
     }
-    parse_header_();
-    for (auto& cur : elementsList_) {
-        if (cur == "vertex") {
-            read_points_();
-        } else if (cur == "face") {
-            read_faces_();
-        } else {
-            int curSkip = skippedLine_[skippedElementCnt];
-            for (int i = 0; i < curSkip; i++) {
-                std::getline(plyFile_, line_);
-            }
-            skippedElementCnt++;
-        }
+    if (s == "uchar" or s == "uint8") {
+        return Type::UInt8;
     }
-    plyFile_.close();
-    create_mesh_();
+    if (s == "short" or s == "int16") {
+        return Type::Int16;
+    }
+    if (s == "ushort" or s == "uint16") {
+        return Type::UInt16;
+    }
+    if (s == "int" or s == "int32") {
+        return Type::Int32;
+    }
+    if (s == "uint" or s == "uint32") {
+        return Type::UInt32;
+    }
+    if (s == "float" or s == "float32") {
+        return Type::Float32;
+    }
+    if (s == "double" or s == "float64") {
+        return Type::Float64;
+    }
+    throw IOException("Unsupported PLY property type: " + s);
+}
 
-    return outMesh_;
+auto IsFloatingPoint(Type t) -> bool
+{
+    return t == Type::Float32 or t == Type::Float64;
 }
 
-void PLYReader::parse_header_()
+auto ParseHeader(const char* data, std::size_t size) -> Header
 {
-    std::getline(plyFile_, line_);
-    while (line_ != "end_header") {
-        if (line_.find("element") != std::string::npos) {
-            auto splitLine = split(line_, ' ');
-            elementsList_.push_back(splitLine[1]);
-            if (splitLine[1] == "vertex") {
-                numVertices_ = std::stoi(splitLine[2]);
-            } else if (splitLine[1] == "face") {
-                numFaces_ = std::stoi(splitLine[2]);
+    Header header;
+    bool hasFormat{false};
+    std::size_t pos{0};
+    std::size_t lineNum{0};
+    while (true) {
+        if (pos >= size) {
+            throw IOException("PLY header is missing end_header");
+        }
+
+        // Get the next line without the line ending
+        const auto* lineEnd = static_cast<const char*>(
+            std::memchr(data + pos, '\n', size - pos));
+        auto lineSize =
+            (lineEnd == nullptr)
+                ? size - pos
+                : static_cast<std::size_t>(lineEnd - (data + pos));
+        std::string line(data + pos, lineSize);
+        pos += lineSize + 1;
+        trim(line);
+        auto tokens = split(line, ' ', '\t');
+
+        if (lineNum++ == 0) {
+            if (line != "ply") {
+                throw IOException("Not a PLY file");
+            }
+        } else if (tokens.empty() or tokens[0] == "comment" or
+                   tokens[0] == "obj_info") {
+            continue;
+        } else if (tokens[0] == "end_header") {
+            break;
+        } else if (tokens[0] == "format" and tokens.size() >= 2) {
+            if (tokens[1] == "ascii") {
+                header.format = Format::ASCII;
+            } else if (tokens[1] == "binary_little_endian") {
+                header.format = Format::BinaryLittleEndian;
+            } else if (tokens[1] == "binary_big_endian") {
+                header.format = Format::BinaryBigEndian;
             } else {
-                skippedLine_.push_back(std::stoi(splitLine[2]));
+                throw IOException("Unsupported PLY format: " + tokens[1]);
             }
-            std::getline(plyFile_, line_);
-            splitLine = split(line_, ' ');
-            int currentLine{0};
-            while (splitLine[0] == "property") {
-                if (splitLine[1] == "list") {
-                    hasLeadingChar_ = line_.find("uchar") != std::string::npos;
-                }
-                // Not sure how to handle if it's not the vertices or faces
-                else {
-                    if (splitLine[2] == "nx") {
-                        hasPointNorm_ = true;
-                    }
-                    properties_[splitLine[2]] = currentLine;
-                }
-                std::getline(plyFile_, line_);
-                currentLine++;
-                splitLine = split(line_, ' ');
+            hasFormat = true;
+        } else if (tokens[0] == "element" and tokens.size() == 3) {
+            Element e;
+            e.name = tokens[1];
+            const auto& c = tokens[2];
+            if (ParseNumber(c.data(), c.data() + c.size(), e.count) !=
+                c.data() + c.size()) {
+                throw IOException("Invalid PLY element count: " + c);
             }
+            header.elements.push_back(e);
+        } else if (tokens[0] == "property" and not header.elements.empty()) {
+            Property p;
+            if (tokens.size() == 5 and tokens[1] == "list") {
+                p.isList = true;
+                p.countType = ParseType(tokens[2]);
+                p.type = ParseType(tokens[3]);
+                p.name = tokens[4];
+            } else if (tokens.size() == 3) {
+                p.type = ParseType(tokens[1]);
+                p.name = tokens[2];
+            } else {
+                throw IOException("Invalid PLY property: " + line);
+            }
+            header.elements.back().properties.push_back(p);
         } else {
-            std::getline(plyFile_, line_);
+            throw IOException("Invalid PLY header line: " + line);
         }
     }
-    if (numFaces_ == 0) {
-        Logger()->warn("Warning: No face information found");
+
+    if (not hasFormat) {
+        throw IOException("PLY header is missing format");
     }
-    std::getline(plyFile_, line_);
+    header.size = std::min(pos, size);
+    return header;
+}
 
-}  // ParseHeader
+auto HostIsLittleEndian() -> bool
+{
+    const std::uint16_t one{1};
+    std::uint8_t first{0};
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
 
-void PLYReader::read_points_()
+// Reads property values from the body of a PLY file
+class BodyReader
 {
-    for (int i = 0; i < numVertices_; i++) {
-        SimpleMesh::Vertex curPoint;
-        auto curLine = split(line_, ' ');
-        curPoint.x = std::stod(curLine[properties_["x"]]);
-        curPoint.y = std::stod(curLine[properties_["y"]]);
-        curPoint.z = std::stod(curLine[properties_["z"]]);
-        if (properties_.find("nx") != properties_.end()) {
-            curPoint.nx = std::stod(curLine[properties_["nx"]]);
-            curPoint.ny = std::stod(curLine[properties_["ny"]]);
-            curPoint.nz = std::stod(curLine[properties_["nz"]]);
+public:
+    BodyReader(const char* first, const char* last, Format format)
+        : pos_{first}
+        , end_{last}
+        , format_{format}
+        , swap_{
+              format != Format::ASCII and
+              (format == Format::BinaryLittleEndian) != HostIsLittleEndian()}
+    {
+    }
+
+    // Read a single value of the given type and convert it to T
+    template <typename T>
+    auto read(Type type) -> T
+    {
+        if (format_ == Format::ASCII) {
+            return read_ascii_<T>(type);
+        }
+        switch (type) {
+            case Type::Int8:
+                return static_cast<T>(read_binary_<std::int8_t>());
+            case Type::UInt8:
+                return static_cast<T>(read_binary_<std::uint8_t>());
+            case Type::Int16:
+                return static_cast<T>(read_binary_<std::int16_t>());
+            case Type::UInt16:
+                return static_cast<T>(read_binary_<std::uint16_t>());
+            case Type::Int32:
+                return static_cast<T>(read_binary_<std::int32_t>());
+            case Type::UInt32:
+                return static_cast<T>(read_binary_<std::uint32_t>());
+            case Type::Float32:
+                return static_cast<T>(read_binary_<float>());
+            case Type::Float64:
+                return static_cast<T>(read_binary_<double>());
+        }
+        return T{};
+    }
+
+    // Read and discard a property
+    void skip(const Property& p)
+    {
+        std::size_t count{1};
+        if (p.isList) {
+            count = read<std::size_t>(p.countType);
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            read<double>(p.type);
+        }
+    }
+
+private:
+    template <typename T>
+    auto read_ascii_(Type type) -> T
+    {
+        // Find the next whitespace separated token
+        auto isSpace = [](char c) {
+            return c == ' ' or c == '\t' or c == '\r' or c == '\n';
+        };
+        pos_ = std::find_if_not(pos_, end_, isSpace);
+        if (pos_ == end_) {
+            throw IOException("Unexpected end of PLY file");
+        }
+        const auto* last = std::find_if(pos_, end_, isSpace);
+
+        // Parse integer types as integers to keep large indices exact
+        T result;
+        const char* parsed{nullptr};
+        if (IsFloatingPoint(type)) {
+            double v{0};
+            parsed = ParseNumber(pos_, last, v);
+            result = static_cast<T>(v);
+        } else {
+            std::int64_t v{0};
+            parsed = ParseNumber(pos_, last, v);
+            result = static_cast<T>(v);
         }
-        if (properties_.find("r") != properties_.end()) {
-            curPoint.r = stoi(curLine[properties_["r"]]);
-            curPoint.g = stoi(curLine[properties_["g"]]);
-            curPoint.b = stoi(curLine[properties_["b"]]);
+        if (parsed != last) {
+            throw IOException(
+                "Invalid PLY value: " + std::string(pos_, last - pos_));
         }
-        pointList_.push_back(curPoint);
-        std::getline(plyFile_, line_);
+        pos_ = last;
+        return result;
     }
+
+    template <typename T>
+    auto read_binary_() -> T
+    {
+        if (static_cast<std::size_t>(end_ - pos_) < sizeof(T)) {
+            throw IOException("Unexpected end of PLY file");
+        }
+        std::array<char, sizeof(T)> bytes{};
+        std::memcpy(bytes.data(), pos_, sizeof(T));
+        if (swap_) {
+            std::reverse(bytes.begin(), bytes.end());
+        }
+        T v;
+        std::memcpy(&v, bytes.data(), sizeof(T));
+        pos_ += sizeof(T);
+        return v;
+    }
+
+    const char* pos_;
+    const char* end_;
+    Format format_;
+    bool swap_;
+};
+
+auto VertexField(const std::string& name) -> Field
+{
+    if (name == "x") {
+        return Field::X;
+    }
+    if (name == "y") {
+        return Field::Y;
+    }
+    if (name == "z") {
+        return Field::Z;
+    }
+    if (name == "nx") {
+        return Field::NX;
+    }
+    if (name == "ny") {
+        return Field::NY;
+    }
+    if (name == "nz") {
+        return Field::NZ;
+    }
+    if (name == "r" or name == "red") {
+        return Field::R;
+    }
+    if (name == "g" or name == "green") {
+        return Field::G;
+    }
+    if (name == "b" or name == "blue") {
+        return Field::B;
+    }
+    return Field::None;
 }
+}  // namespace
 
-void PLYReader::read_faces_()
+auto PLYReader::read() -> ITKMesh::Pointer
 {
-    for (int i = 0; i < numFaces_; i++) {
-        SimpleMesh::Cell face;
-        auto curFace = split(line_, ' ');
-        if (hasLeadingChar_) {
-            int pointsPerFace = std::stoi(curFace[0]);
-            if (pointsPerFace != 3) {
-                auto msg = "Not a Triangular Mesh";
-                throw volcart::IOException(msg);
-            } else {
-                face = SimpleMesh::Cell(
-                    std::stoul(curFace[1]), std::stoul(curFace[2]),
-                    std::stoul(curFace[3]));
-                faceList_.push_back(face);
+    if (inputPath_.empty() || !fs::exists(inputPath_)) {
+        auto msg = "File not provided or does not exist.";
+        throw volcart::IOException(msg);
+    }
+
+    // Resets values of member variables in case of 2nd reading
+    pointList_.clear();
+    faceList_.clear();
+    outMesh_ = ITKMesh::New();
+    hasPointNorm_ = false;
+
+    const MemoryMappedFile file(inputPath_);
+    auto header = ParseHeader(file.data(), file.size());
+    BodyReader body(
+        file.data() + header.size, file.data() + file.size(), header.format);
+
+    bool hasFaces{false};
+    for (const auto& element : header.elements) {
+        if (element.name == "vertex") {
+            std::vector<Field> fields;
+            for (const auto& p : element.properties) {
+                auto f = (p.isList) ? Field::None : VertexField(p.name);
+                hasPointNorm_ |= f == Field::NX;
+                fields.push_back(f);
+            }
+
+            pointList_.reserve(element.count);
+            for (std::size_t i = 0; i < element.count; i++) {
+                SimpleMesh::Vertex v{};
+                for (std::size_t p = 0; p < fields.size(); p++) {
+                    const auto& prop = element.properties[p];
+                    if (fields[p] == Field::None) {
+                        body.skip(prop);
+                        continue;
+                    }
+                    auto val = body.read<double>(prop.type);
+                    switch (fields[p]) {
+                        case Field::X:
+                            v.x = val;
+                            break;
+                        case Field::Y:
+                            v.y = val;
+                            break;
+                        case Field::Z:
+                            v.z = val;
+                            break;
+                        case Field::NX:
+                            v.nx = val;
+                            break;
+                        case Field::NY:
+                            v.ny = val;
+                            break;
+                        case Field::NZ:
+                            v.nz = val;
+                            break;
+                        case Field::R:
+                            v.r = static_cast<int>(val);
+                            break;
+                        case Field::G:
+                            v.g = static_cast<int>(val);
+                            break;
+                        case Field::B:
+                            v.b = static_cast<int>(val);
+                            break;
+                        case Field::None:
+                            break;
+                    }
+                }
+                pointList_.push_back(v);
+            }
+        } else if (element.name == "face") {
+            hasFaces = element.count > 0;
+
+            // The first list property holds the vertex indices
+            auto idxProp = std::find_if(
+                element.properties.begin(), element.properties.end(),
+                [](const auto& p) { return p.isList; });
+
+            faceList_.reserve(element.count);
+            for (std::size_t i = 0; i < element.count; i++) {
+                for (auto p = element.properties.begin();
+                     p != element.properties.end(); ++p) {
+                    if (p != idxProp) {
+                        body.skip(*p);
+                        continue;
+                    }
+                    auto n = body.read<std::size_t>(p->countType);
+                    if (n != 3) {
+                        auto msg = "Not a Triangular Mesh";
+                        throw volcart::IOException(msg);
+                    }
+                    SimpleMesh::Cell face;
+                    face.v1 = body.read<std::uint64_t>(p->type);
+                    face.v2 = body.read<std::uint64_t>(p->type);
+                    face.v3 = body.read<std::uint64_t>(p->type);
+                    faceList_.push_back(face);
+                }
             }
         } else {
-            if (curFace.size() != 3) {
-                auto msg = "Not a Triangular Mesh";
-                throw volcart::IOException(msg);
-            } else {
-                face = SimpleMesh::Cell(
-                    std::stoul(curFace[1]), std::stoul(curFace[2]),
-                    std::stoul(curFace[3]));
-                faceList_.push_back(face);
+            for (std::size_t i = 0; i < element.count; i++) {
+                for (const auto& p : element.properties) {
+                    body.skip(p);
+                }
             }
         }
-        std::getline(plyFile_, line_);
     }
+    if (not hasFaces) {
+        Logger()->warn("Warning: No face information found");
+    }
+
+    create_mesh_();
+
+    return outMesh_;
 }
 
 void PLYReader::create_mesh_()
 {
-    ITKPoint p;
-    std::uint32_t pointCount = 0;
-    for (auto& cur : pointList_) {
+    auto points = ITKPointsContainer::New();
+    points->Reserve(pointList_.size());
+    auto normals = ITKMesh::PointDataContainer::New();
+    if (hasPointNorm_) {
+        normals->Reserve(pointList_.size());
+    }
+    for (std::size_t i = 0; i < pointList_.size(); i++) {
+        const auto& cur = pointList_[i];
+        ITKPoint p;
         p[0] = cur.x;
         p[1] = cur.y;
         p[2] = cur.z;
-        outMesh_->SetPoint(pointCount, p);
+        points->SetElement(i, p);
         if (hasPointNorm_) {
             ITKPixel q;
             q[0] = cur.nx;
             q[1] = cur.ny;
             q[2] = cur.nz;
-            outMesh_->SetPointData(pointCount, q);
+            normals->SetElement(i, q);
         }
-        pointCount++;
     }
-    std::uint32_t faceCount = 0;
+    outMesh_->SetPoints(points);
+    if (hasPointNorm_) {
+        outMesh_->SetPointData(normals);
+    }
+
+    std::uint64_t faceCount = 0;
+    ITKCell::CellAutoPointer cellpointer;
     for (auto& cur : faceList_) {
-        ITKCell::CellAutoPointer cellpointer;
+        if (cur.v1 >= pointList_.size() or cur.v2 >= pointList_.size() or
+            cur.v3 >= pointList_.size()) {
+            throw volcart::IOException("Out-of-range vertex reference");
+        }
         cellpointer.TakeOwnership(new ITKTriangle);
-
         cellpointer->SetPointId(0, cur.v1);
         cellpointer->SetPointId(1, cur.v2);
         cellpointer->SetPointId(2, cur.v3);
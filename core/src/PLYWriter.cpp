@@ -1,8 +1,13 @@
 #include "vc/core/io/PLYWriter.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstring>
+#include <optional>
 
 #include "vc/core/types/Exceptions.hpp"
+#include "vc/core/util/CharConv.hpp"
 #include "vc/core/util/Logging.hpp"
 
 using namespace volcart;
@@ -11,6 +16,27 @@ namespace fs = volcart::filesystem;
 
 namespace
 {
+// Size at which the output buffer is written to disk
+constexpr std::size_t BUFFER_SIZE{1 << 20};
+
+// Append the little endian bytes of a value to a string
+template <typename T>
+void AppendLittleEndian(std::string& str, T value)
+{
+    static const bool hostIsLittleEndian = []() {
+        const std::uint16_t one{1};
+        std::uint8_t first{0};
+        std::memcpy(&first, &one, 1);
+        return first == 1;
+    }();
+    std::array<char, sizeof(T)> bytes{};
+    std::memcpy(bytes.data(), &value, sizeof(T));
+    if (not hostIsLittleEndian) {
+        std::reverse(bytes.begin(), bytes.end());
+    }
+    str.append(bytes.data(), bytes.size());
+}
+
 auto PtIntensity(
     std::size_t idx, const UVMap::Pointer& uvMap, const cv::Mat& image)
     -> double
@@ -30,7 +56,7 @@ void PLYWriter::write()
     }
 
     // Open the file stream
-    outputMesh_.open(outputPath_.string());
+    outputMesh_.open(outputPath_.string(), std::ios::binary);
     if (!outputMesh_.is_open()) {
         auto msg = "failure writing file '" + outputPath_.string() + "'";
         throw IOException(msg);
@@ -43,9 +69,12 @@ void PLYWriter::write()
         uvMap_->setOrigin(UVMap::Origin::TopLeft);
     }
 
+    buffer_.clear();
+    buffer_.reserve(BUFFER_SIZE);
     write_header_();
     write_vertices_();
     write_faces_();
+    flush_buffer_(true);
 
     // Restore the starting origin
     if (uvMap_) {
@@ -60,11 +89,24 @@ void PLYWriter::write()
     }
 }
 
+void PLYWriter::flush_buffer_(bool force)
+{
+    if (force or buffer_.size() >= BUFFER_SIZE) {
+        outputMesh_.write(
+            buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+}
+
 // Write our custom header
 void PLYWriter::write_header_()
 {
     outputMesh_ << "ply" << '\n';
-    outputMesh_ << "format ascii 1.0" << '\n';
+    if (format_ == Format::BinaryLittleEndian) {
+        outputMesh_ << "format binary_little_endian 1.0" << '\n';
+    } else {
+        outputMesh_ << "format ascii 1.0" << '\n';
+    }
     outputMesh_ << "comment VC PLY Exporter v1.0" << '\n';
 
     // Vertex Info for Header
@@ -102,6 +144,20 @@ void PLYWriter::write_vertices_()
     }
     Logger()->info("Writing vertices...");
 
+    // Write a value preceded by a separator if ASCII. Position and normal
+    // values are written as floats to match the header.
+    const bool binary = format_ == Format::BinaryLittleEndian;
+    auto writeValue = [this, binary](auto v, bool first = false) {
+        if (binary) {
+            AppendLittleEndian(buffer_, v);
+            return;
+        }
+        if (not first) {
+            buffer_ += ' ';
+        }
+        AppendNumber(buffer_, v);
+    };
+
     // Iterate over all of the points
     for (auto point = mesh_->GetPoints()->Begin();
          point != mesh_->GetPoints()->End(); ++point) {
@@ -111,11 +167,15 @@ void PLYWriter::write_vertices_()
         mesh_->GetPointData(point.Index(), &normal);
 
         // Write the point position components and its normal components.
-        outputMesh_ << point.Value()[0] << " " << point.Value()[1] << " "
-                    << point.Value()[2] << " ";
-        outputMesh_ << normal[0] << " " << normal[1] << " " << normal[2];
+        writeValue(static_cast<float>(point.Value()[0]), true);
+        writeValue(static_cast<float>(point.Value()[1]));
+        writeValue(static_cast<float>(point.Value()[2]));
+        writeValue(static_cast<float>(normal[0]));
+        writeValue(static_cast<float>(normal[1]));
+        writeValue(static_cast<float>(normal[2]));
 
         // If the texture has images and a uv map, write texture info
+        std::optional<int> color;
         if (not texture_.empty() and uvMap_ and not uvMap_->empty()) {
             // Get the intensity for this point from the texture. If it doesn't
             // exist, set to 0.
@@ -124,16 +184,23 @@ void PLYWriter::write_vertices_()
                 intensity = PtIntensity(point.Index(), uvMap_, texture_);
                 intensity = cvRound(intensity * 255.0 / 65535.0);
             }
-
-            auto i = static_cast<int>(intensity);
-            outputMesh_ << " " << i << " " << i << " " << i;
+            color = static_cast<int>(intensity);
         } else if (not vcolors_.empty()) {
             float val = vcolors_.at(point.Index());
-            auto i = static_cast<int>(val * 255.F / 65535.F);
-            outputMesh_ << " " << i << " " << i << " " << i;
+            color = static_cast<int>(val * 255.F / 65535.F);
+        }
+        for (int i = 0; color and i < 3; i++) {
+            if (binary) {
+                writeValue(static_cast<std::uint8_t>(*color));
+            } else {
+                writeValue(*color);
+            }
         }
 
-        outputMesh_ << '\n';
+        if (not binary) {
+            buffer_ += '\n';
+        }
+        flush_buffer_();
     }
 }
 
@@ -146,17 +213,31 @@ void PLYWriter::write_faces_()
     Logger()->info("Writing faces...");
 
     // Iterate over the faces of the mesh
+    const bool binary = format_ == Format::BinaryLittleEndian;
     ITKPointInCellIterator point;
     for (auto cell = mesh_->GetCells()->Begin();
          cell != mesh_->GetCells()->End(); ++cell) {
-        outputMesh_ << cell->Value()->GetNumberOfPoints();
+        auto numPoints = cell->Value()->GetNumberOfPoints();
+        if (binary) {
+            AppendLittleEndian(buffer_, static_cast<std::uint8_t>(numPoints));
+        } else {
+            AppendNumber(buffer_, numPoints);
+        }
 
         // Iterate over the points of this face and write the point IDs
         for (point = cell.Value()->PointIdsBegin();
              point != cell.Value()->PointIdsEnd(); ++point) {
-            outputMesh_ << " " << *point;
+            if (binary) {
+                AppendLittleEndian(buffer_, static_cast<std::int32_t>(*point));
+            } else {
+                buffer_ += ' ';
+                AppendNumber(buffer_, *point);
+            }
         }
-        outputMesh_ << '\n';
+        if (not binary) {
+            buffer_ += '\n';
+        }
+        flush_buffer_();
     }
 }
 
@@ -165,6 +246,8 @@ void PLYWriter::setVertexColors(const std::vector<std::uint16_t>& c)
     vcolors_ = c;
 }
 
+void PLYWriter::setFormat(Format format) { format_ = format; }
+
 PLYWriter::PLYWriter(fs::path outputPath, ITKMesh::Pointer mesh)
     : outputPath_{std::move(outputPath)}, mesh_{std::move(mesh)}
 {
@@ -0,0 +1,234 @@
+#include "vc/core/util/Profiling.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "vc/core/util/Logging.hpp"
+
+using namespace volcart;
+using namespace volcart::profiling;
+
+using Seconds = std::chrono::duration<double>;
+
+std::atomic<bool> volcart::profiling::detail::enabled{false};
+
+namespace
+{
+using Values = std::array<std::atomic<std::uint64_t>, MAX_TIMERS>;
+using Counters = std::array<std::atomic<std::uint64_t>, NUM_COUNTERS>;
+
+// Add to a value which is only written by one thread. Other threads may read
+// it at any time, but a plain load and store is enough for the writer.
+void Add(std::atomic<std::uint64_t>& v, std::uint64_t n)
+{
+    v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+template <std::size_t N>
+void Zero(std::array<std::atomic<std::uint64_t>, N>& values)
+{
+    for (auto& v : values) {
+        v.store(0, std::memory_order_relaxed);
+    }
+}
+
+struct ThreadData;
+
+// Timer names and the values of every thread
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::string> timerNames;
+    std::unordered_set<ThreadData*> threads;
+    // Totals of threads which have exited
+    Counters counters;
+    Values calls;
+    Values nanos;
+
+    Registry()
+    {
+        Zero(counters);
+        Zero(calls);
+        Zero(nanos);
+    }
+};
+
+auto GetRegistry() -> Registry&
+{
+    static Registry registry;
+    return registry;
+}
+
+// Values recorded by a single thread
+struct ThreadData {
+    Counters counters;
+    Values calls;
+    Values nanos;
+
+    ThreadData()
+    {
+        Zero(counters);
+        Zero(calls);
+        Zero(nanos);
+        auto& registry = GetRegistry();
+        const std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.insert(this);
+    }
+
+    // Move the values into the exited thread totals
+    ~ThreadData()
+    {
+        auto& registry = GetRegistry();
+        const std::lock_guard<std::mutex> lock(registry.mutex);
+        constexpr auto relaxed = std::memory_order_relaxed;
+        for (std::size_t i = 0; i < NUM_COUNTERS; i++) {
+            Add(registry.counters[i], counters[i].load(relaxed));
+        }
+        for (std::size_t i = 0; i < MAX_TIMERS; i++) {
+            Add(registry.calls[i], calls[i].load(relaxed));
+            Add(registry.nanos[i], nanos[i].load(relaxed));
+        }
+        registry.threads.erase(this);
+    }
+
+    ThreadData(const ThreadData&) = delete;
+    auto operator=(const ThreadData&) -> ThreadData& = delete;
+};
+
+auto LocalData() -> ThreadData&
+{
+    thread_local ThreadData data;
+    return data;
+}
+}  // namespace
+
+auto profiling::CounterName(Counter c) -> std::string
+{
+    switch (c) {
+        case Counter::SliceCacheHits:
+            return "sliceCacheHits";
+        case Counter::SliceCacheMisses:
+            return "sliceCacheMisses";
+        case Counter::SliceBytesLoaded:
+            return "sliceBytesLoaded";
+        case Counter::SamplesInterpolated:
+            return "samplesInterpolated";
+        case Counter::BVHTraversals:
+            return "bvhTraversals";
+        case Counter::MaskSamplesSkipped:
+            return "maskSamplesSkipped";
+    }
+    throw std::invalid_argument("Unknown counter");
+}
+
+void profiling::detail::AddCount(Counter c, std::uint64_t n)
+{
+    Add(LocalData().counters[static_cast<std::size_t>(c)], n);
+}
+
+void profiling::detail::AddTime(
+    std::size_t id, std::chrono::steady_clock::duration d)
+{
+    auto& data = LocalData();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    Add(data.calls[id], 1);
+    Add(data.nanos[id], static_cast<std::uint64_t>(ns));
+}
+
+void profiling::SetEnabled(bool b)
+{
+    detail::enabled.store(b, std::memory_order_relaxed);
+}
+
+Timer::Timer(const std::string& name)
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    auto& names = registry.timerNames;
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it != names.end()) {
+        id_ = static_cast<std::size_t>(std::distance(names.begin(), it));
+        return;
+    }
+    if (names.size() == MAX_TIMERS) {
+        throw std::length_error("Too many profiling timers");
+    }
+    id_ = names.size();
+    names.push_back(name);
+}
+
+auto profiling::Snapshot() -> Report
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // Sum the exited and running threads
+    Report report;
+    std::array<std::uint64_t, MAX_TIMERS> calls{};
+    std::array<std::uint64_t, MAX_TIMERS> nanos{};
+    auto addThread = [&](const Counters& c, const Values& cl, const Values& n) {
+        for (std::size_t i = 0; i < NUM_COUNTERS; i++) {
+            report.counters[i] += c[i].load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < MAX_TIMERS; i++) {
+            calls[i] += cl[i].load(std::memory_order_relaxed);
+            nanos[i] += n[i].load(std::memory_order_relaxed);
+        }
+    };
+    addThread(registry.counters, registry.calls, registry.nanos);
+    for (const auto* t : registry.threads) {
+        addThread(t->counters, t->calls, t->nanos);
+    }
+
+    for (std::size_t i = 0; i < registry.timerNames.size(); i++) {
+        if (calls[i] == 0) {
+            continue;
+        }
+        auto s = Seconds(std::chrono::nanoseconds(nanos[i])).count();
+        report.timers.push_back({registry.timerNames[i], calls[i], s});
+    }
+    return report;
+}
+
+void profiling::Reset()
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    Zero(registry.counters);
+    Zero(registry.calls);
+    Zero(registry.nanos);
+    for (auto* t : registry.threads) {
+        Zero(t->counters);
+        Zero(t->calls);
+        Zero(t->nanos);
+    }
+}
+
+auto profiling::ToJson(const Report& report) -> nlohmann::json
+{
+    nlohmann::json counters;
+    for (std::size_t i = 0; i < NUM_COUNTERS; i++) {
+        counters[CounterName(static_cast<Counter>(i))] = report.counters[i];
+    }
+    nlohmann::json timers;
+    for (const auto& t : report.timers) {
+        timers[t.name] = {{"calls", t.calls}, {"seconds", t.seconds}};
+    }
+    return {{"counters", counters}, {"timers", timers}};
+}
+
+void profiling::LogReport(const Report& report)
+{
+    Logger()->info("Profile counters:");
+    for (std::size_t i = 0; i < NUM_COUNTERS; i++) {
+        Logger()->info(
+            "  {}: {}", CounterName(static_cast<Counter>(i)),
+            report.counters[i]);
+    }
+    Logger()->info("Profile timers:");
+    for (const auto& t : report.timers) {
+        Logger()->info(
+            "  {}: {} calls, {:.3f} s", t.name, t.calls, t.seconds);
+    }
+}
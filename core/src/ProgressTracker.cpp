@@ -0,0 +1,57 @@
+#include "vc/core/util/ProgressTracker.hpp"
+
+using namespace volcart;
+
+ProgressTracker::ProgressTracker(
+    IterationsProgress& p, std::chrono::milliseconds interval)
+    : progress_{p}, interval_{interval}
+{
+    progress_.progressStarted();
+    if (progress_.progressUpdated.numConnections() > 0) {
+        reporter_ = std::thread(&ProgressTracker::run_, this);
+    }
+}
+
+ProgressTracker::~ProgressTracker() { stop_(); }
+
+void ProgressTracker::complete()
+{
+    if (completed_) {
+        return;
+    }
+    stop_();
+    report_();
+    completed_ = true;
+    progress_.progressComplete();
+}
+
+void ProgressTracker::run_()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (not cv_.wait_for(lock, interval_, [this]() { return stopping_; })) {
+        lock.unlock();
+        report_();
+        lock.lock();
+    }
+}
+
+void ProgressTracker::stop_()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (reporter_.joinable()) {
+        reporter_.join();
+    }
+}
+
+void ProgressTracker::report_()
+{
+    auto count = count_.load(std::memory_order_relaxed);
+    if (count != reported_) {
+        reported_ = count;
+        progress_.progressUpdated(count);
+    }
+}
@@ -2,6 +2,8 @@
 
 #include <utility>
 
+#include <nlohmann/json.hpp>
+
 using namespace volcart;
 
 namespace fs = volcart::filesystem;
@@ -58,3 +60,47 @@ auto Render::graph() const -> GraphPtr
     }
     return graph_;
 }
+
+void Render::saveGraph() const
+{
+    if (graph_) {
+        const auto file = metadata_.get<std::string>("graph");
+        Graph::Save(path_ / file, *graph_, true);
+    }
+}
+
+void Render::setProfile(const nlohmann::json& profile)
+{
+    metadata_.set("profile", profile);
+    metadata_.save();
+}
+
+void Render::setCheckpoint(
+    const std::string& name, const std::string& hash, const fs::path& file)
+{
+    nlohmann::json checkpoints;
+    if (metadata_.hasKey("checkpoints")) {
+        checkpoints = metadata_.get<nlohmann::json>("checkpoints");
+    }
+    checkpoints[name] = {{"hash", hash}, {"file", file.string()}};
+    metadata_.set("checkpoints", checkpoints);
+    metadata_.save();
+}
+
+auto Render::checkpoint(const std::string& name, const std::string& hash) const
+    -> std::optional<fs::path>
+{
+    if (not metadata_.hasKey("checkpoints")) {
+        return std::nullopt;
+    }
+    auto checkpoints = metadata_.get<nlohmann::json>("checkpoints");
+    if (not checkpoints.contains(name) or
+        checkpoints[name]["hash"].get<std::string>() != hash) {
+        return std::nullopt;
+    }
+    auto file = path_ / checkpoints[name]["file"].get<std::string>();
+    if (not fs::exists(file)) {
+        return std::nullopt;
+    }
+    return file;
+}
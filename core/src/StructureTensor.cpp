@@ -113,15 +113,8 @@ auto volcart::ComputeSubvoxelStructureTensor(
         volume, index(0), index(1), index(2), radius, kernelSize);
 }
 
-auto volcart::ComputeVoxelEigenPairs(
-    const Volume::Pointer& volume,
-    int x,
-    int y,
-    int z,
-    int radius,
-    int kernelSize) -> EigenPairs
+auto volcart::ComputeEigenPairs(const StructureTensor& st) -> EigenPairs
 {
-    auto st = ComputeVoxelStructureTensor(volume, x, y, z, radius, kernelSize);
     cv::Vec3d eigenValues;
     cv::Matx33d eigenVectors;
     cv::eigen(st, eigenValues, eigenVectors);
@@ -138,6 +131,18 @@ auto volcart::ComputeVoxelEigenPairs(
     };
 }
 
+auto volcart::ComputeVoxelEigenPairs(
+    const Volume::Pointer& volume,
+    int x,
+    int y,
+    int z,
+    int radius,
+    int kernelSize) -> EigenPairs
+{
+    auto st = ComputeVoxelStructureTensor(volume, x, y, z, radius, kernelSize);
+    return ComputeEigenPairs(st);
+}
+
 auto volcart::ComputeVoxelEigenPairs(
     const Volume::Pointer& volume,
     const cv::Vec3i& index,
@@ -158,20 +163,7 @@ auto volcart::ComputeSubvoxelEigenPairs(
 {
     auto st =
         ComputeSubvoxelStructureTensor(volume, x, y, z, radius, kernelSize);
-    cv::Vec3d eigenValues;
-    cv::Matx33d eigenVectors;
-    cv::eigen(st, eigenValues, eigenVectors);
-    auto row0 = eigenVectors.row(0);
-    auto row1 = eigenVectors.row(1);
-    auto row2 = eigenVectors.row(2);
-    EigenVector e0{row0(0), row0(1), row0(2)};
-    EigenVector e1{row1(0), row1(1), row1(2)};
-    EigenVector e2{row2(0), row2(1), row2(2)};
-    return {
-        std::make_pair(eigenValues(0), e0),
-        std::make_pair(eigenValues(1), e1),
-        std::make_pair(eigenValues(2), e2),
-    };
+    return ComputeEigenPairs(st);
 }
 
 auto volcart::ComputeSubvoxelEigenPairs(
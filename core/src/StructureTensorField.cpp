@@ -0,0 +1,144 @@
+#include "vc/core/math/StructureTensorField.hpp"
+
+#include <cmath>
+#include <utility>
+
+using namespace volcart;
+
+namespace
+{
+// Floor division by the block size
+auto BlockCoord(int v) -> int
+{
+    constexpr auto bs = StructureTensorField::BLOCK_SIZE;
+    return (v >= 0) ? v / bs : -((-v + bs - 1) / bs);
+}
+
+// Pack a block index into a single key. Each component gets 21 bits.
+auto BlockKey(const cv::Vec3i& idx) -> std::uint64_t
+{
+    constexpr std::int64_t offset{1 << 20};
+    constexpr std::uint64_t mask{(1 << 21) - 1};
+    std::uint64_t key{0};
+    for (int i = 0; i < 3; i++) {
+        auto v = static_cast<std::uint64_t>(idx[i] + offset) & mask;
+        key = (key << 21) | v;
+    }
+    return key;
+}
+}  // namespace
+
+StructureTensorField::StructureTensorField(
+    Volume::Pointer volume, int radius, int kernelSize)
+    : volume_{std::move(volume)}, radius_{radius}, kernelSize_{kernelSize}
+{
+}
+
+auto StructureTensorField::voxelAt(int x, int y, int z) -> StructureTensor
+{
+    cv::Vec3i idx{BlockCoord(x), BlockCoord(y), BlockCoord(z)};
+    const auto& block = block_(idx);
+    auto bx = x - idx[0] * BLOCK_SIZE;
+    auto by = y - idx[1] * BLOCK_SIZE;
+    auto bz = z - idx[2] * BLOCK_SIZE;
+    return block.tensors[(bz * BLOCK_SIZE + by) * BLOCK_SIZE + bx];
+}
+
+auto StructureTensorField::at(const cv::Vec3d& p) -> StructureTensor
+{
+    cv::Vec3i p0{
+        static_cast<int>(std::floor(p[0])), static_cast<int>(std::floor(p[1])),
+        static_cast<int>(std::floor(p[2]))};
+    cv::Vec3d t{p[0] - p0[0], p[1] - p0[1], p[2] - p0[2]};
+
+    // Neighboring voxels usually share a block, so remember the last one
+    cv::Vec3i lastIdx;
+    const Block* last{nullptr};
+
+    StructureTensor result = ZERO_STRUCTURE_TENSOR;
+    for (int corner = 0; corner < 8; corner++) {
+        cv::Vec3i v = p0;
+        double w{1};
+        for (int i = 0; i < 3; i++) {
+            if ((corner >> i) & 1) {
+                v[i] += 1;
+                w *= t[i];
+            } else {
+                w *= 1 - t[i];
+            }
+        }
+        // Skip corners which don't contribute. Integer positions only use
+        // a single voxel.
+        if (w == 0) {
+            continue;
+        }
+
+        cv::Vec3i idx{BlockCoord(v[0]), BlockCoord(v[1]), BlockCoord(v[2])};
+        if (last == nullptr or idx != lastIdx) {
+            last = &block_(idx);
+            lastIdx = idx;
+        }
+        auto bx = v[0] - idx[0] * BLOCK_SIZE;
+        auto by = v[1] - idx[1] * BLOCK_SIZE;
+        auto bz = v[2] - idx[2] * BLOCK_SIZE;
+        result += w * last->tensors[(bz * BLOCK_SIZE + by) * BLOCK_SIZE + bx];
+    }
+    return result;
+}
+
+auto StructureTensorField::eigenPairsAt(const cv::Vec3d& p) -> EigenPairs
+{
+    return ComputeEigenPairs(at(p));
+}
+
+auto StructureTensorField::numBlocks() const -> std::size_t
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return blocks_.size();
+}
+
+void StructureTensorField::clear()
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    blocks_.clear();
+}
+
+auto StructureTensorField::block_(const cv::Vec3i& idx) -> const Block&
+{
+    // Find or insert the block. Blocks are never moved once inserted.
+    Block* block{nullptr};
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        auto& entry = blocks_[BlockKey(idx)];
+        if (not entry) {
+            entry = std::make_unique<Block>();
+        }
+        block = entry.get();
+    }
+
+    // Compute outside of the lock so that other blocks can be computed
+    // concurrently. Other threads which need this block wait here.
+    std::call_once(block->computed, [this, &idx, block]() {
+        compute_block_(idx, *block);
+    });
+    return *block;
+}
+
+void StructureTensorField::compute_block_(
+    const cv::Vec3i& idx, Block& block) const
+{
+    block.tensors.resize(BLOCK_SIZE * BLOCK_SIZE * BLOCK_SIZE);
+    auto* out = block.tensors.data();
+    for (int z = 0; z < BLOCK_SIZE; z++) {
+        for (int y = 0; y < BLOCK_SIZE; y++) {
+            for (int x = 0; x < BLOCK_SIZE; x++) {
+                cv::Vec3d p{
+                    static_cast<double>(idx[0] * BLOCK_SIZE + x),
+                    static_cast<double>(idx[1] * BLOCK_SIZE + y),
+                    static_cast<double>(idx[2] * BLOCK_SIZE + z)};
+                *out++ = ComputeSubvoxelStructureTensor(
+                    volume_, p, radius_, kernelSize_);
+            }
+        }
+    }
+}
@@ -1,8 +1,14 @@
 #include "vc/core/io/TIFFIO.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <opencv2/imgproc.hpp>
 
@@ -10,6 +16,7 @@
 #include "vc/core/io/FileExtensionFilter.hpp"
 #include "vc/core/types/Exceptions.hpp"
 #include "vc/core/util/Logging.hpp"
+#include "vc/core/util/ThreadPool.hpp"
 
 // Wrapping in a namespace to avoid define collisions
 namespace lt
@@ -56,6 +63,7 @@ auto GetCVMatType(
 
 constexpr std::size_t MAX_TIFF_BYTES{4'294'967'296};
 constexpr std::size_t BITS_PER_BYTE{8};
+constexpr int TILE_MULTIPLE{16};
 
 inline auto NeedBigTIFF(
     std::size_t w, std::size_t h, std::size_t cns, std::size_t bps) -> bool
@@ -64,205 +72,491 @@ inline auto NeedBigTIFF(
     return bytes >= MAX_TIFF_BYTES;
 }
 
-}  // namespace
+// Image properties read from a TIFF header
+struct TIFFHeader {
+    std::uint32_t width{0};
+    std::uint32_t height{0};
+    std::uint16_t type{1};
+    std::uint16_t depth{1};
+    std::uint16_t channels{1};
+    std::uint16_t config{0};
+    bool tiled{false};
+};
 
-auto tio::ReadTIFF(const volcart::filesystem::path& path) -> cv::Mat
+auto ReadHeader(lt::TIFF* tif) -> TIFFHeader
 {
-    // Make sure input file exists
-    if (!fs::exists(path)) {
-        throw IOException("File does not exist");
-    }
+    TIFFHeader h;
+    TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &h.width);
+    TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &h.height);
+    TIFFGetField(tif, TIFFTAG_SAMPLEFORMAT, &h.type);
+    TIFFGetField(tif, TIFFTAG_BITSPERSAMPLE, &h.depth);
+    TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &h.channels);
+    TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &h.config);
+    h.tiled = lt::TIFFIsTiled(tif) != 0;
+    return h;
+}
 
-    // Open the file read-only
-    lt::TIFF* tif = lt::TIFFOpen(path.c_str(), "r");
-    if (tif == nullptr) {
-        throw IOException("Failed to open tif");
+// Copy the part of a decoded strip or tile which overlaps the ROI into the
+// output image
+void CopyBlock(
+    const char* block,
+    std::size_t blockStride,
+    const cv::Rect& blockRect,
+    const cv::Rect& roi,
+    cv::Mat& out)
+{
+    const auto overlap = blockRect & roi;
+    const auto elemSize = out.elemSize();
+    const auto rowBytes = static_cast<std::size_t>(overlap.width) * elemSize;
+    for (auto y = overlap.y; y < overlap.y + overlap.height; y++) {
+        const auto* src = block + (y - blockRect.y) * blockStride +
+                          (overlap.x - blockRect.x) * elemSize;
+        auto* dst = out.ptr(y - roi.y) + (overlap.x - roi.x) * elemSize;
+        std::memcpy(dst, src, rowBytes);
     }
+}
 
-    // Get metadata
-    std::uint32_t width = 0;
-    std::uint32_t height = 0;
-    std::uint16_t type = 1;
-    std::uint16_t depth = 1;
-    std::uint16_t channels = 1;
-    std::uint16_t config = 0;
-    TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &width);
-    TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &height);
-    TIFFGetField(tif, TIFFTAG_SAMPLEFORMAT, &type);
-    TIFFGetField(tif, TIFFTAG_BITSPERSAMPLE, &depth);
-    TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &channels);
-    TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &config);
-    auto cvType = ::GetCVMatType(type, depth, channels);
+// Decode the strips which overlap the ROI
+void ReadStrips(
+    lt::TIFF* tif, const TIFFHeader& h, const cv::Rect& roi, cv::Mat& img)
+{
+    std::uint32_t rowsPerStrip{h.height};
+    lt::TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+    rowsPerStrip = std::clamp<std::uint32_t>(rowsPerStrip, 1, h.height);
 
-    // Construct the mat
-    auto h = static_cast<int>(height);
-    auto w = static_cast<int>(width);
-    cv::Mat img = cv::Mat::zeros(h, w, cvType);
-
-    // Read the rows
-    auto bufferSize = static_cast<std::size_t>(lt::TIFFScanlineSize(tif));
-    std::vector<char> buffer(bufferSize + 4);
-    if (config == PLANARCONFIG_CONTIG) {
-        for (auto row = 0; row < height; row++) {
-            lt::TIFFReadScanline(tif, &buffer[0], row);
-            std::memcpy(img.ptr(row), &buffer[0], bufferSize);
+    const auto scanline = static_cast<std::size_t>(lt::TIFFScanlineSize(tif));
+    std::vector<char> buffer(lt::TIFFStripSize(tif) + 4);
+    const auto roiEnd = static_cast<std::uint32_t>(roi.y + roi.height);
+    auto stripY = (roi.y / rowsPerStrip) * rowsPerStrip;
+    for (; stripY < roiEnd; stripY += rowsPerStrip) {
+        // Only decode as far as the last ROI row in this strip
+        auto strip = lt::TIFFComputeStrip(tif, stripY, 0);
+        auto lastRow = std::min({stripY + rowsPerStrip, h.height, roiEnd});
+        auto size = static_cast<lt::tmsize_t>((lastRow - stripY) * scanline);
+        if (lt::TIFFReadEncodedStrip(tif, strip, buffer.data(), size) < 0) {
+            throw vc::IOException(
+                "Failed to read strip " + std::to_string(strip));
         }
-    } else if (config == PLANARCONFIG_SEPARATE) {
-        throw IOException(
-            "Unsupported TIFF planar configuration: PLANARCONFIG_SEPARATE");
+
+        const cv::Rect stripRect(
+            0, static_cast<int>(stripY), static_cast<int>(h.width),
+            static_cast<int>(lastRow - stripY));
+        ::CopyBlock(buffer.data(), scanline, stripRect, roi, img);
     }
+}
 
-    // Do channel conversion
-    auto cvtNeeded = img.channels() == 3 or img.channels() == 4;
-    auto cvtSupported = img.depth() != CV_8S and img.depth() != CV_16S and
-                        img.depth() != CV_32S;
-    if (cvtNeeded) {
-        if (cvtSupported) {
-            if (img.channels() == 3) {
-                cv::cvtColor(img, img, cv::COLOR_RGB2BGR);
-            } else if (img.channels() == 4) {
-                cv::cvtColor(img, img, cv::COLOR_RGBA2BGRA);
-            }
-        } else {
-            vc::Logger()->warn(
-                "[TIFFIO] RGB->BGR conversion for signed 8-bit and 16-bit "
-                "images is not supported. Image will be loaded with RGB "
-                "element order.");
-        }
+// Decode the tiles which overlap the ROI
+void ReadTiles(lt::TIFF* tif, const cv::Rect& roi, cv::Mat& img)
+{
+    std::uint32_t tileW{0};
+    std::uint32_t tileH{0};
+    TIFFGetField(tif, TIFFTAG_TILEWIDTH, &tileW);
+    TIFFGetField(tif, TIFFTAG_TILELENGTH, &tileH);
+    if (tileW == 0 or tileH == 0) {
+        throw vc::IOException("Invalid TIFF tile size");
     }
 
-    lt::TIFFClose(tif);
+    const auto rowBytes = static_cast<std::size_t>(lt::TIFFTileRowSize(tif));
+    std::vector<char> buffer(lt::TIFFTileSize(tif) + 4);
+    const auto roiEndX = static_cast<std::uint32_t>(roi.x + roi.width);
+    const auto roiEndY = static_cast<std::uint32_t>(roi.y + roi.height);
+    for (auto ty = (roi.y / tileH) * tileH; ty < roiEndY; ty += tileH) {
+        for (auto tx = (roi.x / tileW) * tileW; tx < roiEndX; tx += tileW) {
+            if (lt::TIFFReadTile(tif, buffer.data(), tx, ty, 0, 0) < 0) {
+                throw vc::IOException(
+                    "Failed to read tile at (" + std::to_string(tx) + ", " +
+                    std::to_string(ty) + ")");
+            }
 
-    return img;
+            const cv::Rect tileRect(
+                static_cast<int>(tx), static_cast<int>(ty),
+                static_cast<int>(tileW), static_cast<int>(tileH));
+            ::CopyBlock(buffer.data(), rowBytes, tileRect, roi, img);
+        }
+    }
 }
 
-// Write a TIFF to a file. This implementation heavily borrows from how OpenCV's
-// TIFFEncoder writes to the TIFF
-void tio::WriteTIFF(
-    const fs::path& path, const cv::Mat& img, Compression compression)
+// Parameters shared by the scanline and tiled writers
+struct EncodeParams {
+    cv::Mat img;
+    int channels{0};
+    unsigned width{0};
+    unsigned height{0};
+    int bitsPerSample{0};
+    int sampleFormat{0};
+    int photometric{0};
+    bool bigTIFF{false};
+};
+
+// Validate an image type and get its encoding parameters
+auto GetEncodeParams(const fs::path& path, const cv::Size& size, int type)
+    -> EncodeParams
 {
     // Safety checks
-    if (img.channels() < 1 or img.channels() > 4) {
-        throw IOException("Unsupported number of channels");
+    const auto channels = CV_MAT_CN(type);
+    if (channels < 1 or channels > 4) {
+        throw vc::IOException("Unsupported number of channels");
     }
 
-    if (not io::FileExtensionFilter(path, {"tif", "tiff"})) {
-        throw IOException(
+    if (not vc::io::FileExtensionFilter(path, {"tif", "tiff"})) {
+        throw vc::IOException(
             "Invalid file extension " + path.extension().string());
     }
 
     // Image metadata
-    auto channels = img.channels();
-    auto width = static_cast<unsigned>(img.cols);
-    auto height = static_cast<unsigned>(img.rows);
-    auto rowsPerStrip = height;
+    EncodeParams p;
+    p.channels = channels;
+    p.width = static_cast<unsigned>(size.width);
+    p.height = static_cast<unsigned>(size.height);
 
     // Sample format
-    int bitsPerSample;
-    int sampleFormat;
-    switch (img.depth()) {
+    switch (CV_MAT_DEPTH(type)) {
         case CV_8U:
-            sampleFormat = SAMPLEFORMAT_UINT;
-            bitsPerSample = 8;
+            p.sampleFormat = SAMPLEFORMAT_UINT;
+            p.bitsPerSample = 8;
             break;
         case CV_8S:
-            sampleFormat = SAMPLEFORMAT_INT;
-            bitsPerSample = 8;
+            p.sampleFormat = SAMPLEFORMAT_INT;
+            p.bitsPerSample = 8;
             break;
         case CV_16U:
-            sampleFormat = SAMPLEFORMAT_UINT;
-            bitsPerSample = 16;
+            p.sampleFormat = SAMPLEFORMAT_UINT;
+            p.bitsPerSample = 16;
             break;
         case CV_16S:
-            sampleFormat = SAMPLEFORMAT_INT;
-            bitsPerSample = 16;
+            p.sampleFormat = SAMPLEFORMAT_INT;
+            p.bitsPerSample = 16;
             break;
         case CV_32S:
-            sampleFormat = SAMPLEFORMAT_INT;
-            bitsPerSample = 32;
+            p.sampleFormat = SAMPLEFORMAT_INT;
+            p.bitsPerSample = 32;
             break;
         case CV_32F:
-            sampleFormat = SAMPLEFORMAT_IEEEFP;
-            bitsPerSample = 32;
+            p.sampleFormat = SAMPLEFORMAT_IEEEFP;
+            p.bitsPerSample = 32;
             break;
         case CV_64F:
-            sampleFormat = SAMPLEFORMAT_IEEEFP;
-            bitsPerSample = 64;
+            p.sampleFormat = SAMPLEFORMAT_IEEEFP;
+            p.bitsPerSample = 64;
             break;
         default:
-            throw IOException("Unsupported image depth");
+            throw vc::IOException("Unsupported image depth");
     }
 
     // Photometric Interpretation
-    int photometric;
-    switch (channels) {
+    switch (p.channels) {
         case 1:
         case 2:
-            photometric = PHOTOMETRIC_MINISBLACK;
+            p.photometric = PHOTOMETRIC_MINISBLACK;
             break;
         case 3:
         case 4:
-            photometric = PHOTOMETRIC_RGB;
+            p.photometric = PHOTOMETRIC_RGB;
             break;
         default:
-            throw IOException("Unsupported number of channels");
+            throw vc::IOException("Unsupported number of channels");
     }
 
-    // Get working copy with converted channels if an RGB-type image
+    // Estimated file size in bytes
+    p.bigTIFF =
+        ::NeedBigTIFF(p.width, p.height, p.channels, p.bitsPerSample);
+    return p;
+}
+
+// Get a working copy with converted channels if an RGB-type image
+auto ConvertForEncode(const cv::Mat& img) -> cv::Mat
+{
     auto cvtNeeded = img.channels() == 3 or img.channels() == 4;
     auto cvtSupported = img.depth() != CV_8S and img.depth() != CV_16S and
                         img.depth() != CV_32S;
-    cv::Mat imgCopy;
+    cv::Mat result;
     if (cvtNeeded and cvtSupported) {
         if (img.channels() == 3) {
-            cv::cvtColor(img, imgCopy, cv::COLOR_BGR2RGB);
+            cv::cvtColor(img, result, cv::COLOR_BGR2RGB);
         } else if (img.channels() == 4) {
-            cv::cvtColor(img, imgCopy, cv::COLOR_BGRA2RGBA);
+            cv::cvtColor(img, result, cv::COLOR_BGRA2RGBA);
         }
     } else if (cvtNeeded) {
-        throw IOException(
+        throw vc::IOException(
             "BGR->RGB conversion for signed 8-bit and 16-bit images is not "
             "supported.");
     } else {
-        imgCopy = img;
+        result = img;
     }
+    return result;
+}
 
-    // Estimated file size in bytes
-    auto useBigTIFF = ::NeedBigTIFF(width, height, channels, bitsPerSample);
-    if (useBigTIFF) {
-        Logger()->warn("File estimate >= 4GB. Writing as BigTIFF.");
-    }
+// Validate an image and get its encoding parameters
+auto PrepareEncode(const fs::path& path, const cv::Mat& img) -> EncodeParams
+{
+    auto p = ::GetEncodeParams(path, img.size(), img.type());
+    p.img = ::ConvertForEncode(img);
+    return p;
+}
 
-    // Open the file
-    const std::string mode = (useBigTIFF) ? "w8" : "w";
-    auto* out = lt::TIFFOpen(path.c_str(), mode.c_str());
-    if (out == nullptr) {
-        Logger()->error("Failed to open file for writing: {}", path.string());
-        throw IOException("Failed to open file for writing: " + path.string());
+// Check that tile dimensions are valid
+void CheckTileSize(const cv::Size& tileSize)
+{
+    // The TIFF spec requires tile dimensions to be multiples of 16
+    if (tileSize.width <= 0 or tileSize.height <= 0 or
+        tileSize.width % TILE_MULTIPLE != 0 or
+        tileSize.height % TILE_MULTIPLE != 0) {
+        throw vc::IOException(
+            "Tile dimensions must be positive multiples of 16");
     }
+}
 
+// Set the tags shared by the scanline and tiled writers. Closes out and throws
+// if the compression scheme is not supported.
+void SetEncodeFields(
+    lt::TIFF* out,
+    const EncodeParams& p,
+    unsigned width,
+    unsigned height,
+    tio::Compression compression)
+{
     // Encoding parameters
     lt::TIFFSetField(out, TIFFTAG_IMAGEWIDTH, width);
     lt::TIFFSetField(out, TIFFTAG_IMAGELENGTH, height);
-    lt::TIFFSetField(out, TIFFTAG_PHOTOMETRIC, photometric);
+    lt::TIFFSetField(out, TIFFTAG_PHOTOMETRIC, p.photometric);
     lt::TIFFSetField(out, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
-    lt::TIFFSetField(out, TIFFTAG_COMPRESSION, compression);
-    lt::TIFFSetField(out, TIFFTAG_SAMPLEFORMAT, sampleFormat);
-    lt::TIFFSetField(out, TIFFTAG_BITSPERSAMPLE, bitsPerSample);
-    lt::TIFFSetField(out, TIFFTAG_SAMPLESPERPIXEL, channels);
-    lt::TIFFSetField(out, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+    // libtiff accepts schemes without an encoder here and fails later, while
+    // writing, so check that the codec is available first
+    auto scheme = static_cast<std::uint16_t>(compression);
+    if (lt::TIFFIsCODECConfigured(scheme) == 0 or
+        lt::TIFFSetField(out, TIFFTAG_COMPRESSION, scheme) == 0) {
+        lt::TIFFClose(out);
+        throw vc::IOException(
+            "Unsupported TIFF compression scheme: " + std::to_string(scheme));
+    }
+    lt::TIFFSetField(out, TIFFTAG_SAMPLEFORMAT, p.sampleFormat);
+    lt::TIFFSetField(out, TIFFTAG_BITSPERSAMPLE, p.bitsPerSample);
+    lt::TIFFSetField(out, TIFFTAG_SAMPLESPERPIXEL, p.channels);
 
     // Add alpha tag data
     // TODO: Let user decide associated/unassociated tag
     // See TIFF 6.0 spec, section 18
-    if (channels == 2 or channels == 4) {
+    if (p.channels == 2 or p.channels == 4) {
         std::array<std::uint16_t, 1> tag{EXTRASAMPLE_UNASSALPHA};
         lt::TIFFSetField(out, TIFFTAG_EXTRASAMPLES, 1, tag.data());
     }
 
     // Metadata
     lt::TIFFSetField(
-        out, TIFFTAG_SOFTWARE, ProjectInfo::NameAndVersion().c_str());
+        out, TIFFTAG_SOFTWARE, vc::ProjectInfo::NameAndVersion().c_str());
+}
+
+auto OpenForWriting(const fs::path& path, const EncodeParams& p) -> lt::TIFF*
+{
+    if (p.bigTIFF) {
+        vc::Logger()->warn("File estimate >= 4GB. Writing as BigTIFF.");
+    }
+
+    // Open the file
+    const std::string mode = (p.bigTIFF) ? "w8" : "w";
+    auto* out = lt::TIFFOpen(path.c_str(), mode.c_str());
+    if (out == nullptr) {
+        vc::Logger()->error(
+            "Failed to open file for writing: {}", path.string());
+        throw vc::IOException(
+            "Failed to open file for writing: " + path.string());
+    }
+    return out;
+}
+
+// In-memory file used to compress tiles in parallel
+struct MemoryFile {
+    std::vector<char> data;
+    std::size_t pos{0};
+};
+
+auto MemRead(lt::thandle_t h, void* buf, lt::tmsize_t size) -> lt::tmsize_t
+{
+    auto* file = static_cast<MemoryFile*>(h);
+    auto n = std::min<std::size_t>(size, file->data.size() - file->pos);
+    std::memcpy(buf, file->data.data() + file->pos, n);
+    file->pos += n;
+    return static_cast<lt::tmsize_t>(n);
+}
+
+auto MemWrite(lt::thandle_t h, void* buf, lt::tmsize_t size) -> lt::tmsize_t
+{
+    auto* file = static_cast<MemoryFile*>(h);
+    auto n = static_cast<std::size_t>(size);
+    if (file->pos + n > file->data.size()) {
+        file->data.resize(file->pos + n);
+    }
+    std::memcpy(file->data.data() + file->pos, buf, n);
+    file->pos += n;
+    return size;
+}
+
+auto MemSeek(lt::thandle_t h, lt::toff_t off, int whence) -> lt::toff_t
+{
+    auto* file = static_cast<MemoryFile*>(h);
+    switch (whence) {
+        case SEEK_SET:
+            file->pos = off;
+            break;
+        case SEEK_CUR:
+            file->pos += off;
+            break;
+        case SEEK_END:
+            file->pos = file->data.size() + off;
+            break;
+        default:
+            return static_cast<lt::toff_t>(-1);
+    }
+    return file->pos;
+}
+
+auto MemClose(lt::thandle_t /*h*/) -> int { return 0; }
+
+auto MemSize(lt::thandle_t h) -> lt::toff_t
+{
+    return static_cast<MemoryFile*>(h)->data.size();
+}
+
+auto MemMap(lt::thandle_t /*h*/, void** /*base*/, lt::toff_t* /*size*/) -> int
+{
+    return 0;
+}
+
+void MemUnmap(lt::thandle_t /*h*/, void* /*base*/, lt::toff_t /*size*/) {}
+
+// Compress a single tile by writing it to an in-memory, single-tile TIFF and
+// extracting the encoded tile data. libtiff handles are not thread-safe, so
+// this lets every thread use its own encoder.
+auto CompressTile(
+    const EncodeParams& p,
+    const cv::Mat& tile,
+    tio::Compression compression) -> std::vector<char>
+{
+    MemoryFile file;
+    auto* tif = lt::TIFFClientOpen(
+        "tile", "w", &file, ::MemRead, ::MemWrite, ::MemSeek, ::MemClose,
+        ::MemSize, ::MemMap, ::MemUnmap);
+    if (tif == nullptr) {
+        throw vc::IOException("Failed to create tile encoder");
+    }
+
+    auto w = static_cast<unsigned>(tile.cols);
+    auto h = static_cast<unsigned>(tile.rows);
+    ::SetEncodeFields(tif, p, w, h, compression);
+    lt::TIFFSetField(tif, TIFFTAG_TILEWIDTH, w);
+    lt::TIFFSetField(tif, TIFFTAG_TILELENGTH, h);
+
+    // The encoder may modify its input buffer, so give it a copy
+    std::vector<char> buffer(tile.datastart, tile.dataend);
+    if (lt::TIFFWriteTile(tif, buffer.data(), 0, 0, 0, 0) < 0) {
+        lt::TIFFClose(tif);
+        throw vc::IOException("Failed to compress tile");
+    }
+
+    // Extract the encoded tile
+    std::uint64_t* offsets{nullptr};
+    std::uint64_t* counts{nullptr};
+    TIFFGetField(tif, TIFFTAG_TILEOFFSETS, &offsets);
+    TIFFGetField(tif, TIFFTAG_TILEBYTECOUNTS, &counts);
+    if (offsets == nullptr or counts == nullptr) {
+        lt::TIFFClose(tif);
+        throw vc::IOException("Failed to compress tile");
+    }
+    auto begin = file.data.begin() + static_cast<std::ptrdiff_t>(offsets[0]);
+    std::vector<char> encoded(
+        begin, begin + static_cast<std::ptrdiff_t>(counts[0]));
+    lt::TIFFClose(tif);
+
+    return encoded;
+}
+
+}  // namespace
+
+auto tio::ReadTIFF(const volcart::filesystem::path& path) -> cv::Mat
+{
+    return ReadTIFF(path, cv::Rect());
+}
+
+auto tio::ReadTIFF(const volcart::filesystem::path& path, const cv::Rect& roi)
+    -> cv::Mat
+{
+    // Make sure input file exists
+    if (!fs::exists(path)) {
+        throw IOException("File does not exist");
+    }
+
+    // Open the file read-only
+    lt::TIFF* tif = lt::TIFFOpen(path.c_str(), "r");
+    if (tif == nullptr) {
+        throw IOException("Failed to open tif");
+    }
+
+    // Get metadata
+    auto header = ::ReadHeader(tif);
+    auto cvType = ::GetCVMatType(header.type, header.depth, header.channels);
+    if (header.config == PLANARCONFIG_SEPARATE) {
+        lt::TIFFClose(tif);
+        throw IOException(
+            "Unsupported TIFF planar configuration: PLANARCONFIG_SEPARATE");
+    }
+
+    // Check the region
+    const cv::Rect bounds(
+        0, 0, static_cast<int>(header.width), static_cast<int>(header.height));
+    auto region = (roi.area() == 0) ? bounds : roi;
+    if ((region & bounds) != region) {
+        lt::TIFFClose(tif);
+        throw IOException("Region is outside of the image bounds");
+    }
+
+    // Construct the mat
+    cv::Mat img = cv::Mat::zeros(region.height, region.width, cvType);
+
+    // Read the strips or tiles which overlap the region
+    try {
+        if (header.tiled) {
+            ::ReadTiles(tif, region, img);
+        } else {
+            ::ReadStrips(tif, header, region, img);
+        }
+    } catch (...) {
+        lt::TIFFClose(tif);
+        throw;
+    }
+
+    // Do channel conversion
+    auto cvtNeeded = img.channels() == 3 or img.channels() == 4;
+    auto cvtSupported = img.depth() != CV_8S and img.depth() != CV_16S and
+                        img.depth() != CV_32S;
+    if (cvtNeeded) {
+        if (cvtSupported) {
+            if (img.channels() == 3) {
+                cv::cvtColor(img, img, cv::COLOR_RGB2BGR);
+            } else if (img.channels() == 4) {
+                cv::cvtColor(img, img, cv::COLOR_RGBA2BGRA);
+            }
+        } else {
+            vc::Logger()->warn(
+                "[TIFFIO] RGB->BGR conversion for signed 8-bit and 16-bit "
+                "images is not supported. Image will be loaded with RGB "
+                "element order.");
+        }
+    }
+
+    lt::TIFFClose(tif);
+
+    return img;
+}
+
+// Write a TIFF to a file. This implementation heavily borrows from how OpenCV's
+// TIFFEncoder writes to the TIFF
+void tio::WriteTIFF(
+    const fs::path& path, const cv::Mat& img, Compression compression)
+{
+    auto params = ::PrepareEncode(path, img);
+    auto* out = ::OpenForWriting(path, params);
+    ::SetEncodeFields(out, params, params.width, params.height, compression);
+    lt::TIFFSetField(out, TIFFTAG_ROWSPERSTRIP, params.height);
 
     // Row buffer. OpenCV documentation mentions that TIFFWriteScanline
     // modifies its read buffer, so we can't use the cv::Mat directly
@@ -270,8 +564,8 @@ void tio::WriteTIFF(
     std::vector<char> buffer(bufferSize + 32);
 
     // For each row
-    for (unsigned row = 0; row < height; row++) {
-        std::memcpy(&buffer[0], imgCopy.ptr(row), bufferSize);
+    for (unsigned row = 0; row < params.height; row++) {
+        std::memcpy(&buffer[0], params.img.ptr(row), bufferSize);
         auto result = lt::TIFFWriteScanline(out, &buffer[0], row, 0);
         if (result == -1) {
             lt::TIFFClose(out);
@@ -283,3 +577,291 @@ void tio::WriteTIFF(
     // Close the tiff
     lt::TIFFClose(out);
 }
+
+void tio::WriteTiledTIFF(
+    const fs::path& path,
+    const cv::Mat& img,
+    Compression compression,
+    const cv::Size& tileSize,
+    std::size_t numThreads)
+{
+    ::CheckTileSize(tileSize);
+    auto params = ::PrepareEncode(path, img);
+    auto* out = ::OpenForWriting(path, params);
+    ::SetEncodeFields(out, params, params.width, params.height, compression);
+    lt::TIFFSetField(out, TIFFTAG_TILEWIDTH, tileSize.width);
+    lt::TIFFSetField(out, TIFFTAG_TILELENGTH, tileSize.height);
+
+    // Tiles are numbered in row-major order
+    auto tilesAcross = (img.cols + tileSize.width - 1) / tileSize.width;
+    auto tilesDown = (img.rows + tileSize.height - 1) / tileSize.height;
+    auto numTiles = static_cast<std::size_t>(tilesAcross * tilesDown);
+    auto getTile = [&](std::size_t idx) {
+        auto tx = static_cast<int>(idx % tilesAcross) * tileSize.width;
+        auto ty = static_cast<int>(idx / tilesAcross) * tileSize.height;
+        const cv::Rect tileRect({tx, ty}, tileSize);
+        const auto overlap =
+            tileRect & cv::Rect(0, 0, params.img.cols, params.img.rows);
+
+        // Edge tiles are padded with zeros
+        cv::Mat tile = cv::Mat::zeros(tileSize, params.img.type());
+        params.img(overlap).copyTo(tile(overlap - tileRect.tl()));
+        return tile;
+    };
+
+    // JPEG tiles share encoding tables stored in the file header, so they
+    // can't be compressed independently
+    auto parallel = compression != Compression::JPEG and
+                    compression != Compression::OJPEG;
+    if (numThreads == 0) {
+        numThreads = ThreadPool::DefaultThreadCount();
+    }
+    if (not parallel or numThreads == 1) {
+        for (std::size_t idx = 0; idx < numTiles; idx++) {
+            auto tile = getTile(idx);
+            auto t = static_cast<std::uint32_t>(idx);
+            if (lt::TIFFWriteEncodedTile(out, t, tile.data, -1) < 0) {
+                lt::TIFFClose(out);
+                throw IOException("Failed to write tile " + std::to_string(t));
+            }
+        }
+        lt::TIFFClose(out);
+        return;
+    }
+
+    // Compress batches of tiles in parallel, then write them in order
+    ThreadPool pool(numThreads);
+    const auto batchSize = pool.size() * 4;
+    std::vector<std::vector<char>> encoded(batchSize);
+    for (std::size_t begin = 0; begin < numTiles; begin += batchSize) {
+        auto end = std::min(begin + batchSize, numTiles);
+        try {
+            pool.parallelFor(begin, end, [&](std::size_t idx) {
+                encoded[idx - begin] =
+                    ::CompressTile(params, getTile(idx), compression);
+            });
+        } catch (...) {
+            lt::TIFFClose(out);
+            throw;
+        }
+
+        for (auto idx = begin; idx < end; idx++) {
+            auto& data = encoded[idx - begin];
+            auto t = static_cast<std::uint32_t>(idx);
+            auto size = static_cast<lt::tmsize_t>(data.size());
+            if (lt::TIFFWriteRawTile(out, t, data.data(), size) < 0) {
+                lt::TIFFClose(out);
+                throw IOException("Failed to write tile " + std::to_string(t));
+            }
+        }
+    }
+
+    // Close the tiff
+    lt::TIFFClose(out);
+}
+
+struct tio::TiledTIFFWriter::Impl {
+    /** Output file */
+    lt::TIFF* tif{nullptr};
+    /** Encoding parameters */
+    EncodeParams params;
+    /** Image type */
+    int type{0};
+    /** Tile dimensions */
+    cv::Size tileSize;
+    /** Number of rows written */
+    int rows{0};
+    /** Index of the next tile */
+    std::uint32_t nextTile{0};
+
+    void closeFile()
+    {
+        if (tif != nullptr) {
+            lt::TIFFClose(tif);
+            tif = nullptr;
+        }
+    }
+};
+
+tio::TiledTIFFWriter::TiledTIFFWriter(
+    const fs::path& path,
+    const cv::Size& size,
+    int type,
+    Compression compression,
+    const cv::Size& tileSize)
+    : impl_{std::make_unique<Impl>()}
+{
+    ::CheckTileSize(tileSize);
+    impl_->params = ::GetEncodeParams(path, size, type);
+    impl_->type = type;
+    impl_->tileSize = tileSize;
+
+    const auto& params = impl_->params;
+    auto* tif = ::OpenForWriting(path, params);
+    ::SetEncodeFields(tif, params, params.width, params.height, compression);
+    impl_->tif = tif;
+    lt::TIFFSetField(impl_->tif, TIFFTAG_TILEWIDTH, tileSize.width);
+    lt::TIFFSetField(impl_->tif, TIFFTAG_TILELENGTH, tileSize.height);
+}
+
+tio::TiledTIFFWriter::~TiledTIFFWriter() { impl_->closeFile(); }
+
+auto tio::TiledTIFFWriter::size() const -> cv::Size
+{
+    return {
+        static_cast<int>(impl_->params.width),
+        static_cast<int>(impl_->params.height)};
+}
+
+auto tio::TiledTIFFWriter::tileSize() const -> cv::Size
+{
+    return impl_->tileSize;
+}
+
+auto tio::TiledTIFFWriter::rowsWritten() const -> int { return impl_->rows; }
+
+void tio::TiledTIFFWriter::writeTileRow(const cv::Mat& rows)
+{
+    auto& impl = *impl_;
+    if (impl.tif == nullptr) {
+        throw IOException("Writer is closed");
+    }
+
+    // Check the row dimensions
+    const auto imgSize = size();
+    const auto remaining = imgSize.height - impl.rows;
+    const auto expected = std::min(impl.tileSize.height, remaining);
+    if (rows.type() != impl.type or rows.cols != imgSize.width or
+        rows.rows != expected or expected == 0) {
+        throw IOException("Tile row has the wrong size or type");
+    }
+
+    // Edge tiles are padded with zeros
+    auto data = ::ConvertForEncode(rows);
+    const auto& ts = impl.tileSize;
+    cv::Mat tile(ts, rows.type());
+    for (int x = 0; x < imgSize.width; x += ts.width) {
+        const cv::Rect tileRect({x, 0}, ts);
+        const auto overlap = tileRect & cv::Rect(0, 0, data.cols, data.rows);
+        if (overlap.size() != ts) {
+            tile.setTo(0);
+        }
+        data(overlap).copyTo(tile(overlap - tileRect.tl()));
+
+        auto t = impl.nextTile++;
+        if (lt::TIFFWriteEncodedTile(impl.tif, t, tile.data, -1) < 0) {
+            impl.closeFile();
+            throw IOException("Failed to write tile " + std::to_string(t));
+        }
+    }
+    impl.rows += rows.rows;
+}
+
+void tio::TiledTIFFWriter::close()
+{
+    auto complete = impl_->rows == size().height;
+    impl_->closeFile();
+    if (not complete) {
+        throw IOException("Closed tiled TIFF before writing all rows");
+    }
+}
+
+void tio::MergeTiledTIFFs(
+    const std::vector<fs::path>& inputs, const fs::path& path)
+{
+    if (not vc::io::FileExtensionFilter(path, {"tif", "tiff"})) {
+        throw IOException(
+            "Invalid file extension " + path.extension().string());
+    }
+
+    // Use BigTIFF if the inputs are large
+    std::size_t totalBytes{0};
+    for (const auto& input : inputs) {
+        totalBytes += fs::file_size(input);
+    }
+    EncodeParams outParams;
+    outParams.bigTIFF = totalBytes >= MAX_TIFF_BYTES;
+    auto* out = ::OpenForWriting(path, outParams);
+
+    std::vector<char> buffer;
+    auto numPages = static_cast<std::uint16_t>(inputs.size());
+    for (std::uint16_t page = 0; page < numPages; page++) {
+        const auto& input = inputs[page];
+        auto* in = lt::TIFFOpen(input.c_str(), "r");
+        if (in == nullptr) {
+            lt::TIFFClose(out);
+            throw IOException("Failed to open file: " + input.string());
+        }
+        auto fail = [&](const std::string& msg) {
+            lt::TIFFClose(in);
+            lt::TIFFClose(out);
+            throw IOException(msg + ": " + input.string());
+        };
+
+        // Copy the encoding parameters
+        auto header = ::ReadHeader(in);
+        if (not header.tiled) {
+            fail("Image is not tiled");
+        }
+        std::uint16_t compression{COMPRESSION_NONE};
+        std::uint16_t photometric{PHOTOMETRIC_MINISBLACK};
+        std::uint32_t tileWidth{0};
+        std::uint32_t tileHeight{0};
+        TIFFGetField(in, TIFFTAG_COMPRESSION, &compression);
+        TIFFGetField(in, TIFFTAG_PHOTOMETRIC, &photometric);
+        TIFFGetField(in, TIFFTAG_TILEWIDTH, &tileWidth);
+        TIFFGetField(in, TIFFTAG_TILELENGTH, &tileHeight);
+        if (compression == COMPRESSION_JPEG or
+            compression == COMPRESSION_OJPEG) {
+            fail("Cannot copy JPEG compressed tiles");
+        }
+
+        EncodeParams params;
+        params.channels = header.channels;
+        params.bitsPerSample = header.depth;
+        params.sampleFormat = header.type;
+        params.photometric = photometric;
+        try {
+            ::SetEncodeFields(
+                out, params, header.width, header.height,
+                static_cast<Compression>(compression));
+        } catch (...) {
+            lt::TIFFClose(in);
+            throw;
+        }
+        lt::TIFFSetField(out, TIFFTAG_TILEWIDTH, tileWidth);
+        lt::TIFFSetField(out, TIFFTAG_TILELENGTH, tileHeight);
+        std::uint16_t predictor{0};
+        if (TIFFGetField(in, TIFFTAG_PREDICTOR, &predictor) == 1) {
+            lt::TIFFSetField(out, TIFFTAG_PREDICTOR, predictor);
+        }
+        lt::TIFFSetField(out, TIFFTAG_SUBFILETYPE, FILETYPE_PAGE);
+        lt::TIFFSetField(out, TIFFTAG_PAGENUMBER, page, numPages);
+
+        // Copy the compressed tiles
+        std::uint64_t* counts{nullptr};
+        TIFFGetField(in, TIFFTAG_TILEBYTECOUNTS, &counts);
+        if (counts == nullptr) {
+            fail("Failed to read tile sizes");
+        }
+        auto numTiles = lt::TIFFNumberOfTiles(in);
+        for (std::uint32_t t = 0; t < numTiles; t++) {
+            auto size = static_cast<lt::tmsize_t>(counts[t]);
+            buffer.resize(counts[t]);
+            if (lt::TIFFReadRawTile(in, t, buffer.data(), size) != size) {
+                fail("Failed to read tile " + std::to_string(t));
+            }
+            if (lt::TIFFWriteRawTile(out, t, buffer.data(), size) < 0) {
+                fail("Failed to write tile " + std::to_string(t));
+            }
+        }
+        lt::TIFFClose(in);
+
+        if (lt::TIFFWriteDirectory(out) == 0) {
+            lt::TIFFClose(out);
+            throw IOException("Failed to write page " + std::to_string(page));
+        }
+    }
+
+    lt::TIFFClose(out);
+}
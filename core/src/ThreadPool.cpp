@@ -0,0 +1,67 @@
+#include "vc/core/util/ThreadPool.hpp"
+
+using namespace volcart;
+
+ThreadPool::ThreadPool(std::size_t numThreads)
+{
+    numThreads = std::max<std::size_t>(numThreads, 1);
+    workers_.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; i++) {
+        workers_.emplace_back(&ThreadPool::run_, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& w : workers_) {
+        w.join();
+    }
+}
+
+auto ThreadPool::DefaultThreadCount() -> std::size_t
+{
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+auto ThreadPool::Shared() -> ThreadPool&
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+auto ThreadPool::queued() const -> std::size_t
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+void ThreadPool::enqueue_(std::function<void()> task)
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.emplace(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::run_()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if (stop_ && tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
@@ -1,11 +1,17 @@
 #include "vc/core/types/Transforms.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
+#include <optional>
+#include <vector>
 
 #include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/Json.hpp"
 #include "vc/core/util/Logging.hpp"
+#include "vc/core/util/ThreadPool.hpp"
 
 using namespace volcart;
 namespace vc = volcart;
@@ -26,6 +32,97 @@ auto LoadMetadata(const fs::path& path) -> nlohmann::ordered_json
     i >> m;
     return m;
 }
+
+// Number of points transformed per task by ApplyTransform
+constexpr std::size_t CHUNK_SIZE{1 << 14};
+
+// Apply an affine matrix to the first 3 elements of each value, treating
+// them as points
+template <int Cn>
+void AffinePoints(
+    const cv::Matx44d& m, cv::Vec<double, Cn>* values, std::size_t count)
+{
+    // Copy the matrix into locals so the loop can be vectorized
+    const auto m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2), m03 = m(0, 3);
+    const auto m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2), m13 = m(1, 3);
+    const auto m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2), m23 = m(2, 3);
+    for (std::size_t i = 0; i < count; i++) {
+        auto& v = values[i];
+        const auto x = v[0], y = v[1], z = v[2];
+        v[0] = m00 * x + m01 * y + m02 * z + m03;
+        v[1] = m10 * x + m11 * y + m12 * z + m13;
+        v[2] = m20 * x + m21 * y + m22 * z + m23;
+    }
+}
+
+// Normalize the normal component of each point and normal
+void NormalizeNormals(cv::Vec6d* ptNs, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        auto& v = ptNs[i];
+        const auto n = std::sqrt(v[3] * v[3] + v[4] * v[4] + v[5] * v[5]);
+        // Matches cv::normalize: zero vectors stay zero
+        const auto s = (n != 0.) ? 1. / n : 0.;
+        v[3] *= s;
+        v[4] *= s;
+        v[5] *= s;
+    }
+}
+
+// Apply an affine matrix to an array of points and normals
+void AffinePointsAndNormals(
+    const cv::Matx44d& m, cv::Vec6d* ptNs, std::size_t count, bool normalize)
+{
+    AffinePoints(m, ptNs, count);
+    const auto m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+    const auto m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+    const auto m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+    for (std::size_t i = 0; i < count; i++) {
+        auto& v = ptNs[i];
+        const auto x = v[3], y = v[4], z = v[5];
+        v[3] = m00 * x + m01 * y + m02 * z;
+        v[4] = m10 * x + m11 * y + m12 * z;
+        v[5] = m20 * x + m21 * y + m22 * z;
+    }
+    if (normalize) {
+        NormalizeNormals(ptNs, count);
+    }
+}
+
+// Compose a list of Affine and Identity transforms into a single matrix.
+// Returns std::nullopt if the list contains any other transform type.
+auto ComposeAffine(const std::vector<Transform3D::Pointer>& tfms)
+    -> std::optional<cv::Matx44d>
+{
+    auto m = cv::Matx44d::eye();
+    for (const auto& t : tfms) {
+        if (t->type() == AffineTransform::TYPE) {
+            m = std::static_pointer_cast<AffineTransform>(t)->params() * m;
+        } else if (t->type() != IdentityTransform::TYPE) {
+            return std::nullopt;
+        }
+    }
+    return m;
+}
+
+// Call fn(first, last) on chunks of [0, size). Chunks are processed in
+// parallel when there is more than one.
+template <class Fn>
+void ForEachChunk(std::size_t size, std::size_t chunkSize, const Fn& fn)
+{
+    auto numChunks = (size + chunkSize - 1) / chunkSize;
+    auto runChunk = [&](std::size_t c) {
+        auto first = c * chunkSize;
+        fn(first, std::min(first + chunkSize, size));
+    };
+    if (numChunks <= 1) {
+        for (std::size_t c = 0; c < numChunks; c++) {
+            runChunk(c);
+        }
+        return;
+    }
+    ThreadPool::Shared().parallelFor(0, numChunks, runChunk);
+}
 }  // namespace
 
 ///////////////////////////////////////
@@ -54,6 +151,21 @@ auto Transform3D::applyPointAndNormal(
     return {p[0], p[1], p[2], n[0], n[1], n[2]};
 }
 
+void Transform3D::applyPoints(cv::Vec3d* points, std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; i++) {
+        points[i] = applyPoint(points[i]);
+    }
+}
+
+void Transform3D::applyPointsAndNormals(
+    cv::Vec6d* ptNs, std::size_t count, bool normalize) const
+{
+    for (std::size_t i = 0; i < count; i++) {
+        ptNs[i] = applyPointAndNormal(ptNs[i], normalize);
+    }
+}
+
 void Transform3D::clear()
 {
     src_.clear();
@@ -185,6 +297,17 @@ auto AffineTransform::applyVector(const cv::Vec3d& vector) const -> cv::Vec3d
     return {p[0], p[1], p[2]};
 }
 
+void AffineTransform::applyPoints(cv::Vec3d* points, std::size_t count) const
+{
+    ::AffinePoints(params_, points, count);
+}
+
+void AffineTransform::applyPointsAndNormals(
+    cv::Vec6d* ptNs, std::size_t count, bool normalize) const
+{
+    ::AffinePointsAndNormals(params_, ptNs, count, normalize);
+}
+
 void AffineTransform::to_meta_(Metadata& meta) { meta["params"] = params_; }
 
 void AffineTransform::from_meta_(const Metadata& meta)
@@ -362,6 +485,18 @@ auto IdentityTransform::applyVector(const cv::Vec3d& vector) const -> cv::Vec3d
     return vector;
 }
 
+void IdentityTransform::applyPoints(cv::Vec3d* points, std::size_t count) const
+{
+}
+
+void IdentityTransform::applyPointsAndNormals(
+    cv::Vec6d* ptNs, std::size_t count, bool normalize) const
+{
+    if (normalize) {
+        ::NormalizeNormals(ptNs, count);
+    }
+}
+
 void IdentityTransform::to_meta_(Metadata& meta) {}
 
 void IdentityTransform::from_meta_(const Metadata& meta) {}
@@ -401,7 +536,38 @@ auto CompositeTransform::applyVector(const cv::Vec3d& vector) const -> cv::Vec3d
     for (const auto& t : tfms_) {
         vec = t->applyVector(vec);
     }
-    return vector;
+    return vec;
+}
+
+void CompositeTransform::applyPoints(cv::Vec3d* points, std::size_t count) const
+{
+    // Apply all transforms at once if they compose into a single matrix
+    if (auto m = ::ComposeAffine(tfms_)) {
+        ::AffinePoints(*m, points, count);
+        return;
+    }
+
+    for (const auto& t : tfms_) {
+        t->applyPoints(points, count);
+    }
+}
+
+void CompositeTransform::applyPointsAndNormals(
+    cv::Vec6d* ptNs, std::size_t count, bool normalize) const
+{
+    // Apply all transforms at once if they compose into a single matrix
+    if (auto m = ::ComposeAffine(tfms_)) {
+        ::AffinePointsAndNormals(*m, ptNs, count, normalize);
+        return;
+    }
+
+    // Like applyVector(), only normalize after the last transform
+    for (const auto& t : tfms_) {
+        t->applyPointsAndNormals(ptNs, count, false);
+    }
+    if (normalize) {
+        ::NormalizeNormals(ptNs, count);
+    }
 }
 
 void CompositeTransform::push_back(const Transform3D::Pointer& t)
@@ -494,21 +660,76 @@ auto vc::ApplyTransform(
     // Generate a new mesh
     auto out = ITKMesh::New();
 
-    // Copy and transform the vertices/normals
-    for (auto pt = mesh->GetPoints()->Begin(); pt != mesh->GetPoints()->End();
-         ++pt) {
-
-        // Transform point
-        auto p = pt->Value();
-        auto tPt = transform->applyPoint({p[0], p[1], p[2]});
-        p[0] = tPt[0];
-        p[1] = tPt[1];
-        p[2] = tPt[2];
-        out->SetPoint(pt.Index(), p);
-
-        // Transform vertex normal
-        ITKPixel n;
-        if (mesh->GetPointData(pt.Index(), &n)) {
+    // Normals can be transformed with the vertices if every vertex has one
+    const auto* inPts = mesh->GetPoints();
+    const auto* inNmls = mesh->GetPointData();
+    auto numPts = inPts->Size();
+    auto allNormals = inNmls != nullptr and inNmls->Size() == numPts;
+
+    // Copy and transform the vertices/normals in chunks
+    auto outPts = ITKPointsContainer::New();
+    outPts->Reserve(numPts);
+    auto outNmls = ITKMesh::PointDataContainer::New();
+    if (allNormals) {
+        outNmls->Reserve(numPts);
+    }
+
+    // Write through the underlying vectors. The non-const ElementAt()
+    // modifies the container's MTime, which isn't thread-safe.
+    auto& outPtsVec = outPts->CastToSTLContainer();
+    auto& outNmlsVec = outNmls->CastToSTLContainer();
+    ::ForEachChunk(numPts, ::CHUNK_SIZE, [&](auto first, auto last) {
+        std::vector<cv::Vec6d> buffer(last - first);
+        for (auto i = first; i < last; i++) {
+            const auto& p = inPts->ElementAt(i);
+            auto& v = buffer[i - first];
+            v = {p[0], p[1], p[2], 0, 0, 0};
+            if (allNormals) {
+                const auto& n = inNmls->ElementAt(i);
+                v[3] = n[0];
+                v[4] = n[1];
+                v[5] = n[2];
+            }
+        }
+
+        if (allNormals) {
+            transform->applyPointsAndNormals(
+                buffer.data(), buffer.size(), normalize);
+        } else {
+            // Only the points need to be transformed
+            std::vector<cv::Vec3d> pts(buffer.size());
+            for (std::size_t j = 0; j < pts.size(); j++) {
+                pts[j] = {buffer[j][0], buffer[j][1], buffer[j][2]};
+            }
+            transform->applyPoints(pts.data(), pts.size());
+            for (std::size_t j = 0; j < pts.size(); j++) {
+                std::copy_n(pts[j].val, 3, buffer[j].val);
+            }
+        }
+
+        for (auto i = first; i < last; i++) {
+            const auto& v = buffer[i - first];
+            auto& p = outPtsVec[i];
+            p[0] = v[0];
+            p[1] = v[1];
+            p[2] = v[2];
+            if (allNormals) {
+                auto& n = outNmlsVec[i];
+                n[0] = v[3];
+                n[1] = v[4];
+                n[2] = v[5];
+            }
+        }
+    });
+    out->SetPoints(outPts);
+
+    // Copy and transform the normals
+    if (allNormals) {
+        out->SetPointData(outNmls);
+    } else if (inNmls != nullptr) {
+        // Not every vertex has a normal
+        for (auto nml = inNmls->Begin(); nml != inNmls->End(); ++nml) {
+            auto n = nml->Value();
             cv::Vec3d tNml;
             if (normalize) {
                 tNml = transform->applyUnitVector({n[0], n[1], n[2]});
@@ -518,7 +739,7 @@ auto vc::ApplyTransform(
             n[0] = tNml[0];
             n[1] = tNml[1];
             n[2] = tNml[2];
-            out->SetPointData(pt.Index(), n);
+            out->SetPointData(nml.Index(), n);
         }
     }
 
@@ -534,12 +755,42 @@ auto vc::ApplyTransform(
     bool normalize) -> PerPixelMap
 {
     PerPixelMap output(ppm);
-
-    for (auto [y, x] : output.getMappingCoords()) {
-        const auto& m = output.getMapping(y, x);
-        output(y, x) = transform->applyPointAndNormal(m, normalize);
+    auto width = output.width();
+    if (width == 0) {
+        return output;
     }
 
+    // Transform each run of adjacent mapped pixels in place. Rows are stored
+    // contiguously, so a row without masked pixels is a single run.
+    auto mask = output.mask();
+    auto rowsPerChunk = std::max<std::size_t>(1, ::CHUNK_SIZE / width);
+    ::ForEachChunk(output.height(), rowsPerChunk, [&](auto first, auto last) {
+        for (auto y = first; y < last; y++) {
+            auto* row = &output(y, 0);
+            if (mask.empty()) {
+                transform->applyPointsAndNormals(row, width, normalize);
+                continue;
+            }
+
+            const auto* maskRow = mask.ptr<std::uint8_t>(y);
+            std::size_t x{0};
+            while (x < width) {
+                // Find the next run of mapped pixels
+                while (x < width and maskRow[x] != 255) {
+                    x++;
+                }
+                auto runStart = x;
+                while (x < width and maskRow[x] == 255) {
+                    x++;
+                }
+                if (x > runStart) {
+                    transform->applyPointsAndNormals(
+                        row + runStart, x - runStart, normalize);
+                }
+            }
+        }
+    });
+
     return output;
 }
 
@@ -1,17 +1,54 @@
 #include "vc/core/types/Volume.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 #include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
 
 #include "vc/core/io/TIFFIO.hpp"
+#include "vc/core/util/Profiling.hpp"
 
 namespace fs = volcart::filesystem;
 namespace tio = volcart::tiffio;
+namespace prof = volcart::profiling;
 
 using namespace volcart;
 
+// Max distance between consecutive slice requests in a sequential stream
+static constexpr int SEQUENTIAL_MAX_STEP{2};
+// Number of steps before a stream is considered sequential
+static constexpr int SEQUENTIAL_MIN_RUN{2};
+// Regions larger than this fraction of a slice are read through the cache
+static constexpr double REGION_CACHE_FRACTION{0.25};
+// Subdirectory which stores the resolution levels
+static const fs::path LEVELS_DIR{"levels"};
+// Time spent reading slices from disk
+static const prof::Timer LOAD_SLICE_TIMER{"Volume::load_slice"};
+
+namespace
+{
+// Convert a full-resolution position to a position in a level with the given
+// downsampling factor. Level voxel i covers full-resolution voxels
+// [i * scale, (i+1) * scale).
+auto LevelPosition(const cv::Vec3d& v, double scale) -> cv::Vec3d
+{
+    cv::Vec3d p;
+    for (int i = 0; i < 3; i++) {
+        p[i] = std::max((v[i] + 0.5) / scale - 0.5, 0.0);
+    }
+    return p;
+}
+}  // namespace
+
 // Load a Volume from disk
 Volume::Volume(fs::path path) : DiskBasedObjectBaseClass(std::move(path))
 {
@@ -23,6 +60,9 @@ Volume::Volume(fs::path path) : DiskBasedObjectBaseClass(std::move(path))
     height_ = metadata_.get<int>("height");
     slices_ = metadata_.get<int>("slices");
     numSliceCharacters_ = std::to_string(slices_).size();
+    if (metadata_.hasKey("levels")) {
+        numLevels_ = metadata_.get<int>("levels") + 1;
+    }
 }
 
 // Setup a Volume from a folder of slices
@@ -125,6 +165,27 @@ auto Volume::getSliceDataCopy(int index) const -> cv::Mat
     return getSliceData(index).clone();
 }
 
+auto Volume::getSliceRegion(int index, const cv::Rect& roi) const -> cv::Mat
+{
+    auto region = roi & cv::Rect(0, 0, sliceWidth(), sliceHeight());
+    if (cacheSlices_) {
+        const std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (cache_->contains(index)) {
+            return cache_->get(index)(region).clone();
+        }
+    }
+    if (region.area() == 0) {
+        return cv::Mat(region.size(), CV_16UC1);
+    }
+
+    // Large regions are cheaper to read once as a full, cached slice
+    auto sliceArea = static_cast<double>(sliceWidth()) * sliceHeight();
+    if (cacheSlices_ and region.area() > REGION_CACHE_FRACTION * sliceArea) {
+        return getSliceData(index)(region).clone();
+    }
+    return tio::ReadTIFF(getSlicePath(index), region);
+}
+
 void Volume::setSliceData(int index, const cv::Mat& slice, bool compress)
 {
     auto slicePath = getSlicePath(index);
@@ -168,7 +229,7 @@ auto Volume::interpolateAt(double x, double y, double z) const -> std::uint16_t
     auto c00 =
         intensityAt(x0, y0, z0) * (1 - dx) + intensityAt(x1, y0, z0) * dx;
     auto c10 =
-        intensityAt(x0, y1, z0) * (1 - dx) + intensityAt(x1, y0, z0) * dx;
+        intensityAt(x0, y1, z0) * (1 - dx) + intensityAt(x1, y1, z0) * dx;
     auto c01 =
         intensityAt(x0, y0, z1) * (1 - dx) + intensityAt(x1, y0, z1) * dx;
     auto c11 =
@@ -178,45 +239,495 @@ auto Volume::interpolateAt(double x, double y, double z) const -> std::uint16_t
     auto c1 = c01 * (1 - dy) + c11 * dy;
 
     auto c = c0 * (1 - dz) + c1 * dz;
+    prof::Count(prof::Counter::SamplesInterpolated);
     return static_cast<std::uint16_t>(cvRound(c));
 }
 
+void Volume::interpolateAt(
+    const cv::Vec3d* points, std::size_t count, std::uint16_t* out) const
+{
+    // Slices used by this batch. Neighborhoods span few slices, so a linear
+    // search is fast. Deque elements don't move when more are added.
+    std::deque<std::pair<int, cv::Mat>> slices;
+    auto getSlice = [this, &slices](int z) -> const cv::Mat* {
+        if (z >= numSlices()) {
+            return nullptr;
+        }
+        for (const auto& [index, slice] : slices) {
+            if (index == z) {
+                return &slice;
+            }
+        }
+        return &slices.emplace_back(z, getSliceData(z)).second;
+    };
+    // Voxel value which is 0 outside of the slice
+    auto voxel = [this](const cv::Mat* slice, int x, int y) -> double {
+        if (slice == nullptr || x >= sliceWidth() || y >= sliceHeight()) {
+            return 0;
+        }
+        return slice->at<std::uint16_t>(y, x);
+    };
+
+    for (std::size_t i = 0; i < count; i++) {
+        const auto& [x, y, z] = points[i].val;
+        if (!isInBounds(x, y, z)) {
+            out[i] = 0;
+            continue;
+        }
+
+        double intPart;
+        double dx = std::modf(x, &intPart);
+        auto x0 = static_cast<int>(intPart);
+        double dy = std::modf(y, &intPart);
+        auto y0 = static_cast<int>(intPart);
+        double dz = std::modf(z, &intPart);
+        auto z0 = static_cast<int>(intPart);
+
+        const auto* s0 = getSlice(z0);
+        const auto* s1 = getSlice(z0 + 1);
+
+        auto c00 = voxel(s0, x0, y0) * (1 - dx) + voxel(s0, x0 + 1, y0) * dx;
+        auto c10 =
+            voxel(s0, x0, y0 + 1) * (1 - dx) + voxel(s0, x0 + 1, y0 + 1) * dx;
+        auto c01 = voxel(s1, x0, y0) * (1 - dx) + voxel(s1, x0 + 1, y0) * dx;
+        auto c11 =
+            voxel(s1, x0, y0 + 1) * (1 - dx) + voxel(s1, x0 + 1, y0 + 1) * dx;
+
+        auto c0 = c00 * (1 - dy) + c10 * dy;
+        auto c1 = c01 * (1 - dy) + c11 * dy;
+
+        auto c = c0 * (1 - dz) + c1 * dz;
+        out[i] = static_cast<std::uint16_t>(cvRound(c));
+    }
+    prof::Count(prof::Counter::SamplesInterpolated, count);
+}
+
+void Volume::getVoxelBlock(
+    const cv::Vec3i& origin, const cv::Vec3i& size, std::uint16_t* out) const
+{
+    const auto dx = size[0];
+    const auto dy = size[1];
+    const auto dz = size[2];
+    if (dx <= 0 || dy <= 0 || dz <= 0) {
+        return;
+    }
+    const auto rowSize = static_cast<std::size_t>(dx);
+    const auto sliceSize = rowSize * dy;
+
+    // Range of x which is inside of the Volume
+    auto x0 = std::clamp(origin[0], 0, sliceWidth());
+    auto x1 = std::clamp(origin[0] + dx, 0, sliceWidth());
+    auto before = static_cast<std::size_t>(x0 - origin[0]);
+    auto inside = static_cast<std::size_t>(std::max(x1 - x0, 0));
+
+    for (int k = 0; k < dz; k++) {
+        auto* outSlice = out + k * sliceSize;
+        auto z = origin[2] + k;
+        if (z < 0 || z >= numSlices() || inside == 0) {
+            std::fill_n(outSlice, sliceSize, 0);
+            continue;
+        }
+
+        const auto slice = getSliceData(z);
+        for (int j = 0; j < dy; j++) {
+            auto* outRow = outSlice + j * rowSize;
+            auto y = origin[1] + j;
+            if (y < 0 || y >= sliceHeight()) {
+                std::fill_n(outRow, rowSize, 0);
+                continue;
+            }
+            std::fill_n(outRow, before, 0);
+            std::memcpy(
+                outRow + before, slice.ptr<std::uint16_t>(y, x0),
+                inside * sizeof(std::uint16_t));
+            std::fill_n(
+                outRow + before + inside, rowSize - before - inside, 0);
+        }
+    }
+}
+
+void Volume::interpolateBlock(
+    const cv::Vec3d& origin, const cv::Vec3i& size, double* out) const
+{
+    const auto dx = size[0];
+    const auto dy = size[1];
+    const auto dz = size[2];
+    if (dx <= 0 || dy <= 0 || dz <= 0) {
+        return;
+    }
+
+    // Voxels which surround the samples, one larger than the output on each
+    // axis
+    cv::Vec3i base;
+    cv::Vec3d t;
+    for (int i = 0; i < 3; i++) {
+        auto f = std::floor(origin[i]);
+        base[i] = static_cast<int>(f);
+        t[i] = origin[i] - f;
+    }
+    const cv::Vec3i inSize{dx + 1, dy + 1, dz + 1};
+    std::vector<std::uint16_t> voxels(
+        static_cast<std::size_t>(inSize[0]) * inSize[1] * inSize[2]);
+    getVoxelBlock(base, inSize, voxels.data());
+
+    // Interpolate along x: (dx+1, dy+1, dz+1) -> (dx, dy+1, dz+1)
+    const auto numRows = static_cast<std::size_t>(inSize[1]) * inSize[2];
+    std::vector<double> xPass(numRows * dx);
+    for (std::size_t row = 0; row < numRows; row++) {
+        const auto* in = voxels.data() + row * inSize[0];
+        auto* o = xPass.data() + row * dx;
+        for (int i = 0; i < dx; i++) {
+            o[i] = in[i] * (1 - t[0]) + in[i + 1] * t[0];
+        }
+    }
+
+    // Interpolate along y: (dx, dy+1, dz+1) -> (dx, dy, dz+1)
+    std::vector<double> yPass(static_cast<std::size_t>(dx) * dy * inSize[2]);
+    for (int k = 0; k < inSize[2]; k++) {
+        for (int j = 0; j < dy; j++) {
+            const auto* in0 = xPass.data() + (k * inSize[1] + j) * dx;
+            const auto* in1 = in0 + dx;
+            auto* o = yPass.data() + (k * dy + j) * dx;
+            for (int i = 0; i < dx; i++) {
+                o[i] = in0[i] * (1 - t[1]) + in1[i] * t[1];
+            }
+        }
+    }
+
+    // Interpolate along z: (dx, dy, dz+1) -> (dx, dy, dz)
+    const auto sliceSize = static_cast<std::size_t>(dx) * dy;
+    for (int k = 0; k < dz; k++) {
+        const auto* in0 = yPass.data() + k * sliceSize;
+        const auto* in1 = in0 + sliceSize;
+        auto* o = out + k * sliceSize;
+        for (std::size_t i = 0; i < sliceSize; i++) {
+            o[i] = in0[i] * (1 - t[2]) + in1[i] * t[2];
+        }
+    }
+
+    // Match interpolateAt(), which returns 0 for samples out of bounds
+    for (int k = 0; k < dz; k++) {
+        for (int j = 0; j < dy; j++) {
+            for (int i = 0; i < dx; i++) {
+                if (!isInBounds(origin[0] + i, origin[1] + j, origin[2] + k)) {
+                    out[(k * dy + j) * dx + i] = 0;
+                }
+            }
+        }
+    }
+    prof::Count(prof::Counter::SamplesInterpolated, sliceSize * dz);
+}
+
 auto Volume::reslice(
     const cv::Vec3d& center,
     const cv::Vec3d& xvec,
     const cv::Vec3d& yvec,
     int width,
-    int height) const -> Reslice
+    int height,
+    int level) const -> Reslice
 {
-    auto xnorm = cv::normalize(xvec);
-    auto ynorm = cv::normalize(yvec);
+    auto scale = static_cast<double>(LevelScale(level));
+    auto xnorm = scale * cv::normalize(xvec);
+    auto ynorm = scale * cv::normalize(yvec);
     auto origin = center - ((width / 2) * xnorm + (height / 2) * ynorm);
 
+    // Look up the level once for the whole plane
+    Volume::Pointer vol;
+    if (level > 0) {
+        vol = this->level(level);
+    }
     cv::Mat m(height, width, CV_16UC1);
     for (int h = 0; h < height; ++h) {
         for (int w = 0; w < width; ++w) {
-            m.at<std::uint16_t>(h, w) =
-                interpolateAt(origin + (h * ynorm) + (w * xnorm));
+            auto p = origin + (h * ynorm) + (w * xnorm);
+            std::uint16_t value{0};
+            if (level == 0) {
+                value = interpolateAt(p);
+            } else if (isInBounds(p)) {
+                value = vol->interpolateAt(LevelPosition(p, scale));
+            }
+            m.at<std::uint16_t>(h, w) = value;
         }
     }
 
     return Reslice(m, origin, xnorm, ynorm);
 }
 
+auto Volume::numLevels() const -> int { return numLevels_; }
+
+auto Volume::level(int level) const -> Volume::Pointer
+{
+    if (level < 0 || level >= numLevels()) {
+        throw std::out_of_range(
+            "Volume level out of range: " + std::to_string(level));
+    }
+    if (level == 0) {
+        return std::const_pointer_cast<Volume>(shared_from_this());
+    }
+
+    const std::lock_guard<std::mutex> lock(levelsMutex_);
+    levels_.resize(static_cast<std::size_t>(numLevels_ - 1));
+    auto& vol = levels_[level - 1];
+    if (not vol) {
+        vol = Volume::New(level_path_(level));
+
+        // Downsampled slices are smaller, so hold more of them in the same
+        // amount of memory
+        auto factor = std::size_t{1} << (2 * level);
+        vol->setCacheCapacity(getCacheCapacity() * factor);
+        vol->setPrefetchDepth(prefetchDepth_);
+    }
+    return vol;
+}
+
+auto Volume::getSliceData(int index, int level) const -> cv::Mat
+{
+    if (level == 0) {
+        return getSliceData(index);
+    }
+    return this->level(level)->getSliceData(index);
+}
+
+auto Volume::interpolateAt(const cv::Vec3d& v, int level) const
+    -> std::uint16_t
+{
+    if (level == 0) {
+        return interpolateAt(v);
+    }
+
+    if (!isInBounds(v)) {
+        return 0;
+    }
+    auto scale = static_cast<double>(LevelScale(level));
+    return this->level(level)->interpolateAt(LevelPosition(v, scale));
+}
+
+void Volume::generateLevels(int levels, bool compress)
+{
+    // Remove the existing levels
+    {
+        const std::lock_guard<std::mutex> lock(levelsMutex_);
+        levels_.clear();
+    }
+    fs::remove_all(path_ / LEVELS_DIR);
+    metadata_.set("levels", 0);
+    numLevels_ = 1;
+
+    // Each level is generated from the previous one
+    Volume::Pointer prev;
+    for (int l = 1; l <= levels; l++) {
+        const Volume& src = (prev) ? *prev : *this;
+        auto width = (src.sliceWidth() + 1) / 2;
+        auto height = (src.sliceHeight() + 1) / 2;
+        auto slices = (src.numSlices() + 1) / 2;
+
+        auto levelPath = level_path_(l);
+        fs::create_directories(levelPath);
+        auto dst = Volume::New(
+            levelPath, id() + "_" + std::to_string(l),
+            name() + " (level " + std::to_string(l) + ")");
+        dst->setSliceWidth(width);
+        dst->setSliceHeight(height);
+        dst->setNumberOfSlices(slices);
+        dst->setVoxelSize(voxelSize() * LevelScale(l));
+        dst->setMin(min());
+        dst->setMax(max());
+        dst->saveMetadata();
+
+        for (int z = 0; z < slices; z++) {
+            // Average neighboring slices
+            cv::Mat sum;
+            src.getSliceData(2 * z).convertTo(sum, CV_32F);
+            if (2 * z + 1 < src.numSlices()) {
+                cv::Mat next;
+                src.getSliceData(2 * z + 1).convertTo(next, CV_32F);
+                cv::addWeighted(sum, 0.5, next, 0.5, 0, sum);
+            }
+
+            // Average neighboring rows and columns
+            cv::Mat down;
+            cv::resize(sum, down, {width, height}, 0, 0, cv::INTER_AREA);
+            down.convertTo(down, CV_16U);
+            dst->setSliceData(z, down, compress);
+        }
+
+        prev = dst;
+    }
+
+    metadata_.set("levels", levels);
+    numLevels_ = levels + 1;
+    saveMetadata();
+}
+
 auto Volume::load_slice_(int index) const -> cv::Mat
 {
+    const prof::ScopedTimer timer(LOAD_SLICE_TIMER);
     auto slicePath = getSlicePath(index);
-    return cv::imread(slicePath.string(), -1);
+    auto slice = cv::imread(slicePath.string(), -1);
+    auto bytes = slice.total() * slice.elemSize();
+    prof::Count(prof::Counter::SliceBytesLoaded, bytes);
+    return slice;
+}
+
+auto Volume::level_path_(int level) const -> fs::path
+{
+    return path_ / LEVELS_DIR / std::to_string(level);
 }
 
 auto Volume::cache_slice_(int index) const -> cv::Mat
 {
-    const std::lock_guard<std::mutex> lock(cacheMutex_);
+    std::unique_lock<std::mutex> lock(cacheMutex_);
+    track_access_(index);
+
+    // Wait if another thread is already loading this slice
+    loadedCV_.wait(lock, [&]() { return loading_.count(index) == 0; });
     if (cache_->contains(index)) {
+        prof::Count(prof::Counter::SliceCacheHits);
         return cache_->get(index);
     }
+    prof::Count(prof::Counter::SliceCacheMisses);
+
+    // Claim the slice so a queued prefetch doesn't load it again
+    prefetchQueued_.erase(index);
+    loading_.insert(index);
+    lock.unlock();
+
+    // Load without blocking access to other slices
+    cv::Mat slice;
+    try {
+        slice = load_slice_(index);
+    } catch (...) {
+        lock.lock();
+        loading_.erase(index);
+        loadedCV_.notify_all();
+        throw;
+    }
 
-    auto slice = load_slice_(index);
+    lock.lock();
     cache_->put(index, slice);
+    loading_.erase(index);
+    loadedCV_.notify_all();
     return slice;
 }
+
+void Volume::setPrefetchDepth(std::size_t depth) { prefetchDepth_ = depth; }
+
+auto Volume::prefetchDepth() const -> std::size_t { return prefetchDepth_; }
+
+void Volume::setPrefetchThreads(std::size_t n)
+{
+    waitForPrefetch();
+    std::unique_ptr<ThreadPool> oldPool;
+    {
+        const std::lock_guard<std::mutex> lock(cacheMutex_);
+        prefetchThreads_ = std::max<std::size_t>(n, 1);
+        oldPool = std::move(prefetchPool_);
+    }
+}
+
+void Volume::prefetch(int zBegin, int zEnd) const
+{
+    const std::lock_guard<std::mutex> lock(cacheMutex_);
+    queue_prefetch_(zBegin, zEnd);
+}
+
+void Volume::waitForPrefetch() const
+{
+    std::unique_lock<std::mutex> lock(cacheMutex_);
+    loadedCV_.wait(
+        lock, [&]() { return prefetchQueued_.empty() && loading_.empty(); });
+}
+
+void Volume::track_access_(int index) const
+{
+    if (prefetchDepth_ == 0) {
+        return;
+    }
+
+    // Revisiting the stream head
+    auto delta = static_cast<std::int64_t>(index) - streamHead_;
+    if (delta == 0) {
+        return;
+    }
+
+    // Large jumps start a new stream
+    if (std::abs(delta) > SEQUENTIAL_MAX_STEP) {
+        streamHead_ = index;
+        streamDir_ = 0;
+        streamRun_ = 0;
+        return;
+    }
+
+    auto dir = (delta > 0) ? 1 : -1;
+    if (dir == streamDir_) {
+        // Advance the stream
+        streamHead_ = index;
+        streamRun_++;
+    } else if (streamRun_ > 0) {
+        // Small steps behind the head are normal (e.g. interpolating between
+        // slices z and z + 1), so they don't reverse the stream
+        return;
+    } else {
+        // Start moving in a direction
+        streamHead_ = index;
+        streamDir_ = dir;
+        streamRun_ = 1;
+    }
+
+    // Read ahead in the direction of travel
+    if (streamRun_ >= SEQUENTIAL_MIN_RUN) {
+        auto depth = static_cast<int>(prefetchDepth_);
+        if (streamDir_ > 0) {
+            queue_prefetch_(index + 1, index + 1 + depth);
+        } else {
+            queue_prefetch_(index - depth, index);
+        }
+    }
+}
+
+void Volume::queue_prefetch_(int zBegin, int zEnd) const
+{
+    if (not cacheSlices_) {
+        return;
+    }
+
+    zBegin = std::max(zBegin, 0);
+    zEnd = std::min(zEnd, slices_);
+    for (auto z = zBegin; z < zEnd; z++) {
+        if (prefetchQueued_.count(z) > 0 || loading_.count(z) > 0 ||
+            cache_->contains(z)) {
+            continue;
+        }
+        if (not prefetchPool_) {
+            prefetchPool_ = std::make_unique<ThreadPool>(prefetchThreads_);
+        }
+        prefetchQueued_.insert(z);
+        prefetchPool_->submit([this, z]() { prefetch_slice_(z); });
+    }
+}
+
+void Volume::prefetch_slice_(int index) const
+{
+    // Skip slices which were claimed by another thread
+    std::unique_lock<std::mutex> lock(cacheMutex_);
+    if (prefetchQueued_.erase(index) == 0) {
+        return;
+    }
+    loading_.insert(index);
+    lock.unlock();
+
+    // Load the slice. Failures are ignored here and reported when the slice
+    // is requested directly.
+    cv::Mat slice;
+    try {
+        slice = load_slice_(index);
+    } catch (...) {
+    }
+
+    lock.lock();
+    if (not slice.empty()) {
+        cache_->put(index, slice);
+    }
+    loading_.erase(index);
+    loadedCV_.notify_all();
+}
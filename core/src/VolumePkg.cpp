@@ -459,6 +459,13 @@ auto VolumePkg::volume(const Volume::Identifier& id) -> Volume::Pointer
     return volumes_.at(id);
 }
 
+void VolumePkg::removeVolume(const Volume::Identifier& id)
+{
+    auto vol = volumes_.at(id);
+    volumes_.erase(id);
+    fs::remove_all(vol->path());
+}
+
 // SEGMENTATION FUNCTIONS //
 auto VolumePkg::hasSegmentations() const -> bool
 {
@@ -558,6 +565,19 @@ auto VolumePkg::renderIDs() const -> std::vector<Render::Identifier>
     return ids;
 }
 
+auto VolumePkg::findCheckpoint(
+    const std::string& name, const std::string& hash) const
+    -> std::optional<fs::path>
+{
+    // Render IDs are timestamps, so reverse order is newest first
+    for (auto r = renders_.rbegin(); r != renders_.rend(); ++r) {
+        if (auto file = r->second->checkpoint(name, hash)) {
+            return file;
+        }
+    }
+    return std::nullopt;
+}
+
 auto VolumePkg::renderNames() const -> std::vector<std::string>
 {
     std::vector<std::string> names;
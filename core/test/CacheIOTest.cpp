@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+
+#include "vc/core/io/CacheIO.hpp"
+#include "vc/core/io/MeshIO.hpp"
+#include "vc/core/shapes/Arch.hpp"
+#include "vc/core/types/Exceptions.hpp"
+
+using namespace volcart;
+using namespace volcart::io;
+namespace fs = volcart::filesystem;
+
+TEST(CacheIO, WriteReadMesh)
+{
+    auto mesh = shapes::Arch().itkMesh();
+    auto uv = UVMap::New(UVMap::Origin::BottomLeft);
+    uv->ratio(2, 1);
+    for (std::size_t id = 0; id < mesh->GetNumberOfPoints(); id++) {
+        uv->set(id, {0.001 * id, 1.0 - 0.001 * id});
+    }
+    cv::Mat texture(20, 10, CV_16UC1);
+    cv::randu(texture, 0, 65535);
+
+    const fs::path path{"vc_core_CacheIO_WriteReadMesh.vcmesh"};
+    WriteMesh(path, mesh, uv, texture);
+    auto result = ReadMesh(path);
+
+    // Vertices and normals
+    ASSERT_EQ(result.mesh->GetNumberOfPoints(), mesh->GetNumberOfPoints());
+    for (auto pt = mesh->GetPoints()->Begin(); pt != mesh->GetPoints()->End();
+         ++pt) {
+        EXPECT_EQ(result.mesh->GetPoint(pt.Index()), pt.Value());
+        ITKPixel expected;
+        ITKPixel actual;
+        mesh->GetPointData(pt.Index(), &expected);
+        result.mesh->GetPointData(pt.Index(), &actual);
+        EXPECT_EQ(actual, expected);
+    }
+
+    // Faces
+    ASSERT_EQ(result.mesh->GetNumberOfCells(), mesh->GetNumberOfCells());
+    for (auto cell = mesh->GetCells()->Begin(); cell != mesh->GetCells()->End();
+         ++cell) {
+        ITKCell::CellAutoPointer actual;
+        result.mesh->GetCell(cell.Index(), actual);
+        ASSERT_EQ(actual->GetNumberOfPoints(), 3);
+        for (std::uint32_t i = 0; i < 3; i++) {
+            EXPECT_EQ(
+                actual->GetPointIds()[i], cell.Value()->GetPointIds()[i]);
+        }
+    }
+
+    // Texturing information
+    ASSERT_TRUE(result.uv);
+    EXPECT_EQ(result.uv->origin(), uv->origin());
+    EXPECT_DOUBLE_EQ(result.uv->ratio().aspect, uv->ratio().aspect);
+    EXPECT_EQ(result.uv->as_map(), uv->as_map());
+    EXPECT_EQ(result.texture.type(), texture.type());
+    EXPECT_EQ(cv::countNonZero(result.texture != texture), 0);
+}
+
+TEST(CacheIO, WriteReadUVMap)
+{
+    UVMap uv;
+    uv.ratio(100, 50);
+    uv.set(0, {0, 0});
+    uv.set(3, {0.5, 0.25});
+    uv.set(7, {1, 1});
+
+    const fs::path path{"vc_core_CacheIO_WriteReadUVMap.vcuv"};
+    WriteUVMapCache(path, uv);
+    auto result = ReadUVMapCache(path);
+    EXPECT_EQ(result.as_map(), uv.as_map());
+    EXPECT_DOUBLE_EQ(result.ratio().width, 100);
+    EXPECT_DOUBLE_EQ(result.ratio().height, 50);
+}
+
+TEST(CacheIO, WriteReadPPM)
+{
+    PerPixelMap ppm(30, 20);
+    cv::Mat mask = cv::Mat::zeros(30, 20, CV_8UC1);
+    cv::Mat cellMap(30, 20, CV_32SC1, cv::Scalar::all(-1));
+    for (auto y = 5; y < 25; ++y) {
+        for (auto x = 2; x < 18; ++x) {
+            auto dx = static_cast<double>(x);
+            auto dy = static_cast<double>(y);
+            ppm(y, x) = {dx, dy, dx + dy, 0, 0, 1};
+            mask.at<std::uint8_t>(y, x) = 255U;
+            cellMap.at<std::int32_t>(y, x) = y * 20 + x;
+        }
+    }
+    ppm.setMask(mask);
+    ppm.setCellMap(cellMap);
+
+    const fs::path path{"vc_core_CacheIO_WriteReadPPM.vcppm"};
+    WritePPMCache(path, ppm);
+    auto result = ReadPPMCache(path);
+
+    ASSERT_EQ(result.height(), ppm.height());
+    ASSERT_EQ(result.width(), ppm.width());
+    for (std::size_t y = 0; y < ppm.height(); ++y) {
+        for (std::size_t x = 0; x < ppm.width(); ++x) {
+            EXPECT_EQ(result(y, x), ppm(y, x));
+        }
+    }
+    EXPECT_EQ(cv::countNonZero(result.mask() != ppm.mask()), 0);
+    EXPECT_EQ(cv::countNonZero(result.cellMap() != ppm.cellMap()), 0);
+}
+
+TEST(CacheIO, DetectsCorruption)
+{
+    UVMap uv;
+    uv.ratio(1, 1);
+    uv.set(0, {0.5, 0.5});
+
+    const fs::path path{"vc_core_CacheIO_DetectsCorruption.vcuv"};
+    WriteUVMapCache(path, uv);
+
+    // Flip a byte in the payload
+    {
+        std::fstream file(path.string(), std::ios::in | std::ios::out |
+                                             std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('\x7f');
+    }
+    EXPECT_THROW(ReadUVMapCache(path), IOException);
+
+    // Wrong cache type
+    WriteUVMapCache(path, uv);
+    EXPECT_THROW(ReadPPMCache(path), IOException);
+}
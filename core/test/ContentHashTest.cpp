@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+#include "vc/core/util/ContentHash.hpp"
+
+using namespace volcart;
+namespace fs = volcart::filesystem;
+
+TEST(ContentHash, EmptyInput)
+{
+    // FNV-1a offset basis
+    ContentHash hash;
+    EXPECT_EQ(hash.digest(), 14695981039346656037ULL);
+    EXPECT_EQ(hash.hex(), "cbf29ce484222325");
+
+    hash.update(nullptr, 0);
+    EXPECT_EQ(hash.digest(), 14695981039346656037ULL);
+}
+
+TEST(ContentHash, SplitUpdates)
+{
+    const std::string data{"The quick brown fox jumps over the lazy dog"};
+    ContentHash whole;
+    whole.update(data);
+
+    for (std::size_t split = 0; split <= data.size(); split++) {
+        ContentHash parts;
+        parts.update(data.substr(0, split));
+        parts.update(data.substr(split));
+        EXPECT_EQ(parts.digest(), whole.digest());
+    }
+}
+
+TEST(ContentHash, DifferentInputs)
+{
+    ContentHash a;
+    a.update("abcdefghij");
+    ContentHash b;
+    b.update("abcdefghik");
+    EXPECT_NE(a.digest(), b.digest());
+    EXPECT_EQ(a.hex().size(), std::size_t{16});
+}
+
+TEST(ContentHash, File)
+{
+    const std::string data{"vc_core_ContentHash_File"};
+    const fs::path path{"vc_core_ContentHash_File.txt"};
+    {
+        std::ofstream file(path.string(), std::ios::binary);
+        file << data;
+    }
+
+    ContentHash expected;
+    expected.update(data);
+    ContentHash actual;
+    actual.updateFile(path);
+    EXPECT_EQ(actual.digest(), expected.digest());
+}
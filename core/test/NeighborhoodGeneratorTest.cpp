@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/neighborhood/CuboidGenerator.hpp"
+#include "vc/core/neighborhood/LineGenerator.hpp"
+#include "vc/core/types/Volume.hpp"
+#include "vc/testing/TestingUtils.hpp"
+
+namespace vctest = volcart::testing;
+using namespace volcart;
+
+class NeighborhoodGeneratorTest : public ::testing::Test
+{
+public:
+    static constexpr int DIM{16};
+
+    void SetUp() override
+    {
+        vol = vctest::MakeSyntheticVolume(
+            "NeighborhoodGeneratorTest.volume", DIM,
+            [](int x, int y, int z) { return 1000 * z + DIM * y + x; });
+    }
+
+    // Sample a cuboid neighborhood one point at a time
+    auto cuboid(
+        cv::Vec3d r,
+        double i,
+        Direction d,
+        const cv::Vec3d& pt,
+        const std::vector<cv::Vec3d>& b) const -> std::vector<std::uint16_t>
+    {
+        auto center = pt;
+        if (d != Direction::Bidirectional) {
+            r[0] /= 2;
+            auto sign = (d == Direction::Negative) ? -1 : 1;
+            center += sign * b[0] * r[0];
+        }
+        std::vector<std::uint16_t> result;
+        for (int z = 0; z <= static_cast<int>(2 * r[0] / i); z++) {
+            for (int y = 0; y <= static_cast<int>(2 * r[1] / i); y++) {
+                for (int x = 0; x <= static_cast<int>(2 * r[2] / i); x++) {
+                    auto p = center + b[2] * (-r[2] + x * i) +
+                             b[1] * (-r[1] + y * i) + b[0] * (-r[0] + z * i);
+                    result.push_back(vol->interpolateAt(p));
+                }
+            }
+        }
+        return result;
+    }
+
+    Volume::Pointer vol;
+};
+
+TEST_F(NeighborhoodGeneratorTest, BatchInterpolate)
+{
+    std::vector<cv::Vec3d> points{
+        {3.25, 4.5, 2.75}, {5, 6, 7}, {-1, 2, 3}, {2, 2, DIM - 0.5}, {7, 1, 9}};
+    std::vector<std::uint16_t> result(points.size());
+    vol->interpolateAt(points.data(), points.size(), result.data());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(result[i], vol->interpolateAt(points[i]));
+    }
+}
+
+TEST_F(NeighborhoodGeneratorTest, CuboidAligned)
+{
+    const cv::Vec3d r{2, 3, 1};
+    CuboidGenerator gen;
+    gen.setSamplingRadius(r);
+    const std::vector<std::vector<cv::Vec3d>> axes{
+        {{0, 0, 1}, {0, 1, 0}, {1, 0, 0}}, {{-1, 0, 0}, {0, 0, 1}, {0, -1, 0}}};
+    for (const auto& b : axes) {
+        for (const auto d :
+             {Direction::Bidirectional, Direction::Positive,
+              Direction::Negative}) {
+            gen.setSamplingDirection(d);
+            const cv::Vec3d pt{7.5, 6.25, 8};
+            auto n = gen.compute(vol, pt, b);
+            auto expected = cuboid(r, 1, d, pt, b);
+            ASSERT_EQ(n.size(), expected.size());
+            for (std::size_t i = 0; i < n.size(); i++) {
+                EXPECT_EQ(n.data()[i], expected[i]);
+            }
+        }
+    }
+}
+
+TEST_F(NeighborhoodGeneratorTest, CuboidOblique)
+{
+    const cv::Vec3d r{2, 2, 3};
+    CuboidGenerator gen;
+    gen.setSamplingRadius(r);
+    gen.setSamplingInterval(0.5);
+    const std::vector<cv::Vec3d> b{
+        cv::normalize(cv::Vec3d{1, 1, 1}), cv::normalize(cv::Vec3d{1, -1, 0}),
+        cv::normalize(cv::Vec3d{1, 1, -2})};
+    const cv::Vec3d pt{8, 8, 8};
+    auto n = gen.compute(vol, pt, b);
+    auto expected = cuboid(r, 0.5, Direction::Bidirectional, pt, b);
+    ASSERT_EQ(n.size(), expected.size());
+    for (std::size_t i = 0; i < n.size(); i++) {
+        EXPECT_EQ(n.data()[i], expected[i]);
+    }
+}
+
+TEST_F(NeighborhoodGeneratorTest, Line)
+{
+    LineGenerator gen;
+    gen.setSamplingRadius(3);
+    gen.setSamplingInterval(0.5);
+    gen.setSamplingDirection(Direction::Positive);
+    const cv::Vec3d pt{5, 6, 7};
+    const cv::Vec3d axis = cv::normalize(cv::Vec3d{1, 2, 3});
+    auto n = gen.compute(vol, pt, {axis});
+    ASSERT_EQ(n.size(), 7);
+    for (std::size_t i = 0; i < n.size(); i++) {
+        auto expected = vol->interpolateAt(pt + axis * (i * 0.5));
+        EXPECT_EQ(n(i), expected);
+    }
+}
@@ -1,4 +1,8 @@
+#include <array>
+#include <cstddef>
+#include <fstream>
 #include <iostream>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <opencv2/core.hpp>
@@ -84,4 +88,79 @@ TEST_F(OBJReader, Invalid)
 {
     reader.setPath(path + "Invalid.obj");
     EXPECT_THROW(reader.read(), IOException);
-}
\ No newline at end of file
+}
+
+TEST_F(OBJReader, ParseFormatting)
+{
+    // Comments, blank lines, tabs, CRLF line endings, negative references
+    path += "ParseFormatting.obj";
+    std::ofstream file(path, std::ios::binary);
+    file << "# Comment\n"
+            "\n"
+            "v 0.1 0.2 0.3\r\n"
+            "v\t1.0000000000000002 -2.5e-7   3\n"
+            "   \n"
+            "v 123456.78901234567 0 1e10 # trailing comment\n"
+            "vt 0.25 0.5\n"
+            "vt 0.75 0.5\n"
+            "vt 0.5 1\n"
+            "vn 1 0 0\n"
+            "vn 0 1 0\n"
+            "vn 0 0 1\n"
+            "f 1/1/1 2/2/2 3/3/3\n"
+            "# Negative references count back from the last element\n"
+            "f -3/-3/-3 -1/-1/-1 -2/-2/-2\n"
+            "f 1//-1 2//-2 -1//1\n";
+    file.close();
+
+    reader.setPath(path);
+    ASSERT_NO_THROW(reader.read());
+    auto mesh = reader.getMesh();
+    ASSERT_EQ(mesh->GetNumberOfPoints(), 3);
+    ASSERT_EQ(mesh->GetNumberOfCells(), 3);
+
+    // Values are parsed exactly
+    EXPECT_EQ(mesh->GetPoint(0)[0], 0.1);
+    EXPECT_EQ(mesh->GetPoint(0)[2], 0.3);
+    EXPECT_EQ(mesh->GetPoint(1)[0], 1.0000000000000002);
+    EXPECT_EQ(mesh->GetPoint(1)[1], -2.5e-7);
+    EXPECT_EQ(mesh->GetPoint(2)[0], 123456.78901234567);
+    EXPECT_EQ(mesh->GetPoint(2)[2], 1e10);
+
+    // Faces
+    const std::vector<std::array<ITKMesh::PointIdentifier, 3>> faces{
+        {0, 1, 2}, {0, 2, 1}, {0, 1, 2}};
+    for (std::size_t c = 0; c < faces.size(); c++) {
+        ITKCell::CellAutoPointer cell;
+        mesh->GetCell(c, cell);
+        for (int i = 0; i < 3; i++) {
+            EXPECT_EQ(cell->GetPointIds()[i], faces[c][i]);
+        }
+    }
+
+    // UVs are relative to the bottom-left in the file
+    auto uv = reader.getUVMap();
+    using Origin = UVMap::Origin;
+    EXPECT_EQ(uv->get(0, Origin::BottomLeft), cv::Vec2d(0.25, 0.5));
+    EXPECT_EQ(uv->get(1, Origin::BottomLeft), cv::Vec2d(0.75, 0.5));
+    EXPECT_EQ(uv->get(2, Origin::BottomLeft), cv::Vec2d(0.5, 1));
+
+    // The last face sets the normals again
+    const std::vector<cv::Vec3d> normals{{0, 0, 1}, {0, 1, 0}, {1, 0, 0}};
+    for (std::size_t p = 0; p < normals.size(); p++) {
+        ITKPixel n;
+        mesh->GetPointData(p, &n);
+        EXPECT_EQ(cv::Vec3d(n[0], n[1], n[2]), normals[p]);
+    }
+}
+
+TEST_F(OBJReader, InvalidNegativeReference)
+{
+    path += "InvalidNegativeReference.obj";
+    std::ofstream file(path);
+    file << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf -1 -2 -4\n";
+    file.close();
+
+    reader.setPath(path);
+    EXPECT_THROW(reader.read(), IOException);
+}
@@ -2,9 +2,11 @@
 
 #include <cstddef>
 
+#include "vc/core/io/OBJReader.hpp"
 #include "vc/core/io/OBJWriter.hpp"
 #include "vc/core/shapes/Plane.hpp"
 #include "vc/core/types/SimpleMesh.hpp"
+#include "vc/core/types/UVMap.hpp"
 #include "vc/testing/ParsingHelpers.hpp"
 
 namespace vc = volcart;
@@ -72,4 +74,60 @@ TEST_F(OBJWriter, UntexturedMesh)
 
         idx++;
     }
-}
\ No newline at end of file
+}
+
+TEST(OBJWriterReader, RoundTrip)
+{
+    // Values which need all 17 significant digits
+    const std::vector<cv::Vec3d> points{
+        {0.1, 1.0 / 3.0, -2.5e-7},
+        {123456.78901234567, 1.0000000000000002, 1e10},
+        {-0.0001, 2.0 / 3.0, 7.0}};
+    const std::vector<cv::Vec3d> normals{
+        {0.6, 0.8, 0}, {1.0 / 3.0, 2.0 / 3.0, 2.0 / 3.0}, {0, 0, -1}};
+    const std::vector<cv::Vec2d> uvs{{0.125, 0.25}, {0.75, 0.375}, {1, 0}};
+
+    auto mesh = vc::ITKMesh::New();
+    auto uvMap = vc::UVMap::New();
+    for (std::size_t i = 0; i < points.size(); i++) {
+        mesh->SetPoint(i, points[i].val);
+        mesh->SetPointData(i, normals[i].val);
+        uvMap->set(i, uvs[i]);
+    }
+    vc::ITKCell::CellAutoPointer cell;
+    cell.TakeOwnership(new vc::ITKTriangle);
+    cell->SetPointId(0, 0);
+    cell->SetPointId(1, 2);
+    cell->SetPointId(2, 1);
+    mesh->SetCell(0, cell);
+
+    const std::string path{"vc_core_OBJWriter_RoundTrip.obj"};
+    vc::io::OBJWriter writer;
+    writer.setPath(path);
+    writer.setMesh(mesh);
+    writer.setUVMap(uvMap);
+    ASSERT_NO_THROW(writer.write());
+
+    vc::io::OBJReader reader;
+    reader.setPath(path);
+    ASSERT_NO_THROW(reader.read());
+    auto read = reader.getMesh();
+    auto readUV = reader.getUVMap();
+    ASSERT_EQ(read->GetNumberOfPoints(), points.size());
+    ASSERT_EQ(read->GetNumberOfCells(), 1);
+
+    // Positions, normals, and UVs are read back exactly
+    for (std::size_t i = 0; i < points.size(); i++) {
+        auto p = read->GetPoint(i);
+        EXPECT_EQ(cv::Vec3d(p[0], p[1], p[2]), points[i]);
+        vc::ITKPixel n;
+        read->GetPointData(i, &n);
+        EXPECT_EQ(cv::Vec3d(n[0], n[1], n[2]), normals[i]);
+        EXPECT_EQ(readUV->get(i), uvs[i]);
+    }
+
+    read->GetCell(0, cell);
+    EXPECT_EQ(cell->GetPointIds()[0], 0);
+    EXPECT_EQ(cell->GetPointIds()[1], 2);
+    EXPECT_EQ(cell->GetPointIds()[2], 1);
+}
@@ -54,4 +54,33 @@ TEST_F(OrderedPointSetIO, WriteReadASCII)
     EXPECT_EQ(read(0, 0), ps(0, 0));
     EXPECT_EQ(read(0, 1), ps(0, 1));
     EXPECT_EQ(read(0, 2), ps(0, 2));
-}
\ No newline at end of file
+}
+
+TEST_F(OrderedPointSetIO, MappedReadRows)
+{
+    // Write to disk
+    path += "MappedReadRows.vcps";
+    ps.pushRow({{4, 4, 4}, {5, 5, 5}, {6, 6, 6}});
+    ps.pushRow({{7, 7, 7}, {8, 8, 8}, {9, 9, 9}});
+    PointSetIO<cv::Vec3i>::WriteOrderedPointSet(path, ps);
+
+    // Map the file
+    MappedPointSet<cv::Vec3i> mapped(path);
+    EXPECT_TRUE(mapped.ordered());
+    EXPECT_EQ(mapped.width(), ps.width());
+    EXPECT_EQ(mapped.height(), ps.height());
+    EXPECT_EQ(mapped.size(), ps.size());
+
+    // Check row and point access
+    EXPECT_EQ(mapped.row(1), ps.getRow(1));
+    EXPECT_EQ(mapped[8], ps(2, 2));
+
+    // Check row-range read
+    auto rows = mapped.readRows(1, 2);
+    EXPECT_EQ(rows.width(), ps.width());
+    EXPECT_EQ(rows.height(), 2);
+    for (std::size_t i = 0; i < rows.size(); i++) {
+        EXPECT_EQ(rows[i], ps[i + ps.width()]);
+    }
+    EXPECT_THROW(mapped.readRows(2, 2), std::range_error);
+}
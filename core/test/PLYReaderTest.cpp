@@ -259,4 +259,43 @@ TEST_F(ReadITKSphereMeshFixture, ReadSphereMeshTest)
         EXPECT_EQ(in_C->GetPointIds()[1], read_C->GetPointIds()[1]);
         EXPECT_EQ(in_C->GetPointIds()[2], read_C->GetPointIds()[2]);
     }
-}
\ No newline at end of file
+}
+
+TEST(PLYReader, ReadBinaryMesh)
+{
+    auto mesh = volcart::shapes::Arch().itkMesh();
+    volcart::io::PLYWriter writer("PLYReader_arch_binary.ply", mesh);
+    writer.setFormat(volcart::io::PLYWriter::Format::BinaryLittleEndian);
+    writer.write();
+
+    volcart::io::PLYReader reader("PLYReader_arch_binary.ply");
+    auto read = reader.read();
+    ASSERT_EQ(mesh->GetNumberOfPoints(), read->GetNumberOfPoints());
+    ASSERT_EQ(mesh->GetNumberOfCells(), read->GetNumberOfCells());
+    for (std::uint64_t id = 0; id < mesh->GetNumberOfPoints(); id++) {
+        // Written as single precision floats
+        auto expected = mesh->GetPoint(id);
+        auto actual = read->GetPoint(id);
+        for (int i = 0; i < 3; i++) {
+            EXPECT_FLOAT_EQ(expected[i], actual[i]);
+        }
+
+        volcart::ITKPixel expectedN;
+        volcart::ITKPixel actualN;
+        mesh->GetPointData(id, &expectedN);
+        read->GetPointData(id, &actualN);
+        for (int i = 0; i < 3; i++) {
+            EXPECT_FLOAT_EQ(expectedN[i], actualN[i]);
+        }
+    }
+
+    for (std::uint64_t id = 0; id < mesh->GetNumberOfCells(); id++) {
+        volcart::ITKCell::CellAutoPointer expected;
+        volcart::ITKCell::CellAutoPointer actual;
+        mesh->GetCell(id, expected);
+        read->GetCell(id, actual);
+        for (int i = 0; i < 3; i++) {
+            EXPECT_EQ(expected->GetPointIds()[i], actual->GetPointIds()[i]);
+        }
+    }
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <vector>
+
+#include "vc/core/io/PLYReader.hpp"
 #include "vc/core/io/PLYWriter.hpp"
 #include "vc/core/shapes/Plane.hpp"
 #include "vc/core/types/SimpleMesh.hpp"
@@ -70,4 +74,51 @@ TEST_F(PLYWriter, UntexturedMesh)
 
         idx++;
     }
-}
\ No newline at end of file
+}
+
+TEST(PLYWriterReader, ASCIIPrecisionRoundTrip)
+{
+    const std::vector<cv::Vec3d> points{
+        {0.1, 1.0 / 3.0, -2.5e-7},
+        {123456.78901234567, 1.0000000000000002, 1e10},
+        {-0.0001, 2.0 / 3.0, 7.0}};
+
+    auto mesh = vc::ITKMesh::New();
+    for (std::size_t i = 0; i < points.size(); i++) {
+        mesh->SetPoint(i, points[i].val);
+        mesh->SetPointData(i, cv::normalize(points[i]).val);
+    }
+    vc::ITKCell::CellAutoPointer cell;
+    cell.TakeOwnership(new vc::ITKTriangle);
+    for (int i = 0; i < 3; i++) {
+        cell->SetPointId(i, i);
+    }
+    mesh->SetCell(0, cell);
+
+    const std::string path{"vc_core_PLYWriter_ASCIIPrecision.ply"};
+    vc::io::PLYWriter writer(path, mesh);
+    writer.setFormat(vc::io::PLYWriter::Format::ASCII);
+    ASSERT_NO_THROW(writer.write());
+
+    vc::io::PLYReader reader(path);
+    auto read = reader.read();
+    ASSERT_EQ(read->GetNumberOfPoints(), points.size());
+
+    // Values are written as floats, and every float is read back exactly
+    for (std::size_t i = 0; i < points.size(); i++) {
+        auto expected = mesh->GetPoint(i);
+        auto actual = read->GetPoint(i);
+        vc::ITKPixel expectedN;
+        vc::ITKPixel actualN;
+        mesh->GetPointData(i, &expectedN);
+        read->GetPointData(i, &actualN);
+        for (int c = 0; c < 3; c++) {
+            EXPECT_EQ(
+                static_cast<float>(actual[c]),
+                static_cast<float>(expected[c]));
+            EXPECT_EQ(
+                static_cast<float>(actualN[c]),
+                static_cast<float>(expectedN[c]));
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "vc/core/util/Profiling.hpp"
+
+using namespace volcart;
+namespace prof = volcart::profiling;
+
+namespace
+{
+constexpr auto CACHE_HITS = static_cast<std::size_t>(
+    prof::Counter::SliceCacheHits);
+constexpr auto SAMPLES = static_cast<std::size_t>(
+    prof::Counter::SamplesInterpolated);
+}  // namespace
+
+TEST(Profiling, DisabledByDefault)
+{
+    EXPECT_FALSE(prof::IsEnabled());
+    prof::Reset();
+    prof::Count(prof::Counter::SliceCacheHits, 10);
+    auto report = prof::Snapshot();
+    EXPECT_EQ(report.counters[CACHE_HITS], 0);
+}
+
+TEST(Profiling, CountAcrossThreads)
+{
+    prof::SetEnabled(true);
+    prof::Reset();
+
+    // Includes the counts of threads which have exited
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 1000; i++) {
+                prof::Count(prof::Counter::SamplesInterpolated);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    prof::Count(prof::Counter::SamplesInterpolated, 5);
+
+    auto report = prof::Snapshot();
+    EXPECT_EQ(report.counters[SAMPLES], 4005);
+    EXPECT_EQ(report.counters[CACHE_HITS], 0);
+
+    prof::Reset();
+    report = prof::Snapshot();
+    EXPECT_EQ(report.counters[SAMPLES], 0);
+    prof::SetEnabled(false);
+}
+
+TEST(Profiling, Timers)
+{
+    const prof::Timer a{"ProfilingTest::a"};
+    const prof::Timer b{"ProfilingTest::b"};
+    const prof::Timer aAgain{"ProfilingTest::a"};
+    EXPECT_EQ(a.id(), aAgain.id());
+    EXPECT_NE(a.id(), b.id());
+
+    prof::SetEnabled(true);
+    prof::Reset();
+    for (int i = 0; i < 3; i++) {
+        const prof::ScopedTimer timer(a);
+    }
+    auto report = prof::Snapshot();
+    prof::SetEnabled(false);
+
+    // Only called timers are reported
+    ASSERT_EQ(report.timers.size(), 1);
+    EXPECT_EQ(report.timers[0].name, "ProfilingTest::a");
+    EXPECT_EQ(report.timers[0].calls, 3);
+    EXPECT_GE(report.timers[0].seconds, 0);
+
+    auto json = prof::ToJson(report);
+    EXPECT_EQ(json["counters"]["samplesInterpolated"], 0);
+    EXPECT_EQ(json["timers"]["ProfilingTest::a"]["calls"], 3);
+}
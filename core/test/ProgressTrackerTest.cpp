@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "vc/core/util/ProgressTracker.hpp"
+
+using namespace volcart;
+
+namespace
+{
+struct TestProgress : public IterationsProgress {
+    auto progressIterations() const -> std::size_t override { return 4000; }
+};
+}  // namespace
+
+TEST(ProgressTracker, AddFromThreads)
+{
+    TestProgress p;
+    bool started{false};
+    bool completed{false};
+    std::size_t updates{0};
+    std::size_t last{0};
+    p.progressStarted.connect([&]() { started = true; });
+    p.progressUpdated.connect([&](std::size_t v) {
+        EXPECT_GE(v, last);
+        updates++;
+        last = v;
+    });
+    p.progressComplete.connect([&]() { completed = true; });
+
+    ProgressTracker progress(p, std::chrono::milliseconds{1});
+    EXPECT_TRUE(started);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&progress]() {
+            for (int i = 0; i < 10; i++) {
+                progress.add(100);
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(progress.count(), 4000);
+    EXPECT_FALSE(completed);
+
+    progress.complete();
+    EXPECT_TRUE(completed);
+    EXPECT_GE(updates, 1);
+    EXPECT_EQ(last, 4000);
+
+    // Complete is only sent once
+    completed = false;
+    progress.complete();
+    EXPECT_FALSE(completed);
+}
+
+TEST(ProgressTracker, FinalCountReportedOnce)
+{
+    TestProgress p;
+    std::size_t updates{0};
+    p.progressUpdated.connect([&](std::size_t) { updates++; });
+
+    // Long interval: only the final count is reported
+    ProgressTracker progress(p, std::chrono::hours{1});
+    for (std::size_t i = 0; i < 4000; i++) {
+        progress.set(i + 1);
+    }
+    progress.complete();
+    EXPECT_EQ(updates, 1);
+}
+
+TEST(ProgressTracker, NoCompleteWithoutCall)
+{
+    TestProgress p;
+    bool completed{false};
+    p.progressComplete.connect([&]() { completed = true; });
+    {
+        ProgressTracker progress(p);
+        progress.add(10);
+    }
+    EXPECT_FALSE(completed);
+}
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include "vc/core/math/StructureTensor.hpp"
+#include "vc/core/math/StructureTensorField.hpp"
+#include "vc/core/types/VolumePkg.hpp"
+
+using namespace volcart;
+
+TEST(StructureTensorField, MatchesVoxelTensor)
+{
+    VolumePkg pkg{"Testing.volpkg"};
+    auto volume = pkg.volume();
+    StructureTensorField field(volume, 2);
+
+    cv::Vec3d p{50, 10, 10};
+    auto expected = ComputeSubvoxelStructureTensor(volume, p, 2);
+    auto result = field.at(p);
+    for (int i = 0; i < 9; i++) {
+        EXPECT_DOUBLE_EQ(result.val[i], expected.val[i]);
+    }
+    EXPECT_EQ(field.numBlocks(), 1);
+
+    // Halfway between two voxels is their average
+    auto a = field.voxelAt(50, 10, 10);
+    auto b = field.voxelAt(51, 10, 10);
+    auto mid = field.at({50.5, 10, 10});
+    for (int i = 0; i < 9; i++) {
+        EXPECT_NEAR(mid.val[i], 0.5 * (a.val[i] + b.val[i]), 1e-12);
+    }
+}
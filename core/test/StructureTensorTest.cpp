@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "vc/core/math/StructureTensor.hpp"
+#include "vc/testing/TestingUtils.hpp"
+
+using namespace volcart;
+namespace vctest = volcart::testing;
+
+TEST(StructureTensor, SubvoxelNeighborsPathsMatch)
+{
+    auto volume = vctest::MakeSyntheticVolume(
+        "StructureTensorTest.volume", 16, [](int x, int y, int z) {
+            return (13 * x * x + 29 * y + 5 * z * z) % 4096;
+        });
+    constexpr int r{2};
+    const cv::Vec3d center{8.25, 7.5, 6.75};
+
+    // Volume axes use interpolateBlock(). Flipping the x-axis samples the same
+    // positions with interpolateAt().
+    auto block = ComputeSubvoxelNeighbors<double>(volume, center, r, r, r);
+    auto points = ComputeSubvoxelNeighbors<double>(
+        volume, center, r, r, r, {-1, 0, 0});
+    for (int c = 0; c <= 2 * r; c++) {
+        for (int b = 0; b <= 2 * r; b++) {
+            for (int a = 0; a <= 2 * r; a++) {
+                EXPECT_EQ(block(a, b, c), points(2 * r - a, b, c));
+                EXPECT_EQ(block(a, b, c), std::round(block(a, b, c)));
+            }
+        }
+    }
+}
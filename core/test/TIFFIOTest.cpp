@@ -1,10 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <random>
+#include <string>
+#include <vector>
 
 #include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
 
 #include "vc/core/io/TIFFIO.hpp"
 #include "vc/core/types/Exceptions.hpp"
@@ -533,4 +537,177 @@ TEST(TIFFIO, WriteRead32FC4)
     auto equal = std::equal(
         result.begin<PixelT>(), result.end<PixelT>(), img.begin<PixelT>());
     EXPECT_TRUE(equal);
-}
\ No newline at end of file
+}
+
+TEST(TIFFIO, ReadRegion16UC1)
+{
+    using PixelT = std::uint16_t;
+    auto cvType = CV_16UC1;
+
+    cv::Mat img(100, 70, cvType);
+    ::FillRandom<PixelT>(img);
+
+    const fs::path imgPath("vc_core_TIFFIO_ReadRegion.tif");
+    WriteTIFF(imgPath, img);
+
+    const cv::Rect roi(13, 21, 40, 50);
+    auto result = ReadTIFF(imgPath, roi);
+    EXPECT_EQ(result.size(), roi.size());
+    EXPECT_EQ(result.type(), img.type());
+
+    cv::Mat expected = img(roi);
+    auto equal = std::equal(
+        result.begin<PixelT>(), result.end<PixelT>(),
+        expected.begin<PixelT>());
+    EXPECT_TRUE(equal);
+
+    // Regions must be inside the image
+    EXPECT_THROW(ReadTIFF(imgPath, cv::Rect(60, 0, 20, 10)), IOException);
+}
+
+TEST(TIFFIO, WriteReadTiled8UC3)
+{
+    using ElemT = std::uint8_t;
+    using PixelT = cv::Vec<ElemT, 3>;
+    auto cvType = CV_8UC3;
+
+    // Image size is not a multiple of the tile size
+    cv::Mat img(100, 70, cvType);
+    ::FillRandom<ElemT, 3>(img);
+
+    const fs::path imgPath("vc_core_TIFFIO_WriteReadTiled.tif");
+    WriteTiledTIFF(imgPath, img, Compression::LZW, {32, 16}, 4);
+    auto result = ReadTIFF(imgPath);
+
+    EXPECT_EQ(result.size, img.size);
+    EXPECT_EQ(result.type(), img.type());
+
+    auto equal = std::equal(
+        result.begin<PixelT>(), result.end<PixelT>(), img.begin<PixelT>());
+    EXPECT_TRUE(equal);
+
+    // Read a region spanning several tiles
+    const cv::Rect roi(20, 10, 45, 75);
+    result = ReadTIFF(imgPath, roi);
+    EXPECT_EQ(result.size(), roi.size());
+
+    cv::Mat expected = img(roi);
+    equal = std::equal(
+        result.begin<PixelT>(), result.end<PixelT>(),
+        expected.begin<PixelT>());
+    EXPECT_TRUE(equal);
+}
+
+TEST(TIFFIO, WriteTiledSequentialMatchesParallel)
+{
+    using PixelT = float;
+    cv::Mat img(50, 40, CV_32FC1);
+    ::FillRandom<PixelT>(img);
+
+    const fs::path seqPath("vc_core_TIFFIO_WriteTiled_Sequential.tif");
+    const fs::path parPath("vc_core_TIFFIO_WriteTiled_Parallel.tif");
+    WriteTiledTIFF(seqPath, img, Compression::DEFLATE, {16, 16}, 1);
+    WriteTiledTIFF(parPath, img, Compression::DEFLATE, {16, 16}, 3);
+
+    auto seq = ReadTIFF(seqPath);
+    auto par = ReadTIFF(parPath);
+    EXPECT_TRUE(std::equal(
+        seq.begin<PixelT>(), seq.end<PixelT>(), img.begin<PixelT>()));
+    EXPECT_TRUE(std::equal(
+        par.begin<PixelT>(), par.end<PixelT>(), img.begin<PixelT>()));
+
+    // Tile dimensions must be multiples of 16
+    const cv::Size badSize(20, 16);
+    EXPECT_THROW(
+        WriteTiledTIFF(parPath, img, Compression::NONE, badSize), IOException);
+}
+
+TEST(TIFFIO, TiledWriterMatchesWriteTiled)
+{
+    using PixelT = std::uint16_t;
+    cv::Mat img(70, 50, CV_16UC1);
+    ::FillRandom<PixelT>(img);
+
+    // Write one row of tiles at a time. The last row is partial.
+    const fs::path imgPath("vc_core_TIFFIO_TiledWriter.tif");
+    TiledTIFFWriter writer(
+        imgPath, img.size(), img.type(), Compression::LZW, {32, 32});
+    EXPECT_EQ(writer.size(), img.size());
+    for (int y = 0; y < img.rows; y += writer.tileSize().height) {
+        auto rows = std::min(writer.tileSize().height, img.rows - y);
+        writer.writeTileRow(img.rowRange(y, y + rows));
+    }
+    EXPECT_EQ(writer.rowsWritten(), img.rows);
+    writer.close();
+
+    auto result = ReadTIFF(imgPath);
+    EXPECT_EQ(result.size, img.size);
+    EXPECT_EQ(result.type(), img.type());
+    EXPECT_TRUE(std::equal(
+        result.begin<PixelT>(), result.end<PixelT>(), img.begin<PixelT>()));
+}
+
+TEST(TIFFIO, TiledWriterErrors)
+{
+    const fs::path imgPath("vc_core_TIFFIO_TiledWriterErrors.tif");
+    TiledTIFFWriter writer(
+        imgPath, {40, 40}, CV_8UC1, Compression::NONE, {16, 16});
+
+    // Rows must match the tile height, width, and type
+    EXPECT_THROW(writer.writeTileRow(cv::Mat(8, 40, CV_8UC1)), IOException);
+    EXPECT_THROW(writer.writeTileRow(cv::Mat(16, 32, CV_8UC1)), IOException);
+    EXPECT_THROW(writer.writeTileRow(cv::Mat(16, 40, CV_16UC1)), IOException);
+
+    // Closing before all rows are written
+    writer.writeTileRow(cv::Mat::zeros(16, 40, CV_8UC1));
+    EXPECT_THROW(writer.close(), IOException);
+}
+
+TEST(TIFFIO, UnsupportedCompression)
+{
+    // Not a compression scheme, so libtiff has no encoder for it
+    const auto compression = static_cast<Compression>(12345);
+    const fs::path imgPath("vc_core_TIFFIO_UnsupportedCompression.tif");
+    cv::Mat img = cv::Mat::zeros(16, 16, CV_8UC1);
+    EXPECT_THROW(WriteTIFF(imgPath, img, compression), IOException);
+    EXPECT_THROW(
+        WriteTiledTIFF(imgPath, img, compression, {16, 16}), IOException);
+    EXPECT_THROW(
+        TiledTIFFWriter(imgPath, {16, 16}, CV_8UC1, compression, {16, 16}),
+        IOException);
+}
+
+TEST(TIFFIO, MergeTiledTIFFs)
+{
+    using PixelT = std::uint16_t;
+    std::vector<cv::Mat> pages;
+    std::vector<fs::path> paths;
+    for (int i = 0; i < 3; i++) {
+        cv::Mat img(40, 30, CV_16UC1);
+        ::FillRandom<PixelT>(img);
+        paths.emplace_back(
+            "vc_core_TIFFIO_MergePage" + std::to_string(i) + ".tif");
+        WriteTiledTIFF(paths.back(), img, Compression::DEFLATE, {16, 16});
+        pages.emplace_back(img);
+    }
+
+    const fs::path imgPath("vc_core_TIFFIO_Merged.tif");
+    MergeTiledTIFFs(paths, imgPath);
+
+    std::vector<cv::Mat> result;
+    ASSERT_TRUE(
+        cv::imreadmulti(imgPath.string(), result, cv::IMREAD_UNCHANGED));
+    ASSERT_EQ(result.size(), pages.size());
+    for (std::size_t i = 0; i < pages.size(); i++) {
+        EXPECT_EQ(result[i].size, pages[i].size);
+        EXPECT_EQ(result[i].type(), pages[i].type());
+        EXPECT_TRUE(std::equal(
+            result[i].begin<PixelT>(), result[i].end<PixelT>(),
+            pages[i].begin<PixelT>()));
+    }
+
+    // Strip images can't be merged
+    const fs::path stripPath("vc_core_TIFFIO_MergeStrips.tif");
+    WriteTIFF(stripPath, pages[0]);
+    EXPECT_THROW(MergeTiledTIFFs({stripPath}, imgPath), IOException);
+}
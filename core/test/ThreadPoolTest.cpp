@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "vc/core/util/ThreadPool.hpp"
+
+using namespace volcart;
+
+TEST(ThreadPool, Size)
+{
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.size(), 3);
+
+    // Always at least one worker
+    ThreadPool single(0);
+    EXPECT_EQ(single.size(), 1);
+}
+
+TEST(ThreadPool, Submit)
+{
+    ThreadPool pool(2);
+    auto a = pool.submit([]() { return 1; });
+    auto b = pool.submit([](int x, int y) { return x + y; }, 2, 3);
+    EXPECT_EQ(a.get(), 1);
+    EXPECT_EQ(b.get(), 5);
+}
+
+TEST(ThreadPool, SubmitException)
+{
+    ThreadPool pool(2);
+    auto f = pool.submit([]() { throw std::runtime_error("failed"); });
+    EXPECT_THROW(f.get(), std::runtime_error);
+}
+
+TEST(ThreadPool, DestructorFinishesQueuedTasks)
+{
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 100; i++) {
+            pool.submit([&count]() { count++; });
+        }
+    }
+    EXPECT_EQ(count, 100);
+}
+
+TEST(ThreadPool, ParallelFor)
+{
+    ThreadPool pool(4);
+    for (const std::size_t grain : {1, 7, 1000, 5000}) {
+        std::vector<int> values(1001, 0);
+        pool.parallelFor(
+            0, values.size(), [&values](std::size_t i) { values[i] += 1; },
+            grain);
+        EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 1001);
+    }
+
+    // Offset and empty ranges
+    std::atomic<std::size_t> sum{0};
+    pool.parallelFor(10, 20, [&sum](std::size_t i) { sum += i; });
+    EXPECT_EQ(sum, 145);
+    pool.parallelFor(5, 5, [&sum](std::size_t) { sum = 0; });
+    EXPECT_EQ(sum, 145);
+}
+
+TEST(ThreadPool, ParallelForException)
+{
+    ThreadPool pool(4);
+    EXPECT_THROW(
+        pool.parallelFor(
+            0, 100,
+            [](std::size_t i) {
+                if (i == 50) {
+                    throw std::out_of_range("failed");
+                }
+            }),
+        std::out_of_range);
+}
+
+TEST(ThreadPool, NestedParallelFor)
+{
+    ThreadPool pool(2);
+    std::atomic<int> count{0};
+    pool.parallelFor(0, 8, [&](std::size_t) {
+        pool.parallelFor(0, 8, [&](std::size_t) { count++; });
+    });
+    EXPECT_EQ(count, 64);
+}
+
+TEST(ThreadPool, Shared)
+{
+    auto& pool = ThreadPool::Shared();
+    EXPECT_EQ(&pool, &ThreadPool::Shared());
+    EXPECT_EQ(pool.size(), ThreadPool::DefaultThreadCount());
+
+    // Loops started from tasks on the shared pool use the same workers
+    std::atomic<int> count{0};
+    auto task = pool.submit([&]() {
+        pool.parallelFor(0, 16, [&](std::size_t) { count++; });
+    });
+    pool.parallelFor(0, 16, [&](std::size_t) { count++; });
+    task.get();
+    EXPECT_EQ(count, 32);
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <cstdint>
+
 #include "vc/core/types/Transforms.hpp"
 #include "vc/core/util/Iteration.hpp"
 #include "vc/testing/TestingUtils.hpp"
@@ -244,6 +247,31 @@ TEST(Transforms, AffineInvert)
     SmallOrClose(result, orig);
 }
 
+TEST(Transforms, AffineApplyBatch)
+{
+    auto tfm = AffineTransform::New();
+    tfm->scale(2, 3, 4);
+    tfm->rotate(30, 1, 1, 0);
+    tfm->translate(1, 2, 3);
+
+    std::vector<cv::Vec6d> ptNs{
+        {0, 0, 0, 0, 1, 0}, {1, 2, 3, 0, 0, 10}, {-4, 5, 6, 1, 1, 1}};
+    std::vector<cv::Vec3d> pts;
+    for (const auto& v : ptNs) {
+        pts.emplace_back(v[0], v[1], v[2]);
+    }
+
+    // Batch results should match the single point functions
+    auto batchPts = pts;
+    tfm->applyPoints(batchPts.data(), batchPts.size());
+    auto batchPtNs = ptNs;
+    tfm->applyPointsAndNormals(batchPtNs.data(), batchPtNs.size());
+    for (std::size_t i = 0; i < pts.size(); i++) {
+        SmallOrClose(batchPts[i], tfm->applyPoint(pts[i]));
+        SmallOrClose(batchPtNs[i], tfm->applyPointAndNormal(ptNs[i]));
+    }
+}
+
 /////////////////////////////////////////////
 ///////////// IdentityTransform /////////////
 /////////////////////////////////////////////
@@ -555,6 +583,31 @@ TEST(Transforms, CompositeApply)
     SmallOrClose(result, {-5., 10., 0.});
 }
 
+TEST(Transforms, CompositeApplyBatch)
+{
+    // Set up composite transform
+    auto tfm = CompositeTransform::New();
+    auto affine = AffineTransform::New();
+    affine->scale(5);
+    tfm->push_back(affine);
+    tfm->push_back(IdentityTransform::New());
+    affine->reset();
+    affine->rotate(90, 0, 0, 1);
+    tfm->push_back(affine);
+
+    std::vector<cv::Vec6d> ptNs{{0, 1, 0, 0, 2, 0}, {1, 1, 1, 1, 0, 0}};
+    auto batch = ptNs;
+    tfm->applyPointsAndNormals(batch.data(), batch.size(), false);
+    SmallOrClose(batch[0], {-5., 0., 0., -10., 0., 0.});
+    SmallOrClose(batch[1], {-5., 5., 5., 0., 5., 0.});
+
+    batch = ptNs;
+    tfm->applyPointsAndNormals(batch.data(), batch.size());
+    for (std::size_t i = 0; i < ptNs.size(); i++) {
+        SmallOrClose(batch[i], tfm->applyPointAndNormal(ptNs[i]));
+    }
+}
+
 TEST(Transforms, CompositeExplicitInvert)
 {
     auto tfm = CompositeTransform::New();
@@ -608,4 +661,84 @@ TEST(Transforms, CompositeReset)
 
     tfm->reset();
     EXPECT_EQ(tfm->size(), 0);
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////////
+///////////// ApplyTransform ///////////////
+////////////////////////////////////////////
+
+namespace
+{
+auto TestTransform() -> Transform3D::Pointer
+{
+    auto tfm = CompositeTransform::New();
+    auto affine = AffineTransform::New();
+    affine->rotate(30, 1, 1, 0);
+    affine->scale(2, 3, 4);
+    tfm->push_back(affine);
+    affine = AffineTransform::New();
+    affine->translate(5, -2, 1);
+    tfm->push_back(affine);
+    return tfm;
+}
+}  // namespace
+
+TEST(Transforms, ApplyTransformLargeMesh)
+{
+    // Larger than several transform chunks, with a partial last chunk
+    constexpr std::size_t numPts{3 * (1 << 14) + 7};
+    auto mesh = ITKMesh::New();
+    for (std::size_t i = 0; i < numPts; i++) {
+        auto f = static_cast<double>(i);
+        const cv::Vec3d p{f, 0.5 * f, -f};
+        const cv::Vec3d n{1, f, 2};
+        mesh->SetPoint(i, p.val);
+        mesh->SetPointData(i, n.val);
+    }
+
+    auto tfm = TestTransform();
+    auto out = ApplyTransform(mesh, tfm);
+    ASSERT_EQ(out->GetNumberOfPoints(), numPts);
+    for (std::size_t i = 0; i < numPts; i++) {
+        auto p = mesh->GetPoint(i);
+        ITKPixel n;
+        mesh->GetPointData(i, &n);
+        auto expected = tfm->applyPointAndNormal(
+            {p[0], p[1], p[2], n[0], n[1], n[2]});
+
+        auto outP = out->GetPoint(i);
+        ITKPixel outN;
+        out->GetPointData(i, &outN);
+        SmallOrClose(
+            cv::Vec6d{outP[0], outP[1], outP[2], outN[0], outN[1], outN[2]},
+            expected);
+    }
+}
+
+TEST(Transforms, ApplyTransformMaskedPPM)
+{
+    // Several rows per chunk, and runs which touch both edges of a row
+    constexpr std::size_t height{150};
+    constexpr std::size_t width{200};
+    PerPixelMap ppm(height, width);
+    cv::Mat mask(height, width, CV_8UC1);
+    cv::RNG rng(1234);
+    for (const auto [y, x] : range2D(height, width)) {
+        auto f = static_cast<double>(y * width + x);
+        ppm(y, x) = {f, -f, 0.25 * f, 0, 1, static_cast<double>(x)};
+        auto mapped = x == 0 or x == width - 1 or rng.uniform(0, 3) != 0;
+        mask.at<std::uint8_t>(y, x) = mapped ? 255 : 0;
+    }
+    ppm.setMask(mask);
+
+    auto tfm = TestTransform();
+    auto out = ApplyTransform(ppm, tfm);
+    for (const auto [y, x] : range2D(height, width)) {
+        if (mask.at<std::uint8_t>(y, x) == 255) {
+            SmallOrClose(out(y, x), tfm->applyPointAndNormal(ppm(y, x)));
+        } else {
+            // Unmapped pixels are not transformed
+            EXPECT_EQ(out(y, x), ppm(y, x));
+        }
+    }
+}
@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/types/Volume.hpp"
+#include "vc/core/util/Iteration.hpp"
+#include "vc/testing/TestingUtils.hpp"
+
+namespace vctest = volcart::testing;
+using namespace volcart;
+
+class VolumeTest : public ::testing::Test
+{
+public:
+    static constexpr int DIM{16};
+
+    void SetUp() override
+    {
+        vol = vctest::MakeSyntheticVolume(
+            "VolumeTest.volume", DIM,
+            [](int x, int y, int z) { return 1000 * z + DIM * y + x; });
+    }
+
+    Volume::Pointer vol;
+};
+
+TEST_F(VolumeTest, IntensityAt)
+{
+    EXPECT_EQ(vol->intensityAt(3, 2, 5), 5000 + 2 * DIM + 3);
+    EXPECT_EQ(vol->intensityAt(-1, 2, 5), 0);
+    EXPECT_EQ(vol->intensityAt(3, 2, DIM), 0);
+}
+
+TEST_F(VolumeTest, SliceRegion)
+{
+    // Uncached reads decode only the region and don't fill the cache
+    const cv::Rect roi(3, 5, 4, 6);
+    auto region = vol->getSliceRegion(7, roi);
+    EXPECT_EQ(region.size(), roi.size());
+    EXPECT_EQ(vol->getCacheSize(), 0);
+    for (const auto [y, x] : range2D(roi.height, roi.width)) {
+        EXPECT_EQ(
+            region.at<std::uint16_t>(y, x),
+            7000 + DIM * (y + roi.y) + (x + roi.x));
+    }
+
+    // Cached reads match
+    vol->getSliceData(7);
+    auto cached = vol->getSliceRegion(7, roi);
+    EXPECT_EQ(cv::countNonZero(cached != region), 0);
+
+    // Regions are clipped to the slice
+    region = vol->getSliceRegion(2, {DIM - 2, -3, 5, 5});
+    EXPECT_EQ(region.size(), cv::Size(2, 2));
+    EXPECT_EQ(region.at<std::uint16_t>(1, 1), 2000 + DIM + DIM - 1);
+
+    // Large regions are read through the cache
+    vol->cachePurge();
+    region = vol->getSliceRegion(4, {1, 1, DIM - 2, DIM - 2});
+    EXPECT_EQ(vol->getCacheSize(), 1);
+    EXPECT_EQ(region.at<std::uint16_t>(0, 0), 4000 + DIM + 1);
+}
+
+TEST_F(VolumeTest, VoxelBlock)
+{
+    // Block which extends past the edges of the Volume
+    const cv::Vec3i origin{-2, 10, DIM - 3};
+    const cv::Vec3i size{5, 8, 4};
+    std::vector<std::uint16_t> block(size[0] * size[1] * size[2]);
+    vol->getVoxelBlock(origin, size, block.data());
+    std::size_t idx{0};
+    for (int z = 0; z < size[2]; z++) {
+        for (int y = 0; y < size[1]; y++) {
+            for (int x = 0; x < size[0]; x++) {
+                auto expected = vol->intensityAt(
+                    origin[0] + x, origin[1] + y, origin[2] + z);
+                EXPECT_EQ(block[idx++], expected);
+            }
+        }
+    }
+}
+
+TEST_F(VolumeTest, InterpolateBlock)
+{
+    for (const cv::Vec3d origin :
+         {cv::Vec3d{3.25, 4.5, 2.75}, cv::Vec3d{-1.5, DIM - 3.5, 7},
+          cv::Vec3d{5, 6, 7}}) {
+        const cv::Vec3i size{4, 5, 6};
+        std::vector<double> block(size[0] * size[1] * size[2]);
+        vol->interpolateBlock(origin, size, block.data());
+        std::size_t idx{0};
+        for (int z = 0; z < size[2]; z++) {
+            for (int y = 0; y < size[1]; y++) {
+                for (int x = 0; x < size[0]; x++) {
+                    auto p = origin + cv::Vec3d(x, y, z);
+                    auto expected = vol->interpolateAt(p);
+                    EXPECT_NEAR(block[idx++], expected, 0.5);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(VolumeTest, ExplicitPrefetch)
+{
+    vol->prefetch(2, 7);
+    vol->waitForPrefetch();
+    EXPECT_EQ(vol->getCacheSize(), 5);
+
+    // Out of range and repeated requests are ignored
+    vol->prefetch(-5, 3);
+    vol->prefetch(DIM - 1, DIM + 5);
+    vol->waitForPrefetch();
+    EXPECT_EQ(vol->getCacheSize(), 8);
+
+    // Prefetched slices hold the correct data
+    for (int z = 2; z < 7; z++) {
+        EXPECT_EQ(vol->intensityAt(1, 1, z), 1000 * z + DIM + 1);
+    }
+}
+
+TEST_F(VolumeTest, SequentialPrefetch)
+{
+    vol->setPrefetchDepth(4);
+    vol->getSliceData(0);
+    vol->getSliceData(1);
+    vol->waitForPrefetch();
+    EXPECT_EQ(vol->getCacheSize(), 2);
+
+    // Stepping back between neighboring slices doesn't reverse the stream
+    vol->getSliceData(0);
+    vol->getSliceData(2);
+    vol->waitForPrefetch();
+    EXPECT_EQ(vol->getCacheSize(), 7);
+
+    // Backward streams read ahead in the other direction
+    vol->cachePurge();
+    vol->getSliceData(12);
+    vol->getSliceData(11);
+    vol->getSliceData(10);
+    vol->waitForPrefetch();
+    EXPECT_EQ(vol->getCacheSize(), 7);
+}
+
+TEST_F(VolumeTest, PrefetchDisabled)
+{
+    for (int z = 0; z < 5; z++) {
+        vol->getSliceData(z);
+    }
+    vol->waitForPrefetch();
+    EXPECT_EQ(vol->getCacheSize(), 5);
+}
+
+TEST_F(VolumeTest, ConcurrentAccessWithPrefetch)
+{
+    vol->setPrefetchDepth(3);
+    vol->setPrefetchThreads(3);
+
+    std::vector<std::thread> threads;
+    std::vector<int> errors(4, 0);
+    for (std::size_t t = 0; t < errors.size(); t++) {
+        threads.emplace_back([this, t, &errors]() {
+            for (int z = 0; z < DIM; z++) {
+                auto expected = 1000 * z + DIM * 4 + 7;
+                if (vol->intensityAt(7, 4, z) != expected) {
+                    errors[t]++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    vol->waitForPrefetch();
+
+    for (const auto& e : errors) {
+        EXPECT_EQ(e, 0);
+    }
+    EXPECT_EQ(vol->getCacheSize(), DIM);
+}
+
+TEST_F(VolumeTest, ResolutionLevels)
+{
+    EXPECT_EQ(vol->numLevels(), 1);
+    EXPECT_EQ(vol->level(0), vol);
+    EXPECT_THROW(vol->level(1), std::out_of_range);
+
+    vol->generateLevels(2);
+    EXPECT_EQ(vol->numLevels(), 3);
+
+    // Level dimensions
+    auto level1 = vol->level(1);
+    EXPECT_EQ(level1->sliceWidth(), DIM / 2);
+    EXPECT_EQ(level1->sliceHeight(), DIM / 2);
+    EXPECT_EQ(level1->numSlices(), DIM / 2);
+    auto level2 = vol->level(2);
+    EXPECT_EQ(level2->sliceWidth(), DIM / 4);
+    EXPECT_EQ(level2->numSlices(), DIM / 4);
+
+    // Level voxels are the mean of the full-resolution blocks they cover
+    auto mean = [](int x, int y, int z, int scale) {
+        auto c = (scale - 1) / 2.0;
+        return 1000 * (z * scale + c) + DIM * (y * scale + c) + x * scale + c;
+    };
+    auto v1 = vol->getSliceData(1, 1).at<std::uint16_t>(2, 3);
+    EXPECT_NEAR(v1, mean(3, 2, 1, 2), 1);
+    auto v2 = vol->getSliceData(2, 2).at<std::uint16_t>(1, 0);
+    EXPECT_NEAR(v2, mean(0, 1, 2, 4), 1);
+
+    // Sampling a level at full-resolution coordinates
+    EXPECT_NEAR(vol->interpolateAt({6.5, 4.5, 2.5}, 1), mean(3, 2, 1, 2), 1);
+    EXPECT_EQ(vol->interpolateAt({-1, 4.5, 2.5}, 1), 0);
+
+    // Reslices map back to full-resolution coordinates
+    auto reslice = vol->reslice({8, 8, 8}, {1, 0, 0}, {0, 1, 0}, 4, 4, 1);
+    EXPECT_EQ(reslice.sliceData().cols, 4);
+    auto a = reslice.sliceToVoxelCoord(cv::Point{0, 0});
+    auto b = reslice.sliceToVoxelCoord(cv::Point{1, 0});
+    EXPECT_EQ(a, cv::Vec3d(4, 4, 8));
+    EXPECT_EQ(b - a, cv::Vec3d(2, 0, 0));
+    auto pixel = reslice.sliceData().at<std::uint16_t>(1, 2);
+    auto voxel = reslice.sliceToVoxelCoord(cv::Point{2, 1});
+    EXPECT_EQ(pixel, vol->interpolateAt(voxel, 1));
+
+    // Levels are found when the Volume is reloaded
+    auto reloaded = Volume::New(vol->path());
+    EXPECT_EQ(reloaded->numLevels(), 3);
+}
@@ -6,6 +6,7 @@
 
 #include "vc/graph/core.hpp"
 #include "vc/graph/meshing.hpp"
+#include "vc/graph/scheduler.hpp"
 #include "vc/graph/texturing.hpp"
 
 namespace volcart
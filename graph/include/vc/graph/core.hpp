@@ -618,6 +618,8 @@ private:
 /**
  * @copybrief PerPixelMap::ReadPPM()
  *
+ * Files with the .vcppm extension are read with io::ReadPPMCache().
+ *
  * @see PerPixelMap::ReadPPM()
  * @ingroup Graph
  */
@@ -656,6 +658,8 @@ private:
 /**
  * @copybrief PerPixelMap::WritePPM()
  *
+ * Files with the .vcppm extension are written with io::WritePPMCache().
+ *
  * @see PerPixelMap::WritePPM()
  * @ingroup Graph
  */
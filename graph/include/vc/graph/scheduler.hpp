@@ -0,0 +1,80 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <smgl/Graph.hpp>
+
+namespace volcart
+{
+
+/**
+ * @brief Timing and memory usage of a single node update
+ *
+ * @ingroup Graph
+ */
+struct NodeProfile {
+    /** UUID of the node in the graph */
+    std::string uuid;
+    /** Position of the node in the graph's topological order */
+    std::size_t order{0};
+    /** Wall time of the node update in seconds */
+    double wallTime{0};
+    /** Process peak resident memory after the node update in bytes */
+    std::size_t peakMemory{0};
+    /**
+     * Increase in process peak resident memory during the node update in
+     * bytes. When nodes run concurrently, the increase may be caused by
+     * another node.
+     */
+    std::size_t peakMemoryIncrease{0};
+};
+
+/**
+ * @brief Result of UpdateGraphConcurrent()
+ *
+ * @ingroup Graph
+ */
+struct GraphUpdateResult {
+    /** Graph state after the update: Idle on success, Error otherwise */
+    smgl::Graph::State state{smgl::Graph::State::Idle};
+    /** Profile of every updated node in completion order */
+    std::vector<NodeProfile> nodes;
+    /** Wall time of the whole update in seconds */
+    double wallTime{0};
+};
+
+/**
+ * @brief Update a graph, running independent nodes concurrently
+ *
+ * Alternative to smgl::Graph::update(). A node is started on a thread pool as
+ * soon as every node connected to its inputs has finished updating, so
+ * independent branches of the graph (e.g. writing a mesh and texturing it)
+ * run at the same time. Ready nodes are started in the order they become
+ * ready. Setting `numThreads` to 1 updates the nodes one at a time in that
+ * order, which is a valid topological order but not necessarily the order
+ * used by smgl::Graph::update().
+ *
+ * Nodes parallelize their own work with ThreadPool::Shared(), so nodes
+ * which run at the same time share one set of workers with
+ * ThreadPool::DefaultThreadCount() threads. The node threads themselves are
+ * additional, so up to `numThreads` extra threads may be busy. Code which
+ * constructs its own full-size ThreadPool inside a node oversubscribes the
+ * CPU when several such nodes run at once.
+ *
+ * If a node fails, no further nodes are started and the nodes which are
+ * already running are allowed to finish. The graph's own cache file is not
+ * written by this function and should be saved by the caller.
+ *
+ * @param graph Graph to update
+ * @param numThreads Maximum number of nodes updated at once. If 0, uses
+ * ThreadPool::DefaultThreadCount().
+ * @throws The first exception thrown by a node update
+ */
+auto UpdateGraphConcurrent(smgl::Graph& graph, std::size_t numThreads = 0)
+    -> GraphUpdateResult;
+
+}  // namespace volcart
@@ -522,6 +522,8 @@ public:
     smgl::InputPort<Volume::Pointer> volume;
     /** @brief VolumetricMask for a single layer */
     smgl::InputPort<VolumetricMask::Pointer> volumetricMask;
+    /** @copybrief texturing::ThicknessTexture::setMaskVolume() */
+    smgl::InputPort<Volume::Pointer> maskVolume;
     /** @copybrief texturing::ThicknessTexture::setSamplingInterval() */
     smgl::InputPort<double> samplingInterval;
     /** @copybrief texturing::ThicknessTexture::setNormalizeOutput() */
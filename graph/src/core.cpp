@@ -2,8 +2,9 @@
 
 #include <nlohmann/json.hpp>
 
+#include "vc/core/io/CacheIO.hpp"
+#include "vc/core/io/FileExtensionFilter.hpp"
 #include "vc/core/io/PointSetIO.hpp"
-#include "vc/core/io/UVMapIO.hpp"
 #include "vc/core/util/FloatComparison.hpp"
 #include "vc/core/util/Logging.hpp"
 
@@ -201,7 +202,7 @@ auto LoadMeshNode::serialize_(bool useCache, const fs::path& cacheDir)
 {
     smgl::Metadata meta{{"path", path_.string()}, {"cacheArgs", cacheArgs_}};
     if (useCache and cacheArgs_ and loaded_.mesh) {
-        auto file = path_.filename().replace_extension(".obj");
+        auto file = path_.filename().replace_extension(".vcmesh");
         WriteMesh(cacheDir / file, loaded_.mesh, loaded_.uv, loaded_.texture);
         meta["cachedFile"] = file.string();
     }
@@ -241,7 +242,7 @@ auto WriteMeshNode::serialize_(bool useCache, const fs::path& cacheDir)
     smgl::Metadata meta{{"path", path_.string()}, {"cacheArgs", cacheArgs_}};
 
     if (useCache and cacheArgs_) {
-        auto file = path_.filename().replace_extension(".obj");
+        auto file = path_.filename().replace_extension(".vcmesh");
         WriteMesh(cacheDir / file, mesh_, uv_, texture_);
         meta["cachedFile"] = file.string();
     }
@@ -281,8 +282,8 @@ auto RotateUVMapNode::serialize_(bool useCache, const fs::path& cacheDir)
     smgl::Metadata meta;
     meta["theta"] = theta_;
     if (useCache and uvMapOut_ and not uvMapOut_->empty()) {
-        io::WriteUVMap(cacheDir / "uvMap_rot.uvm", *uvMapOut_);
-        meta["uvMap"] = "uvMap_rot.uvm";
+        io::WriteUVMapCache(cacheDir / "uvMap_rot.vcuv", *uvMapOut_);
+        meta["uvMap"] = "uvMap_rot.vcuv";
     }
     return meta;
 }
@@ -293,7 +294,7 @@ void RotateUVMapNode::deserialize_(
     theta_ = meta["theta"].get<double>();
     if (meta.contains("uvMap")) {
         auto uvMapFile = meta["uvMap"].get<std::string>();
-        uvMapOut_ = UVMap::New(io::ReadUVMap(cacheDir / uvMapFile));
+        uvMapOut_ = UVMap::New(io::ReadUVMapCache(cacheDir / uvMapFile));
     }
 }
 
@@ -317,8 +318,8 @@ auto FlipUVMapNode::serialize_(bool useCache, const fs::path& cacheDir)
     smgl::Metadata meta;
     meta["flipAxis"] = axis_;
     if (useCache and uvMapOut_ and not uvMapOut_->empty()) {
-        io::WriteUVMap(cacheDir / "uvMap_flip.uvm", *uvMapOut_);
-        meta["uvMap"] = "uvMap_flip.uvm";
+        io::WriteUVMapCache(cacheDir / "uvMap_flip.vcuv", *uvMapOut_);
+        meta["uvMap"] = "uvMap_flip.vcuv";
     }
     return meta;
 }
@@ -329,7 +330,7 @@ void FlipUVMapNode::deserialize_(
     axis_ = meta["flipAxis"].get<FlipAxis>();
     if (meta.contains("uvMap")) {
         auto uvMapFile = meta["uvMap"].get<std::string>();
-        uvMapOut_ = UVMap::New(io::ReadUVMap(cacheDir / uvMapFile));
+        uvMapOut_ = UVMap::New(io::ReadUVMapCache(cacheDir / uvMapFile));
     }
 }
 
@@ -356,8 +357,8 @@ auto AlignUVMapToAxisNode::serialize_(bool useCache, const fs::path& cacheDir)
 {
     smgl::Metadata meta{{"axis", axis_}};
     if (useCache and uvMapOut_ and not uvMapOut_->empty()) {
-        io::WriteUVMap(cacheDir / "uvMap_align.uvm", *uvMapOut_);
-        meta["uvMap"] = "uvMap_align.uvm";
+        io::WriteUVMapCache(cacheDir / "uvMap_align.vcuv", *uvMapOut_);
+        meta["uvMap"] = "uvMap_align.vcuv";
     }
     return meta;
 }
@@ -368,7 +369,7 @@ void AlignUVMapToAxisNode::deserialize_(
     axis_ = meta["axis"].get<UVMap::AlignmentAxis>();
     if (meta.contains("uvMap")) {
         auto uvMapFile = meta["uvMap"].get<std::string>();
-        uvMapOut_ = UVMap::New(io::ReadUVMap(cacheDir / uvMapFile));
+        uvMapOut_ = UVMap::New(io::ReadUVMapCache(cacheDir / uvMapFile));
     }
 }
 
@@ -526,7 +527,11 @@ LoadPPMNode::LoadPPMNode()
     registerOutputPort("ppm", ppm);
     compute = [&]() {
         Logger()->debug("[graph.core] loading PPM: {}", path_.string());
-        ppm_ = PerPixelMap::New(PerPixelMap::ReadPPM(path_));
+        if (IsFileType(path_, {"vcppm"})) {
+            ppm_ = PerPixelMap::New(io::ReadPPMCache(path_));
+        } else {
+            ppm_ = PerPixelMap::New(PerPixelMap::ReadPPM(path_));
+        }
     };
     usesCacheDir = [&]() { return cacheArgs_; };
 }
@@ -536,8 +541,8 @@ auto LoadPPMNode::serialize_(bool useCache, const fs::path& cacheDir)
 {
     smgl::Metadata meta{{"path", path_.string()}, {"cacheArgs", cacheArgs_}};
     if (useCache and cacheArgs_) {
-        auto file = path_.filename().replace_extension(".ppm");
-        PerPixelMap::WritePPM(cacheDir / file, *ppm_);
+        auto file = path_.filename().replace_extension(".vcppm");
+        io::WritePPMCache(cacheDir / file, *ppm_);
         meta["cachedFile"] = file.string();
     }
     return meta;
@@ -558,7 +563,11 @@ WritePPMNode::WritePPMNode()
     registerInputPort("cacheArgs", cacheArgs);
     compute = [&]() {
         Logger()->debug("[graph.core] writing PPM: {}", path_.string());
-        PerPixelMap::WritePPM(path_, *ppm_);
+        if (IsFileType(path_, {"vcppm"})) {
+            io::WritePPMCache(path_, *ppm_);
+        } else {
+            PerPixelMap::WritePPM(path_, *ppm_);
+        }
     };
     usesCacheDir = [&]() { return cacheArgs_; };
 }
@@ -568,8 +577,8 @@ auto WritePPMNode::serialize_(bool useCache, const fs::path& cacheDir)
 {
     smgl::Metadata meta{{"path", path_.string()}, {"cacheArgs", cacheArgs_}};
     if (useCache and cacheArgs_) {
-        auto file = path_.filename().replace_extension(".ppm");
-        PerPixelMap::WritePPM(cacheDir / file, *ppm_);
+        auto file = path_.filename().replace_extension(".vcppm");
+        io::WritePPMCache(cacheDir / file, *ppm_);
         meta["cachedFile"] = file.string();
     }
 
@@ -743,8 +752,8 @@ auto TransformMeshNode::serialize_(
 {
     auto meta = BaseT::serialize_(useCache, cacheDir);
     if (useCache and output_) {
-        WriteMesh(cacheDir / "transformed.obj", output_);
-        meta["mesh"] = "transformed.obj";
+        WriteMesh(cacheDir / "transformed.vcmesh", output_);
+        meta["mesh"] = "transformed.vcmesh";
     }
     return meta;
 }
@@ -764,8 +773,8 @@ auto TransformPPMNode::serialize_(
 {
     auto meta = BaseT::serialize_(useCache, cacheDir);
     if (useCache and output_) {
-        PerPixelMap::WritePPM(cacheDir / "transformed.ppm", *output_);
-        meta["ppm"] = "transformed.ppm";
+        io::WritePPMCache(cacheDir / "transformed.vcppm", *output_);
+        meta["ppm"] = "transformed.vcppm";
     }
     return meta;
 }
@@ -776,6 +785,6 @@ void TransformPPMNode::deserialize_(
     BaseT::deserialize_(meta, cacheDir);
     if (meta.contains("ppm")) {
         auto ppmFile = meta["ppm"].get<std::string>();
-        output_ = PerPixelMap::New(PerPixelMap::ReadPPM(cacheDir / ppmFile));
+        output_ = PerPixelMap::New(io::ReadPPMCache(cacheDir / ppmFile));
     }
 }
@@ -46,8 +46,8 @@ auto MeshingNode::serialize_(bool useCache, const fs::path& cacheDir)
 {
     smgl::Metadata meta;
     if (useCache and mesh_) {
-        WriteMesh(cacheDir / "mesh.obj", mesh_);
-        meta["mesh"] = "mesh.obj";
+        WriteMesh(cacheDir / "mesh.vcmesh", mesh_);
+        meta["mesh"] = "mesh.vcmesh";
     }
     return meta;
 }
@@ -82,8 +82,8 @@ auto ScaleMeshNode::serialize_(bool useCache, const fs::path& cacheDir)
 {
     smgl::Metadata meta{{"scaleFactor", scaleFactor_}};
     if (useCache and output_) {
-        WriteMesh(cacheDir / "scaled.obj", output_);
-        meta["output"] = "scaled.obj";
+        WriteMesh(cacheDir / "scaled.vcmesh", output_);
+        meta["output"] = "scaled.vcmesh";
     }
     return meta;
 }
@@ -159,8 +159,8 @@ auto LaplacianSmoothMeshNode::serialize_(
         {"edgeAngle", smoother_.edgeAngle()},
         {"boundarySmoothing", smoother_.boundarySmoothing()}};
     if (useCache and mesh_) {
-        WriteMesh(cacheDir / "smoothed.obj", mesh_);
-        meta["mesh"] = "smoothed.obj";
+        WriteMesh(cacheDir / "smoothed.vcmesh", mesh_);
+        meta["mesh"] = "smoothed.vcmesh";
     }
     return meta;
 }
@@ -216,8 +216,8 @@ auto ResampleMeshNode::serialize_(bool useCache, const fs::path& cacheDir)
         {"subsampleThreshold", acvd_.subsampleThreshold()},
         {"quadricsOptimizationLevel", acvd_.quadricsOptimizationLevel()}};
     if (useCache and mesh_) {
-        WriteMesh(cacheDir / "resampled.obj", mesh_);
-        meta["mesh"] = "resampled.obj";
+        WriteMesh(cacheDir / "resampled.vcmesh", mesh_);
+        meta["mesh"] = "resampled.vcmesh";
     }
     return meta;
 }
@@ -262,8 +262,8 @@ auto UVMapToMeshNode::serialize_(bool useCache, const fs::path& cacheDir)
 {
     smgl::Metadata meta{{"scaleToUVDims", scaleDims_}};
     if (useCache and output_) {
-        WriteMesh(cacheDir / "uvMesh.obj", output_);
-        meta["mesh"] = "uvMesh.obj";
+        WriteMesh(cacheDir / "uvMesh.vcmesh", output_);
+        meta["mesh"] = "uvMesh.vcmesh";
     }
     return meta;
 }
@@ -303,8 +303,8 @@ auto OrientNormalsNode::serialize_(bool useCache, const fs::path& cacheDir)
         meta["referencePoint"] = orientNormals_.referencePoint();
     }
     if (useCache and output_) {
-        WriteMesh(cacheDir / "orient_normals.obj", output_);
-        meta["mesh"] = "orient_normals.obj";
+        WriteMesh(cacheDir / "orient_normals.vcmesh", output_);
+        meta["mesh"] = "orient_normals.vcmesh";
     }
     return meta;
 }
@@ -0,0 +1,122 @@
+#include "vc/graph/scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include <smgl/Node.hpp>
+
+#include "vc/core/util/Logging.hpp"
+#include "vc/core/util/MemoryUsage.hpp"
+#include "vc/core/util/ThreadPool.hpp"
+
+using namespace volcart;
+
+using Clock = std::chrono::steady_clock;
+using Seconds = std::chrono::duration<double>;
+
+auto volcart::UpdateGraphConcurrent(smgl::Graph& graph, std::size_t numThreads)
+    -> GraphUpdateResult
+{
+    const auto start = Clock::now();
+    const auto nodes = smgl::Graph::Schedule(graph);
+
+    // Count the upstream nodes of every node and record its downstream nodes
+    std::unordered_map<smgl::Node*, std::size_t> index;
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        index[nodes[i].get()] = i;
+    }
+    std::vector<std::size_t> waitingOn(nodes.size(), 0);
+    std::vector<std::vector<std::size_t>> downstream(nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        std::vector<smgl::Node*> sources;
+        for (const auto& c : nodes[i]->getInputConnections()) {
+            auto src = index.find(c.srcNode);
+            if (src == index.end() or
+                std::find(sources.begin(), sources.end(), c.srcNode) !=
+                    sources.end()) {
+                continue;
+            }
+            sources.push_back(c.srcNode);
+            downstream[src->second].push_back(i);
+            waitingOn[i]++;
+        }
+    }
+
+    GraphUpdateResult result;
+    if (numThreads == 0) {
+        numThreads = ThreadPool::DefaultThreadCount();
+    }
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t running{0};
+    bool failed{false};
+    std::exception_ptr error;
+    ThreadPool pool(numThreads);
+
+    // Update a node, then start the downstream nodes which are now ready.
+    // Must be started while holding the lock.
+    std::function<void(std::size_t)> updateNode = [&](std::size_t i) {
+        NodeProfile profile;
+        profile.uuid = nodes[i]->uuid().string();
+        profile.order = i;
+        const auto peakBefore = PeakResidentMemory();
+        const auto nodeStart = Clock::now();
+        bool nodeFailed{false};
+        std::exception_ptr nodeError;
+        try {
+            nodes[i]->update();
+            nodeFailed = nodes[i]->state() == smgl::Node::State::Error;
+        } catch (...) {
+            nodeFailed = true;
+            nodeError = std::current_exception();
+        }
+        profile.wallTime = Seconds(Clock::now() - nodeStart).count();
+        profile.peakMemory = PeakResidentMemory();
+        profile.peakMemoryIncrease = profile.peakMemory - peakBefore;
+        Logger()->debug(
+            "Updated node {} in {:.3f} s", profile.uuid, profile.wallTime);
+
+        const std::lock_guard<std::mutex> lock(mutex);
+        result.nodes.push_back(profile);
+        if (nodeFailed and not failed) {
+            failed = true;
+            error = nodeError;
+        }
+        if (not failed) {
+            for (const auto& d : downstream[i]) {
+                if (--waitingOn[d] == 0) {
+                    running++;
+                    pool.submit(updateNode, d);
+                }
+            }
+        }
+        running--;
+        cv.notify_all();
+    };
+
+    // Start the nodes which have no upstream nodes
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            if (waitingOn[i] == 0) {
+                running++;
+                pool.submit(updateNode, i);
+            }
+        }
+        cv.wait(lock, [&running]() { return running == 0; });
+    }
+
+    result.wallTime = Seconds(Clock::now() - start).count();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (failed or result.nodes.size() != nodes.size()) {
+        result.state = smgl::Graph::State::Error;
+    }
+    return result;
+}
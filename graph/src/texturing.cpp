@@ -7,8 +7,8 @@
 
 #include "vc/core/io/ImageIO.hpp"
 #include "vc/core/io/MeshIO.hpp"
+#include "vc/core/io/CacheIO.hpp"
 #include "vc/core/io/PointSetIO.hpp"
-#include "vc/core/io/UVMapIO.hpp"
 #include "vc/core/neighborhood/CuboidGenerator.hpp"
 #include "vc/core/neighborhood/LineGenerator.hpp"
 #include "vc/core/types/PointSet.hpp"
@@ -104,10 +104,10 @@ auto ABFNode::serialize_(bool useCache, const fs::path& cacheDir)
         {"abfMaxIterations", abf_.abfMaxIterations()}};
 
     if (useCache and uvMap_ and not uvMap_->empty()) {
-        io::WriteUVMap(cacheDir / "uvMap.uvm", *uvMap_);
-        meta["uvMap"] = "uvMap.uvm";
-        WriteMesh(cacheDir / "uvMesh.obj", mesh_);
-        meta["mesh"] = "uvMesh.obj";
+        io::WriteUVMapCache(cacheDir / "uvMap.vcuv", *uvMap_);
+        meta["uvMap"] = "uvMap.vcuv";
+        WriteMesh(cacheDir / "uvMesh.vcmesh", mesh_);
+        meta["mesh"] = "uvMesh.vcmesh";
     }
     return meta;
 }
@@ -119,7 +119,7 @@ void ABFNode::deserialize_(const smgl::Metadata& meta, const fs::path& cacheDir)
 
     if (meta.contains("uvMap")) {
         auto file = meta["uvMap"].get<std::string>();
-        uvMap_ = UVMap::New(io::ReadUVMap(cacheDir / file));
+        uvMap_ = UVMap::New(io::ReadUVMapCache(cacheDir / file));
     }
 
     if (meta.contains("uvMesh")) {
@@ -151,10 +151,10 @@ auto OrthographicFlatteningNode::serialize_(
 {
     smgl::Metadata meta;
     if (useCache and uvMap_ and not uvMap_->empty()) {
-        io::WriteUVMap(cacheDir / "uvMap.uvm", *uvMap_);
-        meta["uvMap"] = "uvMap.uvm";
-        WriteMesh(cacheDir / "uvMesh.obj", mesh_);
-        meta["mesh"] = "uvMesh.obj";
+        io::WriteUVMapCache(cacheDir / "uvMap.vcuv", *uvMap_);
+        meta["uvMap"] = "uvMap.vcuv";
+        WriteMesh(cacheDir / "uvMesh.vcmesh", mesh_);
+        meta["mesh"] = "uvMesh.vcmesh";
     }
     return meta;
 }
@@ -164,7 +164,7 @@ void OrthographicFlatteningNode::deserialize_(
 {
     if (meta.contains("uvMap")) {
         auto file = meta["uvMap"].get<std::string>();
-        uvMap_ = UVMap::New(io::ReadUVMap(cacheDir / file));
+        uvMap_ = UVMap::New(io::ReadUVMapCache(cacheDir / file));
     }
 
     if (meta.contains("uvMesh")) {
@@ -301,8 +301,8 @@ auto PPMGeneratorNode::serialize_(bool useCache, const fs::path& cacheDir)
 {
     smgl::Metadata meta{{"shading", shading_}};
     if (useCache and ppm_ and ppm_->initialized()) {
-        PerPixelMap::WritePPM(cacheDir / "PerPixelMap.ppm", *ppm_);
-        meta["ppm"] = "PerPixelMap.ppm";
+        io::WritePPMCache(cacheDir / "PerPixelMap.vcppm", *ppm_);
+        meta["ppm"] = "PerPixelMap.vcppm";
     }
     return meta;
 }
@@ -313,7 +313,7 @@ void PPMGeneratorNode::deserialize_(
     shading_ = meta["shading"].get<Shading>();
     if (meta.contains("ppm")) {
         auto ppmFile = meta["ppm"].get<std::string>();
-        ppm_ = PerPixelMap::New(PerPixelMap::ReadPPM(cacheDir / ppmFile));
+        ppm_ = PerPixelMap::New(io::ReadPPMCache(cacheDir / ppmFile));
     }
 }
 
@@ -561,6 +561,7 @@ ThicknessTextureNode::ThicknessTextureNode()
     , ppm{&textureGen_, &TAlgo::setPerPixelMap}
     , volume{&textureGen_, &TAlgo::setVolume}
     , volumetricMask{&textureGen_, &TAlgo::setVolumetricMask}
+    , maskVolume{&textureGen_, &TAlgo::setMaskVolume}
     , samplingInterval{&textureGen_, &TAlgo::setSamplingInterval}
     , normalizeOutput{&textureGen_, &TAlgo::setNormalizeOutput}
     , texture{&texture_}
@@ -568,6 +569,7 @@ ThicknessTextureNode::ThicknessTextureNode()
     registerInputPort("ppm", ppm);
     registerInputPort("volume", volume);
     registerInputPort("volumetricMask", volumetricMask);
+    registerInputPort("maskVolume", maskVolume);
     registerInputPort("samplingInterval", samplingInterval);
     registerInputPort("normalizeOutput", normalizeOutput);
     registerOutputPort("texture", texture);
@@ -0,0 +1,132 @@
+#pragma once
+
+/** @file */
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/types/ITKMesh.hpp"
+
+namespace volcart::meshing
+{
+/**
+ * @class MeshSlicer
+ * @brief Intersect triangle meshes with planes of constant z
+ *
+ * The triangles of the input meshes are sorted by their minimum z value once,
+ * when the meshes are added. A single slice only tests the triangles whose
+ * z-extent can reach the slice plane. A range of slices is computed by
+ * sweeping through the sorted triangles with a set of active triangles, and
+ * blocks of slices are computed in parallel.
+ *
+ * Each slice is returned as a list of polylines built from the triangle-plane
+ * intersections. Intersection points on edges shared by adjacent triangles
+ * are joined, so the polylines follow the connectivity of the mesh. Closed
+ * polylines repeat their first point at the end. If every input mesh has
+ * vertex normals, each polyline point also has a normal interpolated from the
+ * edge's vertex normals.
+ *
+ * Triangles which lie entirely in the slice plane are not intersected. A
+ * vertex which lies on the slice plane is a single polyline point shared by
+ * all of its edges.
+ *
+ * @code{.cpp}
+ * MeshSlicer slicer(mesh);
+ * for (const auto& line : slicer.slice(10)) {
+ *     // line.points holds the intersection points
+ * }
+ * @endcode
+ *
+ * @ingroup Meshing
+ */
+class MeshSlicer
+{
+public:
+    /** @brief Connected intersection points */
+    struct Polyline {
+        /** Intersection points */
+        std::vector<cv::Vec3d> points;
+        /** Per-point normals. Empty if the meshes do not have normals. */
+        std::vector<cv::Vec3d> normals;
+    };
+
+    /** Intersection of the meshes with a single plane */
+    using Slice = std::vector<Polyline>;
+
+    /** @brief Default constructor */
+    MeshSlicer() = default;
+
+    /** @brief Construct and add a mesh */
+    explicit MeshSlicer(const ITKMesh::Pointer& mesh);
+
+    /** @brief Remove all meshes and set a new input mesh */
+    void setMesh(const ITKMesh::Pointer& mesh);
+
+    /**
+     * @brief Add a mesh to the set of intersected meshes
+     *
+     * Vertices are not merged across meshes.
+     */
+    void addMesh(const ITKMesh::Pointer& mesh);
+
+    /** @brief Remove all meshes */
+    void clear();
+
+    /** @brief Whether every input mesh has vertex normals */
+    [[nodiscard]] auto hasNormals() const -> bool;
+
+    /** @brief Minimum z value of the input mesh triangles */
+    [[nodiscard]] auto zMin() const -> double;
+
+    /** @brief Maximum z value of the input mesh triangles */
+    [[nodiscard]] auto zMax() const -> double;
+
+    /** @brief Intersect the meshes with the plane at `z` */
+    [[nodiscard]] auto slice(double z) const -> Slice;
+
+    /**
+     * @brief Intersect the meshes with every integer z plane in [first, last)
+     *
+     * Returns one Slice per plane, in order. Blocks of slices are computed in
+     * parallel on ThreadPool::Shared(), with the range split into enough
+     * blocks for `numThreads` threads. If `numThreads` is 0, uses
+     * ThreadPool::DefaultThreadCount(). If `numThreads` is 1, every slice is
+     * computed on the calling thread.
+     */
+    [[nodiscard]] auto slices(int first, int last, std::size_t numThreads = 0)
+        const -> std::vector<Slice>;
+
+private:
+    /** Triangle and its z-extent */
+    struct Triangle {
+        std::array<std::size_t, 3> v;
+        double zMin;
+        double zMax;
+    };
+
+    /** Intersect the meshes with every z in [first, last) by sweeping */
+    void sweep_(int first, int last, Slice* output) const;
+
+    /** Intersect a set of triangles with the plane at z */
+    auto intersect_(const std::vector<std::size_t>& tris, double z) const
+        -> Slice;
+
+    /** Vertices of all input meshes */
+    std::vector<cv::Vec3d> vertices_;
+    /** Vertex normals of all input meshes */
+    std::vector<cv::Vec3d> normals_;
+    /** Triangles of all input meshes, sorted by zMin */
+    std::vector<Triangle> triangles_;
+    /** Minimum z value of any triangle */
+    double zMin_{0};
+    /** Maximum z value of any triangle */
+    double zMax_{0};
+    /** Largest z-extent of any triangle */
+    double maxHeight_{0};
+    /** Whether every input mesh has normals */
+    bool hasNormals_{true};
+};
+}  // namespace volcart::meshing
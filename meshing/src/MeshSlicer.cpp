@@ -0,0 +1,328 @@
+#include "vc/meshing/MeshSlicer.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "vc/core/util/ThreadPool.hpp"
+
+using namespace volcart;
+using namespace volcart::meshing;
+
+namespace
+{
+// Mesh edge identified by its vertex indices, lowest first
+using EdgeKey = std::pair<std::size_t, std::size_t>;
+
+struct EdgeKeyHash {
+    auto operator()(const EdgeKey& k) const noexcept -> std::size_t
+    {
+        auto h = std::hash<std::size_t>{}(k.first);
+        return h ^ (std::hash<std::size_t>{}(k.second) + 0x9e3779b97f4a7c15 +
+                    (h << 6) + (h >> 2));
+    }
+};
+}  // namespace
+
+MeshSlicer::MeshSlicer(const ITKMesh::Pointer& mesh) { addMesh(mesh); }
+
+void MeshSlicer::setMesh(const ITKMesh::Pointer& mesh)
+{
+    clear();
+    addMesh(mesh);
+}
+
+void MeshSlicer::addMesh(const ITKMesh::Pointer& mesh)
+{
+    // Copy the vertices and normals
+    auto offset = vertices_.size();
+    auto numPts = mesh->GetNumberOfPoints();
+    vertices_.reserve(offset + numPts);
+    for (auto pt = mesh->GetPoints()->Begin(); pt != mesh->GetPoints()->End();
+         ++pt) {
+        const auto& p = pt->Value();
+        vertices_.emplace_back(p[0], p[1], p[2]);
+    }
+
+    const auto* nmls = mesh->GetPointData();
+    if (hasNormals_ and nmls != nullptr and nmls->Size() == numPts) {
+        normals_.reserve(offset + numPts);
+        for (auto n = nmls->Begin(); n != nmls->End(); ++n) {
+            const auto& v = n->Value();
+            normals_.emplace_back(v[0], v[1], v[2]);
+        }
+    } else {
+        hasNormals_ = false;
+        normals_.clear();
+    }
+
+    // Copy the triangles and their z-extents
+    if (mesh->GetCells() == nullptr) {
+        return;
+    }
+    auto first = triangles_.empty();
+    triangles_.reserve(triangles_.size() + mesh->GetNumberOfCells());
+    for (auto cell = mesh->GetCells()->Begin();
+         cell != mesh->GetCells()->End(); ++cell) {
+        if (cell->Value()->GetNumberOfPoints() != 3) {
+            continue;
+        }
+        Triangle t{};
+        auto* ids = cell->Value()->PointIdsBegin();
+        for (std::size_t i = 0; i < 3; i++) {
+            t.v[i] = offset + ids[i];
+        }
+        std::tie(t.zMin, t.zMax) = std::minmax(
+            {vertices_[t.v[0]][2], vertices_[t.v[1]][2],
+             vertices_[t.v[2]][2]});
+
+        // Update the bounds
+        if (first) {
+            zMin_ = t.zMin;
+            zMax_ = t.zMax;
+            first = false;
+        }
+        zMin_ = std::min(zMin_, t.zMin);
+        zMax_ = std::max(zMax_, t.zMax);
+        maxHeight_ = std::max(maxHeight_, t.zMax - t.zMin);
+        triangles_.push_back(t);
+    }
+
+    // Sort for the sweep
+    std::sort(
+        triangles_.begin(), triangles_.end(),
+        [](const auto& l, const auto& r) { return l.zMin < r.zMin; });
+}
+
+void MeshSlicer::clear()
+{
+    vertices_.clear();
+    normals_.clear();
+    triangles_.clear();
+    zMin_ = 0;
+    zMax_ = 0;
+    maxHeight_ = 0;
+    hasNormals_ = true;
+}
+
+auto MeshSlicer::hasNormals() const -> bool
+{
+    return hasNormals_ and not vertices_.empty();
+}
+
+auto MeshSlicer::zMin() const -> double { return zMin_; }
+
+auto MeshSlicer::zMax() const -> double { return zMax_; }
+
+auto MeshSlicer::slice(double z) const -> Slice
+{
+    // Triangles which start at or before z and are tall enough to reach it
+    auto byZMin = [](const Triangle& t, double v) { return t.zMin < v; };
+    auto begin = std::lower_bound(
+        triangles_.begin(), triangles_.end(), z - maxHeight_, byZMin);
+    std::vector<std::size_t> active;
+    for (auto it = begin; it != triangles_.end() and it->zMin <= z; ++it) {
+        if (it->zMax >= z) {
+            active.push_back(std::distance(triangles_.begin(), it));
+        }
+    }
+    return intersect_(active, z);
+}
+
+auto MeshSlicer::slices(int first, int last, std::size_t numThreads) const
+    -> std::vector<Slice>
+{
+    if (last <= first) {
+        return {};
+    }
+    auto numSlices = static_cast<std::size_t>(last - first);
+    std::vector<Slice> output(numSlices);
+
+    // Split the range into blocks which are each swept by one thread
+    if (numThreads == 0) {
+        numThreads = ThreadPool::DefaultThreadCount();
+    }
+    auto numBlocks = std::min(numSlices, numThreads * 4);
+    auto blockSize = (numSlices + numBlocks - 1) / numBlocks;
+    auto sweepBlock = [&](std::size_t b) {
+        auto begin = first + static_cast<int>(b * blockSize);
+        auto end = std::min(begin + static_cast<int>(blockSize), last);
+        if (begin < end) {
+            sweep_(begin, end, &output[b * blockSize]);
+        }
+    };
+    if (numThreads == 1 or numBlocks == 1) {
+        for (std::size_t b = 0; b < numBlocks; b++) {
+            sweepBlock(b);
+        }
+    } else {
+        ThreadPool::Shared().parallelFor(0, numBlocks, sweepBlock);
+    }
+
+    return output;
+}
+
+void MeshSlicer::sweep_(int first, int last, Slice* output) const
+{
+    // Skip the triangles which end before the first slice
+    auto byZMin = [](const Triangle& t, double v) { return t.zMin < v; };
+    auto next = std::lower_bound(
+        triangles_.begin(), triangles_.end(), first - maxHeight_, byZMin);
+
+    std::vector<std::size_t> active;
+    for (auto z = first; z < last; z++) {
+        // Add the triangles which start at or before this slice
+        for (; next != triangles_.end() and next->zMin <= z; ++next) {
+            active.push_back(std::distance(triangles_.begin(), next));
+        }
+
+        // Remove the triangles which end before this slice
+        active.erase(
+            std::remove_if(
+                active.begin(), active.end(),
+                [this, z](auto t) { return triangles_[t].zMax < z; }),
+            active.end());
+
+        output[z - first] = intersect_(active, z);
+    }
+}
+
+auto MeshSlicer::intersect_(const std::vector<std::size_t>& tris, double z)
+    const -> Slice
+{
+    // Intersection points, one per intersected edge or vertex on the plane
+    std::vector<cv::Vec3d> points;
+    std::vector<cv::Vec3d> normals;
+    std::unordered_map<EdgeKey, std::size_t, EdgeKeyHash> edgePoints;
+    auto edgePoint = [&](std::size_t a, std::size_t b) {
+        // A vertex on the plane is the intersection point of every edge which
+        // touches it. Key it by its index so that those edges share one point.
+        // Otherwise, always interpolate from the lower vertex index so that
+        // triangles which share this edge compute the same point.
+        EdgeKey key = std::minmax(a, b);
+        if (vertices_[a][2] == z) {
+            key = {a, a};
+        } else if (vertices_[b][2] == z) {
+            key = {b, b};
+        }
+        auto [it, inserted] = edgePoints.try_emplace(key, points.size());
+        if (inserted) {
+            const auto& v0 = vertices_[key.first];
+            const auto& v1 = vertices_[key.second];
+            auto t = (key.first == key.second)
+                         ? 0.0
+                         : (z - v0[2]) / (v1[2] - v0[2]);
+            cv::Vec3d p = v0 + t * (v1 - v0);
+            p[2] = z;
+            points.push_back(p);
+            if (hasNormals_) {
+                cv::Vec3d n = normals_[key.first] +
+                              t * (normals_[key.second] - normals_[key.first]);
+                normals.push_back(cv::normalize(n));
+            }
+        }
+        return it->second;
+    };
+
+    // Line segment for each triangle which crosses the plane. Vertices on the
+    // plane count as above it so that each crossing triangle has exactly two
+    // crossing edges. A triangle which only touches the plane at one vertex
+    // gives a zero-length segment, which is dropped.
+    std::vector<std::array<std::size_t, 2>> segments;
+    for (const auto& idx : tris) {
+        const auto& tri = triangles_[idx];
+        std::array<bool, 3> above{};
+        for (std::size_t i = 0; i < 3; i++) {
+            above[i] = vertices_[tri.v[i]][2] >= z;
+        }
+        if (above[0] == above[1] and above[1] == above[2]) {
+            continue;
+        }
+
+        std::array<std::size_t, 2> seg{};
+        std::size_t numEnds{0};
+        for (std::size_t i = 0; i < 3; i++) {
+            auto j = (i + 1) % 3;
+            if (above[i] != above[j]) {
+                seg[numEnds++] = edgePoint(tri.v[i], tri.v[j]);
+            }
+        }
+        if (seg[0] != seg[1]) {
+            segments.push_back(seg);
+        }
+    }
+
+    // Segments adjacent to each point, in compressed row form
+    std::vector<std::size_t> adjStart(points.size() + 1, 0);
+    for (const auto& seg : segments) {
+        adjStart[seg[0] + 1]++;
+        adjStart[seg[1] + 1]++;
+    }
+    for (std::size_t i = 1; i < adjStart.size(); i++) {
+        adjStart[i] += adjStart[i - 1];
+    }
+    std::vector<std::size_t> adj(adjStart.back());
+    auto fill = adjStart;
+    for (std::size_t s = 0; s < segments.size(); s++) {
+        adj[fill[segments[s][0]]++] = s;
+        adj[fill[segments[s][1]]++] = s;
+    }
+
+    // Follow unused segments from a point until reaching a dead end
+    std::vector<bool> used(segments.size(), false);
+    Slice slice;
+    auto walk = [&](std::size_t start, std::size_t seg) {
+        Polyline line;
+        auto addPoint = [&](std::size_t p) {
+            line.points.push_back(points[p]);
+            if (hasNormals_) {
+                line.normals.push_back(normals[p]);
+            }
+        };
+        auto cur = start;
+        addPoint(cur);
+        while (true) {
+            used[seg] = true;
+            const auto& s = segments[seg];
+            cur = (s[0] == cur) ? s[1] : s[0];
+            addPoint(cur);
+
+            // Find the next unused segment
+            auto found = false;
+            for (auto i = adjStart[cur]; i < adjStart[cur + 1]; i++) {
+                if (not used[adj[i]]) {
+                    seg = adj[i];
+                    found = true;
+                    break;
+                }
+            }
+            if (not found) {
+                break;
+            }
+        }
+        slice.push_back(std::move(line));
+    };
+
+    // Open polylines start at points which don't have exactly two segments
+    for (std::size_t p = 0; p < points.size(); p++) {
+        if (adjStart[p + 1] - adjStart[p] == 2) {
+            continue;
+        }
+        for (auto i = adjStart[p]; i < adjStart[p + 1]; i++) {
+            if (not used[adj[i]]) {
+                walk(p, adj[i]);
+            }
+        }
+    }
+
+    // Everything left is a closed loop
+    for (std::size_t s = 0; s < segments.size(); s++) {
+        if (not used[s]) {
+            walk(segments[s][0], s);
+        }
+    }
+
+    return slice;
+}
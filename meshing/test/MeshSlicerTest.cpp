@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+#include "vc/core/shapes/Cube.hpp"
+#include "vc/core/shapes/Plane.hpp"
+#include "vc/meshing/MeshSlicer.hpp"
+
+using namespace volcart;
+using namespace volcart::shapes;
+using namespace volcart::meshing;
+
+TEST(MeshSlicer, CubeSlice)
+{
+    MeshSlicer slicer(Cube(10).itkMesh());
+    EXPECT_DOUBLE_EQ(slicer.zMin(), 0);
+    EXPECT_DOUBLE_EQ(slicer.zMax(), 10);
+
+    // The sides of the cube form a single closed loop
+    auto slice = slicer.slice(5);
+    ASSERT_EQ(slice.size(), 1);
+    const auto& line = slice[0];
+    EXPECT_EQ(line.points.size(), 9);
+    EXPECT_EQ(line.points.front(), line.points.back());
+    EXPECT_EQ(line.normals.size(), line.points.size());
+
+    // Every point is on the sides of the cube
+    for (const auto& p : line.points) {
+        EXPECT_DOUBLE_EQ(p[2], 5);
+        auto onSide = p[0] == 0 or p[0] == 10 or p[1] == 0 or p[1] == 10;
+        EXPECT_TRUE(onSide);
+    }
+
+    // Outside of the cube
+    EXPECT_TRUE(slicer.slice(-1).empty());
+    EXPECT_TRUE(slicer.slice(11).empty());
+}
+
+TEST(MeshSlicer, SliceThroughVertexRow)
+{
+    // Ordered mesh with rows of vertices at every integer z
+    MeshSlicer slicer(Plane(5, 5).itkMesh());
+
+    // The plane passes through a row of vertices. Each vertex is one point.
+    auto slice = slicer.slice(2);
+    ASSERT_EQ(slice.size(), 1);
+    const auto& points = slice[0].points;
+    ASSERT_EQ(points.size(), 5);
+    auto step = (points.front()[0] == 0) ? 1.0 : -1.0;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        auto x = (step > 0) ? 0.0 : 4.0;
+        x += step * static_cast<double>(i);
+        EXPECT_EQ(points[i], cv::Vec3d(x, 0, 2));
+    }
+}
+
+TEST(MeshSlicer, SweepMatchesSingleSlice)
+{
+    MeshSlicer slicer;
+    slicer.addMesh(Cube(10).itkMesh());
+    slicer.addMesh(Cube(3).itkMesh());
+
+    auto slices = slicer.slices(-2, 13, 3);
+    ASSERT_EQ(slices.size(), 15);
+    for (int z = -2; z < 13; z++) {
+        auto expected = slicer.slice(z);
+        const auto& result = slices[z + 2];
+        ASSERT_EQ(result.size(), expected.size());
+        for (std::size_t i = 0; i < result.size(); i++) {
+            EXPECT_EQ(result[i].points, expected[i].points);
+        }
+    }
+}
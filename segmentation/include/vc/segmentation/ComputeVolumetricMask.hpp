@@ -21,6 +21,10 @@ namespace volcart::segmentation
  * compute a per-voxel mask for a segmented layer in a volume. For each slice
  * in the Z-range of the input PointSet, the points which intersect that slice
  * are used as the seeds for running the flood fill algorithm.
+ *
+ * By default, the mask is accumulated in memory and returned by compute().
+ * For large segmentations, set a mask volume with setMaskVolume() to instead
+ * write each slice's mask to disk as soon as it has been computed.
  */
 class ComputeVolumetricMask : public IterationsProgress
 {
@@ -31,6 +35,9 @@ public:
     /** @brief Set the input PointSet */
     void setPointSet(const PointSet& ps);
 
+    /** @copydoc setPointSet(const PointSet&) */
+    void setPointSet(PointSet&& ps);
+
     /** @brief Set the input Volume */
     void setVolume(const Volume::Pointer& v);
 
@@ -62,7 +69,25 @@ public:
      */
     void setMaxRadius(std::size_t radius);
 
-    /** @brief Computes the segmentation. */
+    /**
+     * @brief Set an output mask volume
+     *
+     * If set, the mask of each slice is written to this Volume as soon as it
+     * has been computed, and the in-memory VolumetricMask is not populated.
+     * The mask volume is given the same slice layout as the input Volume.
+     * Voxels in the mask have the value 65535. All other voxels, including
+     * those of slices outside the Z-range of the input PointSet, are 0.
+     *
+     * The resulting volume can be sampled through the slice cache by
+     * texturing::ThicknessTexture::setMaskVolume().
+     */
+    void setMaskVolume(const Volume::Pointer& v);
+
+    /**
+     * @brief Computes the segmentation.
+     *
+     * If a mask volume has been set, the returned mask is empty.
+     */
     VolumetricMask::Pointer compute();
 
     /** @brief Return the full, 3D mask. */
@@ -90,6 +115,13 @@ private:
     std::size_t maxRadius_{std::numeric_limits<std::size_t>::max()};
     /** Mask */
     VolumetricMask::Pointer mask_;
+    /** Output mask volume */
+    Volume::Pointer maskVol_;
+
+    /** Setup the mask volume metadata */
+    void init_mask_volume_();
+    /** Write a binary slice mask to the mask volume */
+    void write_mask_slice_(std::size_t z, const cv::Mat& img);
 };
 
 }  // namespace volcart::segmentation
\ No newline at end of file
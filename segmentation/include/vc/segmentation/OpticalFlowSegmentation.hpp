@@ -8,6 +8,7 @@
 
 #include "vc/core/types/OrderedPointSet.hpp"
 #include "vc/core/types/VolumePkg.hpp"
+#include "vc/core/util/ThreadPool.hpp"
 #include "vc/segmentation/ChainSegmentationAlgorithm.hpp"
 #include "vc/segmentation/lrps/FittedCurve.hpp"
 
@@ -107,8 +108,12 @@ private:
     /**
      * @brief Compute the curve for z + 1 given a curve on z using the optical
      * flow between the two slices
+     *
+     * The optical flow is computed once over the bounding box of the whole
+     * curve. Points are then displaced in parallel using `pool`.
      */
-    auto compute_curve_(const FittedCurve& currentCurve, int zIndex)
+    auto compute_curve_(
+        const FittedCurve& currentCurve, int zIndex, ThreadPool& pool)
         -> std::vector<Voxel>;
 
     /**
@@ -2,13 +2,18 @@
 
 /** @file */
 
+#include <array>
 #include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
+#include "vc/core/math/StructureTensorField.hpp"
+#include "vc/core/util/ThreadPool.hpp"
 #include "vc/segmentation/ChainSegmentationAlgorithm.hpp"
-#include "vc/segmentation/stps/Particle.hpp"
-#include "vc/segmentation/stps/ParticleChain.hpp"
+#include "vc/segmentation/stps/ForceChain.hpp"
 
 namespace volcart::segmentation
 {
@@ -20,6 +25,13 @@ namespace volcart::segmentation
  * estimate of the local neighborhood as a guide. Point movement is constrained
  * by way of a corrective spring force between each point.
  *
+ * The chain is stored as a structure of arrays and is integrated with a
+ * fourth-order Runge-Kutta scheme. The buffers for each RK stage are allocated
+ * once per call to compute(). Forces are evaluated for all particles in
+ * parallel. By default, the structure tensor is computed from the subvoxel
+ * neighborhood of every particle at every stage. Enable setUseTensorField() to
+ * instead sample a cached field of voxel structure tensors.
+ *
  * @ingroup stps
  */
 class StructureTensorParticleSim : public ChainSegmentationAlgorithm
@@ -50,6 +62,25 @@ public:
      * RK iterations per output step is determined by `stepSize_ / rkStepSize_`.
      */
     void setRKStepSize(double s) { rkStepSize_ = s; }
+
+    /**
+     * @brief Sample structure tensors from a cached tensor field
+     *
+     * If enabled, structure tensors are computed once per voxel and
+     * interpolated at particle positions using a StructureTensorField.
+     * This is much faster when the chain is propagated over many steps, but
+     * the interpolated tensors differ slightly from those computed directly
+     * at subvoxel positions. Default: disabled
+     */
+    void setUseTensorField(bool b) { useTensorField_ = b; }
+
+    /**
+     * @brief Set the number of threads used to compute particle forces
+     *
+     * Forces are computed on ThreadPool::Shared(), using at most this many
+     * threads. If 0, uses ThreadPool::DefaultThreadCount(). Default: 0
+     */
+    void setNumThreads(std::size_t n) { numThreads_ = n; }
     /**@}*/
 
     /**@{*/
@@ -70,8 +101,26 @@ private:
     /** Radius for structure tensor calculation kernel */
     int radius_{5};
 
-    /** Most recent version of the chain */
-    ParticleChain currentChain_;
+    /** Sample the cached tensor field */
+    bool useTensorField_{false};
+    /** Number of force threads */
+    std::size_t numThreads_{0};
+
+    /** Most recent particle positions */
+    std::vector<cv::Vec3d> pos_;
+    /** Resting length to the previous particle in the chain */
+    std::vector<double> restingL_;
+    /** Resting length to the next particle in the chain */
+    std::vector<double> restingR_;
+    /** Particle positions for the current RK stage */
+    std::vector<cv::Vec3d> stagePos_;
+    /** Forces computed by each RK stage */
+    std::array<std::vector<Force>, 4> k_;
+
+    /** Cached tensor field, if enabled */
+    std::unique_ptr<StructureTensorField> field_;
+    /** Number of threads computing forces in the current compute() */
+    std::size_t forceThreads_{1};
 
     /**
      * Runge-Kutta step size. Number of RK iterations per step is determined by
@@ -79,11 +128,23 @@ private:
      */
     double rkStepSize_{0.5};
 
-    /** Calculate the propagation force direction for each point in the chain */
-    ForceChain calc_prop_forces_(ParticleChain c);
+    /**
+     * Calculate the normalized sum of the propagation and spring forces for
+     * each particle
+     */
+    void calc_forces_(
+        const std::vector<cv::Vec3d>& pos, std::vector<Force>& forces);
+
+    /** Calculate the propagation force for particle i */
+    auto calc_prop_force_(const std::vector<cv::Vec3d>& pos, std::size_t i)
+        -> Force;
+
+    /** Calculate the corrective spring force for particle i */
+    auto calc_spring_force_(const std::vector<cv::Vec3d>& pos, std::size_t i)
+        const -> Force;
 
-    /** Calculate the corrective spring force for each point in the chain */
-    ForceChain calc_spring_forces_(ParticleChain c);
+    /** Call fn(i) for every particle, in parallel if enabled */
+    void for_each_particle_(const std::function<void(std::size_t)>& fn);
 
     /** Add the current chain to the final result point set */
     void add_chain_to_result_();
@@ -0,0 +1,86 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/util/HashFunctions.hpp"
+
+namespace volcart::segmentation
+{
+
+/** Sparse voxel set used by the reference skeletonization functions */
+using VoxelSet = std::unordered_set<cv::Vec3i, Vec3iHash>;
+
+/**
+ * @brief Convert a binary slice mask to a skeleton bitmap
+ *
+ * Skeleton bitmaps are dense, single-slice CV_8UC1 images with a one pixel,
+ * zero-valued border. Slice pixel (x, y) is stored at bitmap position
+ * (x + 1, y + 1) and has the value 1 when it belongs to the skeleton. The
+ * border lets the thinning and pruning passes look up all eight neighbors of
+ * a pixel without bounds checks.
+ *
+ * @param mask CV_8UC1 image. All non-zero pixels are considered foreground.
+ */
+cv::Mat MakeSkeletonBitmap(const cv::Mat& mask);
+
+/**
+ * @brief Get the foreground pixels of a skeleton bitmap as voxels
+ *
+ * Voxels are returned in row-major order and are assigned the z-index `z`.
+ */
+std::vector<cv::Vec3i> SkeletonBitmapToVoxels(const cv::Mat& bitmap, int z);
+
+/**
+ * @brief Skeletonize a mask by thinning
+ *
+ * Dense implementation of the directional thinning algorithm described in
+ * section 8.6.2 of "Computer Vision", 5th Edition, by E.R. Davies. Each
+ * directional pass is evaluated in parallel over the rows of the bitmap.
+ * Produces the same skeleton as ThinMask(VoxelSet&).
+ *
+ * @param bitmap Skeleton bitmap. Thinned in place.
+ */
+void ThinMask(cv::Mat& bitmap);
+
+/**
+ * @brief Find skeleton pixels with more than two skeleton neighbors
+ *
+ * Intersections are returned in bitmap coordinates and in row-major order.
+ */
+std::vector<cv::Point> FindIntersections(const cv::Mat& bitmap);
+
+/**
+ * @brief Remove spurs of `spurLength` or fewer pixels from a skeleton bitmap
+ *
+ * Branches are only walked until they exceed `spurLength`, so the cost of
+ * pruning is proportional to the number of intersections rather than to the
+ * size of the skeleton.
+ *
+ * @param bitmap Skeleton bitmap. Pruned in place.
+ * @param spurLength Maximum length of a pruned spur
+ */
+void PruneSpurs(cv::Mat& bitmap, std::size_t spurLength);
+
+/**
+ * @brief Skeletonize a mask by thinning
+ *
+ * Reference implementation operating on a sparse voxel set. Kept for
+ * validating and benchmarking ThinMask(cv::Mat&).
+ */
+VoxelSet ThinMask(VoxelSet& pts);
+
+/**
+ * @brief Remove spurs from a skeleton
+ *
+ * Reference implementation operating on a sparse voxel set. Kept for
+ * validating and benchmarking PruneSpurs(cv::Mat&, std::size_t).
+ */
+VoxelSet PruneSpurs(VoxelSet skeleton, std::size_t spurLength);
+
+}  // namespace volcart::segmentation
@@ -1,6 +1,7 @@
 #include "vc/segmentation/ComputeVolumetricMask.hpp"
 
 #include <map>
+#include <utility>
 #include <opencv2/imgproc.hpp>
 
 #include "vc/core/util/Iteration.hpp"
@@ -12,6 +13,9 @@ using namespace volcart::segmentation;
 using Voxel = cv::Vec3i;
 using VoxelList = std::vector<Voxel>;
 
+// Value of in-mask voxels in a mask volume
+static constexpr std::uint16_t MASK_VOLUME_IN{65535};
+
 void ComputeVolumetricMask::setLowThreshold(std::uint16_t t) { low_ = t; }
 
 void ComputeVolumetricMask::setHighThreshold(std::uint16_t t) { high_ = t; }
@@ -30,6 +34,11 @@ void ComputeVolumetricMask::setMaxRadius(std::size_t radius)
     maxRadius_ = radius;
 }
 
+void ComputeVolumetricMask::setMaskVolume(const Volume::Pointer& v)
+{
+    maskVol_ = v;
+}
+
 auto ComputeVolumetricMask::compute() -> VolumetricMask::Pointer
 {
     // Setup the output
@@ -47,6 +56,21 @@ auto ComputeVolumetricMask::compute() -> VolumetricMask::Pointer
         seedsBySlice[sliceIdx].emplace_back(pt[0], pt[1], pt[2]);
     }
 
+    // Write empty slices below the segmentation
+    std::size_t numSlices{0};
+    if (maskVol_) {
+        numSlices = static_cast<std::size_t>(vol_->numSlices());
+        init_mask_volume_();
+        for (auto z : range(std::min(startSlice, numSlices))) {
+            write_mask_slice_(z, cv::Mat());
+        }
+    }
+
+    // No seeds: every slice was written as empty above
+    if (seedsBySlice.empty()) {
+        return mask_;
+    }
+
     // Signal progress has begun
     progressStarted();
 
@@ -61,6 +85,9 @@ auto ComputeVolumetricMask::compute() -> VolumetricMask::Pointer
             seedPoints = seedsBySlice.at(zIndex);
         } catch (const std::out_of_range& e) {
             // No seeds for this slice. Skip.
+            if (maskVol_) {
+                write_mask_slice_(zIndex, cv::Mat());
+            }
             continue;
         }
 
@@ -83,16 +110,25 @@ auto ComputeVolumetricMask::compute() -> VolumetricMask::Pointer
         auto sliceMask = DoFloodFill(seedPoints, bound, slice, low_, high_);
 
         // Apply closing to fill holes and gaps.
-        if (enableClosing_) {
+        if (enableClosing_ or maskVol_) {
             // Convert mask to a binary image so we can apply closing
             cv::Mat binaryImg = cv::Mat::zeros(slice.size(), CV_8UC1);
             for (const Voxel& v : sliceMask) {
                 binaryImg.at<std::uint8_t>(v[1], v[0]) = 255;
             }
 
-            cv::Mat kernel = cv::Mat::ones(kernel_, kernel_, CV_8U);
-            cv::Mat closedImg;
-            cv::morphologyEx(binaryImg, closedImg, cv::MORPH_CLOSE, kernel);
+            cv::Mat closedImg = binaryImg;
+            if (enableClosing_) {
+                cv::Mat kernel = cv::Mat::ones(kernel_, kernel_, CV_8U);
+                cv::morphologyEx(
+                    binaryImg, closedImg, cv::MORPH_CLOSE, kernel);
+            }
+
+            // Write the slice to the mask volume
+            if (maskVol_) {
+                write_mask_slice_(zIndex, closedImg);
+                continue;
+            }
 
             // Save to the full volume mask
             for (const auto p : range2D(closedImg.rows, closedImg.cols)) {
@@ -107,11 +143,50 @@ auto ComputeVolumetricMask::compute() -> VolumetricMask::Pointer
         }
     }
     progressComplete();
+
+    // Write empty slices above the segmentation
+    if (maskVol_) {
+        for (auto z : range(std::min(endSlice + 1, numSlices), numSlices)) {
+            write_mask_slice_(z, cv::Mat());
+        }
+    }
+
     return mask_;
 }
 
+void ComputeVolumetricMask::init_mask_volume_()
+{
+    maskVol_->setSliceWidth(vol_->sliceWidth());
+    maskVol_->setSliceHeight(vol_->sliceHeight());
+    maskVol_->setNumberOfSlices(vol_->numSlices());
+    maskVol_->setVoxelSize(vol_->voxelSize());
+    maskVol_->setMin(0);
+    maskVol_->setMax(MASK_VOLUME_IN);
+    maskVol_->saveMetadata();
+}
+
+void ComputeVolumetricMask::write_mask_slice_(std::size_t z, const cv::Mat& img)
+{
+    // Empty image: No voxels in the mask
+    cv::Mat slice;
+    if (img.empty()) {
+        auto h = vol_->sliceHeight();
+        auto w = vol_->sliceWidth();
+        slice = cv::Mat::zeros(h, w, CV_16UC1);
+    } else {
+        slice = cv::Mat::zeros(img.size(), CV_16UC1);
+        slice.setTo(MASK_VOLUME_IN, img);
+    }
+    maskVol_->setSliceData(static_cast<int>(z), slice);
+}
+
 void ComputeVolumetricMask::setPointSet(const PointSet& ps) { input_ = ps; }
 
+void ComputeVolumetricMask::setPointSet(PointSet&& ps)
+{
+    input_ = std::move(ps);
+}
+
 void ComputeVolumetricMask::setVolume(const Volume::Pointer& v) { vol_ = v; }
 
 auto ComputeVolumetricMask::getMask() const -> VolumetricMask::Pointer
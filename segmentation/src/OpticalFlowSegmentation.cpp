@@ -15,6 +15,7 @@
 #include "vc/core/types/Color.hpp"
 #include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/String.hpp"
+#include "vc/core/util/ThreadPool.hpp"
 #include "vc/segmentation/OpticalFlowSegmentation.hpp"
 #include "vc/segmentation/lrps/Derivative.hpp"
 #include "vc/segmentation/lrps/FittedCurve.hpp"
@@ -121,21 +122,24 @@ auto OpticalFlowSegmentation::progressIterations() const -> std::size_t
     return static_cast<std::size_t>((endIndex_ - startIndex) / stepSize_);
 }
 
-// Multithreaded computation of split curve segment
+// Multithreaded computation of the next curve
 auto OpticalFlowSegmentation::compute_curve_(
-    const FittedCurve& currentCurve, int zIndex) -> std::vector<Voxel>
+    const FittedCurve& currentCurve, int zIndex, ThreadPool& pool)
+    -> std::vector<Voxel>
 {
-    // Extract 2D image slices at zIndex and zIndex+1
-    const auto slice1 = vol_->getSliceDataCopy(zIndex);
-    const auto slice2 = vol_->getSliceDataCopy(zIndex + 1);
+    // Evaluate the curve once so that the points can be shared by all threads
+    std::vector<Voxel> currentVs;
+    currentVs.reserve(currentCurve.size());
+    for (int i = 0; i < currentCurve.size(); ++i) {
+        currentVs.emplace_back(currentCurve(i));
+    }
 
     // Calculate the bounding box of the curve to define the region of interest
     int xMin = std::numeric_limits<int>::max();
     int yMin = std::numeric_limits<int>::max();
     int xMax = std::numeric_limits<int>::min();
     int yMax = std::numeric_limits<int>::min();
-    for (int i = 0; i < currentCurve.size(); ++i) {
-        auto point = currentCurve(i);
+    for (const auto& point : currentVs) {
         xMin = std::min(xMin, static_cast<int>(point[0]));
         yMin = std::min(yMin, static_cast<int>(point[1]));
         xMax = std::max(xMax, static_cast<int>(point[0]));
@@ -146,13 +150,17 @@ auto OpticalFlowSegmentation::compute_curve_(
     const int margin = 15;
     xMin = std::max(0, xMin - margin);
     yMin = std::max(0, yMin - margin);
-    xMax = std::min(slice1.cols - 1, xMax + margin);
-    yMax = std::min(slice1.rows - 1, yMax + margin);
-
-    // Extract the region of interest
+    xMax = std::min(vol_->sliceWidth() - 1, xMax + margin);
+    yMax = std::min(vol_->sliceHeight() - 1, yMax + margin);
+
+    // Get the region of interest from the slices at zIndex and zIndex+1. The
+    // window covers the whole curve, so it is often a large part of the
+    // slice. Large windows are read through the slice cache, so slice
+    // zIndex+1 is only decoded once even though the next iteration reads it
+    // again as zIndex. Small windows are decoded directly.
     const cv::Rect roi(xMin, yMin, xMax - xMin + 1, yMax - yMin + 1);
-    const cv::Mat roiSlice1 = slice1(roi);
-    const cv::Mat roiSlice2 = slice2(roi);
+    const auto roiSlice1 = vol_->getSliceRegion(zIndex, roi);
+    const auto roiSlice2 = vol_->getSliceRegion(zIndex + 1, roi);
 
     // Convert to grayscale and normalize the slices
     cv::Mat gray1;
@@ -162,58 +170,67 @@ auto OpticalFlowSegmentation::compute_curve_(
     cv::Mat integralImg;
     cv::integral(gray2, integralImg, CV_32S);
 
-    // Compute dense optical flow using Farneback method
+    // Compute dense optical flow using Farneback method. This is done once
+    // for the whole curve and shared by all threads.
     cv::Mat flow;
     cv::calcOpticalFlowFarneback(gray1, gray2, flow, 0.5, 3, 15, 3, 7, 1.2, 0);
 
     // Calculate the average flow around a 5x5 window
     int windowSize = 5;
     const cv::Point2f minPt(static_cast<float>(xMin), static_cast<float>(yMin));
-    std::vector<Voxel> nextVs;
-    for (int i = 0; i < currentCurve.size(); ++i) {
-        // Get the current point
-        auto cp = currentCurve(i);
-        const cv::Point2f pt(cp[0], cp[1]);
-
-        // Convert pt to ROI coordinates
-        const auto roiPt = pt - minPt;
-
-        // Get the optical flow vector at the current point
-        auto flowVec = flow.at<cv::Vec2f>(roiPt);
-
-        // Check if the flow magnitude is more than opticalFlowDisplacementThreshold_ pixels
-        if (cv::norm(flowVec) > opticalFlowDisplacementThreshold_) {
-            cv::Vec2f avgFlow(0, 0);
-            int count = 0;
-            const auto bXY = -windowSize / 2;
-            const auto eXY = 1 + windowSize / 2;
-            for (const auto [x, y] : range2D(bXY, eXY, bXY, eXY)) {
-                const cv::Point2f xyPt{
-                    static_cast<float>(x), static_cast<float>(y)};
-                const auto neighborPt = roiPt + xyPt;
-                if (::IsInBounds(neighborPt, flow)) {
-                    auto neighborIntensity = gray2.at<std::uint8_t>(neighborPt);
-                    if (neighborIntensity > opticalFlowPixelThreshold_) {
-                        avgFlow += flow.at<cv::Vec2f>(neighborPt);
-                        count++;
+    std::vector<Voxel> nextVs(currentVs.size());
+    const std::size_t grainSize{16};
+    pool.parallelFor(
+        0, currentVs.size(),
+        [&](std::size_t i) {
+            // Get the current point
+            const auto& cp = currentVs[i];
+            const cv::Point2f pt(cp[0], cp[1]);
+
+            // Convert pt to ROI coordinates
+            const auto roiPt = pt - minPt;
+
+            // Get the optical flow vector at the current point
+            auto flowVec = flow.at<cv::Vec2f>(roiPt);
+
+            // Check if the flow magnitude is more than
+            // opticalFlowDisplacementThreshold_ pixels
+            if (cv::norm(flowVec) > opticalFlowDisplacementThreshold_) {
+                cv::Vec2f avgFlow(0, 0);
+                int count = 0;
+                const auto bXY = -windowSize / 2;
+                const auto eXY = 1 + windowSize / 2;
+                for (const auto [x, y] : range2D(bXY, eXY, bXY, eXY)) {
+                    const cv::Point2f xyPt{
+                        static_cast<float>(x), static_cast<float>(y)};
+                    const auto neighborPt = roiPt + xyPt;
+                    if (::IsInBounds(neighborPt, flow)) {
+                        auto neighborIntensity =
+                            gray2.at<std::uint8_t>(neighborPt);
+                        if (neighborIntensity > opticalFlowPixelThreshold_) {
+                            avgFlow += flow.at<cv::Vec2f>(neighborPt);
+                            count++;
+                        }
                     }
                 }
+                // Update the flow vec with the mean vec
+                if (count > 0) {
+                    flowVec = avgFlow / count;
+                }
             }
-            // Update the flow vec with the mean vec
-            if (count > 0) {
-                flowVec = avgFlow / count;
-            }
-        }
 
-        // Move the point along with respect to the optical flow vector
-        auto updatedPt = pt + cv::Point2f(flowVec);
+            // Move the point along with respect to the optical flow vector
+            auto updatedPt = pt + cv::Point2f(flowVec);
 
-        // Add the updated point to the updated curve
-        nextVs.emplace_back(updatedPt.x, updatedPt.y, zIndex + 1);
-    }
+            // Add the updated point to the updated curve
+            nextVs[i] = Voxel(updatedPt.x, updatedPt.y, zIndex + 1);
+        },
+        grainSize);
 
     // Smooth black pixels by moving them closer to the edge
     // Smooth very bright pixels by moving them closer to the edge
+    // Each point is projected between its already smoothed predecessor and its
+    // successor, so this pass stays serial.
     windowSize = static_cast<int>(
         std::ceil(materialThickness_ / vol_->voxelSize()) * 0.25);
     for (int i = 0; i < nextVs.size(); ++i) {
@@ -296,6 +313,14 @@ auto OpticalFlowSegmentation::compute() -> PointSet
         (endIndex_ - startIndex + 1) / static_cast<std::size_t>(stepSize_));
     points.push_back(currentVs);
 
+    // Set up the maximum number of threads. The pool is reused by every
+    // iteration.
+    auto maxThreads = std::max(1U, std::thread::hardware_concurrency() - 1);
+    if (maxThreads_.has_value()) {
+        maxThreads = std::max(1U, std::min(maxThreads, maxThreads_.value()));
+    }
+    ThreadPool pool(maxThreads);
+
     // Iterate over z-slices
     std::size_t iteration{0};
     auto stepSize = static_cast<int>(stepSize_);
@@ -321,80 +346,13 @@ auto OpticalFlowSegmentation::compute() -> PointSet
                 draw_particle_on_slice_(currentCurve, zIndex, -1, true));
         }
 
-        // Set up the maximum number of threads
-        auto maxThreads = std::thread::hardware_concurrency() - 1;
-        if (maxThreads_.has_value()) {
-            maxThreads = std::min(maxThreads, maxThreads_.value());
-        }
-
-        // Calculate the num threads we're going to use
-        const std::uint32_t minPointsPerThread{15};
-        const auto numPts = currentVs.size();
-        const auto ptsPerThread = static_cast<std::uint32_t>(std::floor(
-            static_cast<float>(numPts) /
-            static_cast<float>(minPointsPerThread)));
-        const auto numThreads =
-            std::max(1U, std::min(ptsPerThread, maxThreads));
-        const auto baseSegmentLength = static_cast<std::uint32_t>(std::floor(
-            static_cast<float>(numPts) / static_cast<float>(numThreads)));
-        const auto numThreadsWithExtraPoint = numPts % numThreads;
-
-        // Parallel computation of curve segments
-        std::vector<std::vector<Voxel>> subsegmentVectors;
-        std::size_t startIdx{0};
-        for (const auto& i : range(numThreads)) {
-            auto segmentLength =
-                baseSegmentLength + (i < numThreadsWithExtraPoint ? 1 : 0);
-            auto endIdx = startIdx + segmentLength;
-
-            // Change start_idx and end_idx to include overlap
-            auto startIdxPadded =
-                static_cast<std::int64_t>((i == 0) ? 0 : (startIdx - 2));
-            auto endIdxPadded = static_cast<std::int64_t>(
-                (i == numThreads - 1) ? numPts : (endIdx + 2));
-
-            // Copy from currentVs to our vector
-            auto startIt = std::next(currentVs.begin(), startIdxPadded);
-            auto endIt = std::next(currentVs.begin(), endIdxPadded);
-            subsegmentVectors.emplace_back(startIt, endIt);
-            startIdx = endIdx;
-        }
-
-        // Initialize the threads
-        std::vector<std::thread> threads;
-        std::vector<std::vector<Voxel>> subsegmentPoints(numThreads);
-        for (const auto& i : range(numThreads)) {
-            threads.emplace_back(
-                [this, &subsegmentVectors, &zIndex, &subsegmentPoints, i]() {
-                    const Chain subsegmentChain(subsegmentVectors[i]);
-                    const FittedCurve curve(subsegmentChain, zIndex);
-                    subsegmentPoints[i] = compute_curve_(curve, zIndex);
-                });
-        }
-
-        // Join threads and stitch curve segments together
-        for (auto& thread : threads) {
-            thread.join();
-        }
-
-        // Stitch curve segments together, discarding overlapping points
-        std::vector<Voxel> stitched;
-        stitched.reserve(currentVs.size());
-        for (auto [i, segment] : enumerate(subsegmentPoints)) {
-            auto startIt = segment.begin();
-            auto endIt = segment.end();
-            if (i > 0) {
-                startIt = std::next(segment.begin(), 2);
-            }
-            if (i < numThreads - 1) {
-                endIt = std::next(segment.end(), -2);
-            }
-            stitched.insert(stitched.end(), startIt, endIt);
-        }
+        // Compute the curve on the next slice
+        const FittedCurve spacedCurve(currentVs, zIndex);
+        auto computed = compute_curve_(spacedCurve, zIndex, pool);
 
-        // Generate nextVs by evenly spacing points in the stitched curve
-        FittedCurve stitchedFittedCurve(stitched, zIndex + 1);
-        auto nextVs = stitchedFittedCurve.evenlySpacePoints();
+        // Generate nextVs by evenly spacing points in the computed curve
+        FittedCurve computedFittedCurve(computed, zIndex + 1);
+        auto nextVs = computedFittedCurve.evenlySpacePoints();
 
         // Check if any points in nextVs are outside volume boundaries. If so,
         // stop iterating and dump the resulting point cloud.
@@ -0,0 +1,379 @@
+#include "vc/segmentation/tff/Skeletonize.hpp"
+
+#include <array>
+#include <cstdint>
+#include <queue>
+
+#include <opencv2/imgproc.hpp>
+
+#include "vc/core/util/Logging.hpp"
+#include "vc/segmentation/tff/FloodFill.hpp"
+
+using namespace volcart;
+using namespace volcart::segmentation;
+
+namespace vcs = volcart::segmentation;
+
+using Voxel = cv::Vec3i;
+
+// Neighbor offsets in the same order as GetNeighbors()
+static const std::array<cv::Point, 8> NEIGHBOR_OFFSETS{
+    {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}}};
+
+// Whether a point with the given 8-neighborhood should be removed by a
+// directional thinning pass. Neighbors are numbered counter-clockwise starting
+// from (x, y + 1).
+static auto ShouldThin(
+    int dir,
+    bool a1,
+    bool a2,
+    bool a3,
+    bool a4,
+    bool a5,
+    bool a6,
+    bool a7,
+    bool a8) -> bool
+{
+    // Calculate 'chi', the crossing number.
+    int chi = (a1 != a3) + (a3 != a5) + (a5 != a7) + int(a7 != a1) +
+              (2 * (a2 > a1) && (a2 > a3)) + ((a4 > a3) && (a4 > a5)) +
+              ((a6 > a5) && (a6 > a7)) + ((a8 > a7) && (a8 > a1));
+
+    // Obtain sigma -- a count of the number of 8-connected neighbors of
+    // this pixel that are also in the mask.
+    int sigma = a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8;
+
+    // Skip this unless chi == 2 and sigma != 1
+    if (chi != 2 || sigma == 1) {
+        return false;
+    }
+
+    // Remove this point if my shouldntFind neighbor IS NOT in the points
+    // and my shouldFind neighbor IS in the points
+    switch (dir) {
+        // "North" points
+        case 0:
+            return !a1 && a5;
+        // "South" points
+        case 1:
+            return !a5 && a1;
+        // "East" points
+        case 2:
+            return !a3 && a7;
+        // "West" points
+        case 3:
+            return !a7 && a3;
+        default:
+            return false;
+    }
+}
+
+auto vcs::MakeSkeletonBitmap(const cv::Mat& mask) -> cv::Mat
+{
+    cv::Mat bitmap;
+    cv::copyMakeBorder(mask, bitmap, 1, 1, 1, 1, cv::BORDER_CONSTANT, 0);
+    cv::threshold(bitmap, bitmap, 0, 1, cv::THRESH_BINARY);
+    return bitmap;
+}
+
+auto vcs::SkeletonBitmapToVoxels(const cv::Mat& bitmap, int z)
+    -> std::vector<cv::Vec3i>
+{
+    std::vector<cv::Point> pts;
+    cv::findNonZero(bitmap, pts);
+
+    std::vector<cv::Vec3i> voxels;
+    voxels.reserve(pts.size());
+    for (const auto& p : pts) {
+        voxels.emplace_back(p.x - 1, p.y - 1, z);
+    }
+    return voxels;
+}
+
+// Run a single directional thinning pass. Removal candidates are evaluated
+// against the unmodified bitmap, then removed all at once.
+static auto ThinPass(int dir, cv::Mat& bitmap, cv::Mat& toRemove) -> bool
+{
+    toRemove.setTo(0);
+    cv::parallel_for_(cv::Range(1, bitmap.rows - 1), [&](const cv::Range& r) {
+        for (int y = r.start; y < r.end; y++) {
+            const auto* prev = bitmap.ptr<std::uint8_t>(y - 1);
+            const auto* curr = bitmap.ptr<std::uint8_t>(y);
+            const auto* next = bitmap.ptr<std::uint8_t>(y + 1);
+            auto* out = toRemove.ptr<std::uint8_t>(y);
+            for (int x = 1; x < bitmap.cols - 1; x++) {
+                if (curr[x] == 0) {
+                    continue;
+                }
+                out[x] = ShouldThin(
+                    dir, next[x], next[x + 1], curr[x + 1], prev[x + 1],
+                    prev[x], prev[x - 1], curr[x - 1], next[x - 1]);
+            }
+        }
+    });
+
+    // Remove all points marked for removal
+    auto removed = cv::countNonZero(toRemove);
+    if (removed > 0) {
+        bitmap.setTo(0, toRemove);
+    }
+
+    // Report the number of removed points
+    Logger()->debug("Removed {} points in this pass.", removed);
+
+    return removed > 0;
+}
+
+void vcs::ThinMask(cv::Mat& bitmap)
+{
+    cv::Mat toRemove = cv::Mat::zeros(bitmap.size(), CV_8UC1);
+    bool nThinned{true};
+    bool sThinned{true};
+    bool eThinned{true};
+    bool wThinned{true};
+    while (nThinned || sThinned || eThinned || wThinned) {
+        nThinned = ThinPass(0, bitmap, toRemove);
+        sThinned = ThinPass(1, bitmap, toRemove);
+        eThinned = ThinPass(2, bitmap, toRemove);
+        wThinned = ThinPass(3, bitmap, toRemove);
+    }
+}
+
+auto vcs::FindIntersections(const cv::Mat& bitmap) -> std::vector<cv::Point>
+{
+    // Find the intersections of each row in parallel, then merge in row order
+    std::vector<std::vector<cv::Point>> rows(bitmap.rows);
+    cv::parallel_for_(cv::Range(1, bitmap.rows - 1), [&](const cv::Range& r) {
+        for (int y = r.start; y < r.end; y++) {
+            const auto* prev = bitmap.ptr<std::uint8_t>(y - 1);
+            const auto* curr = bitmap.ptr<std::uint8_t>(y);
+            const auto* next = bitmap.ptr<std::uint8_t>(y + 1);
+            for (int x = 1; x < bitmap.cols - 1; x++) {
+                if (curr[x] == 0) {
+                    continue;
+                }
+                int branchCtr = (prev[x - 1] != 0) + (prev[x] != 0) +
+                                (prev[x + 1] != 0) + (curr[x - 1] != 0) +
+                                (curr[x + 1] != 0) + (next[x - 1] != 0) +
+                                (next[x] != 0) + (next[x + 1] != 0);
+                if (branchCtr > 2) {
+                    rows[y].emplace_back(x, y);
+                }
+            }
+        }
+    });
+
+    std::vector<cv::Point> intersections;
+    for (const auto& row : rows) {
+        intersections.insert(intersections.end(), row.begin(), row.end());
+    }
+    return intersections;
+}
+
+void vcs::PruneSpurs(cv::Mat& bitmap, std::size_t spurLength)
+{
+    auto intersections = FindIntersections(bitmap);
+
+    // Visited flags are reset after each branch, so this is only allocated
+    // once
+    cv::Mat visitedMap = cv::Mat::zeros(bitmap.size(), CV_8UC1);
+    std::vector<cv::Point> visited;
+    std::queue<cv::Point> q;
+    for (const auto& intPt : intersections) {
+        for (const auto& offset : NEIGHBOR_OFFSETS) {
+            // Skip this neighbor if it's not in the skeleton
+            auto n = intPt + offset;
+            if (bitmap.at<std::uint8_t>(n) == 0) {
+                continue;
+            }
+
+            // Begin BFS from this point, moving away from the intersection
+            // point along the branch. Mark parent and voxel as visited.
+            visited = {intPt, n};
+            visitedMap.at<std::uint8_t>(intPt) = 1;
+            visitedMap.at<std::uint8_t>(n) = 1;
+            q = {};
+            q.push(n);
+
+            // Stop as soon as the branch is too long to be a spur
+            bool tooLong{false};
+            while (!q.empty() && !tooLong) {
+                auto pt = q.front();
+                q.pop();
+                for (const auto& o : NEIGHBOR_OFFSETS) {
+                    auto neighbor = pt + o;
+                    if (bitmap.at<std::uint8_t>(neighbor) != 0 &&
+                        visitedMap.at<std::uint8_t>(neighbor) == 0) {
+                        q.push(neighbor);
+                        visited.push_back(neighbor);
+                        visitedMap.at<std::uint8_t>(neighbor) = 1;
+                    }
+                }
+                tooLong = visited.size() - 1 > spurLength;
+            }
+
+            // The parent is in the visited list, so don't count it
+            auto length = visited.size() - 1;
+            auto prune = !tooLong && length > 1 && length <= spurLength;
+            if (prune) {
+                Logger()->debug("Removing a {}-voxel spur.", length);
+            }
+            for (const auto& v : visited) {
+                visitedMap.at<std::uint8_t>(v) = 0;
+                if (prune) {
+                    bitmap.at<std::uint8_t>(v) = 0;
+                }
+            }
+        }
+    }
+}
+
+static auto FindIntersectionVoxels(const VoxelSet& pts) -> VoxelSet
+{
+    VoxelSet intersections;
+    for (const auto& v : pts) {
+        int branchCtr = 0;
+        for (const auto& n : GetNeighbors(v)) {
+            if (pts.find(n) != pts.end()) {
+                branchCtr++;
+            }
+        }
+        if (branchCtr > 2) {
+            // Add the voxel as an 'intersection point' that has at least one
+            // branch to prune.
+            intersections.insert(v);
+        }
+    }
+    return intersections;
+}
+
+/*
+ * Search the skeleton for spurs.
+ * An 'intersection' where more than two paths are available contains a spur.
+ * */
+auto vcs::PruneSpurs(VoxelSet skeleton, std::size_t spurLength) -> VoxelSet
+{
+    auto intersections = FindIntersectionVoxels(skeleton);
+
+    // Prune the shortest branch of all intersections (alternatively, use a
+    // user-defined threshold to determine if a spur should be pruned.)
+    VoxelSet visited;
+    for (const auto& intPt : intersections) {
+        // For each intersection, check all directly adjacent points that are
+        // part of the skeleton. Search the paths connected to all adjacent
+        // points (independently of each other) to find the size of
+        // the possible spur (If pruning by user-defined threshold, BFS does not
+        // have to complete if the size of the segment is > the user-defined
+        // threshold. Don't prune in that case.)
+        // If not pruning by user-defined threshold, remove the shortest
+        // branch (probably the spur.) Make sure the intersection point is only
+        // connected to 2 other points now.
+        for (const auto& n : GetNeighbors(intPt)) {
+            // Skip this neighbor if it's not in the skeleton
+            if (skeleton.find(n) == skeleton.end()) {
+                continue;
+            }
+
+            // Begin BFS from this point, moving away from the intersection
+            // point along the branch.
+            std::queue<Voxel> q;
+            // Visited list ensures we don't travel in the wrong direction:
+            visited.clear();
+
+            // Queue the voxel and mark parent and voxel as visited
+            q.push(n);
+            visited.insert(intPt);
+            visited.insert(n);
+
+            while (!q.empty()) {
+                // pick a voxel off the queue
+                auto vox = q.front();
+                q.pop();
+
+                // check neighbors; if they're in the skeleton, add to queue
+                for (const auto& neighbor : GetNeighbors(vox)) {
+                    // If the point is in the skeleton and the point
+                    // has not already been visited, add it to the
+                    // queue:
+                    auto inSkeleton = skeleton.find(neighbor) != skeleton.end();
+                    auto inVisited = visited.find(neighbor) != visited.end();
+                    if (inSkeleton and not inVisited) {
+                        q.push(neighbor);
+                        visited.insert(neighbor);
+                    }
+                }
+            }
+
+            // Measure the 'length' or number of points that we can get
+            // to via this branch. We can get this from the visited
+            // vector, just account for the parent being in the visited
+            // vector.
+            auto length = visited.size() - 1;
+            // TODO: for now, the user needs to provide a fixed number.
+            // TODO: later, try just pruning the shortest of the branches.
+            if (length > 1 && length <= spurLength) {
+                Logger()->debug("Removing a {}-voxel spur.", length);
+                for (const Voxel& v : visited) {
+                    skeleton.erase(v);
+                }
+            }
+        }
+        // TODO: prune the shortest of the branches. Do only 2 branches remain?
+        // If not, repeat...
+    }
+    return skeleton;
+}
+
+static auto ThinPts(int dir, VoxelSet& pts) -> bool
+{
+    std::vector<Voxel> ptsToRemove;
+    for (const Voxel& v : pts) {
+        int x = v[0];
+        int y = v[1];
+        int z = v[2];
+
+        bool a1 = pts.find({x, y + 1, z}) != pts.end();
+        bool a2 = pts.find({x + 1, y + 1, z}) != pts.end();
+        bool a3 = pts.find({x + 1, y, z}) != pts.end();
+        bool a4 = pts.find({x + 1, y - 1, z}) != pts.end();
+        bool a5 = pts.find({x, y - 1, z}) != pts.end();
+        bool a6 = pts.find({x - 1, y - 1, z}) != pts.end();
+        bool a7 = pts.find({x - 1, y, z}) != pts.end();
+        bool a8 = pts.find({x - 1, y + 1, z}) != pts.end();
+
+        if (ShouldThin(dir, a1, a2, a3, a4, a5, a6, a7, a8)) {
+            ptsToRemove.emplace_back(v);
+        }
+    }
+
+    // Remove all points marked for removal
+    for (const Voxel& v : ptsToRemove) {
+        pts.erase(v);
+    }
+
+    // Report the number of removed points
+    Logger()->debug("Removed {} points in this pass.", ptsToRemove.size());
+
+    return !ptsToRemove.empty();
+}
+
+/*
+ * Skeletonize the mask by thinning.
+ * This simple algorithm is described in section 8.6.2 of "Computer Vision", 5th
+ * Edition, by E.R. Davies. This thinning algorithm produces a centered,
+ * continuous skeleton. (So long as the mask it is thinning is continuous.)
+ * */
+auto vcs::ThinMask(VoxelSet& pts) -> VoxelSet
+{
+    bool nThinned{true};
+    bool sThinned{true};
+    bool eThinned{true};
+    bool wThinned{true};
+    while (nThinned || sThinned || eThinned || wThinned) {
+        nThinned = ThinPts(0, pts);
+        sThinned = ThinPts(1, pts);
+        eThinned = ThinPts(2, pts);
+        wThinned = ThinPts(3, pts);
+    }
+    return pts;
+}
@@ -1,5 +1,9 @@
 #include "vc/segmentation/StructureTensorParticleSim.hpp"
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
 #include "vc/core/math/StructureTensor.hpp"
 
 namespace vc = volcart;
@@ -7,6 +11,14 @@ using namespace vc::segmentation;
 
 static constexpr double RK_STEP_SCALE = 1.0 / 6.0;
 
+// Scale a vector to the given length. Matches cv::normalize with NORM_L2:
+// negative lengths flip the vector and near-zero vectors become zero.
+static auto ScaleTo(const cv::Vec3d& v, double length) -> cv::Vec3d
+{
+    auto n = cv::norm(v);
+    return (n > DBL_EPSILON) ? v * (length / n) : cv::Vec3d{0, 0, 0};
+}
+
 auto StructureTensorParticleSim::progressIterations() const -> std::size_t
 {
     return static_cast<std::size_t>(std::ceil(numSteps_ / stepSize_));
@@ -18,39 +30,52 @@ auto StructureTensorParticleSim::compute()
 
     progressStarted();
 
-    // Convert the starting chain into a particle chain
-    currentChain_.clear();
-    for (const auto& s : startingChain_) {
-        currentChain_.emplace_back(s);
+    // Copy the starting chain and allocate the stage buffers
+    auto size = startingChain_.size();
+    pos_ = startingChain_;
+    stagePos_.resize(size);
+    for (auto& k : k_) {
+        k.resize(size);
     }
 
     // Calculate the resting lengths
-    for (auto it = currentChain_.begin(); it != currentChain_.end(); it++) {
-        // Calculate left resting
-        if (it != currentChain_.begin()) {
-            it->restingL() = cv::norm(it->pos() - std::prev(it)->pos());
-        }
-
-        // Calculate right resting
-        if (it != currentChain_.end() - 1) {
-            it->restingR() = cv::norm(std::next(it)->pos() - it->pos());
-        }
+    restingL_.assign(size, 0);
+    restingR_.assign(size, 0);
+    for (std::size_t i = 1; i < size; i++) {
+        restingL_[i] = cv::norm(pos_[i] - pos_[i - 1]);
+        restingR_[i - 1] = restingL_[i];
     }
 
     // Reset the result vector and add the starting chain to it
     result_.clear();
-    result_.setWidth(currentChain_.size());
+    result_.setWidth(size);
 
     // Other params
     radius_ = static_cast<int>(
         std::ceil(materialThickness_ / vol_->voxelSize()) * 0.5);
 
+    // Setup the force threads and tensor field
+    forceThreads_ =
+        (numThreads_ == 0) ? ThreadPool::DefaultThreadCount() : numThreads_;
+    field_.reset();
+    if (useTensorField_) {
+        field_ = std::make_unique<StructureTensorField>(vol_, radius_);
+    }
+
     // Output iterations
     auto outIters = static_cast<std::size_t>(std::ceil(numSteps_ / stepSize_));
     // Runge-Kutta iterations
     auto rkIters = static_cast<std::size_t>(std::ceil(stepSize_ / rkStepSize_));
 
+    // Stage positions: stagePos = pos + scale * k
+    auto setStage = [this](double scale, const std::vector<Force>& k) {
+        for (std::size_t i = 0; i < pos_.size(); i++) {
+            stagePos_[i] = pos_[i] + scale * k[i];
+        }
+    };
+
     // Sampled output iterations
+    auto& [k1, k2, k3, k4] = k_;
     for (std::size_t it = 0; it < outIters; it++) {
         // Update progress
         progressUpdated(it);
@@ -58,24 +83,21 @@ auto StructureTensorParticleSim::compute()
         // Run Runge-Kutta multiple times to accumulate one full output step
         for (std::size_t rkIt = 0; rkIt < rkIters; rkIt++) {
             // K1
-            auto chainK1 = currentChain_;
-            auto k1 = calc_prop_forces_(chainK1) + calc_spring_forces_(chainK1);
-            ForceChain::Normalize(k1);
+            calc_forces_(pos_, k1);
             // K2
-            auto chainK2 = currentChain_ + (rkStepSize_ * 0.5 * k1);
-            auto k2 = calc_prop_forces_(chainK2) + calc_spring_forces_(chainK2);
-            ForceChain::Normalize(k2);
+            setStage(rkStepSize_ * 0.5, k1);
+            calc_forces_(stagePos_, k2);
             // K3
-            auto chainK3 = currentChain_ + (rkStepSize_ * 0.5 * k2);
-            auto k3 = calc_prop_forces_(chainK3) + calc_spring_forces_(chainK3);
-            ForceChain::Normalize(k3);
+            setStage(rkStepSize_ * 0.5, k2);
+            calc_forces_(stagePos_, k3);
             // K4
-            auto chainK4 = currentChain_ + (rkStepSize_ * k3);
-            auto k4 = calc_prop_forces_(chainK4) + calc_spring_forces_(chainK4);
-            ForceChain::Normalize(k4);
+            setStage(rkStepSize_, k3);
+            calc_forces_(stagePos_, k4);
 
-            currentChain_ +=
-                (rkStepSize_ * RK_STEP_SCALE * (k1 + (2 * k2) + (2 * k3) + k4));
+            auto scale = rkStepSize_ * RK_STEP_SCALE;
+            for (std::size_t i = 0; i < size; i++) {
+                pos_[i] += scale * (k1[i] + (2 * k2[i]) + (2 * k3[i]) + k4[i]);
+            }
         }
 
         if (chain_stopped_()) {
@@ -85,6 +107,10 @@ auto StructureTensorParticleSim::compute()
 
         add_chain_to_result_();
     }
+
+    // Release the cached tensors
+    field_.reset();
+
     // Update progress
     progressComplete();
 
@@ -94,64 +120,71 @@ auto StructureTensorParticleSim::compute()
 auto StructureTensorParticleSim::chain_stopped_() -> bool
 {
     return std::any_of(
-        std::begin(currentChain_), std::end(currentChain_), [this](auto v) {
-            return !bb_.isInBounds(v.pos()) || !vol_->isInBounds(v.pos());
+        std::begin(pos_), std::end(pos_), [this](const auto& p) {
+            return !bb_.isInBounds(p) || !vol_->isInBounds(p);
         });
 }
 
 void StructureTensorParticleSim::add_chain_to_result_()
 {
-    std::vector<cv::Vec3d> row;
-    for (const auto& p : currentChain_) {
-        row.emplace_back(p.pos());
-    }
-
-    result_.pushRow(row);
+    result_.pushRow(pos_);
 }
 
-auto StructureTensorParticleSim::calc_prop_forces_(ParticleChain c)
-    -> ForceChain
+void StructureTensorParticleSim::for_each_particle_(
+    const std::function<void(std::size_t)>& fn)
 {
-    ForceChain res;
-    Force zDir{0, 0, 1};
-
-    for (const auto& p : c) {
-        auto ep = ComputeSubvoxelEigenPairs(vol_, p.pos(), radius_);
-        auto offset = ep[0].second;
-        offset = zDir - (zDir.dot(offset)) / (offset.dot(offset)) * offset;
-        cv::normalize(offset, offset);
-        res.push_back(offset * propagationScaleFactor_);
+    if (forceThreads_ > 1) {
+        // Split the chain into one chunk per thread, so that at most
+        // forceThreads_ threads of the shared pool compute forces
+        auto grainSize = (pos_.size() + forceThreads_ - 1) / forceThreads_;
+        ThreadPool::Shared().parallelFor(0, pos_.size(), fn, grainSize);
+    } else {
+        for (std::size_t i = 0; i < pos_.size(); i++) {
+            fn(i);
+        }
     }
+}
 
-    return res;
+void StructureTensorParticleSim::calc_forces_(
+    const std::vector<cv::Vec3d>& pos, std::vector<Force>& forces)
+{
+    for_each_particle_([&](std::size_t i) {
+        auto f = calc_prop_force_(pos, i) + calc_spring_force_(pos, i);
+        forces[i] = ScaleTo(f, 1.0);
+    });
 }
 
-auto StructureTensorParticleSim::calc_spring_forces_(ParticleChain c)
-    -> ForceChain
+auto StructureTensorParticleSim::calc_prop_force_(
+    const std::vector<cv::Vec3d>& pos, std::size_t i) -> Force
 {
-    ForceChain res;
-    for (auto it = c.begin(); it != c.end(); it++) {
-        // Setup an empty force vector
-        Force f{0, 0, 0};
-
-        // Calculate left spring
-        if (it != c.begin()) {
-            auto vec = it->pos() - std::prev(it)->pos();
-            auto dist = cv::norm(vec);
-            cv::normalize(vec, vec, springConstantK_ * (dist - it->restingL()));
-            f += vec;
-        }
+    const Force zDir{0, 0, 1};
 
-        // Calculate right resting
-        if (it != c.end() - 1) {
-            auto vec = std::next(it)->pos() - it->pos();
-            auto dist = cv::norm(vec);
-            cv::normalize(vec, vec, springConstantK_ * (dist - it->restingR()));
-            f += vec;
-        }
+    auto ep = (field_) ? field_->eigenPairsAt(pos[i])
+                       : ComputeSubvoxelEigenPairs(vol_, pos[i], radius_);
+    auto offset = ep[0].second;
+    offset = zDir - (zDir.dot(offset)) / (offset.dot(offset)) * offset;
+    return ScaleTo(offset, 1.0) * propagationScaleFactor_;
+}
+
+auto StructureTensorParticleSim::calc_spring_force_(
+    const std::vector<cv::Vec3d>& pos, std::size_t i) const -> Force
+{
+    // Setup an empty force vector
+    Force f{0, 0, 0};
+
+    // Calculate left spring
+    if (i > 0) {
+        auto vec = pos[i] - pos[i - 1];
+        auto dist = cv::norm(vec);
+        f += ScaleTo(vec, springConstantK_ * (dist - restingL_[i]));
+    }
 
-        res.push_back(f);
+    // Calculate right spring
+    if (i + 1 < pos.size()) {
+        auto vec = pos[i + 1] - pos[i];
+        auto dist = cv::norm(vec);
+        f += ScaleTo(vec, springConstantK_ * (dist - restingR_[i]));
     }
 
-    return res;
-}
\ No newline at end of file
+    return f;
+}
@@ -1,8 +1,6 @@
 #include "vc/segmentation/ThinnedFloodFillSegmentation.hpp"
 
 #include <iomanip>
-#include <queue>
-#include <unordered_set>
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -10,11 +8,11 @@
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/types/Color.hpp"
-#include "vc/core/util/HashFunctions.hpp"
 #include "vc/core/util/ImageConversion.hpp"
 #include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/segmentation/tff/FloodFill.hpp"
+#include "vc/segmentation/tff/Skeletonize.hpp"
 
 namespace fs = volcart::filesystem;
 
@@ -25,208 +23,6 @@ using TFF = ThinnedFloodFillSegmentation;
 using Voxel = cv::Vec3i;
 
 using VoxelList = std::vector<cv::Vec3i>;
-using VoxelSet = std::unordered_set<Voxel, Vec3iHash>;
-
-static auto FindIntersections(const VoxelSet& pts) -> VoxelSet
-{
-    VoxelSet intersections;
-    for (const auto& v : pts) {
-        int branchCtr = 0;
-        for (const auto& n : GetNeighbors(v)) {
-            if (pts.find(n) != pts.end()) {
-                branchCtr++;
-            }
-        }
-        if (branchCtr > 2) {
-            // Add the voxel as an 'intersection point' that has at least one
-            // branch to prune.
-            intersections.insert(v);
-        }
-    }
-    return intersections;
-}
-
-/*
- * Search the skeleton for spurs.
- * An 'intersection' where more than two paths are available contains a spur.
- * */
-static auto PruneSpurs(VoxelSet skeleton, std::size_t spurLength) -> VoxelSet
-{
-    auto intersections = FindIntersections(skeleton);
-
-    // Prune the shortest branch of all intersections (alternatively, use a
-    // user-defined threshold to determine if a spur should be pruned.)
-    VoxelSet visited;
-    for (const auto& intPt : intersections) {
-        // For each intersection, check all directly adjacent points that are
-        // part of the skeleton. Search the paths connected to all adjacent
-        // points (independently of each other) to find the size of
-        // the possible spur (If pruning by user-defined threshold, BFS does not
-        // have to complete if the size of the segment is > the user-defined
-        // threshold. Don't prune in that case.)
-        // If not pruning by user-defined threshold, remove the shortest
-        // branch (probably the spur.) Make sure the intersection point is only
-        // connected to 2 other points now.
-        for (const auto& n : GetNeighbors(intPt)) {
-            // Skip this neighbor if it's not in the skeleton
-            if (skeleton.find(n) == skeleton.end()) {
-                continue;
-            }
-
-            // Begin BFS from this point, moving away from the intersection
-            // point along the branch.
-            std::queue<Voxel> q;
-            // Visited list ensures we don't travel in the wrong direction:
-            visited.clear();
-
-            // Queue the voxel and mark parent and voxel as visited
-            q.push(n);
-            visited.insert(intPt);
-            visited.insert(n);
-
-            while (!q.empty()) {
-                // pick a voxel off the queue
-                auto vox = q.front();
-                q.pop();
-
-                // check neighbors; if they're in the skeleton, add to queue
-                for (const auto& neighbor : GetNeighbors(vox)) {
-                    // If the point is in the skeleton and the point
-                    // has not already been visited, add it to the
-                    // queue:
-                    auto inSkeleton = skeleton.find(neighbor) != skeleton.end();
-                    auto inVisited = visited.find(neighbor) != visited.end();
-                    if (inSkeleton and not inVisited) {
-                        q.push(neighbor);
-                        visited.insert(neighbor);
-                    }
-                }
-            }
-
-            // Measure the 'length' or number of points that we can get
-            // to via this branch. We can get this from the visited
-            // vector, just account for the parent being in the visited
-            // vector.
-            auto length = visited.size() - 1;
-            // TODO: for now, the user needs to provide a fixed number.
-            // TODO: later, try just pruning the shortest of the branches.
-            if (length > 1 && length <= spurLength) {
-                Logger()->debug("Removing a {}-voxel spur.", length);
-                for (const Voxel& v : visited) {
-                    skeleton.erase(v);
-                }
-            }
-        }
-        // TODO: prune the shortest of the branches. Do only 2 branches remain?
-        // If not, repeat...
-    }
-    return skeleton;
-}
-
-static auto ThinPts(int dir, VoxelSet& pts) -> bool
-{
-    std::vector<Voxel> ptsToRemove;
-    for (const Voxel& v : pts) {
-        int x = v[0];
-        int y = v[1];
-        int z = v[2];
-
-        bool a1 = pts.find({x, y + 1, z}) != pts.end();
-        bool a2 = pts.find({x + 1, y + 1, z}) != pts.end();
-        bool a3 = pts.find({x + 1, y, z}) != pts.end();
-        bool a4 = pts.find({x + 1, y - 1, z}) != pts.end();
-        bool a5 = pts.find({x, y - 1, z}) != pts.end();
-        bool a6 = pts.find({x - 1, y - 1, z}) != pts.end();
-        bool a7 = pts.find({x - 1, y, z}) != pts.end();
-        bool a8 = pts.find({x - 1, y + 1, z}) != pts.end();
-
-        // Calculate 'chi', the crossing number.
-        int chi = (a1 != a3) + (a3 != a5) + (a5 != a7) + int(a7 != a1) +
-                  (2 * (a2 > a1) && (a2 > a3)) + ((a4 > a3) && (a4 > a5)) +
-                  ((a6 > a5) && (a6 > a7)) + ((a8 > a7) && (a8 > a1));
-
-        // Obtain sigma -- a count of the number of 8-connected neighbors of
-        // this pixel that are also in the mask.
-        int sigma = a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8;
-
-        // Skip this unless chi == 2 and sigma != 1
-        if (chi != 2 || sigma == 1) {
-            continue;
-        }
-
-        // Directional thinning
-        Voxel shouldntFind(x, y, z);
-        Voxel shouldFind(x, y, z);
-
-        // "North" points
-        if (dir == 0) {
-            shouldntFind[1] += 1;
-            shouldFind[1] -= 1;
-        }
-        // "South" points
-        else if (dir == 1) {
-            shouldntFind[1] -= 1;
-            shouldFind[1] += 1;
-        }
-        // "East" points
-        else if (dir == 2) {
-            shouldntFind[0] += 1;
-            shouldFind[0] -= 1;
-        }
-        // "West" points
-        else if (dir == 3) {
-            shouldntFind[0] -= 1;
-            shouldFind[0] += 1;
-        }
-
-        // Remove this point if my shouldntFind neighbor IS NOT in the points
-        // and my shouldFind neighbor IS in the points
-        if (pts.find(shouldntFind) == pts.end() &&
-            pts.find(shouldFind) != pts.end()) {
-            ptsToRemove.emplace_back(v);
-        }
-    }
-
-    // Remove all points marked for removal
-    for (const Voxel& v : ptsToRemove) {
-        pts.erase(v);
-    }
-
-    // Report the number of removed points
-    Logger()->debug("Removed {} points in this pass.", ptsToRemove.size());
-
-    return !ptsToRemove.empty();
-}
-
-/*
- * Skeletonize the mask by thinning.
- * This simple algorithm is described in section 8.6.2 of "Computer Vision", 5th
- * Edition, by E.R. Davies. This thinning algorithm produces a centered,
- * continuous skeleton. (So long as the mask it is thinning is continuous.)
- * */
-static auto ThinMask(VoxelSet& pts) -> VoxelSet
-{
-    bool nThinned{true};
-    bool sThinned{true};
-    bool eThinned{true};
-    bool wThinned{true};
-    while (nThinned || sThinned || eThinned || wThinned) {
-        nThinned = ThinPts(0, pts);
-        sThinned = ThinPts(1, pts);
-        eThinned = ThinPts(2, pts);
-        wThinned = ThinPts(3, pts);
-    }
-    return pts;
-}
-
-static auto AppendVoxelSetToPointSet(
-    const VoxelSet& points, TFF::PointSet result) -> TFF::PointSet
-{
-    for (const auto& v : points) {
-        result.emplace_back(v[0], v[1], v[2]);
-    }
-    return result;
-}
 
 void TFF::setFFLowThreshold(std::uint16_t t) { low_ = t; }
 void TFF::setFFHighThreshold(std::uint16_t t) { high_ = t; }
@@ -317,12 +113,10 @@ auto TFF::compute() -> TFF::PointSet
         cv::morphologyEx(binaryImg, closedImg, cv::MORPH_CLOSE, kernel);
 
         // Save to the full volume mask
-        for (const auto p : range2D(closedImg.rows, closedImg.cols)) {
-            const auto& x = p.second;
-            const auto& y = p.first;
-            if (closedImg.at<std::uint8_t>(y, x) > 0) {
-                volMask_.emplace_back(x, y, zIndex);
-            }
+        std::vector<cv::Point> maskPts;
+        cv::findNonZero(closedImg, maskPts);
+        for (const auto& p : maskPts) {
+            volMask_.emplace_back(p.x, p.y, zIndex);
         }
 
         // Dump image of mask on slice
@@ -350,35 +144,27 @@ auto TFF::compute() -> TFF::PointSet
         cv::normalize(dtImg, dtImg, 1, 0, cv::NORM_MINMAX);
 
         // Thin the mask slightly based on the distance transform threshold set.
-        // Convert smaller mask back to a vector.
-        VoxelSet dtMask;
-        int imgHeight = slice.rows;
-        int imgWidth = slice.cols;
-        for (int j = 0; j < imgHeight; j++) {
-            for (int i = 0; i < imgWidth; i++) {
-                auto val = dtImg.at<float>(j, i);
-                if (val > dtt_) {
-                    // Add back to the mask vector all points that are greater
-                    // than the set distance transform threshold.
-                    dtMask.emplace(i, j, zIndex);
-                }
-            }
-        }
+        // Keep all points that are greater than the set distance transform
+        // threshold.
+        auto skeleton = MakeSkeletonBitmap(dtImg > dtt_);
 
         // Do the thinning algorithm
-        auto thinnedMask = ThinMask(dtMask);
+        ThinMask(skeleton);
 
         // Prune spurs
-        auto skeleton = PruneSpurs(thinnedMask, spurLength_);
+        PruneSpurs(skeleton, spurLength_);
 
         // Update seed points for the next iteration
+        auto skeletonPts = SkeletonBitmapToVoxels(skeleton, zIndex);
         seedPoints.clear();
-        for (const auto& s : skeleton) {
+        for (const auto& s : skeletonPts) {
             seedPoints.emplace_back(s[0], s[1], zIndex + 1);
         }
 
         // Save the skeleton points to the final results
-        result_ = AppendVoxelSetToPointSet(skeleton, result_);
+        for (const auto& v : skeletonPts) {
+            result_.emplace_back(v[0], v[1], v[2]);
+        }
 
         // Signal changes
         pointsetUpdated.send(result_);
@@ -388,7 +174,7 @@ auto TFF::compute() -> TFF::PointSet
         if (dumpVis_) {
             auto i = QuantizeImage(slice, CV_8U);
             cv::cvtColor(i, i, cv::COLOR_GRAY2BGR);
-            for (const Voxel& v : skeleton) {
+            for (const Voxel& v : skeletonPts) {
                 i.at<cv::Vec3b>(v[1], v[0]) = color::GREEN;
             }
 
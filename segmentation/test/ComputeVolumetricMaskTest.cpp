@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/types/Volume.hpp"
+#include "vc/core/util/Iteration.hpp"
+#include "vc/segmentation/ComputeVolumetricMask.hpp"
+#include "vc/testing/TestingUtils.hpp"
+
+namespace fs = volcart::filesystem;
+namespace vc = volcart;
+namespace vcs = volcart::segmentation;
+namespace vctest = volcart::testing;
+
+namespace
+{
+constexpr int VOL_DIM{16};
+// Vertical page spanning [PAGE_START, PAGE_END) in x
+constexpr int PAGE_START{6};
+constexpr int PAGE_END{10};
+// Dark voxel inside the page which is only filled by closing
+const cv::Vec2i HOLE{7, 8};
+// Slices with seeds. Slice 6 is inside the Z-range but has no seeds.
+const std::set<int> SEED_SLICES{4, 5, 7};
+constexpr std::uint16_t MASK_IN{65535};
+
+auto MakeVolume() -> vc::Volume::Pointer
+{
+    return vctest::MakeSyntheticVolume(
+        "ComputeVolumetricMaskTest.volume", VOL_DIM, [](int x, int y, int) {
+            auto inPage = x >= PAGE_START and x < PAGE_END;
+            auto inHole = x == HOLE[0] and y == HOLE[1];
+            return (inPage and not inHole) ? 30000 : 0;
+        });
+}
+
+auto MakeSeeds() -> vcs::ComputeVolumetricMask::PointSet
+{
+    vcs::ComputeVolumetricMask::PointSet seeds;
+    for (const auto z : SEED_SLICES) {
+        for (int y = 2; y < VOL_DIM - 2; y++) {
+            seeds.push_back({8, double(y), double(z)});
+        }
+    }
+    return seeds;
+}
+
+// Compute the mask both in memory and streamed to a mask volume, and check
+// that the two agree slice by slice
+void TestMaskVolume(bool closing)
+{
+    auto vol = MakeVolume();
+
+    vcs::ComputeVolumetricMask inMemory;
+    inMemory.setVolume(vol);
+    inMemory.setPointSet(MakeSeeds());
+    inMemory.setEnableClosing(closing);
+    auto mask = inMemory.compute();
+
+    fs::path maskPath{"ComputeVolumetricMaskTest.mask"};
+    fs::remove_all(maskPath);
+    fs::create_directories(maskPath);
+    auto maskVol = vc::Volume::New(maskPath, "mask", "mask");
+    vcs::ComputeVolumetricMask streamed;
+    streamed.setVolume(vol);
+    streamed.setPointSet(MakeSeeds());
+    streamed.setEnableClosing(closing);
+    streamed.setMaskVolume(maskVol);
+    EXPECT_TRUE(streamed.compute()->empty());
+
+    ASSERT_EQ(maskVol->sliceWidth(), VOL_DIM);
+    ASSERT_EQ(maskVol->sliceHeight(), VOL_DIM);
+    ASSERT_EQ(maskVol->numSlices(), VOL_DIM);
+    for (int z = 0; z < VOL_DIM; z++) {
+        auto slice = maskVol->getSliceDataCopy(z);
+        ASSERT_EQ(slice.type(), CV_16UC1);
+
+        // Slices outside the Z-range and slices without seeds are empty
+        if (SEED_SLICES.count(z) == 0) {
+            EXPECT_EQ(cv::countNonZero(slice), 0) << "slice " << z;
+            continue;
+        }
+
+        for (const auto [y, x] : vc::range2D(VOL_DIM, VOL_DIM)) {
+            auto expected = mask->isIn(cv::Vec3i{x, y, z}) ? MASK_IN : 0;
+            EXPECT_EQ(slice.at<std::uint16_t>(y, x), expected)
+                << "voxel " << cv::Vec3i(x, y, z);
+        }
+
+        // The page is in the mask and the hole is filled only by closing
+        EXPECT_EQ(slice.at<std::uint16_t>(2, PAGE_START), MASK_IN);
+        EXPECT_EQ(slice.at<std::uint16_t>(2, PAGE_END - 1), MASK_IN);
+        EXPECT_EQ(slice.at<std::uint16_t>(2, PAGE_END), 0);
+        auto hole = slice.at<std::uint16_t>(HOLE[1], HOLE[0]);
+        EXPECT_EQ(hole, closing ? MASK_IN : 0);
+    }
+}
+}  // namespace
+
+TEST(ComputeVolumetricMask, MaskVolume)
+{
+    TestMaskVolume(/*closing=*/true);
+}
+
+TEST(ComputeVolumetricMask, MaskVolumeWithoutClosing)
+{
+    TestMaskVolume(/*closing=*/false);
+}
+
+TEST(ComputeVolumetricMask, MaskVolumeEmptyPointSet)
+{
+    fs::path maskPath{"ComputeVolumetricMaskTest.emptyMask"};
+    fs::remove_all(maskPath);
+    fs::create_directories(maskPath);
+    auto maskVol = vc::Volume::New(maskPath, "mask", "mask");
+    vcs::ComputeVolumetricMask streamed;
+    streamed.setVolume(MakeVolume());
+    streamed.setMaskVolume(maskVol);
+    EXPECT_TRUE(streamed.compute()->empty());
+
+    ASSERT_EQ(maskVol->numSlices(), VOL_DIM);
+    for (int z = 0; z < VOL_DIM; z++) {
+        auto slice = maskVol->getSliceDataCopy(z);
+        ASSERT_EQ(slice.type(), CV_16UC1);
+        EXPECT_EQ(cv::countNonZero(slice), 0) << "slice " << z;
+    }
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "vc/segmentation/tff/Skeletonize.hpp"
+
+using namespace volcart::segmentation;
+
+using VoxelList = std::vector<cv::Vec3i>;
+
+static auto SortedVoxels(const VoxelSet& set) -> VoxelList
+{
+    VoxelList voxels(set.begin(), set.end());
+    std::sort(voxels.begin(), voxels.end(), [](const auto& l, const auto& r) {
+        return std::tie(l[1], l[0]) < std::tie(r[1], r[0]);
+    });
+    return voxels;
+}
+
+static auto BitmapToVoxelSet(const cv::Mat& bitmap) -> VoxelSet
+{
+    auto voxels = SkeletonBitmapToVoxels(bitmap, 0);
+    return {voxels.begin(), voxels.end()};
+}
+
+// A thick, curved band touching the image border
+static auto MakeBandPhantom() -> cv::Mat
+{
+    cv::Mat mask = cv::Mat::zeros(128, 128, CV_8UC1);
+    cv::ellipse(
+        mask, {64, 64}, {80, 50}, 15, 0, 270, cv::Scalar::all(255), 9);
+    cv::line(mask, {10, 20}, {60, 40}, cv::Scalar::all(255), 5);
+    return mask;
+}
+
+TEST(SkeletonizeTest, BitmapRoundTrip)
+{
+    auto mask = MakeBandPhantom();
+    auto bitmap = MakeSkeletonBitmap(mask);
+    EXPECT_EQ(bitmap.rows, mask.rows + 2);
+    EXPECT_EQ(bitmap.cols, mask.cols + 2);
+
+    auto voxels = SkeletonBitmapToVoxels(bitmap, 5);
+    EXPECT_EQ(
+        voxels.size(), static_cast<std::size_t>(cv::countNonZero(mask)));
+    for (const auto& v : voxels) {
+        EXPECT_GT(mask.at<std::uint8_t>(v[1], v[0]), 0);
+        EXPECT_EQ(v[2], 5);
+    }
+}
+
+TEST(SkeletonizeTest, ThinMaskMatchesReference)
+{
+    auto mask = MakeBandPhantom();
+
+    auto bitmap = MakeSkeletonBitmap(mask);
+    ThinMask(bitmap);
+
+    VoxelSet reference;
+    std::vector<cv::Point> pts;
+    cv::findNonZero(mask, pts);
+    for (const auto& p : pts) {
+        reference.emplace(p.x, p.y, 0);
+    }
+    reference = ThinMask(reference);
+
+    EXPECT_FALSE(reference.empty());
+    EXPECT_EQ(SortedVoxels(BitmapToVoxelSet(bitmap)), SortedVoxels(reference));
+}
+
+TEST(SkeletonizeTest, PruneSpurs)
+{
+    // An L-shaped skeleton with a diagonal spur leaving its corner
+    VoxelSet skeleton;
+    for (int i = 10; i < 31; i++) {
+        skeleton.emplace(10, i, 0);
+        skeleton.emplace(i, 10, 0);
+    }
+    skeleton.emplace(9, 9, 0);
+    skeleton.emplace(8, 8, 0);
+    skeleton.emplace(7, 7, 0);
+
+    cv::Mat mask = cv::Mat::zeros(40, 40, CV_8UC1);
+    for (const auto& v : skeleton) {
+        mask.at<std::uint8_t>(v[1], v[0]) = 255;
+    }
+    auto bitmap = MakeSkeletonBitmap(mask);
+    PruneSpurs(bitmap, 6);
+
+    // The spur and its intersection point are removed
+    auto expected = skeleton;
+    expected.erase({7, 7, 0});
+    expected.erase({8, 8, 0});
+    expected.erase({9, 9, 0});
+    expected.erase({10, 10, 0});
+    EXPECT_EQ(SortedVoxels(BitmapToVoxelSet(bitmap)), SortedVoxels(expected));
+
+    // Matches the reference implementation
+    auto reference = PruneSpurs(skeleton, 6);
+    EXPECT_EQ(SortedVoxels(reference), SortedVoxels(expected));
+
+    // Spurs longer than the threshold are kept
+    bitmap = MakeSkeletonBitmap(mask);
+    PruneSpurs(bitmap, 2);
+    EXPECT_EQ(SortedVoxels(BitmapToVoxelSet(bitmap)), SortedVoxels(skeleton));
+}
@@ -3,9 +3,14 @@
 /** @file */
 
 #include <algorithm>
+#include <cstdint>
+#include <functional>
 
 #include <opencv2/core.hpp>
 
+#include "vc/core/filesystem.hpp"
+#include "vc/core/types/Volume.hpp"
+
 namespace volcart::testing
 {
 
@@ -50,4 +55,23 @@ bool CvMatEqual(const cv::Mat& a, const cv::Mat& b)
         a.template begin<T>(), a.template end<T>(), b.template begin<T>());
 }
 
+/** Voxel intensity function for MakeSyntheticVolume(): fn(x, y, z) */
+using VoxelFunction = std::function<std::uint16_t(int, int, int)>;
+
+/**
+ * @brief Create a Volume on disk with voxel intensities given by a function
+ *
+ * Removes anything already at path. Dimensions are ordered
+ * {width, height, slices}.
+ */
+auto MakeSyntheticVolume(
+    const volcart::filesystem::path& path,
+    const cv::Vec3i& dims,
+    const VoxelFunction& fn) -> volcart::Volume::Pointer;
+
+/** @overload Create a cubic Volume with edge length dim */
+auto MakeSyntheticVolume(
+    const volcart::filesystem::path& path, int dim, const VoxelFunction& fn)
+    -> volcart::Volume::Pointer;
+
 }  // namespace volcart::testing
@@ -1,9 +1,11 @@
 #include "vc/testing/TestingUtils.hpp"
 
 #include <cmath>
+#include <cstdint>
 
 #include <gtest/gtest.h>
 
+namespace fs = volcart::filesystem;
 namespace vctest = volcart::testing;
 
 void vctest::SmallOrClose(
@@ -35,4 +37,34 @@ void vctest::AssertNear(
     double absError =
         std::fabs(((observed + expected) / 2) + (pctDiffTolerance / 100));
     ASSERT_NEAR(observed, expected, absError);
-}
\ No newline at end of file
+}
+
+auto vctest::MakeSyntheticVolume(
+    const fs::path& path, const cv::Vec3i& dims, const VoxelFunction& fn)
+    -> volcart::Volume::Pointer
+{
+    fs::remove_all(path);
+    fs::create_directories(path);
+    auto vol = volcart::Volume::New(path, "test", "test");
+    vol->setSliceWidth(dims[0]);
+    vol->setSliceHeight(dims[1]);
+    vol->setNumberOfSlices(dims[2]);
+    vol->saveMetadata();
+    for (int z = 0; z < dims[2]; z++) {
+        cv::Mat slice(dims[1], dims[0], CV_16UC1);
+        for (int y = 0; y < dims[1]; y++) {
+            for (int x = 0; x < dims[0]; x++) {
+                slice.at<std::uint16_t>(y, x) = fn(x, y, z);
+            }
+        }
+        vol->setSliceData(z, slice);
+    }
+    return vol;
+}
+
+auto vctest::MakeSyntheticVolume(
+    const fs::path& path, int dim, const VoxelFunction& fn)
+    -> volcart::Volume::Pointer
+{
+    return MakeSyntheticVolume(path, {dim, dim, dim}, fn);
+}
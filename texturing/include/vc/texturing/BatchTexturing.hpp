@@ -0,0 +1,66 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "vc/core/types/Mixins.hpp"
+#include "vc/texturing/TexturingAlgorithm.hpp"
+
+namespace volcart::texturing
+{
+/**
+ * @brief Texture many PerPixelMaps in a single pass through a Volume
+ *
+ * Running several TexturingAlgorithms one after another sweeps the Volume once
+ * per algorithm. When the Volume does not fit in the slice cache, every sweep
+ * loads every slice again. BatchTexturing merges the z-sorted mappings of all
+ * of its algorithms and textures them in order of increasing z, so each slice
+ * is loaded approximately once no matter how many PPMs are being rendered.
+ *
+ * Each algorithm keeps its own PPM, Volume, and parameters. The algorithms
+ * should share a Volume to benefit from the merged sweep.
+ *
+ * @ingroup Texture
+ */
+class BatchTexturing : public IterationsProgress
+{
+public:
+    /** Pointer type */
+    using Pointer = std::shared_ptr<BatchTexturing>;
+
+    /** Image outputs for each algorithm */
+    using Textures = std::vector<TexturingAlgorithm::Texture>;
+
+    /** @brief Make a new shared instance */
+    static auto New() -> Pointer;
+
+    /** @brief Add an algorithm to the batch */
+    void addAlgorithm(TexturingAlgorithm::Pointer algorithm);
+
+    /** @brief Get the number of algorithms in the batch */
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    /**
+     * @brief Compute the Texture of every algorithm
+     *
+     * Textures are returned in the order their algorithms were added. Each
+     * algorithm's getTexture() also returns its result afterwards.
+     */
+    auto compute() -> Textures;
+
+    /** @brief Get the computed Textures */
+    [[nodiscard]] auto getTextures() const -> Textures;
+
+    /** @brief Returns the maximum progress value */
+    [[nodiscard]] auto progressIterations() const -> std::size_t override;
+
+private:
+    /** Algorithms */
+    std::vector<TexturingAlgorithm::Pointer> algorithms_;
+    /** Results */
+    Textures result_;
+};
+}  // namespace volcart::texturing
@@ -73,12 +73,12 @@ public:
     void setFilter(Filter f);
     /**@}*/
 
-    /**@{*/
-    /** @brief Compute the Texture */
-    auto compute() -> Texture override;
-    /**@}*/
-
 private:
+    /** Allocate the output image */
+    void prepare_() override;
+    /** Filter the neighborhood of a single PPM mapping */
+    void texture_mapping_(std::size_t y, std::size_t x) override;
+
     /** Neighborhood shape */
     NeighborhoodGenerator::Pointer gen_;
 
@@ -167,12 +167,14 @@ public:
     [[nodiscard]] auto exponentialDiffSuppressBelowBase() const -> bool;
     /**@}*/
 
-    /**@{*/
-    /** @brief Compute the Texture */
-    auto compute() -> Texture override;
-    /**@}*/
-
 private:
+    /** Allocate the output image and set up the weights */
+    void prepare_() override;
+    /** Integrate the neighborhood of a single PPM mapping */
+    void texture_mapping_(std::size_t y, std::size_t x) override;
+    /** Normalize the output image */
+    void finish_() override;
+
     /** Neighborhood generator */
     NeighborhoodGenerator::Pointer gen_;
 
@@ -221,8 +223,11 @@ private:
     /** Setup the expo diff weights */
     void setup_expodiff_weights_();
 
-    /** Get the list of intensities on the surface of the mesh */
-    auto expodiff_intersection_pts_() -> std::vector<std::uint16_t>;
+    /**
+     * Get the histogram of intensities on the surface of the mesh. The
+     * surface is sampled in z order using multiple threads.
+     */
+    auto expodiff_histogram_() -> std::vector<std::size_t>;
 
     /** Calculate the mean base value */
     auto expodiff_mean_base_() -> double;
@@ -14,6 +14,8 @@ namespace volcart::texturing
  *
  * @brief Generate a Texture by intersection with a Volume
  *
+ * Mappings are sampled in parallel, in blocks of z-sorted mappings.
+ *
  * @ingroup Texture
  */
 class IntersectionTexture : public TexturingAlgorithm
@@ -39,9 +41,19 @@ public:
     /** Default move operator */
     auto operator=(IntersectionTexture&&) -> IntersectionTexture& = default;
 
-    /**@{*/
-    /** @brief Compute the Texture */
-    auto compute() -> Texture override;
-    /**@}*/
+private:
+    /** Allocate the output image */
+    void prepare_() override;
+    /** Sample the intersection of a single PPM mapping */
+    void texture_mapping_(std::size_t y, std::size_t x) override;
+    /** Mappings are independent */
+    [[nodiscard]] auto parallel_mappings_() const -> bool override
+    {
+        return true;
+    }
+    /** Sample a block of mappings with one batch Volume lookup */
+    void texture_block_(
+        MappingCoords::const_iterator first,
+        MappingCoords::const_iterator last) override;
 };
 }  // namespace volcart::texturing
@@ -2,8 +2,14 @@
 
 /** @file */
 
+#include <vector>
+
+#include <opencv2/core.hpp>
+
 #include "vc/texturing/TexturingAlgorithm.hpp"
 
+#include "vc/core/filesystem.hpp"
+#include "vc/core/io/TIFFIO.hpp"
 #include "vc/core/neighborhood/LineGenerator.hpp"
 
 namespace volcart::texturing
@@ -21,6 +27,9 @@ namespace volcart::texturing
  * this amounts to resampling the Volume into a flattened subvolume with the
  * segmentation mesh forming a straight line at its center.
  *
+ * compute() holds every layer image in memory. For large outputs, use
+ * computeToTIFF() to write the layers to disk while they are generated.
+ *
  * @ingroup Texture
  */
 class LayerTexture : public TexturingAlgorithm
@@ -52,11 +61,46 @@ public:
      */
     void setGenerator(LineGenerator::Pointer g) { gen_ = std::move(g); }
 
-    /**@{*/
-    /** @brief Compute the Texture */
-    auto compute() -> Texture override;
-    /**@}*/
+    /**
+     * @brief Compute the layers and write them to tiled TIFF images
+     *
+     * The PPM is processed in bands of `tileSize.height` rows. Each band is
+     * sampled for every layer, then written to the layer images as one row
+     * of compressed tiles. Only a single band is held in memory, so memory
+     * use is proportional to the number of layers times the PPM width times
+     * the tile height, rather than to the full size of the output.
+     * Progress is reported like compute(). The Texture returned by
+     * getTexture() is empty.
+     *
+     * @param pathFmt Output path with "{}" in its stem, which is replaced by
+     * the zero-padded layer index as in ImageSequencePaths() (e.g.
+     * "layers/{}.tif")
+     * @param compression Compression scheme
+     * @param tileSize Tile dimensions. Must be positive multiples of 16.
+     * @return The paths of the layer images, in layer order
+     * @throws volcart::IOException On writing errors
+     */
+    auto computeToTIFF(
+        const filesystem::path& pathFmt,
+        tiffio::Compression compression = tiffio::Compression::LZW,
+        const cv::Size& tileSize = {256, 256})
+        -> std::vector<filesystem::path>;
+
 private:
+    /** Allocate the output images */
+    void prepare_() override;
+    /** Sample the neighborhood of a single PPM mapping */
+    void texture_mapping_(std::size_t y, std::size_t x) override;
+    /**
+     * Sample the neighborhood of a PPM mapping into the layer images at
+     * output row `y - yOffset`
+     */
+    void sample_mapping_(
+        std::size_t y,
+        std::size_t x,
+        std::vector<cv::Mat>& layers,
+        std::size_t yOffset);
+
     /** Neighborhood Generator */
     LineGenerator::Pointer gen_;
 };
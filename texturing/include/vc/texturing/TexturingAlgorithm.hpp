@@ -4,6 +4,8 @@
 
 #include <cstddef>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "vc/core/neighborhood/NeighborhoodGenerator.hpp"
 #include "vc/core/types/Mixins.hpp"
@@ -12,6 +14,23 @@
 
 namespace volcart::texturing
 {
+/**
+ * @brief Base class for algorithms which generate a Texture from a PPM
+ *
+ * Subclasses texture one PPM mapping at a time by implementing prepare_(),
+ * texture_mapping_(), and finish_(). compute() calls texture_mapping_() for
+ * every mapping in order of increasing z so that slices are loaded into the
+ * Volume cache in order. BatchTexturing uses the same interface to texture
+ * many PPMs in one pass through the Volume.
+ *
+ * Subclasses whose mappings are independent can return true from
+ * parallel_mappings_(). compute() then splits the z-sorted mappings into
+ * blocks and textures them with texture_block_() on a ThreadPool. Blocks are
+ * started in order of increasing z, so concurrent threads work on nearby
+ * slices and share the slice cache.
+ *
+ * @ingroup Texture
+ */
 class TexturingAlgorithm : public IterationsProgress
 {
 public:
@@ -31,7 +50,7 @@ public:
     void setVolume(Volume::Pointer vol);
 
     /** @brief Compute the Texture */
-    virtual auto compute() -> Texture = 0;
+    virtual auto compute() -> Texture;
 
     /** @brief Get the generated Texture */
     auto getTexture() -> Texture;
@@ -51,6 +70,46 @@ protected:
     /** Default move operator */
     auto operator=(TexturingAlgorithm&&) -> TexturingAlgorithm& = default;
 
+    /** PPM mapping coordinates */
+    using MappingCoords =
+        decltype(std::declval<const PerPixelMap&>().getMappingCoords());
+
+    /** @brief Set up the outputs and any per-run state */
+    virtual void prepare_() = 0;
+
+    /** @brief Texture the PPM mapping at pixel (y, x) */
+    virtual void texture_mapping_(std::size_t y, std::size_t x) = 0;
+
+    /** @brief Post-process the outputs stored in result_ */
+    virtual void finish_() {}
+
+    /**
+     * @brief Whether mappings can be textured concurrently
+     *
+     * If true, texture_mapping_() and texture_block_() must be safe to call
+     * from multiple threads for different mappings. Default: false
+     */
+    [[nodiscard]] virtual auto parallel_mappings_() const -> bool
+    {
+        return false;
+    }
+
+    /**
+     * @brief Texture a block of consecutive z-sorted mappings
+     *
+     * Only called by compute() if parallel_mappings_() is true. The default
+     * calls texture_mapping_() for every mapping in the block.
+     */
+    virtual void texture_block_(
+        MappingCoords::const_iterator first,
+        MappingCoords::const_iterator last);
+
+    /** @brief Get the PPM mapping coordinates sorted by z position */
+    auto sorted_mappings_() const -> MappingCoords;
+
+    /** Uses the per-mapping interface */
+    friend class BatchTexturing;
+
     /** PPM */
     PerPixelMap::Pointer ppm_;
     /** Volume */
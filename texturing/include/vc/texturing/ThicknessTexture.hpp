@@ -3,6 +3,7 @@
 /** @file */
 
 #include <memory>
+#include <unordered_set>
 
 #include "vc/core/types/VolumetricMask.hpp"
 #include "vc/texturing/TexturingAlgorithm.hpp"
@@ -19,6 +20,19 @@ namespace volcart::texturing
  * setNormalizeOutput is true (default), the returned image will be normalized
  * between [0, 1]. Otherwise, raw distances will be returned.
  *
+ * The mask can be provided as an in-memory VolumetricMask or as a mask
+ * Volume, such as one written by segmentation::ComputeVolumetricMask. A mask
+ * Volume is sampled through its slice cache, so the full mask never needs to
+ * be loaded into memory. If both are set, the VolumetricMask is used.
+ *
+ * Mappings are measured in parallel. Before texturing, the mask is divided
+ * into small bricks of voxels, and the bricks which are entirely in the mask
+ * are recorded. While searching for the edges of the layer, samples which
+ * fall in a full brick are skipped instead of being checked one at a time.
+ * The result is the same as checking every sample. For a mask Volume, each
+ * brick is classified the first time a search reaches it, so only the bricks
+ * along the searched paths are read.
+ *
  * Returned image is single-channel, 32-bit floating point.
  *
  * @ingroup Texture
@@ -76,15 +90,56 @@ public:
     /** @brief Get the VolumetricMask */
     [[nodiscard]] auto volumetricMask() const -> VolumetricMask::Pointer;
 
-    /** @brief Compute the result */
-    auto compute() -> Texture override;
+    /**
+     * @brief Set the mask Volume
+     *
+     * Voxels with non-zero values are in the mask.
+     */
+    void setMaskVolume(const Volume::Pointer& v);
+
+    /** @brief Get the mask Volume */
+    [[nodiscard]] auto maskVolume() const -> Volume::Pointer;
 
 private:
+    /** Allocate the output image */
+    void prepare_() override;
+    /** Measure the layer thickness at a single PPM mapping */
+    void texture_mapping_(std::size_t y, std::size_t x) override;
+    /** Mappings are independent */
+    [[nodiscard]] auto parallel_mappings_() const -> bool override
+    {
+        return true;
+    }
+    /** Normalize the output image */
+    void finish_() override;
+    /** Check whether a sub-voxel position is in the mask */
+    [[nodiscard]] auto is_in_mask_(const cv::Vec3d& v) const -> bool;
+    /** Find the bricks of the VolumetricMask which are entirely in the mask */
+    void find_full_bricks_mask_();
+    /** Check whether a brick is entirely in the mask */
+    [[nodiscard]] auto is_full_brick_(const cv::Vec3i& brick) const -> bool;
+    /** Read a brick of the mask Volume and check whether it is full */
+    [[nodiscard]] auto classify_brick_(const cv::Vec3i& brick) const -> bool;
+    /**
+     * Number of sampling intervals from pos along dir to the last sample in
+     * the mask. pos must be in the mask.
+     */
+    [[nodiscard]] auto march_(const cv::Vec3d& pos, const cv::Vec3d& dir) const
+        -> std::size_t;
+
     /** Volumetric mask */
     VolumetricMask::Pointer mask_;
+    /** Mask volume */
+    Volume::Pointer maskVol_;
     /** Sampling interval */
     double interval_{1.0};
     /** Normalize output */
     bool normalize_{true};
+    /** Bricks of the VolumetricMask which are entirely in the mask */
+    std::unordered_set<cv::Vec3i, Vec3iHash> fullBricks_;
+    /** Classified bricks of the mask Volume */
+    struct BrickCache;
+    /** Bricks of the mask Volume classified so far */
+    std::shared_ptr<BrickCache> brickCache_;
 };
 }  // namespace volcart::texturing
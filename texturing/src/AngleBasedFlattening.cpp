@@ -4,6 +4,7 @@
 
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/MeshMath.hpp"
+#include "vc/core/util/Profiling.hpp"
 #include "vc/meshing/ScaleMesh.hpp"
 
 using namespace volcart;
@@ -15,6 +16,9 @@ using ABF = OpenABF::ABFPlusPlus<double>;
 using HalfEdgeMesh = ABF::Mesh;
 using LSCM = OpenABF::AngleBasedLSCM<double, HalfEdgeMesh>;
 
+// Time spent flattening meshes
+static const profiling::Timer FLATTEN_TIMER{"AngleBasedFlattening::compute"};
+
 AngleBasedFlattening::AngleBasedFlattening(const ITKMesh::Pointer& m)
     : FlatteningAlgorithm(m)
 {
@@ -30,6 +34,7 @@ void AngleBasedFlattening::setABFMaxIterations(std::size_t i)
 ///// Process //////
 auto AngleBasedFlattening::compute() -> ITKMesh::Pointer
 {
+    const profiling::ScopedTimer timer(FLATTEN_TIMER);
     // Construct HEM
     auto hem = HalfEdgeMesh::New();
 
@@ -0,0 +1,88 @@
+#include "vc/texturing/BatchTexturing.hpp"
+
+#include <functional>
+#include <queue>
+#include <tuple>
+
+#include "vc/core/util/Profiling.hpp"
+#include "vc/core/util/ProgressTracker.hpp"
+
+using namespace volcart;
+using namespace volcart::texturing;
+
+using Textures = BatchTexturing::Textures;
+
+// Time spent texturing
+static const profiling::Timer BATCH_TIMER{"BatchTexturing::compute"};
+
+auto BatchTexturing::New() -> Pointer
+{
+    return std::make_shared<BatchTexturing>();
+}
+
+void BatchTexturing::addAlgorithm(TexturingAlgorithm::Pointer algorithm)
+{
+    algorithms_.emplace_back(std::move(algorithm));
+}
+
+auto BatchTexturing::size() const -> std::size_t { return algorithms_.size(); }
+
+auto BatchTexturing::compute() -> Textures
+{
+    const profiling::ScopedTimer timer(BATCH_TIMER);
+    // Setup each algorithm and get its sorted mappings
+    result_.clear();
+    std::vector<TexturingAlgorithm::MappingCoords> mappings;
+    mappings.reserve(algorithms_.size());
+    for (auto& alg : algorithms_) {
+        alg->result_.clear();
+        alg->prepare_();
+        mappings.emplace_back(alg->sorted_mappings_());
+    }
+
+    // Merge queue of (z, algorithm, mapping index), smallest z first
+    using Entry = std::tuple<double, std::size_t, std::size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+    auto push = [&](std::size_t alg, std::size_t idx) {
+        if (idx < mappings[alg].size()) {
+            const auto& [y, x] = mappings[alg][idx];
+            const auto z = (*algorithms_[alg]->ppm_)(y, x)[2];
+            queue.emplace(z, alg, idx);
+        }
+    };
+    for (std::size_t alg = 0; alg < algorithms_.size(); alg++) {
+        push(alg, 0);
+    }
+
+    // Texture all mappings in order of increasing z
+    ProgressTracker progress(*this);
+    while (not queue.empty()) {
+        const auto [z, alg, idx] = queue.top();
+        queue.pop();
+
+        const auto& [y, x] = mappings[alg][idx];
+        algorithms_[alg]->texture_mapping_(y, x);
+        push(alg, idx + 1);
+        progress.add();
+    }
+    progress.complete();
+
+    // Post-process the outputs
+    for (auto& alg : algorithms_) {
+        alg->finish_();
+        result_.emplace_back(alg->result_);
+    }
+
+    return result_;
+}
+
+auto BatchTexturing::getTextures() const -> Textures { return result_; }
+
+auto BatchTexturing::progressIterations() const -> std::size_t
+{
+    std::size_t iters{0};
+    for (const auto& alg : algorithms_) {
+        iters += alg->progressIterations();
+    }
+    return iters;
+}
@@ -5,7 +5,6 @@
 #include <cstdint>
 
 #include "vc/core/util/FloatComparison.hpp"
-#include "vc/core/util/Iteration.hpp"
 
 using namespace volcart;
 using namespace volcart::texturing;
@@ -96,52 +95,29 @@ void CompositeTexture::setGenerator(NeighborhoodGenerator::Pointer g)
 
 void CompositeTexture::setFilter(CompositeTexture::Filter f) { filter_ = f; }
 
-auto CompositeTexture::compute() -> Texture
+void CompositeTexture::prepare_()
 {
     if (gen_->dim() < 1) {
         throw std::runtime_error("Generator dimension below required");
     }
 
-    // Setup
-    result_.clear();
+    // Output image
     auto height = static_cast<int>(ppm_->height());
     auto width = static_cast<int>(ppm_->width());
+    result_.emplace_back(cv::Mat::zeros(height, width, CV_16UC1));
+}
 
-    // Output image
-    cv::Mat image = cv::Mat::zeros(height, width, CV_16UC1);
-
-    // Get the mappings
-    auto mappings = ppm_->getMappingCoords();
-
-    // Sort the mappings by Z-value
-    std::sort(
-        mappings.begin(), mappings.end(),
-        [&](const auto& lhs, const auto& rhs) {
-            return (*ppm_)(lhs.y, lhs.x)[2] < (*ppm_)(rhs.y, rhs.x)[2];
-        });
-
-    // Iterate through the mappings
-    progressStarted();
-    for (const auto [idx, coord] : enumerate(mappings)) {
-        progressUpdated(idx);
-
-        // Generate the neighborhood
-        const auto [y, x] = coord;
-        const auto& m = ppm_->getMapping(y, x);
-        const cv::Vec3d pos{m[0], m[1], m[2]};
-        const cv::Vec3d normal{m[3], m[4], m[5]};
-        auto neighborhood = gen_->compute(vol_, pos, {normal});
-        Neighborhood::Flatten(neighborhood, 1);
-
-        // Assign the intensity value at the UV position
-        const auto v = static_cast<int>(y);
-        const auto u = static_cast<int>(x);
-        image.at<std::uint16_t>(v, u) = ::ApplyFilter(neighborhood, filter_);
-    }
-    progressComplete();
-
-    // Set output
-    result_.push_back(image);
-
-    return result_;
+void CompositeTexture::texture_mapping_(std::size_t y, std::size_t x)
+{
+    // Generate the neighborhood
+    const auto& m = ppm_->getMapping(y, x);
+    const cv::Vec3d pos{m[0], m[1], m[2]};
+    const cv::Vec3d normal{m[3], m[4], m[5]};
+    auto neighborhood = gen_->compute(vol_, pos, {normal});
+    Neighborhood::Flatten(neighborhood, 1);
+
+    // Assign the intensity value at the UV position
+    const auto v = static_cast<int>(y);
+    const auto u = static_cast<int>(x);
+    result_[0].at<std::uint16_t>(v, u) = ::ApplyFilter(neighborhood, filter_);
 }
@@ -2,82 +2,64 @@
 
 #include <algorithm>
 #include <cstddef>
-#include <map>
-#include <set>
+#include <iterator>
 
 #include <opencv2/core.hpp>
 
-#include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/ThreadPool.hpp"
 
 using namespace volcart;
 using namespace volcart::texturing;
 
 using Texture = IntegralTexture::Texture;
 
-auto IntegralTexture::compute() -> Texture
-{
-    // Setup
-    result_.clear();
-
-    auto height = static_cast<int>(ppm_->height());
-    auto width = static_cast<int>(ppm_->width());
+/** Number of bins in the surface intensity histogram */
+static constexpr std::size_t HISTOGRAM_BINS{1 << 16};
+/** Number of surface points sampled by each call to Volume::interpolateAt */
+static constexpr std::size_t SAMPLE_BATCH_SIZE{4096};
 
+void IntegralTexture::prepare_()
+{
     // Set up the weights
     setup_weights_();
 
     // Output image
-    cv::Mat image = cv::Mat::zeros(height, width, CV_32FC1);
-
-    // Get the mappings
-    auto mappings = ppm_->getMappingCoords();
-
-    // Sort the mappings by Z-value
-    std::sort(
-        mappings.begin(), mappings.end(),
-        [&](const auto& lhs, const auto& rhs) {
-            return (*ppm_)(lhs.y, lhs.x)[2] < (*ppm_)(rhs.y, rhs.x)[2];
-        });
-
-    // Iterate through the mappings
-    progressStarted();
-    for (const auto [idx, coord] : enumerate(mappings)) {
-        progressUpdated(idx);
-
-        // Generate the neighborhood
-        const auto [y, x] = coord;
-        const auto& m = ppm_->getMapping(y, x);
-        const cv::Vec3d pos{m[0], m[1], m[2]};
-        const cv::Vec3d normal{m[3], m[4], m[5]};
-        auto n = gen_->compute(vol_, pos, {normal});
-
-        // Clamp values
-        if (clampToMax_) {
-            std::replace_if(
-                n.begin(), n.end(),
-                [this](std::uint16_t v) { return v > clampMax_; }, clampMax_);
-        }
-
-        // Convert to double and weight the neighborhood
-        NDArray<double> neighborhoodD(
-            n.dims(), n.extents(), n.begin(), n.end());
-        auto weighted = apply_weights_(neighborhoodD);
-
-        // Sum the neighborhood
-        auto value = std::accumulate(weighted.begin(), weighted.end(), 0.0);
+    auto height = static_cast<int>(ppm_->height());
+    auto width = static_cast<int>(ppm_->width());
+    result_.emplace_back(cv::Mat::zeros(height, width, CV_32FC1));
+}
 
-        // Assign the intensity value at the UV position
-        const auto v = static_cast<int>(y);
-        const auto u = static_cast<int>(x);
-        image.at<float>(v, u) = static_cast<float>(value);
+void IntegralTexture::texture_mapping_(std::size_t y, std::size_t x)
+{
+    // Generate the neighborhood
+    const auto& m = ppm_->getMapping(y, x);
+    const cv::Vec3d pos{m[0], m[1], m[2]};
+    const cv::Vec3d normal{m[3], m[4], m[5]};
+    auto n = gen_->compute(vol_, pos, {normal});
+
+    // Clamp values
+    if (clampToMax_) {
+        std::replace_if(
+            n.begin(), n.end(),
+            [this](std::uint16_t v) { return v > clampMax_; }, clampMax_);
     }
-    progressComplete();
 
-    cv::normalize(image, image, 0.0, 1.0, cv::NORM_MINMAX);
+    // Convert to double and weight the neighborhood
+    NDArray<double> neighborhoodD(n.dims(), n.extents(), n.begin(), n.end());
+    auto weighted = apply_weights_(neighborhoodD);
+
+    // Sum the neighborhood
+    auto value = std::accumulate(weighted.begin(), weighted.end(), 0.0);
 
-    // Set output
-    result_.push_back(image);
+    // Assign the intensity value at the UV position
+    const auto v = static_cast<int>(y);
+    const auto u = static_cast<int>(x);
+    result_[0].at<float>(v, u) = static_cast<float>(value);
+}
 
-    return result_;
+void IntegralTexture::finish_()
+{
+    cv::normalize(result_[0], result_[0], 0.0, 1.0, cv::NORM_MINMAX);
 }
 
 ///// Setup and Apply weights generally /////
@@ -160,58 +142,71 @@ void IntegralTexture::setup_expodiff_weights_()
     }
 }
 
-auto IntegralTexture::expodiff_intersection_pts_() -> std::vector<std::uint16_t>
+auto IntegralTexture::expodiff_histogram_() -> std::vector<std::size_t>
 {
-    // Get all the intensity values
-    std::vector<std::uint16_t> values;
-    for (const auto [y, x] : ppm_->getMappingCoords()) {
-        const auto& m = ppm_->getMapping(y, x);
-        values.emplace_back(vol_->interpolateAt({m[0], m[1], m[2]}));
+    // Sample the surface in z order, giving each thread a contiguous run of
+    // mappings so that threads mostly read different slices
+    auto mappings = sorted_mappings_();
+    auto& pool = ThreadPool::Shared();
+    auto numThreads = std::min(pool.size() + 1, mappings.size());
+    std::vector<std::vector<std::size_t>> histograms(numThreads);
+    pool.parallelFor(0, numThreads, [&](std::size_t t) {
+        auto& histogram = histograms[t];
+        histogram.assign(HISTOGRAM_BINS, 0);
+        auto first = mappings.size() * t / numThreads;
+        auto last = mappings.size() * (t + 1) / numThreads;
+
+        // Sample the intensities in batches
+        std::vector<cv::Vec3d> points;
+        std::vector<std::uint16_t> values;
+        for (auto b = first; b < last; b += SAMPLE_BATCH_SIZE) {
+            auto count = std::min(SAMPLE_BATCH_SIZE, last - b);
+            points.resize(count);
+            values.resize(count);
+            for (std::size_t i = 0; i < count; i++) {
+                const auto& c = mappings[b + i];
+                const auto& m = ppm_->getMapping(c.y, c.x);
+                points[i] = {m[0], m[1], m[2]};
+            }
+            vol_->interpolateAt(points.data(), count, values.data());
+            for (const auto& v : values) {
+                histogram[v]++;
+            }
+        }
+    });
+
+    // Merge the per-thread histograms
+    std::vector<std::size_t> histogram(HISTOGRAM_BINS, 0);
+    for (const auto& h : histograms) {
+        for (std::size_t v = 0; v < HISTOGRAM_BINS; v++) {
+            histogram[v] += h[v];
+        }
     }
 
-    return values;
+    return histogram;
 }
 
 auto IntegralTexture::expodiff_mean_base_() -> double
 {
-    // Get intersection points
-    auto values = expodiff_intersection_pts_();
-
-    // Calculate the mean
-    std::size_t n = 0;
-    double mean = 0.0;
-    for (const auto& v : values) {
-        double delta = v - mean;
-        mean += delta / static_cast<double>(++n);
+    // Calculate the mean of the surface intensities
+    auto histogram = expodiff_histogram_();
+    std::size_t n{0};
+    double sum{0};
+    for (std::size_t v = 0; v < HISTOGRAM_BINS; v++) {
+        n += histogram[v];
+        sum += static_cast<double>(v) * static_cast<double>(histogram[v]);
     }
 
-    return mean;
+    return (n > 0) ? sum / static_cast<double>(n) : 0.0;
 }
 
 auto IntegralTexture::expodiff_mode_base_() -> double
 {
-    // Get intersection points
-    auto values = expodiff_intersection_pts_();
-
-    // Generate a histogram
-    std::map<std::uint16_t, int> histogram;
-    for (const auto& v : values) {
-        try {
-            histogram.at(v) += 1;
-        } catch (const std::out_of_range&) {
-            histogram[v] = 1;
-        }
-    }
-
-    // Sort by frequency high to low
-    using KVPair = std::pair<std::uint16_t, int>;
-    using Comparator = std::function<bool(KVPair, KVPair)>;
-    Comparator compare = [](KVPair a, KVPair b) { return a.second > b.second; };
-    std::set<KVPair, Comparator> sorter(
-        histogram.begin(), histogram.end(), compare);
-
-    // Return the top candidate
-    return sorter.begin()->first;
+    // Return the most frequent surface intensity. Ties go to the lowest
+    // intensity.
+    auto histogram = expodiff_histogram_();
+    auto mode = std::max_element(histogram.begin(), histogram.end());
+    return static_cast<double>(std::distance(histogram.begin(), mode));
 }
 
 auto IntegralTexture::apply_expodiff_weights_(NDArray<double>& n) const
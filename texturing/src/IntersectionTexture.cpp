@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <vector>
 
 using namespace volcart;
 using namespace volcart::texturing;
@@ -14,41 +16,42 @@ auto IntersectionTexture::New() -> Pointer
     return std::make_shared<IntersectionTexture>();
 }
 
-auto IntersectionTexture::compute() -> Texture
+void IntersectionTexture::prepare_()
 {
-    // Setup
-    result_.clear();
+    // Output image
     auto height = static_cast<int>(ppm_->height());
     auto width = static_cast<int>(ppm_->width());
+    result_.emplace_back(cv::Mat::zeros(height, width, CV_16UC1));
+}
 
-    // Output image
-    cv::Mat image = cv::Mat::zeros(height, width, CV_16UC1);
-
-    // Get the mappings
-    auto mappings = ppm_->getMappingCoords();
-
-    // Sort the mappings by Z-value
-    std::sort(
-        mappings.begin(), mappings.end(),
-        [&](const auto& lhs, const auto& rhs) {
-            return (*ppm_)(lhs.y, lhs.x)[2] < (*ppm_)(rhs.y, rhs.x)[2];
-        });
-
-    // Iterate through the mappings
-    std::size_t counter{0};
-    progressStarted();
-    for (const auto [y, x] : mappings) {
-        progressUpdated(counter++);
-
-        // Assign the intensity value at the XY position
-        const auto& m = ppm_->getMapping(y, x);
-        image.at<std::uint16_t>(static_cast<int>(y), static_cast<int>(x)) =
-            vol_->interpolateAt({m[0], m[1], m[2]});
+void IntersectionTexture::texture_mapping_(std::size_t y, std::size_t x)
+{
+    // Assign the intensity value at the XY position
+    const auto& m = ppm_->getMapping(y, x);
+    result_[0].at<std::uint16_t>(static_cast<int>(y), static_cast<int>(x)) =
+        vol_->interpolateAt({m[0], m[1], m[2]});
+}
+
+void IntersectionTexture::texture_block_(
+    MappingCoords::const_iterator first, MappingCoords::const_iterator last)
+{
+    // Gather the positions
+    std::vector<cv::Vec3d> positions;
+    positions.reserve(static_cast<std::size_t>(std::distance(first, last)));
+    for (auto it = first; it != last; ++it) {
+        const auto& m = ppm_->getMapping(it->y, it->x);
+        positions.emplace_back(m[0], m[1], m[2]);
     }
-    progressComplete();
 
-    // Set output
-    result_.push_back(image);
+    // Sample the block
+    std::vector<std::uint16_t> values(positions.size());
+    vol_->interpolateAt(positions.data(), positions.size(), values.data());
 
-    return result_;
-}
\ No newline at end of file
+    // Each mapping is a distinct pixel, so blocks can be written concurrently
+    auto value = values.cbegin();
+    for (auto it = first; it != last; ++it, ++value) {
+        auto y = static_cast<int>(it->y);
+        auto x = static_cast<int>(it->x);
+        result_[0].at<std::uint16_t>(y, x) = *value;
+    }
+}
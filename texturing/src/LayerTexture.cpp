@@ -1,60 +1,128 @@
 #include "vc/texturing/LayerTexture.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
 
 #include <opencv2/core.hpp>
 
+#include "vc/core/io/ImageIO.hpp"
 #include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/ProgressTracker.hpp"
+#include "vc/core/util/ThreadPool.hpp"
 
 using namespace volcart;
 using namespace volcart::texturing;
 
+namespace fs = volcart::filesystem;
+namespace tio = volcart::tiffio;
+
 using Texture = LayerTexture::Texture;
 
 auto LayerTexture::New() -> Pointer { return std::make_shared<LayerTexture>(); }
 
-auto LayerTexture::compute() -> Texture
+auto LayerTexture::computeToTIFF(
+    const fs::path& pathFmt,
+    tio::Compression compression,
+    const cv::Size& tileSize) -> std::vector<fs::path>
 {
-    // Setup
     result_.clear();
-    auto height = static_cast<int>(ppm_->height());
-    auto width = static_cast<int>(ppm_->width());
+    const auto numLayers = gen_->extents()[0];
+    const auto height = static_cast<int>(ppm_->height());
+    const auto width = static_cast<int>(ppm_->width());
 
-    // Setup output images
-    for (std::size_t i = 0; i < gen_->extents()[0]; i++) {
-        result_.emplace_back(cv::Mat::zeros(height, width, CV_16UC1));
+    // Open a writer for every layer
+    if (pathFmt.stem().string().find("{}") == std::string::npos) {
+        throw std::invalid_argument(
+            "Layer path does not contain {}: " + pathFmt.string());
+    }
+    auto paths = ImageSequencePaths(pathFmt, numLayers);
+    std::vector<std::unique_ptr<tio::TiledTIFFWriter>> writers;
+    writers.reserve(numLayers);
+    for (const auto& path : paths) {
+        writers.emplace_back(std::make_unique<tio::TiledTIFFWriter>(
+            path, cv::Size(width, height), CV_16UC1, compression, tileSize));
     }
 
-    // Get the mappings
+    // One band of rows for every layer
+    std::vector<cv::Mat> band(numLayers);
+    for (auto& layer : band) {
+        layer = cv::Mat(tileSize.height, width, CV_16UC1);
+    }
+
+    // Mappings are in row-major order
     auto mappings = ppm_->getMappingCoords();
+    auto begin = mappings.begin();
+    std::size_t done{0};
+    auto& pool = ThreadPool::Shared();
+    ProgressTracker progress(*this);
+    for (int y0 = 0; y0 < height; y0 += tileSize.height) {
+        const auto rows = std::min(tileSize.height, height - y0);
+        const auto bandEnd = static_cast<std::size_t>(y0 + rows);
+        for (auto& layer : band) {
+            layer.setTo(0);
+        }
 
-    // Sort the mappings by Z-value
-    std::sort(
-        mappings.begin(), mappings.end(),
-        [&](const auto& lhs, const auto& rhs) {
+        // Sample the mappings in this band, sorted by Z-value
+        auto end = std::find_if(begin, mappings.end(), [&](const auto& c) {
+            return c.y >= bandEnd;
+        });
+        std::sort(begin, end, [&](const auto& lhs, const auto& rhs) {
             return (*ppm_)(lhs.y, lhs.x)[2] < (*ppm_)(rhs.y, rhs.x)[2];
         });
-
-    // Iterate through the mappings
-    progressStarted();
-    for (const auto [idx, coord] : enumerate(mappings)) {
-        progressUpdated(idx);
-
-        // Generate the neighborhood
-        const auto [y, x] = coord;
-        const auto& m = ppm_->getMapping(y, x);
-        const cv::Vec3d pos{m[0], m[1], m[2]};
-        const cv::Vec3d normal{m[3], m[4], m[5]};
-        auto neighborhood = gen_->compute(vol_, pos, {normal});
-
-        // Assign to the output images
-        for (const auto [it, v] : enumerate(neighborhood)) {
-            const auto yy = static_cast<int>(y);
-            const auto xx = static_cast<int>(x);
-            result_.at(it).at<std::uint16_t>(yy, xx) = v;
+        for (auto it = begin; it != end; ++it) {
+            sample_mapping_(it->y, it->x, band, y0);
+            progress.set(++done);
         }
+        begin = end;
+
+        // Compress and write the layers in parallel
+        pool.parallelFor(0, numLayers, [&](std::size_t i) {
+            writers[i]->writeTileRow(band[i].rowRange(0, rows));
+        });
     }
-    progressComplete();
 
-    return result_;
-}
\ No newline at end of file
+    for (auto& writer : writers) {
+        writer->close();
+    }
+    progress.complete();
+    return paths;
+}
+
+void LayerTexture::prepare_()
+{
+    // Setup output images
+    auto height = static_cast<int>(ppm_->height());
+    auto width = static_cast<int>(ppm_->width());
+    for (std::size_t i = 0; i < gen_->extents()[0]; i++) {
+        result_.emplace_back(cv::Mat::zeros(height, width, CV_16UC1));
+    }
+}
+
+void LayerTexture::texture_mapping_(std::size_t y, std::size_t x)
+{
+    sample_mapping_(y, x, result_, 0);
+}
+
+void LayerTexture::sample_mapping_(
+    std::size_t y,
+    std::size_t x,
+    std::vector<cv::Mat>& layers,
+    std::size_t yOffset)
+{
+    // Generate the neighborhood
+    const auto& m = ppm_->getMapping(y, x);
+    const cv::Vec3d pos{m[0], m[1], m[2]};
+    const cv::Vec3d normal{m[3], m[4], m[5]};
+    auto neighborhood = gen_->compute(vol_, pos, {normal});
+
+    // Assign to the output images
+    const auto yy = static_cast<int>(y - yOffset);
+    const auto xx = static_cast<int>(x);
+    for (const auto [it, v] : enumerate(neighborhood)) {
+        layers.at(it).at<std::uint16_t>(yy, xx) = v;
+    }
+}
@@ -14,6 +14,8 @@
 
 #include "vc/core/util/BarycentricCoordinates.hpp"
 #include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/Profiling.hpp"
+#include "vc/core/util/ProgressTracker.hpp"
 #include "vc/meshing/CalculateNormals.hpp"
 
 using namespace volcart;
@@ -21,6 +23,7 @@ using namespace texturing;
 
 namespace vcm = volcart::meshing;
 namespace vct = volcart::texturing;
+namespace prof = volcart::profiling;
 
 static constexpr std::uint8_t MASK_TRUE{255};
 
@@ -32,6 +35,9 @@ using Bvh = bvh::Bvh<Scalar>;
 using Intersector = bvh::ClosestPrimitiveIntersector<Bvh, Triangle>;
 using Traverser = bvh::SingleRayTraverser<Bvh>;
 
+// Time spent generating PPMs
+static const prof::Timer PPM_TIMER{"PPMGenerator::compute"};
+
 PPMGenerator::PPMGenerator(std::size_t h, std::size_t w) : width_{w}, height_{h}
 {
 }
@@ -59,6 +65,7 @@ auto PPMGenerator::progressIterations() const -> std::size_t
 // Compute
 auto PPMGenerator::compute() -> PerPixelMap::Pointer
 {
+    const prof::ScopedTimer timer(PPM_TIMER);
     if (inputMesh_.IsNull() || inputMesh_->GetNumberOfPoints() == 0 ||
         inputMesh_->GetNumberOfCells() == 0 || not uvMap_ || uvMap_->empty() ||
         width_ == 0 || height_ == 0) {
@@ -110,10 +117,13 @@ auto PPMGenerator::compute() -> PerPixelMap::Pointer
     Traverser traverser(bvh);
 
     // Iterate over all of the pixels
-    progressStarted();
+    ProgressTracker progress(*this);
     ITKCell::CellAutoPointer cell;
     for (const auto [y, x] : range2D(height_, width_)) {
-        progressUpdated(y * width_ + x);
+        // Report progress once per row
+        if (x == 0) {
+            progress.set(y * width_);
+        }
         // This pixel's uv coordinate
         cv::Vec3d uv{0, 0, 0};
         uv[0] = static_cast<double>(x) / static_cast<double>(width_ - 1);
@@ -184,7 +194,9 @@ auto PPMGenerator::compute() -> PerPixelMap::Pointer
         ppm_->getMapping(y, x) = cv::Vec6d(
             xyz(0), xyz(1), xyz(2), xyzNorm(0), xyzNorm(1), xyzNorm(2));
     }
-    progressComplete();
+    progress.set(height_ * width_);
+    progress.complete();
+    prof::Count(prof::Counter::BVHTraversals, width_ * height_);
 
     // Finish setting up the output
     ppm_->setMask(mask);
@@ -252,5 +264,6 @@ auto vct::GenerateCellMap(
             static_cast<int>(hit->primitive_index);
     }
 
+    prof::Count(prof::Counter::BVHTraversals, width * height);
     return cellMap;
 }
@@ -15,6 +15,7 @@
 
 #include "vc/core/util/BarycentricCoordinates.hpp"
 #include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/Profiling.hpp"
 #include "vc/meshing/ITK2VTK.hpp"
 
 static constexpr std::uint8_t MASK_TRUE{255};
@@ -30,6 +31,10 @@ using Traverser = bvh::SingleRayTraverser<Bvh>;
 namespace vc = volcart;
 namespace vcm = vc::meshing;
 namespace vct = vc::texturing;
+namespace prof = vc::profiling;
+
+// Time spent projecting meshes
+static const prof::Timer PROJECT_TIMER{"ProjectMesh::compute"};
 
 void vct::ProjectMesh::setMesh(const ITKMesh::Pointer& inputMesh)
 {
@@ -72,6 +77,7 @@ void vct::ProjectMesh::setUseFirstIntersection(bool useFirstIntersection)
 
 auto vct::ProjectMesh::compute() -> vc::PerPixelMap
 {
+    const prof::ScopedTimer timer(PROJECT_TIMER);
     if (!inputMesh_) {
         throw std::runtime_error("Empty input mesh");
     }
@@ -228,6 +234,10 @@ auto vct::ProjectMesh::compute() -> vc::PerPixelMap
         mask.at<std::uint8_t>(v, u) = MASK_TRUE;
     }
 
+    prof::Count(
+        prof::Counter::BVHTraversals,
+        static_cast<std::uint64_t>(ppmHeight_) * ppmWidth_);
+
     outputPPM_.setMask(mask);
     outputPPM_.setCellMap(cellMap);
     return outputPPM_;
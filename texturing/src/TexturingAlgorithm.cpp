@@ -1,7 +1,22 @@
 #include "vc/texturing/TexturingAlgorithm.hpp"
 
+#include <algorithm>
+#include <cstddef>
+
+#include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/Profiling.hpp"
+#include "vc/core/util/ProgressTracker.hpp"
+#include "vc/core/util/ThreadPool.hpp"
+
+using namespace volcart;
 using namespace volcart::texturing;
 
+// Time spent texturing
+static const profiling::Timer TEXTURE_TIMER{"TexturingAlgorithm::compute"};
+
+// Number of mappings in a block when texturing in parallel
+static constexpr std::size_t BLOCK_SIZE{4096};
+
 void TexturingAlgorithm::setPerPixelMap(PerPixelMap::Pointer ppm)
 {
     ppm_ = std::move(ppm);
@@ -17,4 +32,65 @@ auto TexturingAlgorithm::getTexture() -> Texture { return result_; }
 auto TexturingAlgorithm::progressIterations() const -> std::size_t
 {
     return ppm_->numMappings();
-}
\ No newline at end of file
+}
+
+auto TexturingAlgorithm::compute() -> Texture
+{
+    const profiling::ScopedTimer timer(TEXTURE_TIMER);
+    // Setup
+    result_.clear();
+    prepare_();
+
+    // Get the mappings
+    auto mappings = sorted_mappings_();
+
+    // Iterate through the mappings
+    ProgressTracker progress(*this);
+    if (parallel_mappings_()) {
+        // Texture blocks of z-sorted mappings in parallel
+        auto numBlocks = (mappings.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        ThreadPool::Shared().parallelFor(0, numBlocks, [&](std::size_t b) {
+            auto begin = b * BLOCK_SIZE;
+            auto end = std::min(begin + BLOCK_SIZE, mappings.size());
+            auto first = mappings.cbegin() + static_cast<std::ptrdiff_t>(begin);
+            auto last = mappings.cbegin() + static_cast<std::ptrdiff_t>(end);
+            texture_block_(first, last);
+            progress.add(end - begin);
+        });
+    } else {
+        for (const auto [idx, coord] : enumerate(mappings)) {
+            texture_mapping_(coord.y, coord.x);
+            progress.set(idx + 1);
+        }
+    }
+    progress.complete();
+
+    // Post-process the output
+    finish_();
+
+    return result_;
+}
+
+void TexturingAlgorithm::texture_block_(
+    MappingCoords::const_iterator first,
+    MappingCoords::const_iterator last)
+{
+    for (auto it = first; it != last; ++it) {
+        texture_mapping_(it->y, it->x);
+    }
+}
+
+auto TexturingAlgorithm::sorted_mappings_() const -> MappingCoords
+{
+    // Get the mappings
+    auto mappings = ppm_->getMappingCoords();
+
+    // Sort the mappings by Z-value
+    std::sort(
+        mappings.begin(), mappings.end(),
+        [&](const auto& lhs, const auto& rhs) {
+            return (*ppm_)(lhs.y, lhs.x)[2] < (*ppm_)(rhs.y, rhs.x)[2];
+        });
+
+    return mappings;
+}
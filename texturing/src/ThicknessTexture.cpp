@@ -1,12 +1,63 @@
 #include "vc/texturing/ThicknessTexture.hpp"
 
-#include "vc/core/util/Iteration.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "vc/core/util/Profiling.hpp"
 
 using namespace volcart;
 using namespace volcart::texturing;
+namespace prof = volcart::profiling;
 
 using Texture = ThicknessTexture::Texture;
 
+// Edge length of a mask brick, in voxels
+static constexpr int BRICK_SIZE{4};
+static constexpr std::size_t BRICK_VOXELS{BRICK_SIZE * BRICK_SIZE * BRICK_SIZE};
+// Samples closer than this to a brick boundary are not skipped
+static constexpr double BOUNDARY_EPS{1e-9};
+// Number of independently locked parts of the mask Volume brick cache
+static constexpr std::size_t BRICK_SHARDS{64};
+
+// Mask Volume bricks are classified by whichever thread reaches them first.
+// The cache is sharded so that threads rarely wait on the same lock.
+struct ThicknessTexture::BrickCache {
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<cv::Vec3i, bool, Vec3iHash> full;
+    };
+    std::array<Shard, BRICK_SHARDS> shards;
+};
+
+namespace
+{
+auto FloorDiv(int a, int b) -> int
+{
+    auto q = a / b;
+    return (a % b != 0 and (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+auto VoxelOf(const cv::Vec3d& v) -> cv::Vec3i
+{
+    return {
+        static_cast<int>(std::floor(v[0])), static_cast<int>(std::floor(v[1])),
+        static_cast<int>(std::floor(v[2]))};
+}
+
+auto BrickOf(const cv::Vec3i& v) -> cv::Vec3i
+{
+    return {
+        FloorDiv(v[0], BRICK_SIZE), FloorDiv(v[1], BRICK_SIZE),
+        FloorDiv(v[2], BRICK_SIZE)};
+}
+}  // namespace
+
 auto ThicknessTexture::New() -> Pointer
 {
     return std::make_shared<ThicknessTexture>();
@@ -21,91 +72,203 @@ void ThicknessTexture::setVolumetricMask(const VolumetricMask::Pointer& m)
     mask_ = m;
 }
 
-auto ThicknessTexture::compute() -> Texture
+void ThicknessTexture::setMaskVolume(const Volume::Pointer& v)
 {
-    // Setup
-    result_.clear();
+    maskVol_ = v;
+}
+
+void ThicknessTexture::prepare_()
+{
+    if (not mask_ and not maskVol_) {
+        throw std::runtime_error("No volumetric mask or mask volume");
+    }
+
+    // Find the bricks which can be skipped. Mask Volume bricks are found
+    // while texturing.
+    fullBricks_.clear();
+    brickCache_ = std::make_shared<BrickCache>();
+    if (mask_) {
+        find_full_bricks_mask_();
+    }
+
+    // Output image
     auto height = static_cast<int>(ppm_->height());
     auto width = static_cast<int>(ppm_->width());
+    result_.emplace_back(cv::Mat::zeros(height, width, CV_32FC1));
+}
 
-    // Output image
-    cv::Mat image = cv::Mat::zeros(height, width, CV_32FC1);
-
-    // Get the mappings
-    auto mappings = ppm_->getMappingCoords();
-
-    // Sort the mappings by Z-value
-    std::sort(
-        mappings.begin(), mappings.end(),
-        [&](const auto& lhs, const auto& rhs) {
-            return (*ppm_)(lhs.y, lhs.x)[2] < (*ppm_)(rhs.y, rhs.x)[2];
-        });
-
-    // Iterate through the mappings
-    progressStarted();
-    for (const auto [idx, coord] : enumerate(mappings)) {
-        progressUpdated(idx);
-
-        // Generate the neighborhood
-        const auto [y, x] = coord;
-        const auto& m = ppm_->getMapping(y, x);
-        const cv::Vec3d pos{m[0], m[1], m[2]};
-        const cv::Vec3d normal{m[3], m[4], m[5]};
-
-        // Starting voxel must be in mask
-        if (mask_->isIn(pos)) {
-            // Setup bidirectional search
-            bool foundMin{false};
-            bool foundMax{false};
-            cv::Vec3d min{pos};
-            cv::Vec3d max{pos};
-            double offset{0};
-
-            // Find the edges of the layer from this point
-            while (not foundMin or not foundMax) {
-                // Calculate offset
-                offset += interval_;
-                auto delta = offset * normal;
-
-                // Check the negative direction
-                if (not foundMin) {
-                    auto neg = pos - delta;
-                    foundMin = mask_->isOut(neg);
-                    min = (foundMin) ? min : neg;
-                }
+void ThicknessTexture::find_full_bricks_mask_()
+{
+    // Count the mask voxels in each brick
+    std::unordered_map<cv::Vec3i, std::size_t, Vec3iHash> counts;
+    for (const auto& v : *mask_) {
+        counts[BrickOf(v)]++;
+    }
+    for (const auto& [brick, count] : counts) {
+        if (count == BRICK_VOXELS) {
+            fullBricks_.insert(brick);
+        }
+    }
+}
+
+auto ThicknessTexture::is_full_brick_(const cv::Vec3i& brick) const -> bool
+{
+    if (mask_) {
+        return fullBricks_.count(brick) > 0;
+    }
+
+    // Classify the brick on its first visit
+    auto& shard = brickCache_->shards[Vec3iHash{}(brick) % BRICK_SHARDS];
+    {
+        const std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.full.find(brick);
+        if (it != shard.full.end()) {
+            return it->second;
+        }
+    }
+
+    // Read the brick without holding the lock. Threads which race to classify
+    // the same brick get the same result.
+    auto full = classify_brick_(brick);
+    const std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.full.emplace(brick, full);
+    return full;
+}
 
-                // Check the positive direction
-                if (not foundMax) {
-                    auto newPos = pos + delta;
-                    foundMax = mask_->isOut(newPos);
-                    max = (foundMax) ? max : newPos;
+auto ThicknessTexture::classify_brick_(const cv::Vec3i& brick) const -> bool
+{
+    // Bricks which are not entirely inside the volume are never full
+    const std::array<int, 3> dims{
+        maskVol_->sliceWidth(), maskVol_->sliceHeight(),
+        maskVol_->numSlices()};
+    cv::Vec3i first;
+    for (int i = 0; i < 3; i++) {
+        first[i] = brick[i] * BRICK_SIZE;
+        if (first[i] < 0 or first[i] + BRICK_SIZE > dims[i]) {
+            return false;
+        }
+    }
+
+    for (int z = first[2]; z < first[2] + BRICK_SIZE; z++) {
+        auto slice = maskVol_->getSliceData(z);
+        for (int y = first[1]; y < first[1] + BRICK_SIZE; y++) {
+            const auto* row = slice.ptr<std::uint16_t>(y);
+            for (int x = first[0]; x < first[0] + BRICK_SIZE; x++) {
+                if (row[x] == 0) {
+                    return false;
                 }
             }
+        }
+    }
+    return true;
+}
+
+void ThicknessTexture::texture_mapping_(std::size_t y, std::size_t x)
+{
+    const auto& m = ppm_->getMapping(y, x);
+    const cv::Vec3d pos{m[0], m[1], m[2]};
+    const cv::Vec3d normal{m[3], m[4], m[5]};
+
+    // Starting voxel must be in mask
+    if (not is_in_mask_(pos)) {
+        return;
+    }
+
+    // Find the edges of the layer from this point
+    auto negSteps = static_cast<double>(march_(pos, -normal));
+    auto posSteps = static_cast<double>(march_(pos, normal));
+    cv::Vec3d min = pos - (negSteps * interval_) * normal;
+    cv::Vec3d max = pos + (posSteps * interval_) * normal;
+
+    // Assign the intensity value at the UV position
+    const auto u = static_cast<int>(x);
+    const auto v = static_cast<int>(y);
+
+    // If max = min, then thickness 1
+    // Otherwise, thickness == distance
+    if (max == min) {
+        result_[0].at<float>(v, u) = 1;
+    } else {
+        auto dist = cv::norm(max, min, cv::NORM_L2);
+        result_[0].at<float>(v, u) = static_cast<float>(dist);
+    }
+}
+
+auto ThicknessTexture::march_(const cv::Vec3d& pos, const cv::Vec3d& dir)
+    const -> std::size_t
+{
+    // A zero direction never leaves the mask
+    if (dir == cv::Vec3d::all(0)) {
+        return 0;
+    }
 
-            // Assign the intensity value at the UV position
-            const auto u = static_cast<int>(x);
-            const auto v = static_cast<int>(y);
-
-            // If max = min, then thickness 1
-            // Otherwise, thickness == distance
-            if (max == min) {
-                image.at<float>(v, u) = 1;
-            } else {
-                auto dist = cv::norm(max, min, cv::NORM_L2);
-                image.at<float>(v, u) = static_cast<float>(dist);
+    auto sample = [&](std::size_t step) -> cv::Vec3d {
+        return pos + (static_cast<double>(step) * interval_) * dir;
+    };
+
+    // The VolumetricMask may have no full bricks to look up
+    auto lookup = not mask_ or not fullBricks_.empty();
+
+    std::size_t steps{0};
+    cv::Vec3i lastBrick;
+    bool checkedBrick{false};
+    while (true) {
+        // Skip the samples which stay in a full brick. Each brick is looked
+        // up once per visit.
+        auto current = sample(steps);
+        auto brick = BrickOf(VoxelOf(current));
+        if (lookup and (not checkedBrick or brick != lastBrick)) {
+            lastBrick = brick;
+            checkedBrick = true;
+            if (is_full_brick_(brick)) {
+                // Distance along dir to the brick boundary
+                auto t = std::numeric_limits<double>::max();
+                for (int i = 0; i < 3; i++) {
+                    auto lo = static_cast<double>(brick[i] * BRICK_SIZE);
+                    if (dir[i] > 0) {
+                        auto d = lo + BRICK_SIZE - current[i];
+                        t = std::min(t, d / dir[i]);
+                    } else if (dir[i] < 0) {
+                        t = std::min(t, (current[i] - lo) / -dir[i]);
+                    }
+                }
+
+                // Samples closer than t are in the brick
+                auto skip = std::ceil((t - BOUNDARY_EPS) / interval_) - 1;
+                if (skip >= 1) {
+                    steps += static_cast<std::size_t>(skip);
+                    prof::Count(
+                        prof::Counter::MaskSamplesSkipped,
+                        static_cast<std::uint64_t>(skip));
+                    continue;
+                }
             }
         }
-    }
-    progressComplete();
 
-    if (normalize_) {
-        cv::normalize(image, image, 0.0, 1.0, cv::NORM_MINMAX);
+        // Check the next sample
+        if (not is_in_mask_(sample(steps + 1))) {
+            return steps;
+        }
+        steps++;
     }
+}
 
-    // Set output
-    result_.push_back(image);
+auto ThicknessTexture::is_in_mask_(const cv::Vec3d& v) const -> bool
+{
+    if (mask_) {
+        return mask_->isIn(v);
+    }
+    auto x = static_cast<int>(std::floor(v[0]));
+    auto y = static_cast<int>(std::floor(v[1]));
+    auto z = static_cast<int>(std::floor(v[2]));
+    return maskVol_->intensityAt(x, y, z) > 0;
+}
 
-    return result_;
+void ThicknessTexture::finish_()
+{
+    if (normalize_) {
+        cv::normalize(result_[0], result_[0], 0.0, 1.0, cv::NORM_MINMAX);
+    }
 }
 
 auto ThicknessTexture::samplingInterval() const -> double { return interval_; }
@@ -116,3 +279,8 @@ auto ThicknessTexture::volumetricMask() const -> VolumetricMask::Pointer
 {
     return mask_;
 }
+
+auto ThicknessTexture::maskVolume() const -> Volume::Pointer
+{
+    return maskVol_;
+}
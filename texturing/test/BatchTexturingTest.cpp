@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/core/types/Volume.hpp"
+#include "vc/core/util/Iteration.hpp"
+#include "vc/testing/TestingUtils.hpp"
+#include "vc/texturing/BatchTexturing.hpp"
+#include "vc/texturing/IntersectionTexture.hpp"
+
+namespace vc = volcart;
+namespace vct = volcart::texturing;
+namespace vctest = volcart::testing;
+
+namespace
+{
+constexpr int VOL_DIM{20};
+
+// Volume where each voxel's intensity encodes its position
+auto MakeVolume() -> vc::Volume::Pointer
+{
+    return vctest::MakeSyntheticVolume(
+        "BatchTexturingTest.volume", VOL_DIM,
+        [](int x, int y, int z) { return 100 * z + 10 * y + x; });
+}
+
+// Tilted plane through the volume
+auto MakePPM(double zOffset, double zSlope) -> vc::PerPixelMap::Pointer
+{
+    auto ppm = vc::PerPixelMap::New(10, 10);
+    for (const auto [y, x] : vc::range2D(10, 10)) {
+        auto z = zOffset + zSlope * static_cast<double>(x);
+        (*ppm)(y, x) = {double(x) + 5, double(y) + 5, z, 0, 0, 1};
+    }
+    return ppm;
+}
+}  // namespace
+
+TEST(BatchTexturingTest, MatchesIndividualTexturing)
+{
+    auto vol = MakeVolume();
+    std::vector<vc::PerPixelMap::Pointer> ppms{
+        MakePPM(2, 1), MakePPM(15, -1), MakePPM(8, 0.5)};
+
+    // Reference: texture each PPM individually
+    std::vector<cv::Mat> expected;
+    for (const auto& ppm : ppms) {
+        vct::IntersectionTexture alg;
+        alg.setVolume(vol);
+        alg.setPerPixelMap(ppm);
+        expected.emplace_back(alg.compute()[0]);
+    }
+
+    // Texture all PPMs in one pass
+    vct::BatchTexturing batch;
+    std::vector<vct::IntersectionTexture::Pointer> algs;
+    for (const auto& ppm : ppms) {
+        auto alg = vct::IntersectionTexture::New();
+        alg->setVolume(vol);
+        alg->setPerPixelMap(ppm);
+        batch.addAlgorithm(alg);
+        algs.emplace_back(alg);
+    }
+    EXPECT_EQ(batch.size(), ppms.size());
+    EXPECT_EQ(batch.progressIterations(), 300);
+
+    auto results = batch.compute();
+    ASSERT_EQ(results.size(), expected.size());
+    for (std::size_t i = 0; i < results.size(); i++) {
+        ASSERT_EQ(results[i].size(), 1);
+        EXPECT_EQ(cv::countNonZero(results[i][0] != expected[i]), 0);
+        auto texture = algs[i]->getTexture();
+        EXPECT_EQ(cv::countNonZero(texture[0] != expected[i]), 0);
+    }
+}
+
+TEST(BatchTexturingTest, ProgressCoversAllMappings)
+{
+    auto vol = MakeVolume();
+    vct::BatchTexturing batch;
+    for (const auto& ppm : {MakePPM(2, 1), MakePPM(4, 0)}) {
+        auto alg = vct::IntersectionTexture::New();
+        alg->setVolume(vol);
+        alg->setPerPixelMap(ppm);
+        batch.addAlgorithm(alg);
+    }
+
+    std::size_t updates{0};
+    std::size_t last{0};
+    bool completed{false};
+    batch.progressUpdated.connect([&](std::size_t v) {
+        updates++;
+        last = v;
+    });
+    batch.progressComplete.connect([&]() { completed = true; });
+    batch.compute();
+
+    // Updates are throttled, but the final count is always reported
+    EXPECT_GE(updates, 1);
+    EXPECT_LE(updates, 200);
+    EXPECT_EQ(last, 200);
+    EXPECT_TRUE(completed);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/neighborhood/LineGenerator.hpp"
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/core/types/Volume.hpp"
+#include "vc/testing/TestingUtils.hpp"
+#include "vc/texturing/IntegralTexture.hpp"
+
+namespace vc = volcart;
+namespace vct = volcart::texturing;
+namespace vctest = volcart::testing;
+
+using Method = vct::IntegralTexture::ExpoDiffBaseMethod;
+
+namespace
+{
+// Surface intensities. 10 and 30 are tied for the mode.
+const std::vector<std::uint16_t> INTENSITIES{10, 30, 10, 50, 30};
+
+// Texture one pixel per intensity using only the surface voxel, so that each
+// pixel is |v - base| before normalization
+auto Texture(Method method) -> cv::Mat
+{
+    // One voxel per intensity
+    auto width = static_cast<int>(INTENSITIES.size());
+    auto vol = vctest::MakeSyntheticVolume(
+        "IntegralTextureTest.volume", {width, 1, 1},
+        [](int x, int, int) { return INTENSITIES[x]; });
+
+    // Map each pixel to its voxel
+    auto ppm = vc::PerPixelMap::New(1, INTENSITIES.size());
+    for (std::size_t x = 0; x < INTENSITIES.size(); x++) {
+        (*ppm)(0, x) = {double(x), 0, 0, 0, 0, 1};
+    }
+    ppm->setMask(cv::Mat(1, width, CV_8UC1, cv::Scalar(255)));
+
+    auto gen = vc::LineGenerator::New();
+    gen->setSamplingRadius(0);
+
+    vct::IntegralTexture alg;
+    alg.setVolume(vol);
+    alg.setPerPixelMap(ppm);
+    alg.setGenerator(gen);
+    alg.setWeightMethod(vct::IntegralTexture::WeightMethod::ExpoDiff);
+    alg.setExponentialDiffBaseMethod(method);
+    alg.setExponentialDiffExponent(1);
+    alg.setExponentialDiffSuppressBelowBase(false);
+    return alg.compute()[0];
+}
+}  // namespace
+
+TEST(IntegralTexture, ExpoDiffMeanBase)
+{
+    // Base: (10 + 30 + 10 + 50 + 30) / 5 = 26
+    // |v - base| = {16, 4, 16, 24, 4}
+    const std::vector<float> expected{0.6F, 0, 0.6F, 1, 0};
+    auto texture = Texture(Method::Mean);
+    for (std::size_t x = 0; x < expected.size(); x++) {
+        EXPECT_NEAR(texture.at<float>(0, int(x)), expected[x], 1e-6);
+    }
+}
+
+TEST(IntegralTexture, ExpoDiffModeBase)
+{
+    // 10 and 30 each occur twice. Ties go to the lowest intensity.
+    // Base: 10
+    // |v - base| = {0, 20, 0, 40, 20}
+    const std::vector<float> expected{0, 0.5F, 0, 1, 0.5F};
+    auto texture = Texture(Method::Mode);
+    for (std::size_t x = 0; x < expected.size(); x++) {
+        EXPECT_NEAR(texture.at<float>(0, int(x)), expected[x], 1e-6);
+    }
+}
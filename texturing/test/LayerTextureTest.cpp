@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/io/TIFFIO.hpp"
+#include "vc/core/neighborhood/LineGenerator.hpp"
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/core/types/Volume.hpp"
+#include "vc/core/util/Iteration.hpp"
+#include "vc/testing/TestingUtils.hpp"
+#include "vc/texturing/LayerTexture.hpp"
+
+namespace fs = volcart::filesystem;
+namespace vc = volcart;
+namespace vct = volcart::texturing;
+namespace vctest = volcart::testing;
+
+namespace
+{
+constexpr int VOL_DIM{20};
+
+// Volume where each voxel's intensity encodes its position
+auto MakeVolume() -> vc::Volume::Pointer
+{
+    return vctest::MakeSyntheticVolume(
+        "LayerTextureTest.volume", VOL_DIM,
+        [](int x, int y, int z) { return 100 * z + 10 * y + x; });
+}
+
+// Tilted plane through the volume. Larger than one tile in both dimensions.
+auto MakePPM() -> vc::PerPixelMap::Pointer
+{
+    constexpr std::size_t height{40};
+    constexpr std::size_t width{36};
+    auto ppm = vc::PerPixelMap::New(height, width);
+    cv::Mat mask = cv::Mat::zeros(height, width, CV_8UC1);
+    for (const auto [y, x] : vc::range2D(height, width)) {
+        // Leave some pixels unmapped
+        if ((x + y) % 7 == 0) {
+            continue;
+        }
+        auto px = 2.0 + 0.4 * static_cast<double>(x);
+        auto py = 2.0 + 0.4 * static_cast<double>(y);
+        auto z = 6.0 + 0.1 * static_cast<double>(x);
+        (*ppm)(y, x) = {px, py, z, 0, 0, 1};
+        mask.at<std::uint8_t>(y, x) = 255;
+    }
+    ppm->setMask(mask);
+    return ppm;
+}
+}  // namespace
+
+TEST(LayerTextureTest, TiledMatchesInMemory)
+{
+    auto vol = MakeVolume();
+    auto ppm = MakePPM();
+    auto gen = vc::LineGenerator::New();
+    gen->setSamplingRadius(3);
+
+    vct::LayerTexture alg;
+    alg.setVolume(vol);
+    alg.setPerPixelMap(ppm);
+    alg.setGenerator(gen);
+    auto expected = alg.compute();
+
+    const fs::path outDir{"LayerTextureTest.layers"};
+    fs::remove_all(outDir);
+    fs::create_directories(outDir);
+    auto paths = alg.computeToTIFF(
+        outDir / "layer_{}.tif", vc::tiffio::Compression::LZW, {16, 16});
+    EXPECT_TRUE(alg.getTexture().empty());
+
+    ASSERT_EQ(paths.size(), expected.size());
+    EXPECT_EQ(paths[0].filename().string(), "layer_0.tif");
+    for (std::size_t i = 0; i < paths.size(); i++) {
+        auto layer = vc::tiffio::ReadTIFF(paths[i]);
+        ASSERT_EQ(layer.size(), expected[i].size());
+        EXPECT_EQ(cv::countNonZero(layer != expected[i]), 0);
+    }
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/core/types/Volume.hpp"
+#include "vc/core/types/VolumetricMask.hpp"
+#include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/Profiling.hpp"
+#include "vc/testing/TestingUtils.hpp"
+#include "vc/texturing/ThicknessTexture.hpp"
+
+namespace vc = volcart;
+namespace prof = volcart::profiling;
+namespace vct = volcart::texturing;
+namespace vctest = volcart::testing;
+
+namespace
+{
+constexpr int VOL_DIM{20};
+constexpr int LAYER_START{8};
+constexpr int LAYER_END{12};
+// Layer spanning several mask bricks
+constexpr int THICK_START{1};
+constexpr int THICK_END{19};
+
+// Mask of a horizontal layer
+auto MakeMask(int start = LAYER_START, int end = LAYER_END)
+    -> vc::VolumetricMask::Pointer
+{
+    auto mask = vc::VolumetricMask::New();
+    for (int z = start; z < end; z++) {
+        for (const auto [y, x] : vc::range2D(VOL_DIM, VOL_DIM)) {
+            mask->setIn({x, y, z});
+        }
+    }
+    return mask;
+}
+
+// The same layer as a mask volume
+auto MakeMaskVolume(int start = LAYER_START, int end = LAYER_END)
+    -> vc::Volume::Pointer
+{
+    return vctest::MakeSyntheticVolume(
+        "ThicknessTextureTest.volume", VOL_DIM, [=](int, int, int z) {
+            return (z >= start and z < end) ? 65535 : 0;
+        });
+}
+
+// Plane in the middle of the layer
+auto MakePPM(const cv::Vec3d& normal = {0, 0, 1}) -> vc::PerPixelMap::Pointer
+{
+    auto ppm = vc::PerPixelMap::New(10, 10);
+    cv::Mat mask = cv::Mat::zeros(10, 10, CV_8UC1);
+    for (const auto [y, x] : vc::range2D(10, 10)) {
+        (*ppm)(y, x) = {
+            double(x) + 5, double(y) + 5, 10, normal[0], normal[1], normal[2]};
+        mask.at<std::uint8_t>(y, x) = 255;
+    }
+    ppm->setMask(mask);
+    return ppm;
+}
+
+// Thickness found by checking every sample along the normal
+auto ExpectedThickness(
+    const vc::VolumetricMask& mask,
+    const cv::Vec3d& pos,
+    const cv::Vec3d& normal,
+    double interval) -> float
+{
+    auto edge = [&](double sign) {
+        double offset{0};
+        while (mask.isIn(pos + sign * (offset + interval) * normal)) {
+            offset += interval;
+        }
+        return offset;
+    };
+    auto dist = (edge(-1) + edge(1)) * cv::norm(normal);
+    return dist == 0 ? 1.F : static_cast<float>(dist);
+}
+}  // namespace
+
+TEST(ThicknessTextureTest, MaskVolumeMatchesVolumetricMask)
+{
+    auto ppm = MakePPM();
+
+    vct::ThicknessTexture expected;
+    expected.setPerPixelMap(ppm);
+    expected.setVolumetricMask(MakeMask());
+    expected.setNormalizeOutput(false);
+    auto expectedTex = expected.compute()[0];
+
+    vct::ThicknessTexture alg;
+    alg.setPerPixelMap(ppm);
+    alg.setMaskVolume(MakeMaskVolume());
+    alg.setNormalizeOutput(false);
+    auto texture = alg.compute()[0];
+
+    // Layer spans voxels [8, 11] along the normal
+    EXPECT_EQ(cv::countNonZero(texture != expectedTex), 0);
+    EXPECT_FLOAT_EQ(texture.at<float>(0, 0), 3.F);
+}
+
+TEST(ThicknessTextureTest, MissingMaskThrows)
+{
+    vct::ThicknessTexture alg;
+    alg.setPerPixelMap(MakePPM());
+    EXPECT_THROW(alg.compute(), std::runtime_error);
+}
+
+TEST(ThicknessTextureTest, ThickLayerMatchesFixedStep)
+{
+    // Oblique normal, so the search crosses brick boundaries on every axis
+    cv::Vec3d normal{0.3, -0.2, 0.9};
+    normal /= cv::norm(normal);
+    auto ppm = MakePPM(normal);
+    auto mask = MakeMask(THICK_START, THICK_END);
+    constexpr double interval{0.5};
+
+    vct::ThicknessTexture alg;
+    alg.setPerPixelMap(ppm);
+    alg.setVolumetricMask(mask);
+    alg.setSamplingInterval(interval);
+    alg.setNormalizeOutput(false);
+    auto texture = alg.compute()[0];
+
+    vct::ThicknessTexture volAlg;
+    volAlg.setPerPixelMap(ppm);
+    volAlg.setMaskVolume(MakeMaskVolume(THICK_START, THICK_END));
+    volAlg.setSamplingInterval(interval);
+    volAlg.setNormalizeOutput(false);
+    auto volTexture = volAlg.compute()[0];
+
+    for (const auto [y, x] : vc::range2D(10, 10)) {
+        const auto& m = ppm->getMapping(y, x);
+        auto expected =
+            ExpectedThickness(*mask, {m[0], m[1], m[2]}, normal, interval);
+        auto u = static_cast<int>(x);
+        auto v = static_cast<int>(y);
+        EXPECT_NEAR(texture.at<float>(v, u), expected, 1e-4);
+        EXPECT_NEAR(volTexture.at<float>(v, u), expected, 1e-4);
+    }
+}
+
+TEST(ThicknessTextureTest, MaskVolumeSkipsBricksOutsidePPM)
+{
+    // The PPM is a plane at z = 10, but the layer spans z in [1, 18]
+    vct::ThicknessTexture alg;
+    alg.setPerPixelMap(MakePPM());
+    alg.setMaskVolume(MakeMaskVolume(THICK_START, THICK_END));
+    alg.setNormalizeOutput(false);
+
+    prof::Reset();
+    prof::SetEnabled(true);
+    auto texture = alg.compute()[0];
+    prof::SetEnabled(false);
+    auto skipped = prof::Snapshot().counters[static_cast<std::size_t>(
+        prof::Counter::MaskSamplesSkipped)];
+
+    // Full bricks are [4, 8), [8, 12), and [12, 16) in z. Going up, the search
+    // skips z = 11 and z = 13-15. Going down, it skips z = 9 and z = 5-6.
+    EXPECT_EQ(skipped, 7U * 100);
+    EXPECT_EQ(cv::countNonZero(texture != 17.F), 0);
+}
@@ -1,5 +1,8 @@
 #include <algorithm>
 #include <cctype>
+#include <cstddef>
+#include <iterator>
+#include <limits>
 #include <unordered_set>
 
 #include <boost/program_options.hpp>
@@ -19,6 +22,9 @@ using Voxel = cv::Vec3d;
 using VoxelHash = vc::Vec3Hash<Voxel>;
 using psio = vc::PointSetIO<Voxel>;
 
+// Number of points read from a pointset at a time
+constexpr std::size_t CHUNK_SIZE{1 << 20};
+
 /*
  * Does a very simple merge--merges all .vcps files in a certain directory.
  * Merge pointsets can prune unnecessary parts of a segmentation if
@@ -110,28 +116,18 @@ auto main(int argc, char* argv[]) -> int
 
     // Read all vcps files in the directory:
     for (const auto& p : resolvedPaths) {
-        // Load the file
+        // Map the file. Points are read in chunks below so that large point
+        // sets never need to be loaded whole.
         vc::Logger()->info("Loading file: \"{}\"", p.string());
-        auto tmpCloud = psio::ReadPointSet(p);
-        vc::Logger()->info("Loaded pointset with {} points", tmpCloud.size());
+        vc::MappedPointSet<Voxel> mapped(p);
+        vc::Logger()->info("Opened pointset with {} points", mapped.size());
 
         // Prune as needed
+        auto maxZ = std::numeric_limits<double>::max();
         if (parsed.count("prune")) {
             auto filename = p.stem().string();
             if (std::all_of(filename.begin(), filename.end(), ::isdigit)) {
-                int maxSliceNum = std::stoi(filename);
-
-                volcart::PointSet<Voxel> prunedCloud;
-                for (auto& pt : tmpCloud) {
-                    // Check the z-value. Only add it to prunedCloud if z is
-                    // less than the vcps name.
-                    if (pt[2] <= maxSliceNum) {
-                        prunedCloud.push_back(pt);
-                    }
-                }
-                tmpCloud = prunedCloud;
-                vc::Logger()->info(
-                    "Pruned pointset to {} points", tmpCloud.size());
+                maxZ = std::stoi(filename);
             } else {
                 vc::Logger()->warn(
                     "Filename contains characters other than digits. File will "
@@ -140,17 +136,40 @@ auto main(int argc, char* argv[]) -> int
             }
         }
 
+        // Call fn on every chunk of points which survives pruning. Only add
+        // a point if its z-value is less than the vcps name.
+        auto forEachChunk = [&mapped, maxZ](const auto& fn) {
+            for (std::size_t i = 0; i < mapped.size(); i += CHUNK_SIZE) {
+                auto count = std::min(CHUNK_SIZE, mapped.size() - i);
+                auto chunk = mapped.readPoints(i, count);
+                auto last = std::remove_if(
+                    chunk.begin(), chunk.end(),
+                    [maxZ](const auto& pt) { return pt[2] > maxZ; });
+                fn(chunk.begin(), last);
+            }
+        };
+
+        // Count the pruned points and find their z-range
+        std::size_t keptSize{0};
+        auto minChunkZ = std::numeric_limits<double>::max();
+        auto maxChunkZ = std::numeric_limits<double>::lowest();
+        forEachChunk([&](auto first, auto last) {
+            for (auto it = first; it != last; ++it) {
+                minChunkZ = std::min(minChunkZ, (*it)[2]);
+                maxChunkZ = std::max(maxChunkZ, (*it)[2]);
+            }
+            keptSize += std::distance(first, last);
+        });
+        if (keptSize != mapped.size()) {
+            vc::Logger()->info("Pruned pointset to {} points", keptSize);
+        }
+
         // Overwrite overlap
-        if (parsed.count("overwrite-overlap")) {
-            auto minMax = std::minmax_element(
-                tmpCloud.begin(), tmpCloud.end(),
-                [](const auto& l, const auto& r) { return l[2] < r[2]; });
-            auto minZ = (*minMax.first)[2];
-            auto maxZ = (*minMax.second)[2];
+        if (parsed.count("overwrite-overlap") and keptSize > 0) {
             auto origSize = pts.size();
             for (auto i = pts.begin(), last = pts.end(); i != last;) {
                 auto z = (*i)[2];
-                if (z >= minZ and z <= maxZ) {
+                if (z >= minChunkZ and z <= maxChunkZ) {
                     i = pts.erase(i);
                 } else {
                     ++i;
@@ -163,8 +182,9 @@ auto main(int argc, char* argv[]) -> int
 
         // Add all the points in the smaller cloud to the set
         auto origSize = pts.size();
-        pts.reserve(pts.size() + tmpCloud.size());
-        pts.insert(tmpCloud.begin(), tmpCloud.end());
+        pts.reserve(pts.size() + keptSize);
+        forEachChunk(
+            [&pts](auto first, auto last) { pts.insert(first, last); });
         vc::Logger()->info("Merged {} new points", pts.size() - origSize);
     }
 
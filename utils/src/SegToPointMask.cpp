@@ -33,8 +33,13 @@ auto main(int argc, char* argv[]) -> int
             "Default: The first volume in the volume package.")
         ("input-pts,i", po::value<std::string>()->required(),
             "Path to an input point set representing a segmentation")
-        ("output-pts,o", po::value<std::string>()->required(),
-         "Path to a directory to store the output point mask");
+        ("output-pts,o", po::value<std::string>(),
+         "Path to a directory to store the output point mask")
+        ("output-volume", po::value<std::string>(),
+         "Write the mask to a new volume with this name in the volume "
+         "package. Each slice is written as soon as it is computed, so the "
+         "full mask is never held in memory. Can be used instead of, but not "
+         "with, --output-pts.");
 
     // TFF options
     po::options_description tffOptions("Thinned Flood Fill Segmentation Options");
@@ -97,15 +102,24 @@ auto main(int argc, char* argv[]) -> int
 
     // Get the input and output paths
     fs::path ptsPath = parsed["input-pts"].as<std::string>();
-    fs::path outPath = parsed["output-pts"].as<std::string>();
+    auto hasOutPts = parsed.count("output-pts") > 0;
+    auto hasOutVol = parsed.count("output-volume") > 0;
+    if (hasOutPts == hasOutVol) {
+        vc::Logger()->error(
+            "Provide exactly one of --output-pts or --output-volume");
+        return EXIT_FAILURE;
+    }
 
-    // Read the segmentation pointset
+    // Read the segmentation pointset directly into the mask generator so
+    // that only one copy of it is held in memory
     vc::Logger()->info("Reading segmentation");
-    auto segmentation = vc::PointSetIO<cv::Vec3d>::ReadPointSet(ptsPath);
+    vcs::ComputeVolumetricMask maskGen;
+    {
+        vc::MappedPointSet<cv::Vec3d> segmentation(ptsPath);
+        maskGen.setPointSet(segmentation.readPoints(0, segmentation.size()));
+    }
 
     // Setup the mask generator
-    vcs::ComputeVolumetricMask maskGen;
-    maskGen.setPointSet(segmentation);
     maskGen.setVolume(volume);
     maskGen.setLowThreshold(parsed["low-thresh"].as<std::uint16_t>());
     maskGen.setHighThreshold(parsed["high-thresh"].as<std::uint16_t>());
@@ -117,14 +131,26 @@ auto main(int argc, char* argv[]) -> int
     }
     maskGen.setMeasureVertical(parsed.count("measure-vert") > 0);
 
+    // Stream the mask slices to a new volume
+    if (hasOutVol) {
+        auto name = parsed["output-volume"].as<std::string>();
+        auto maskVol = vpkg->newVolume(name);
+        vc::Logger()->info("Writing mask volume: {}", maskVol->id());
+        maskGen.setMaskVolume(maskVol);
+    }
+
     // Setup progress reporting
     vc::ReportProgress(maskGen, "Generating mask");
 
     // Compute the mask
     auto mask = maskGen.compute();
+    if (hasOutVol) {
+        return EXIT_SUCCESS;
+    }
 
     // Save the mask
     vc::Logger()->info("Saving mask");
+    fs::path outPath = parsed["output-pts"].as<std::string>();
     vc::PointSet<cv::Vec3i> maskPts;
     maskPts.append(mask->as_vector());
     vc::PointSetIO<cv::Vec3i>::WritePointSet(outPath, maskPts);